@@ -1,12 +1,15 @@
 
 #pragma once
 
+#include <cstdint>
 #include <sstream>
 #include <vector>
+#include <sys/time.h>
 
 #include <TFile.h>
 
 #include <boost/foreach.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -43,8 +46,16 @@ public:
 	{
 		typedef typename TPipelineRunner::setting_type setting_type;
 
-		LoadGlobalProducer <TPipelineRunner,TFactory, setting_type > (runner, factory);
+		setting_type& gSettings = GetGlobalSettings< setting_type >();
+
+		timeval tStart;
+		gettimeofday(&tStart, nullptr);
+		LoadGlobalProducer <TPipelineRunner,TFactory, setting_type > (runner, factory, gSettings);
+		LOG(INFO) << "Startup: initialised global processors in " << GetSecondsSince(tStart) << " s.";
+
+		gettimeofday(&tStart, nullptr);
 		LoadPipelines< TPipelineInitializer, TPipelineRunner>(pInit, runner, factory, outputFile);
+		LOG(INFO) << "Startup: initialised pipelines in " << GetSecondsSince(tStart) << " s.";
 	}
 
 	template<class TSettings>
@@ -56,6 +67,24 @@ public:
 		return pset;
 	}
 
+	// settings used to initialise the global processors in LoadConfiguration, created by the first call
+	// pass this instance to PipelineRunner::RunPipelines, such that the values cached by the global
+	// processors are also used in the event loop and are not reported as read after freezing
+	template<class TSettings>
+	TSettings& GetGlobalSettings()
+	{
+		if (! m_globalSettings)
+		{
+			m_globalSettings.reset(new TSettings(GetSettings< TSettings >()));
+		}
+		TSettings* globalSettings = dynamic_cast<TSettings*>(m_globalSettings.get());
+		if (globalSettings == nullptr)
+		{
+			LOG(FATAL) << "The global settings have already been created with a different type!";
+		}
+		return *globalSettings;
+	}
+
 	std::string const& GetOutputPath() const
 	{
 		return m_outputPath;
@@ -69,15 +98,26 @@ private:
 
 	void InitConfig( bool configPreLoaded = false );
 
+	// The binary cache of the property tree can be used if it is newer than the json file.
+	// It stores the size and a hash of the json file, which are compared before the tree is read.
+	// Caches that do not match or cannot be read are ignored and the json file is parsed instead.
+	bool IsConfigCacheValid() const;
+	bool ReadConfigCache(std::string const& jsonConfigContent);
+	void WriteConfigCache(std::string const& jsonConfigContent) const;
+	static uint64_t GetConfigHash(std::string const& jsonConfigContent);
+
+	static const uint32_t ConfigCacheVersion = 1;
+
+	static double GetSecondsSince(timeval const& tStart);
+
 	std::pair < bool, el::Level> parseLogLevel(std::string const& inpString) const;
 
 	// load the global produce list from configuration and
 	// use the factory object to add these producers to the pipeline runner
 	// don't use directly but call LoadConfiguration
 	template<class TPipelineRunner, class TFactory, class TGlobalSettings>
-	void LoadGlobalProducer( TPipelineRunner& runner, TFactory & factory ) {
+	void LoadGlobalProducer( TPipelineRunner& runner, TFactory & factory, TGlobalSettings const& gSettings ) {
 
-		TGlobalSettings gSettings = GetSettings< TGlobalSettings >();
 		std::vector<std::string> globalProds = gSettings.GetProcessors();
 		for (std::vector<std::string>::const_iterator it = globalProds.begin(); it != globalProds.end(); ++it) {
 
@@ -117,9 +157,16 @@ private:
 		typedef typename TPipelineInitializer::setting_type setting_type;
 		typedef typename TPipelineInitializer::pipeline_type pipeline_type;
 
+		size_t nPipelines = 0;
+		double slowestPipelineTime = 0.0;
+		std::string slowestPipeline;
+
 		BOOST_FOREACH(boost::property_tree::ptree::value_type& v,
 				m_propTreeRoot.get_child("Pipelines"))
 		{
+			timeval tStart;
+			gettimeofday(&tStart, nullptr);
+
 			setting_type pset;
 
 			// the key name of the dictionary will also become the 
@@ -176,13 +223,30 @@ private:
 
 			pLine->InitPipeline(pset, pInit);
 			runner.AddPipeline(pLine);
+
+			double pipelineTime = GetSecondsSince(tStart);
+			LOG(DEBUG) << "Startup: initialised pipeline \"" << sKeyName << "\" in " << pipelineTime << " s.";
+			if (pipelineTime > slowestPipelineTime)
+			{
+				slowestPipelineTime = pipelineTime;
+				slowestPipeline = sKeyName;
+			}
+			++nPipelines;
+		}
+
+		if (nPipelines > 0)
+		{
+			LOG(INFO) << "Startup: " << nPipelines << " pipelines, slowest is \"" << slowestPipeline
+			          << "\" (" << slowestPipelineTime << " s).";
 		}
 	}
 
 	std::string m_jsonConfigFileName;
+	std::string m_configCacheFileName;
 	std::string m_outputPath;
 	std::vector<std::string> m_fileNames;
 	boost::property_tree::ptree m_propTreeRoot;
+	boost::scoped_ptr<SettingsBase> m_globalSettings;
 
 	std::string m_minimumLogLevelString;
 
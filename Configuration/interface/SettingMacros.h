@@ -1,13 +1,32 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "VarCache.h"
 #include "Artus/Utility/interface/Utility.h"
 
 
+/**
+   Implements a implicit caching of a setting using the VarCache class.
+   Settings that are not yet cached are reported if the settings are already frozen
+   (see SettingsBase::Freeze), since they are then read during the event loop.
+*/
+#define RETURN_CACHED_SETTING(CACHE_MEMBER, SNAME, VALUEPATH) \
+{ \
+	if (! CACHE_MEMBER.IsCached()) \
+	{ \
+		ReportUncachedSetting(#SNAME); \
+		CACHE_MEMBER.SetCache( VALUEPATH ); \
+	} \
+	return CACHE_MEMBER.GetValue(); \
+}
+
 /**
    Implements a Setting with automatic read + caching from a Boost PropertyTree
-   You can access the value via myObject.GetSNAME
+   You can access the value via myObject.GetSNAME, which returns a reference to the cached value
+   The value is taken from the pipeline settings and, if it is not set there, from the global settings
+   (see SettingsBase::ResolveSettingTree).
 */
 
 #define IMPL_SETTING_PRIVATE(TYPE, SNAME, READGLOBAL) \
@@ -25,28 +44,23 @@ public: \
 		} \
 	} \
 	mutable VarCache<TYPE> Cache##SNAME; \
-	TYPE Get##SNAME ( ) const { \
+	TYPE const& Get##SNAME ( ) const { \
 		if (Cache##SNAME.IsCached()) { \
 			return Cache##SNAME.GetValue(); \
 		} \
-		TYPE val = TYPE(); \
-		try { \
-			val = GetPropTree()->get< TYPE >( FullKey##SNAME ()); \
-		} catch(...) { \
-			try { \
-				val = GetPropTree()->get< TYPE >( Key##SNAME ()); \
-			} catch(...) { \
-				LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			} \
+		ReportUncachedSetting(#SNAME); \
+		boost::optional<TYPE> val = GetOptionalSetting<TYPE>(#SNAME, READGLOBAL); \
+		if (! val) { \
+			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
 		} \
-		Cache##SNAME.SetCache( val ); \
-		return val; \
+		Cache##SNAME.SetCache( *val ); \
+		return Cache##SNAME.GetValue(); \
 	}
 
 /**
    Implements a Setting with automatic read + caching from a Boost PropertyTree
    You can set a default value which will be used if the entry was not found in the PropertyTree
-   You can access the value via myObject.GetSNAME
+   You can access the value via myObject.GetSNAME, which returns a reference to the cached value
 */
 
 #define IMPL_SETTING_DEFAULT_PRIVATE(TYPE, SNAME, DEFAULT_VAL, READGLOBAL) \
@@ -64,18 +78,14 @@ public: \
 		} \
 	} \
 	mutable VarCache<TYPE> Cache##SNAME; \
-	TYPE Get##SNAME ( ) const { \
+	TYPE const& Get##SNAME ( ) const { \
 		if (Cache##SNAME.IsCached()) { \
 			return Cache##SNAME.GetValue(); \
 		} \
-		TYPE val; \
-		try { \
-		val = GetPropTree()->get< TYPE >( FullKey##SNAME () ); \
-		} catch(...) { \
-		val = GetPropTree()->get< TYPE >( Key##SNAME (), DEFAULT_VAL ); \
-		} \
-		Cache##SNAME.SetCache( val ); \
-		return val; \
+		ReportUncachedSetting(#SNAME); \
+		boost::optional<TYPE> val = GetOptionalSetting<TYPE>(#SNAME, READGLOBAL); \
+		Cache##SNAME.SetCache( val ? *val : static_cast<TYPE>(DEFAULT_VAL) ); \
+		return Cache##SNAME.GetValue(); \
 	}
 
 #define IMPL_SETTING(TYPE, SNAME) IMPL_SETTING_PRIVATE(TYPE, SNAME, false)
@@ -84,346 +94,106 @@ public: \
 // #define IMPL_GLOBAL_SETTING(TYPE, SNAME) IMPL_SETTING_PRIVATE(TYPE, SNAME, true)
 // #define IMPL_GLOBAL_SETTING_DEFAULT(TYPE, SNAME, DEFAULT_VAL) IMPL_SETTING_DEFAULT_PRIVATE(TYPE, SNAME, DEFAULT_VAL, true)
 
-#define IMPL_SETTING_STRINGLIST( SNAME ) \
-VarCache<std::vector<std::string>> m_##SNAME; \
-virtual std::vector<std::string>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
+/**
+   Implements a list setting read with the function READER from PropertyTreeSupport.
+   SORT can be Utility::Sorted or left empty. If the pipeline entry cannot be converted
+   (e.g. bad_lexical_cast), the global entry is used (see SettingsBase::ReadListSetting).
+*/
+
+#define IMPL_SETTING_LIST_PRIVATE(TYPE, SNAME, READER, SORT, READGLOBAL) \
+VarCache<std::vector<TYPE>> m_##SNAME; \
+virtual std::vector<TYPE>& Get##SNAME () const { \
+	if (! m_##SNAME.IsCached()) \
+	{ \
+		ReportUncachedSetting(#SNAME); \
+		std::vector<TYPE> value; \
+		if (! ReadListSetting<TYPE>(#SNAME, READGLOBAL, &READER, value)) \
+		{ \
 			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
 		} \
+		m_##SNAME.SetCache( SORT(value) ); \
 	} \
+	return m_##SNAME.GetValue(); \
 }
 
-#define IMPL_GLOBAL_SETTING_STRINGLIST( SNAME ) \
-VarCache<std::vector<std::string>> m_##SNAME; \
-std::vector<std::string>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
-	} \
-	catch(...) { \
-		LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-		throw; \
-	} \
-}
-
-#define IMPL_SETTING_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<std::string>> m_##SNAME; \
-virtual std::vector<std::string>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME )) \
+#define IMPL_SETTING_LIST_DEFAULT_PRIVATE(TYPE, SNAME, READER, SORT, DEFAULT_VAL) \
+VarCache<std::vector<TYPE>> m_##SNAME; \
+virtual std::vector<TYPE>& Get##SNAME () const { \
+	if (! m_##SNAME.IsCached()) \
+	{ \
+		ReportUncachedSetting(#SNAME); \
+		std::vector<TYPE> value; \
+		if (ReadListSetting<TYPE>(#SNAME, false, &READER, value)) \
+		{ \
+			m_##SNAME.SetCache( SORT(value) ); \
 		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
+		else \
+		{ \
+			m_##SNAME.SetCache( DEFAULT_VAL ); \
 		} \
 	} \
+	return m_##SNAME.GetValue(); \
 }
 
+#define IMPL_SETTING_STRINGLIST( SNAME ) \
+	IMPL_SETTING_LIST_PRIVATE(std::string, SNAME, PropertyTreeSupport::GetAsStringList, , false)
+
+#define IMPL_GLOBAL_SETTING_STRINGLIST( SNAME ) \
+	IMPL_SETTING_LIST_PRIVATE(std::string, SNAME, PropertyTreeSupport::GetAsStringList, , true)
+
+#define IMPL_SETTING_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(std::string, SNAME, PropertyTreeSupport::GetAsStringList, , DEFAULT_VAL)
+
 #define IMPL_SETTING_SORTED_STRINGLIST( SNAME ) \
-VarCache<std::vector<std::string>> m_##SNAME; \
-virtual std::vector<std::string>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(std::string, SNAME, PropertyTreeSupport::GetAsStringList, Utility::Sorted, false)
 
 #define IMPL_SETTING_SORTED_STRINGLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<std::string>> m_##SNAME; \
-virtual std::vector<std::string>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsStringList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(std::string, SNAME, PropertyTreeSupport::GetAsStringList, Utility::Sorted, DEFAULT_VAL)
 
 #define IMPL_SETTING_DOUBLELIST( SNAME ) \
-VarCache<std::vector<double>> m_##SNAME; \
-virtual std::vector<double>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(double, SNAME, PropertyTreeSupport::GetAsDoubleList, , false)
 
 #define IMPL_SETTING_DOUBLELIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<double>> m_##SNAME; \
-virtual std::vector<double>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(double, SNAME, PropertyTreeSupport::GetAsDoubleList, , DEFAULT_VAL)
 
 #define IMPL_SETTING_SORTED_DOUBLELIST( SNAME ) \
-VarCache<std::vector<double>> m_##SNAME; \
-virtual std::vector<double>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(double, SNAME, PropertyTreeSupport::GetAsDoubleList, Utility::Sorted, false)
 
 #define IMPL_SETTING_SORTED_DOUBLELIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<double>> m_##SNAME; \
-virtual std::vector<double>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsDoubleList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(double, SNAME, PropertyTreeSupport::GetAsDoubleList, Utility::Sorted, DEFAULT_VAL)
 
 #define IMPL_SETTING_FLOATLIST( SNAME ) \
-VarCache<std::vector<float>> m_##SNAME; \
-virtual std::vector<float>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(float, SNAME, PropertyTreeSupport::GetAsFloatList, , false)
 
 #define IMPL_SETTING_FLOATLIST_DEFAULT( SNAME, DEFAULT_VAL) \
-VarCache<std::vector<float>> m_##SNAME; \
-virtual std::vector<float>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(float, SNAME, PropertyTreeSupport::GetAsFloatList, , DEFAULT_VAL)
 
 #define IMPL_SETTING_SORTED_FLOATLIST( SNAME ) \
-VarCache<std::vector<float>> m_##SNAME; \
-virtual std::vector<float>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(float, SNAME, PropertyTreeSupport::GetAsFloatList, Utility::Sorted, false)
 
 #define IMPL_SETTING_SORTED_FLOATLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<float>> m_##SNAME; \
-virtual std::vector<float>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsFloatList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(float, SNAME, PropertyTreeSupport::GetAsFloatList, Utility::Sorted, DEFAULT_VAL)
 
 #define IMPL_SETTING_INTLIST( SNAME ) \
-VarCache<std::vector<int>> m_##SNAME; \
-virtual std::vector<int>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(int, SNAME, PropertyTreeSupport::GetAsIntList, , false)
 
 #define IMPL_SETTING_INTLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<int>> m_##SNAME; \
-virtual std::vector<int>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(int, SNAME, PropertyTreeSupport::GetAsIntList, , DEFAULT_VAL)
 
 #define IMPL_SETTING_SORTED_INTLIST( SNAME ) \
-VarCache<std::vector<int>> m_##SNAME; \
-virtual std::vector<int>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(int, SNAME, PropertyTreeSupport::GetAsIntList, Utility::Sorted, false)
 
 #define IMPL_SETTING_SORTED_INTLIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<int>> m_##SNAME; \
-virtual std::vector<int>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsIntList(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL) \
-		} \
-	} \
-}
-
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(int, SNAME, PropertyTreeSupport::GetAsIntList, Utility::Sorted, DEFAULT_VAL)
 
 #define IMPL_SETTING_UINT64LIST( SNAME ) \
-VarCache<std::vector<uint64_t>> m_##SNAME; \
-virtual std::vector<uint64_t>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(uint64_t, SNAME, PropertyTreeSupport::GetAsUInt64List, , false)
 
 #define IMPL_SETTING_UINT64LIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<uint64_t>> m_##SNAME; \
-virtual std::vector<uint64_t>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME )) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME )) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
-
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(uint64_t, SNAME, PropertyTreeSupport::GetAsUInt64List, , DEFAULT_VAL)
 
 #define IMPL_SETTING_SORTED_UINT64LIST( SNAME ) \
-VarCache<std::vector<uint64_t>> m_##SNAME; \
-virtual std::vector<uint64_t>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			LOG(FATAL) << "Could not read value for config tag \"" << (#SNAME) << "\" in pipeline or global settings! It is either not specified or the specified type is incompatible!"; \
-			throw; \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_PRIVATE(uint64_t, SNAME, PropertyTreeSupport::GetAsUInt64List, Utility::Sorted, false)
 
 #define IMPL_SETTING_SORTED_UINT64LIST_DEFAULT( SNAME, DEFAULT_VAL ) \
-VarCache<std::vector<uint64_t>> m_##SNAME; \
-virtual std::vector<uint64_t>& Get##SNAME () const { \
-	try { \
-		RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), GetPipelinePrefix() + #SNAME ))) \
-	} \
-	catch(...) { \
-		try { \
-			RETURN_CACHED(m_##SNAME, Utility::Sorted(PropertyTreeSupport::GetAsUInt64List(GetPropTree(), #SNAME ))) \
-		} \
-		catch(...) { \
-			RETURN_CACHED(m_##SNAME, DEFAULT_VAL ) \
-		} \
-	} \
-}
+	IMPL_SETTING_LIST_DEFAULT_PRIVATE(uint64_t, SNAME, PropertyTreeSupport::GetAsUInt64List, Utility::Sorted, DEFAULT_VAL)
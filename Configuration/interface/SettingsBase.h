@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
+
 #include "TFile.h"
 
 #include "Artus/Configuration/interface/PropertyTreeSupport.h"
@@ -87,8 +90,91 @@ public:
 	// in the config file
 	PipelineInfos GetPipelineInfos () const;
 
+	/// Freeze the settings once all processors are initialised. The settings read so far are
+	/// resolved and cached and are returned by reference without any lookup in the property tree.
+	/// Settings read for the first time after freezing are looked up during the event loop and
+	/// are therefore reported. Copies of frozen settings keep the cached values and are frozen as well.
+	void Freeze() const;
+	bool IsFrozen() const;
+
+	/// called by the setting macros for every setting that is not yet cached
+	void ReportUncachedSetting(std::string const& key) const;
+
+	/// list of "<pipeline>: <key>" entries of settings first read after freezing
+	static std::vector<std::string> const& GetSettingsReadAfterFreezing();
+
+	/// Returns the (sub-)tree which holds the setting key, i.e. the settings of this pipeline if the
+	/// key is set there and the global settings otherwise. Returns nullptr if the key is not set at all.
+	/// The pipeline sub-tree is resolved once, such that the lookup only needs to search the
+	/// direct children of the pipeline and of the global settings and no exceptions are thrown.
+	boost::property_tree::ptree* ResolveSettingTree(std::string const& key, bool readGlobal=false) const;
+
+	/// Reads a single value. If the pipeline entry cannot be converted to TValue,
+	/// the global entry is tried. Returns an empty optional if both fail.
+	template<class TValue>
+	boost::optional<TValue> GetOptionalSetting(std::string const& key, bool readGlobal=false) const
+	{
+		boost::property_tree::ptree* pipelineTree = (readGlobal ? nullptr : GetPipelineTree());
+		if (pipelineTree != nullptr)
+		{
+			boost::optional<TValue> value = pipelineTree->get_optional<TValue>(boost::property_tree::ptree::path_type(key));
+			if (value)
+			{
+				return value;
+			}
+		}
+		if (GetPropTree() == nullptr)
+		{
+			return boost::optional<TValue>();
+		}
+		return GetPropTree()->get_optional<TValue>(boost::property_tree::ptree::path_type(key));
+	}
+
+	/// Reads a list with one of the PropertyTreeSupport functions. If the pipeline entry cannot be
+	/// converted, the global entry is tried. Returns false if both fail.
+	template<class TValue>
+	bool ReadListSetting(std::string const& key, bool readGlobal,
+	                     std::vector<TValue> (*reader)(boost::property_tree::ptree*, std::string),
+	                     std::vector<TValue>& value) const
+	{
+		boost::property_tree::ptree* pipelineTree = (readGlobal ? nullptr : GetPipelineTree());
+		boost::property_tree::ptree* settingTrees[2] = { pipelineTree, GetPropTree() };
+		for (size_t treeIndex = 0; treeIndex < 2; ++treeIndex)
+		{
+			boost::property_tree::ptree* settingTree = settingTrees[treeIndex];
+			if ((settingTree == nullptr) || (settingTree->find(key) == settingTree->not_found()))
+			{
+				continue;
+			}
+			try
+			{
+				value = reader(settingTree, key);
+				return true;
+			}
+			catch (boost::bad_lexical_cast const&)
+			{
+			}
+			catch (boost::property_tree::ptree_error const&)
+			{
+			}
+		}
+		return false;
+	}
+
 private:
 	VarCache < PipelineInfos > m_pipelineInfos;
+	mutable bool m_frozen;
+
+	// resolved sub-tree of this pipeline in the property tree (nullptr for the global settings)
+	// together with the root and path used to resolve it
+	mutable boost::property_tree::ptree* m_pipelineTree;
+	mutable boost::property_tree::ptree* m_pipelineTreeRoot;
+	mutable std::string m_pipelineTreePath;
+	mutable bool m_pipelineTreeResolved;
+
+	boost::property_tree::ptree* GetPipelineTree() const;
+
+	static std::vector<std::string>& SettingsReadAfterFreezing();
 
 };
 
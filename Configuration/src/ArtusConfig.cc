@@ -1,8 +1,14 @@
 #include <iostream>
+#include <fstream>
+#include <iterator>
 #include <cstdlib>
+#include <sys/stat.h>
 
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/property_tree/ptree_serialization.hpp>
 
 #include "TObjString.h"
 
@@ -12,6 +18,7 @@
 
 ArtusConfig::ArtusConfig(int argc, char** argv) :
 	m_jsonConfigFileName(""),
+	m_configCacheFileName(""),
 	m_minimumLogLevelString("")
 {
 	boost::program_options::options_description programOptions("Options");
@@ -20,7 +27,9 @@ ArtusConfig::ArtusConfig(int argc, char** argv) :
 		("log-level", boost::program_options::value< std::string >(&m_minimumLogLevelString),
 		 "Detail level of logging (debug, info, warning, error, critical). [Default: taken from JSON config or info]")
 		("json-config", boost::program_options::value< std::string >(&m_jsonConfigFileName),
-		 "JSON config file");
+		 "JSON config file")
+		("config-cache", boost::program_options::value< std::string >(&m_configCacheFileName),
+		 "Binary cache of the JSON config. It is read instead of the JSON config if it is newer, otherwise it is (re-)written. [Default: no cache]");
 
 	
 	boost::program_options::positional_options_description positionalProgramOptions;
@@ -72,6 +81,7 @@ std::pair<bool, el::Level> ArtusConfig::parseLogLevel(
 
 ArtusConfig::ArtusConfig(std::stringstream & sStream) :
     m_jsonConfigFileName(""),
+    m_configCacheFileName(""),
     m_minimumLogLevelString("")
 {
 	boost::property_tree::json_parser::read_json(sStream, m_propTreeRoot);
@@ -81,15 +91,41 @@ ArtusConfig::ArtusConfig(std::stringstream & sStream) :
 
 void ArtusConfig::InitConfig( bool configPreLoaded )
 {
+	timeval tStart;
+	gettimeofday(&tStart, nullptr);
+	bool configFromCache = false;
+
     // has the config been preloaded via the constructor already ?
     if (! configPreLoaded ) {
 	    if(m_jsonConfigFileName.empty()) {
 		    LOG(FATAL) << "NO JSON config specified!";
 	    }
 	
-	    std::cout << "Loading Config file from \"" << m_jsonConfigFileName << "\"." << std::endl;
-	    boost::property_tree::json_parser::read_json(m_jsonConfigFileName, m_propTreeRoot);
+	    if (m_configCacheFileName.empty()) {
+		    std::cout << "Loading Config file from \"" << m_jsonConfigFileName << "\"." << std::endl;
+		    boost::property_tree::json_parser::read_json(m_jsonConfigFileName, m_propTreeRoot);
+	    }
+	    else {
+		    // the content of the JSON config is needed anyway to validate the cache
+		    std::ifstream jsonConfigFile(m_jsonConfigFileName.c_str(), std::ios::binary);
+		    if (! jsonConfigFile) {
+			    LOG(FATAL) << "JSON config \"" << m_jsonConfigFileName << "\" cannot be opened!";
+		    }
+		    std::string jsonConfigContent((std::istreambuf_iterator<char>(jsonConfigFile)), std::istreambuf_iterator<char>());
+
+		    if (IsConfigCacheValid()) {
+			    std::cout << "Loading Config cache from \"" << m_configCacheFileName << "\"." << std::endl;
+			    configFromCache = ReadConfigCache(jsonConfigContent);
+		    }
+		    if (! configFromCache) {
+			    std::cout << "Loading Config file from \"" << m_jsonConfigFileName << "\"." << std::endl;
+			    std::istringstream jsonConfigStream(jsonConfigContent);
+			    boost::property_tree::json_parser::read_json(jsonConfigStream, m_propTreeRoot);
+			    WriteConfigCache(jsonConfigContent);
+		    }
+	    }
     }
+	double configLoadTime = GetSecondsSince(tStart);
 	
 	// init logging
 	if(m_minimumLogLevelString.empty()) {
@@ -140,6 +176,8 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 
 	el::Loggers::reconfigureLogger("default", defaultLoggingConfig);
 
+	LOG(INFO) << "Startup: " << (configFromCache ? "read config cache" : "parsed config") << " in " << configLoadTime << " s.";
+
 	m_outputPath = m_propTreeRoot.get<std::string>("OutputPath", "output.root");
 	m_fileNames = PropertyTreeSupport::GetAsStringList(&m_propTreeRoot, "InputFiles");
 	LOG(INFO) << "Loading " << m_fileNames.size() << " input files.";
@@ -150,6 +188,85 @@ void ArtusConfig::InitConfig( bool configPreLoaded )
 	}
 }
 
+bool ArtusConfig::IsConfigCacheValid() const
+{
+	if (m_configCacheFileName.empty())
+	{
+		return false;
+	}
+
+	struct stat jsonStat, cacheStat;
+	if ((stat(m_jsonConfigFileName.c_str(), &jsonStat) != 0) || (stat(m_configCacheFileName.c_str(), &cacheStat) != 0))
+	{
+		return false;
+	}
+	return (cacheStat.st_mtime >= jsonStat.st_mtime);
+}
+
+bool ArtusConfig::ReadConfigCache(std::string const& jsonConfigContent)
+{
+	try
+	{
+		std::ifstream cacheFile(m_configCacheFileName.c_str(), std::ios::binary);
+		boost::archive::binary_iarchive cacheArchive(cacheFile);
+
+		uint32_t cacheVersion = 0;
+		uint64_t jsonConfigSize = 0;
+		uint64_t jsonConfigHash = 0;
+		cacheArchive >> cacheVersion >> jsonConfigSize >> jsonConfigHash;
+		if ((cacheVersion != ConfigCacheVersion) || (jsonConfigSize != jsonConfigContent.size()) ||
+		    (jsonConfigHash != GetConfigHash(jsonConfigContent)))
+		{
+			std::cout << "Config cache \"" << m_configCacheFileName << "\" does not match the JSON config." << std::endl;
+			return false;
+		}
+
+		cacheArchive >> m_propTreeRoot;
+	}
+	catch (std::exception const& exception)
+	{
+		std::cout << "Config cache \"" << m_configCacheFileName << "\" cannot be read (" << exception.what() << ")." << std::endl;
+		m_propTreeRoot.clear();
+		return false;
+	}
+	return true;
+}
+
+void ArtusConfig::WriteConfigCache(std::string const& jsonConfigContent) const
+{
+	std::ofstream cacheFile(m_configCacheFileName.c_str(), std::ios::binary);
+	if (! cacheFile.good())
+	{
+		std::cout << "Cannot write Config cache to \"" << m_configCacheFileName << "\"." << std::endl;
+		return;
+	}
+	boost::archive::binary_oarchive cacheArchive(cacheFile);
+	uint32_t cacheVersion = ConfigCacheVersion;
+	uint64_t jsonConfigSize = jsonConfigContent.size();
+	uint64_t jsonConfigHash = GetConfigHash(jsonConfigContent);
+	cacheArchive << cacheVersion << jsonConfigSize << jsonConfigHash;
+	cacheArchive << m_propTreeRoot;
+}
+
+uint64_t ArtusConfig::GetConfigHash(std::string const& jsonConfigContent)
+{
+	// 64 bit FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (std::string::const_iterator character = jsonConfigContent.begin(); character != jsonConfigContent.end(); ++character)
+	{
+		hash ^= static_cast<unsigned char>(*character);
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+double ArtusConfig::GetSecondsSince(timeval const& tStart)
+{
+	timeval tEnd;
+	gettimeofday(&tEnd, nullptr);
+	return static_cast<double>(tEnd.tv_sec - tStart.tv_sec) + static_cast<double>(tEnd.tv_usec - tStart.tv_usec) * 1e-6;
+}
+
 void ArtusConfig::SaveConfig(TFile * outputFile) const
 {
 	TObjString jsonConfigContent(
@@ -2,14 +2,24 @@
 #include "Artus/Configuration/interface/ArtusConfig.h"
 #include "Artus/Configuration/interface/SettingsBase.h"
 
+#include <algorithm>
+
 SettingsBase::SettingsBase() :
-	m_RootOutFile(nullptr)
+	m_RootOutFile(nullptr),
+	m_frozen(false),
+	m_pipelineTree(nullptr),
+	m_pipelineTreeRoot(nullptr),
+	m_pipelineTreeResolved(false)
 {
 }
 
 SettingsBase::SettingsBase(std::string const& name) :
 	m_Name(name),
-	m_RootOutFile(nullptr)
+	m_RootOutFile(nullptr),
+	m_frozen(false),
+	m_pipelineTree(nullptr),
+	m_pipelineTreeRoot(nullptr),
+	m_pipelineTreeResolved(false)
 {
 }
 
@@ -89,3 +99,69 @@ std::vector<std::string> SettingsBase::GetAllProcessors () const {
 std::vector<std::string> SettingsBase::GetFilters () const {
 	return SettingsUtil::ExtractFilters(GetProcessors());
 }
+
+void SettingsBase::Freeze() const {
+	m_frozen = true;
+}
+
+bool SettingsBase::IsFrozen() const {
+	return m_frozen;
+}
+
+void SettingsBase::ReportUncachedSetting(std::string const& key) const {
+	if (! m_frozen)
+		return;
+
+	std::string entry = (GetName() == "" ? "global" : GetName()) + ": " + key;
+	std::vector<std::string>& readAfterFreezing = SettingsReadAfterFreezing();
+	if (std::find(readAfterFreezing.begin(), readAfterFreezing.end(), entry) == readAfterFreezing.end()) {
+		LOG(DEBUG) << "Setting \"" << key << "\" (" << (GetName() == "" ? "global" : GetName())
+		           << ") is read for the first time after the initialisation.";
+		readAfterFreezing.push_back(entry);
+	}
+}
+
+std::vector<std::string> const& SettingsBase::GetSettingsReadAfterFreezing() {
+	return SettingsReadAfterFreezing();
+}
+
+std::vector<std::string>& SettingsBase::SettingsReadAfterFreezing() {
+	static std::vector<std::string> readAfterFreezing;
+	return readAfterFreezing;
+}
+
+boost::property_tree::ptree* SettingsBase::GetPipelineTree() const {
+	std::string pipelinePath = GetPropTreePath();
+	if (pipelinePath.empty() && (! GetName().empty())) {
+		pipelinePath = "Pipelines." + GetName();
+	}
+
+	// resolve again only if the settings have been pointed to a different tree or pipeline
+	if ((! m_pipelineTreeResolved) || (m_pipelineTreeRoot != GetPropTree()) || (m_pipelineTreePath != pipelinePath)) {
+		m_pipelineTree = nullptr;
+		if ((GetPropTree() != nullptr) && (! pipelinePath.empty())) {
+			boost::optional<boost::property_tree::ptree&> pipelineTree = GetPropTree()->get_child_optional(pipelinePath);
+			if (pipelineTree) {
+				m_pipelineTree = &(*pipelineTree);
+			}
+		}
+		m_pipelineTreeRoot = GetPropTree();
+		m_pipelineTreePath = pipelinePath;
+		m_pipelineTreeResolved = true;
+	}
+	return m_pipelineTree;
+}
+
+boost::property_tree::ptree* SettingsBase::ResolveSettingTree(std::string const& key, bool readGlobal) const {
+	if (! readGlobal) {
+		boost::property_tree::ptree* pipelineTree = GetPipelineTree();
+		if ((pipelineTree != nullptr) && (pipelineTree->find(key) != pipelineTree->not_found())) {
+			return pipelineTree;
+		}
+	}
+	if ((GetPropTree() != nullptr) && (GetPropTree()->find(key) != GetPropTree()->not_found())) {
+		return GetPropTree();
+	}
+	return nullptr;
+}
+
@@ -0,0 +1,208 @@
+
+#pragma once
+
+#include <algorithm>
+
+#include <TDirectory.h>
+#include <TTree.h>
+#include <TROOT.h>
+
+#include "Artus/Utility/interface/RootFileHelper.h"
+#include "Artus/Consumer/interface/CutFlowConsumerBase.h"
+
+
+/**
+   \brief Cut flow consumer writing one row per event into a single tree.
+
+   The tree "cutFlowEvents" contains run, lumi and event number, a 64 bit mask
+   of the passed filters (bit i corresponds to the i-th filter of the pipeline,
+   see the tree title) and the event weight. For every filter, an alias with
+   the filter name is defined, such that e.g. cutFlowEvents->Draw("weight", "JsonFilter")
+   works. The output size and fill cost do not depend on the number of filters.
+
+   The tree "cutFlowLumis" contains the (weighted) numbers of events passing each
+   filter per lumi section. A new row is written each time the lumi section changes,
+   therefore rows of the same lumi section have to be summed for unsorted inputs.
+*/
+template < class TTypes >
+class CutFlowBitmaskConsumer: public CutFlowConsumerBase< TTypes > {
+public:
+
+	typedef typename TTypes::event_type event_type;
+	typedef typename TTypes::product_type product_type;
+	typedef typename TTypes::setting_type setting_type;
+
+	typedef typename std::function<uint64_t(event_type const&, product_type const&, setting_type const&)> uint64_extractor_lambda;
+	typedef typename std::function<double(event_type const&, product_type const&, setting_type const&)> weight_extractor_lambda;
+
+	std::string GetConsumerId() const override
+	{
+		return "CutFlowBitmaskConsumer";
+	}
+
+	CutFlowBitmaskConsumer() :
+		CutFlowConsumerBase< TTypes >(),
+		m_treesInitialised(false)
+	{
+	}
+
+	void Init(setting_type const& settings) override
+	{
+		CutFlowConsumerBase<TTypes>::Init(settings);
+
+		// default run,lumi,event = 1, weight = 1.0
+		// overwrite this in analysis-specific code
+		m_runExtractor = [](event_type const&, product_type const&, setting_type const&) { return 1; };
+		m_lumiExtractor = [](event_type const&, product_type const&, setting_type const&) { return 1; };
+		m_eventExtractor = [](event_type const&, product_type const&, setting_type const&) { return 1; };
+		m_weightExtractor = [](event_type const&, product_type const&, setting_type const&) { return 1.0; };
+	}
+
+	void ProcessEvent(event_type const& event,
+	                  product_type const& product,
+	                  setting_type const& setting,
+	                  FilterResult & filterResult) override
+	{
+		// the base class is not called on purpose, since the overall cut flow
+		// needs to be filled with weights
+		m_weight = m_weightExtractor(event, product, setting);
+		this->m_flow.AddFilterResult(filterResult, m_weight);
+
+		if(! m_treesInitialised) {
+			m_treesInitialised = InitialiseTrees(setting, filterResult);
+		}
+
+		m_run = m_runExtractor(event, product, setting);
+		m_lumi = m_lumiExtractor(event, product, setting);
+		m_event = m_eventExtractor(event, product, setting);
+		m_passedFilters = CutFlow::GetPassedFilterMask(filterResult);
+
+		m_cutFlowEventsTree->Fill();
+
+		if ((m_lumiFlow.GetEventCount() > 0) && ((m_run != m_lumiRun) || (m_lumi != m_lumiLumi)))
+		{
+			FillLumiTree();
+		}
+		m_lumiRun = m_run;
+		m_lumiLumi = m_lumi;
+		m_lumiFlow.AddFilterResult(filterResult, m_weight);
+	}
+
+	void Finish(setting_type const& setting) override {
+		CutFlowConsumerBase<TTypes>::Finish(setting);
+
+		if (m_treesInitialised)
+		{
+			if (m_lumiFlow.GetEventCount() > 0)
+			{
+				FillLumiTree();
+			}
+
+			RootFileHelper::SafeCd(setting.GetRootOutFile(),
+					setting.GetRootFileFolder());
+
+			m_cutFlowEventsTree->Write(m_cutFlowEventsTree->GetName());
+			m_cutFlowLumisTree->Write(m_cutFlowLumisTree->GetName());
+		}
+	}
+
+protected:
+	uint64_extractor_lambda m_runExtractor;
+	uint64_extractor_lambda m_lumiExtractor;
+	uint64_extractor_lambda m_eventExtractor;
+	weight_extractor_lambda m_weightExtractor;
+
+private:
+	bool m_treesInitialised;
+	TTree* m_cutFlowEventsTree = nullptr;
+	TTree* m_cutFlowLumisTree = nullptr;
+
+	// branches of the event tree
+	uint64_t m_run = 0;
+	uint64_t m_lumi = 0;
+	uint64_t m_event = 0;
+	uint64_t m_passedFilters = 0;
+	double m_weight = 1.0;
+
+	// branches of the lumi tree
+	CutFlow m_lumiFlow;
+	uint64_t m_lumiRun = 0;
+	uint64_t m_lumiLumi = 0;
+	Long64_t m_lumiEvents = 0;
+	double m_lumiWeightedEvents = 0.0;
+	std::vector<Long64_t> m_lumiPassed;
+	std::vector<double> m_lumiWeightedPassed;
+
+	void FillLumiTree()
+	{
+		CutFlow::CutCount const& cutCount = m_lumiFlow.GetCutCount();
+		CutFlow::WeightedCutCount const& weightedCutCount = m_lumiFlow.GetWeightedCutCount();
+		for (size_t filterIndex = 0; (filterIndex < cutCount.size()) && (filterIndex < m_lumiPassed.size()); ++filterIndex)
+		{
+			m_lumiPassed[filterIndex] = cutCount[filterIndex].second;
+			m_lumiWeightedPassed[filterIndex] = weightedCutCount[filterIndex];
+		}
+		m_lumiEvents = m_lumiFlow.GetEventCount();
+		m_lumiWeightedEvents = m_lumiFlow.GetWeightedEventCount();
+
+		m_cutFlowLumisTree->Fill();
+		m_lumiFlow.Reset();
+	}
+
+	// initialise trees; to be called in first event
+	bool InitialiseTrees(setting_type const& setting, FilterResult & filterResult) {
+
+		std::vector<std::string> filterNames = filterResult.GetFilterNames();
+		if (filterNames.size() > CutFlow::MaxFiltersInMask)
+		{
+			LOG(FATAL) << "CutFlowBitmaskConsumer supports at most " << CutFlow::MaxFiltersInMask
+			           << " filters, but pipeline \"" << setting.GetName() << "\" has " << filterNames.size() << "!";
+		}
+
+		std::string title("Cut flow for pipeline \"" + setting.GetName() + "\", bits of passedFilters:");
+		for (size_t filterIndex = 0; filterIndex < filterNames.size(); ++filterIndex)
+		{
+			title += " " + std::to_string(filterIndex) + "=" + filterNames[filterIndex];
+			if (filterResult.IsTaggingFilter(filterNames[filterIndex]) == FilterResult::TaggingMode::Tagging) {
+				title += "(T)";
+			}
+		}
+
+		TDirectory* tmpDirectory = gDirectory;
+		RootFileHelper::SafeCd(setting.GetRootOutFile(),
+		                       setting.GetRootFileFolder());
+
+		m_cutFlowEventsTree = new TTree("cutFlowEvents", title.c_str());
+		m_cutFlowEventsTree->Branch("run", &m_run, "run/l");
+		m_cutFlowEventsTree->Branch("lumi", &m_lumi, "lumi/l");
+		m_cutFlowEventsTree->Branch("event", &m_event, "event/l");
+		m_cutFlowEventsTree->Branch("passedFilters", &m_passedFilters, "passedFilters/l");
+		m_cutFlowEventsTree->Branch("weight", &m_weight, "weight/D");
+
+		for (size_t filterIndex = 0; filterIndex < filterNames.size(); ++filterIndex)
+		{
+			std::string formula("((passedFilters >> " + std::to_string(filterIndex) + ") & 1)");
+			m_cutFlowEventsTree->SetAlias(filterNames[filterIndex].c_str(), formula.c_str());
+		}
+
+		// at least one entry, such that the addresses of the arrays are valid
+		const size_t nFilters = std::max(filterNames.size(), size_t(1));
+		m_lumiPassed.assign(nFilters, 0);
+		m_lumiWeightedPassed.assign(nFilters, 0.0);
+
+		m_cutFlowLumisTree = new TTree("cutFlowLumis", title.c_str());
+		m_cutFlowLumisTree->Branch("run", &m_lumiRun, "run/l");
+		m_cutFlowLumisTree->Branch("lumi", &m_lumiLumi, "lumi/l");
+		m_cutFlowLumisTree->Branch("nEvents", &m_lumiEvents, "nEvents/L");
+		m_cutFlowLumisTree->Branch("sumWeights", &m_lumiWeightedEvents, "sumWeights/D");
+		m_cutFlowLumisTree->Branch("nPassed", &(m_lumiPassed[0]),
+		                           ("nPassed[" + std::to_string(nFilters) + "]/L").c_str());
+		m_cutFlowLumisTree->Branch("sumWeightsPassed", &(m_lumiWeightedPassed[0]),
+		                           ("sumWeightsPassed[" + std::to_string(nFilters) + "]/D").c_str());
+
+		gDirectory = tmpDirectory;
+
+		return true;
+	}
+
+};
@@ -122,8 +122,8 @@ private:
 			TTree* cutFlowTree = new TTree(name.c_str(), title.c_str());
 			
 			cutFlowTree->Branch("run", &m_run, "run/l");
-			cutFlowTree->Branch("lumi", &m_run, "lumi/l");
-			cutFlowTree->Branch("event", &m_run, "event/l");
+			cutFlowTree->Branch("lumi", &m_lumi, "lumi/l");
+			cutFlowTree->Branch("event", &m_event, "event/l");
 			
 			m_cutFlowTrees.push_back(cutFlowTree);
 			
@@ -8,16 +8,20 @@
 #include "TFile.h"
 
 #include "ProfileBase.h"
+#include "ProfileBinAccumulator.h"
+
+/*
+	Profile of y versus x. The points are accumulated online in one
+	ProfileBinAccumulator per x bin when they are added, so the memory
+	consumption is constant for an arbitrary number of events. The TProfile
+	is only created from the accumulated values when storing.
+	Without a valid x range (the default, lower = upper), ROOT determines
+	the binning automatically and the points are filled into the TProfile.
+*/
 
 class Profile2d: public ProfileBase<Profile2d> {
 public:
 
-	class DataPoint {
-	public:
-		DataPoint(double x, double y, double weight);
-		double m_fx, m_fy, m_fweight;
-	};
-
 	Profile2d(std::string sName, std::string sFolder);
 
 	void Init();
@@ -28,7 +32,10 @@ public:
 	double m_dBinLowerX;
 	double m_dBinUpperX;
 
-	std::vector<DataPoint> m_points;
+	// index 0 is the underflow bin, index m_iBinCountX + 1 the overflow bin
+	std::vector<ProfileBinAccumulator> m_bins;
+	long m_lEntries;
+	bool m_automaticBinning;
 
 	boost::scoped_ptr<TProfile> m_profile;
 };
@@ -0,0 +1,42 @@
+
+#pragma once
+
+#include <boost/scoped_ptr.hpp>
+
+#include "TROOT.h"
+#include "TProfile2D.h"
+#include "TFile.h"
+
+#include "ProfileBase.h"
+#include "ProfileBinAccumulator.h"
+
+/*
+	Profile of z versus the 2D-binned (x, y) plane. Accumulates online in
+	the same way as Profile2d and is stored as a TProfile2D.
+*/
+
+class Profile3d: public ProfileBase<Profile3d> {
+public:
+
+	Profile3d(std::string sName, std::string sFolder);
+
+	void Init();
+	void Store(TFile * pRootFile);
+	void AddPoint(double x, double y, double z, double weight);
+
+	unsigned int m_iBinCountX;
+	double m_dBinLowerX;
+	double m_dBinUpperX;
+
+	unsigned int m_iBinCountY;
+	double m_dBinLowerY;
+	double m_dBinUpperY;
+
+	// indexed by the global ROOT bin number including under- and overflow
+	std::vector<ProfileBinAccumulator> m_bins;
+	long m_lEntries;
+	bool m_automaticBinning;
+
+	boost::scoped_ptr<TProfile2D> m_profile;
+};
+
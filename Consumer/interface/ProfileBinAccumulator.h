@@ -0,0 +1,63 @@
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <TArrayD.h>
+
+/*
+	Online accumulator for the weighted mean and spread of the profiled
+	quantity in one bin of a profile.
+
+	Points are folded in with the weighted Welford (West) update, so the
+	memory needed per bin is constant and does not grow with the number of
+	processed events. Compared to summing w*y and w*y^2 directly, the update
+	is also numerically stable for very large numbers of entries.
+*/
+class ProfileBinAccumulator {
+public:
+
+	ProfileBinAccumulator();
+
+	void AddPoint(double y, double weight);
+
+	// sum of w*y, as stored by ROOT in the bin content of a profile
+	double GetSumWeightedValues() const;
+
+	// sum of w*y^2, as stored by ROOT in the Sumw2 array of a profile
+	double GetSumWeightedSquaredValues() const;
+
+	double m_dSumWeights;
+	double m_dSumSquaredWeights;
+	double m_dMean;
+	double m_dSumSquaredDeviations;
+};
+
+/*
+	Copy a vector of bin accumulators (indexed by the global ROOT bin number
+	including under- and overflow) into a TProfile or TProfile2D. The
+	resulting profile is equivalent to one filled point by point.
+*/
+template<class TProfileType>
+void CopyBinAccumulatorsToProfile(std::vector<ProfileBinAccumulator> const& bins,
+                                  TProfileType* profile, double entries)
+{
+	profile->Sumw2();
+
+	double* binContents = profile->GetArray();
+	double* binSumw2 = profile->GetSumw2()->GetArray();
+	double* binEntriesSumw2 = profile->GetBinSumw2()->GetArray();
+
+	for (size_t bin = 0; bin < bins.size(); ++bin)
+	{
+		binContents[bin] = bins[bin].GetSumWeightedValues();
+		binSumw2[bin] = bins[bin].GetSumWeightedSquaredValues();
+		binEntriesSumw2[bin] = bins[bin].m_dSumSquaredWeights;
+		profile->SetBinEntries(static_cast<int>(bin), bins[bin].m_dSumWeights);
+	}
+
+	// recompute the global statistics from the bin contents
+	profile->ResetStats();
+	profile->SetEntries(entries);
+}
@@ -5,6 +5,7 @@
 
 #include "DrawConsumerBase.h"
 #include "Profile2D.h"
+#include "Profile3D.h"
 
 template<class TTypes>
 class ProfileConsumerBase: public ConsumerBase<TTypes> {
@@ -18,12 +19,23 @@ public:
 			std::vector<float>(event_type const&, product_type const& )>
 					            ValueExtractLambda;
 	typedef std::pair<ValueExtractLambda, ValueModifiers> ValueDesc;
+	typedef std::function<
+			double(event_type const&, product_type const& )>
+					            WeightExtractLambda;
 
 	typedef Pipeline<TTypes> PipelineTypeForThis;
 
 	ProfileConsumerBase(std::string plotName, ValueDesc xsource,
 			ValueDesc ysource) :
-			m_plotName(plotName), m_xsource(xsource), m_ysource(ysource) {
+			m_plotName(plotName), m_xsource(xsource), m_ysource(ysource),
+			m_weightSource([](event_type const&, product_type const&) { return 1.0; }) {
+	}
+
+	// weighted profile, the weight is evaluated once per event
+	ProfileConsumerBase(std::string plotName, ValueDesc xsource,
+			ValueDesc ysource, WeightExtractLambda weightSource) :
+			m_plotName(plotName), m_xsource(xsource), m_ysource(ysource),
+			m_weightSource(weightSource) {
 	}
 
 	std::string GetConsumerId() const override {
@@ -70,12 +82,14 @@ public:
 		if ((resX.size() == 0) || (resY.size() == 0))
 			return;
 
+		const double weight = m_weightSource(event, product);
+
 		size_t ix = 0;
 		size_t iy = 0;
 		bool terminate = false;
 		while (!terminate) {
 
-			m_profile->AddPoint(resX[ix], resY[iy], 1.0f);
+			m_profile->AddPoint(resX[ix], resY[iy], weight);
 
 			bool oneIncreased = false;
 			if (ix < (resX.size() - 1)) {
@@ -103,6 +117,116 @@ private:
 	std::string m_plotName;
 	ValueDesc m_xsource;
 	ValueDesc m_ysource;
+	WeightExtractLambda m_weightSource;
 	boost::scoped_ptr<Profile2d> m_profile;
 };
 
+/*
+	Profile of z in bins of (x, y). The value vectors of the three sources
+	are combined index by index in the same way as in ProfileConsumerBase.
+*/
+template<class TTypes>
+class Profile3dConsumerBase: public ConsumerBase<TTypes> {
+public:
+
+	typedef typename TTypes::event_type event_type;
+	typedef typename TTypes::product_type product_type;
+	typedef typename TTypes::setting_type setting_type;
+
+	typedef typename ProfileConsumerBase<TTypes>::ValueDesc ValueDesc;
+	typedef typename ProfileConsumerBase<TTypes>::WeightExtractLambda WeightExtractLambda;
+
+	Profile3dConsumerBase(std::string plotName, ValueDesc xsource,
+			ValueDesc ysource, ValueDesc zsource) :
+			m_plotName(plotName), m_xsource(xsource), m_ysource(ysource), m_zsource(zsource),
+			m_weightSource([](event_type const&, product_type const&) { return 1.0; }) {
+	}
+
+	Profile3dConsumerBase(std::string plotName, ValueDesc xsource,
+			ValueDesc ysource, ValueDesc zsource, WeightExtractLambda weightSource) :
+			m_plotName(plotName), m_xsource(xsource), m_ysource(ysource), m_zsource(zsource),
+			m_weightSource(weightSource) {
+	}
+
+	std::string GetConsumerId() const override {
+		return "profile3d";
+	}
+
+	void Init( typename TTypes::setting_type const& settings) override
+	{
+		ConsumerBase<TTypes>::Init(settings);
+
+		m_profile.reset(
+				new Profile3d(m_plotName,
+						settings.GetRootFileFolder()));
+
+		for (auto const& m : m_xsource.second) {
+			m->applyProfile3dBeforeCreation(m_profile.get(), 0);
+		}
+		for (auto const& m : m_ysource.second) {
+			m->applyProfile3dBeforeCreation(m_profile.get(), 1);
+		}
+		for (auto const& m : m_zsource.second) {
+			m->applyProfile3dBeforeCreation(m_profile.get(), 2);
+		}
+
+		m_profile->Init();
+	}
+
+	void ProcessFilteredEvent(typename TTypes::event_type const& event,
+			typename TTypes::product_type const& product,
+			typename TTypes::setting_type const& setting) override
+	{
+		ConsumerBase<TTypes>::ProcessFilteredEvent(event, product, setting);
+
+		auto resX = m_xsource.first(event, product);
+		auto resY = m_ysource.first(event, product);
+		auto resZ = m_zsource.first(event, product);
+
+		if ((resX.size() == 0) || (resY.size() == 0) || (resZ.size() == 0))
+			return;
+
+		const double weight = m_weightSource(event, product);
+
+		size_t ix = 0;
+		size_t iy = 0;
+		size_t iz = 0;
+		while (true) {
+
+			m_profile->AddPoint(resX[ix], resY[iy], resZ[iz], weight);
+
+			bool oneIncreased = false;
+			if (ix < (resX.size() - 1)) {
+				++ix;
+				oneIncreased = true;
+			}
+			if (iy < (resY.size() - 1)) {
+				++iy;
+				oneIncreased = true;
+			}
+			if (iz < (resZ.size() - 1)) {
+				++iz;
+				oneIncreased = true;
+			}
+			if (!oneIncreased)
+				break;
+		}
+	}
+
+	void Finish(setting_type const& setting) override {
+		m_profile->Store(setting.GetRootOutFile());
+	}
+
+	void SetPlotName(std::string plotName) {
+		m_plotName = plotName;
+	}
+
+private:
+	std::string m_plotName;
+	ValueDesc m_xsource;
+	ValueDesc m_ysource;
+	ValueDesc m_zsource;
+	WeightExtractLambda m_weightSource;
+	boost::scoped_ptr<Profile3d> m_profile;
+};
+
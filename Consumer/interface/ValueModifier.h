@@ -8,12 +8,14 @@
 class Hist1D;
 class Hist2D;
 class Profile2d;
+class Profile3d;
 
 class ValueModifier {
 public:
 	virtual ~ValueModifier();
 	virtual void applyHistBeforeCreation(Hist1D * h1, size_t index);
 	virtual void applyProfileBeforeCreation(Profile2d * h1, size_t index);
+	virtual void applyProfile3dBeforeCreation(Profile3d * h1, size_t index);
 	virtual void applyHist2DBeforeCreation(Hist2D * h1, size_t index);
 	// virtual void applyProfile(Profile2 * h1, size_t index);
 };
@@ -24,6 +26,7 @@ public:
 	virtual ~ValueModifierRange();
 	void applyHistBeforeCreation(Hist1D * h1, size_t index)	override;
 	void applyProfileBeforeCreation(Profile2d * h1, size_t index) override;
+	void applyProfile3dBeforeCreation(Profile3d * h1, size_t index) override;
 	void applyHist2DBeforeCreation(Hist2D * h1, size_t index) override;
 
 private:
@@ -37,6 +40,7 @@ public:
 	virtual ~ValueModifierBinCount();
 	void applyHistBeforeCreation(Hist1D * h1, size_t index) override;
 	void applyProfileBeforeCreation(Profile2d * h1, size_t index) override;
+	void applyProfile3dBeforeCreation(Profile3d * h1, size_t index) override;
 	void applyHist2DBeforeCreation(Hist2D * h1, size_t index) override;
 
 private:
@@ -4,15 +4,13 @@
 #include "Artus/Utility/interface/RootFileHelper.h"
 
 
-Profile2d::DataPoint::DataPoint(double x, double y, double weight) :
-		m_fx(x), m_fy(y), m_fweight(weight) {
-}
-
 Profile2d::Profile2d(std::string sName, std::string sFolder) :
 	ProfileBase<Profile2d>(sName, sFolder),
 	m_iBinCountX(100),
 	m_dBinLowerX(100),
-	m_dBinUpperX(100)
+	m_dBinUpperX(100),
+	m_lEntries(0),
+	m_automaticBinning(true)
 {
 }
 
@@ -22,14 +20,31 @@ void Profile2d::Init() {
 			RootFileHelper::GetStandaloneTProfile(GetName().c_str(),
 					GetName().c_str(), m_iBinCountX, m_dBinLowerX,
 					m_dBinUpperX));
+	// ROOT determines the range itself for a degenerate axis (lower >= upper),
+	// in this case the points are filled directly into the TProfile
+	m_automaticBinning = !(m_dBinLowerX < m_dBinUpperX);
+	m_bins.assign(m_automaticBinning ? 0 : m_iBinCountX + 2, ProfileBinAccumulator());
+	m_lEntries = 0;
 }
 
 void Profile2d::Store(TFile * pRootFile) {
+	if (! m_automaticBinning)
+	{
+		CopyBinAccumulatorsToProfile(m_bins, m_profile.get(), static_cast<double>(m_lEntries));
+	}
+
 	RootFileHelper::SafeCd(pRootFile, GetRootFileFolder());
 	m_profile->Write(GetName().c_str());
 }
 
 void Profile2d::AddPoint(double x, double y, double weight) {
-	m_profile->Fill(x, y, weight);
+	if (m_automaticBinning)
+	{
+		m_profile->Fill(x, y, weight);
+		return;
+	}
+	const int bin = m_profile->GetXaxis()->FindFixBin(x);
+	m_bins[static_cast<size_t>(bin)].AddPoint(y, weight);
+	++m_lEntries;
 }
 
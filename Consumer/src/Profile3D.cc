@@ -0,0 +1,52 @@
+
+#include "Artus/Consumer/interface/Profile3D.h"
+
+#include "Artus/Utility/interface/RootFileHelper.h"
+
+
+Profile3d::Profile3d(std::string sName, std::string sFolder) :
+	ProfileBase<Profile3d>(sName, sFolder),
+	m_iBinCountX(100),
+	m_dBinLowerX(0.0),
+	m_dBinUpperX(100.0),
+	m_iBinCountY(100),
+	m_dBinLowerY(0.0),
+	m_dBinUpperY(100.0),
+	m_lEntries(0),
+	m_automaticBinning(false)
+{
+}
+
+void Profile3d::Init() {
+	RootFileHelper::SafeCd(gROOT, GetRootFileFolder());
+	m_profile.reset(
+			RootFileHelper::GetStandaloneTProfile2D(GetName().c_str(),
+					GetName().c_str(), m_iBinCountX, m_dBinLowerX,
+					m_dBinUpperX, m_iBinCountY, m_dBinLowerY, m_dBinUpperY));
+	// as in Profile2d, ROOT bins a degenerate axis automatically
+	m_automaticBinning = (!(m_dBinLowerX < m_dBinUpperX)) || (!(m_dBinLowerY < m_dBinUpperY));
+	m_bins.assign(m_automaticBinning ? 0 : (m_iBinCountX + 2) * (m_iBinCountY + 2), ProfileBinAccumulator());
+	m_lEntries = 0;
+}
+
+void Profile3d::Store(TFile * pRootFile) {
+	if (! m_automaticBinning)
+	{
+		CopyBinAccumulatorsToProfile(m_bins, m_profile.get(), static_cast<double>(m_lEntries));
+	}
+
+	RootFileHelper::SafeCd(pRootFile, GetRootFileFolder());
+	m_profile->Write(GetName().c_str());
+}
+
+void Profile3d::AddPoint(double x, double y, double z, double weight) {
+	if (m_automaticBinning)
+	{
+		m_profile->Fill(x, y, z, weight);
+		return;
+	}
+	const int bin = m_profile->FindFixBin(x, y);
+	m_bins[static_cast<size_t>(bin)].AddPoint(z, weight);
+	++m_lEntries;
+}
+
@@ -0,0 +1,34 @@
+
+#include "Artus/Consumer/interface/ProfileBinAccumulator.h"
+
+
+ProfileBinAccumulator::ProfileBinAccumulator() :
+		m_dSumWeights(0.0), m_dSumSquaredWeights(0.0),
+		m_dMean(0.0), m_dSumSquaredDeviations(0.0) {
+}
+
+void ProfileBinAccumulator::AddPoint(double y, double weight) {
+	const double sumWeights = m_dSumWeights + weight;
+	m_dSumSquaredWeights += weight * weight;
+
+	// positive and negative weights cancelled exactly, the mean is undefined
+	if (sumWeights == 0.0) {
+		m_dSumWeights = 0.0;
+		m_dMean = 0.0;
+		m_dSumSquaredDeviations = 0.0;
+		return;
+	}
+
+	const double delta = y - m_dMean;
+	m_dMean += delta * weight / sumWeights;
+	m_dSumSquaredDeviations += weight * delta * (y - m_dMean);
+	m_dSumWeights = sumWeights;
+}
+
+double ProfileBinAccumulator::GetSumWeightedValues() const {
+	return m_dSumWeights * m_dMean;
+}
+
+double ProfileBinAccumulator::GetSumWeightedSquaredValues() const {
+	return m_dSumSquaredDeviations + m_dSumWeights * m_dMean * m_dMean;
+}
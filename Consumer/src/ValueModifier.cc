@@ -2,6 +2,8 @@
 #include "Artus/Consumer/interface/ValueModifier.h"
 
 #include "Artus/Consumer/interface/Hist1D.h"
+#include "Artus/Consumer/interface/Profile2D.h"
+#include "Artus/Consumer/interface/Profile3D.h"
 
 ValueModifier::~ValueModifier() {
 }
@@ -14,6 +16,10 @@ void ValueModifier::applyProfileBeforeCreation(Profile2d * h1, size_t index) {
 	assert(false);
 }
 
+void ValueModifier::applyProfile3dBeforeCreation(Profile3d * h1, size_t index) {
+	assert(false);
+}
+
 void ValueModifier::applyHist2DBeforeCreation(Hist2D * h1, size_t index) {
 	assert(false);
 }
@@ -61,29 +67,52 @@ void ValueModifierRange::applyHist2DBeforeCreation(Hist2D * h1, size_t index) {
 }
 
 void ValueModifierRange::applyProfileBeforeCreation(Profile2d * h1,
-		size_t index) {/*
-		 assert((index == 0) || (index == 1));
-		 if (index == 0) {
-		 h1->m_dBinLowerX = this->m_binLower;
-		 h1->m_dBinUpperX = this->m_binUpper;
-		 }
-		 if (index == 1) {
-		 //ignore Y bin settings, because there is no binning in y direction
-		 //for 2d profiles
-		 }*/
+		size_t index) {
+	assert((index == 0) || (index == 1));
+	if (index == 0) {
+		h1->m_dBinLowerX = this->m_binLower;
+		h1->m_dBinUpperX = this->m_binUpper;
+	}
+	// ignore y range settings, because there is no binning in y direction
+	// for 2d profiles
+}
+
+void ValueModifierRange::applyProfile3dBeforeCreation(Profile3d * h1,
+		size_t index) {
+	assert((index == 0) || (index == 1) || (index == 2));
+	if (index == 0) {
+		h1->m_dBinLowerX = this->m_binLower;
+		h1->m_dBinUpperX = this->m_binUpper;
+	}
+	if (index == 1) {
+		h1->m_dBinLowerY = this->m_binLower;
+		h1->m_dBinUpperY = this->m_binUpper;
+	}
+	// ignore z range settings, because there is no binning in z direction
+	// for 3d profiles
 }
 
 void ValueModifierBinCount::applyProfileBeforeCreation(Profile2d * h1,
 		size_t index) {
-	/*
-	 assert((index == 0) || (index == 1));
-	 if (index == 0) {
-	 h1->m_iBinCountX = this->m_binCount;
-	 }
-	 if (index == 1) {
-	 //ignore Y bin settings, because there is no binning in y direction
-	 //for 2d profiles
-	 }*/
+	assert((index == 0) || (index == 1));
+	if (index == 0) {
+		h1->m_iBinCountX = static_cast<unsigned int>(this->m_binCount);
+	}
+	// ignore y bin settings, because there is no binning in y direction
+	// for 2d profiles
+}
+
+void ValueModifierBinCount::applyProfile3dBeforeCreation(Profile3d * h1,
+		size_t index) {
+	assert((index == 0) || (index == 1) || (index == 2));
+	if (index == 0) {
+		h1->m_iBinCountX = static_cast<unsigned int>(this->m_binCount);
+	}
+	if (index == 1) {
+		h1->m_iBinCountY = static_cast<unsigned int>(this->m_binCount);
+	}
+	// ignore z bin settings, because there is no binning in z direction
+	// for 3d profiles
 }
 
 void ValueModifierBinCount::applyHist2DBeforeCreation(Hist2D * h1,
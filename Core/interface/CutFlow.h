@@ -1,33 +1,60 @@
 
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
 #include "FilterResult.h"
 
+/**
+   \brief Counts passed events per filter, unweighted and weighted.
+
+   The counters are stored by index in the order the filters appear in the
+   filter results. Since this order is fixed within a pipeline, the counter of
+   a filter is found by its position. The names are only resolved to the
+   counters in the first event (or when the number of filters changes).
+*/
 class CutFlow: public boost::noncopyable
 {
 public:
 
 	typedef std::pair<std::string, long> CutStat;
-	typedef std::list<CutStat> CutCount;
+	typedef std::vector<CutStat> CutCount;
+	typedef std::vector<double> WeightedCutCount;
 
 	CutFlow();
 
 	// sum up all passed events per filter
-	void AddFilterResult(FilterResult const& fres);
+	void AddFilterResult(FilterResult const& fres, double weight = 1.0);
+
+	// set all counters to zero, but keep the list of known filters
+	void Reset();
 
 	CutStat * GetCutEntry(std::string const& filterName);
 
 	CutCount const& GetCutCount() const;
+	WeightedCutCount const& GetWeightedCutCount() const;
 
 	long GetEventCount() const;
+	double GetWeightedEventCount() const;
 
 	std::string ToString() const;
 
+	// bit i is set, if the i-th filter in the filter result has passed
+	// (regardless of whether it is a tagging filter). At most 64 filters are supported.
+	static uint64_t GetPassedFilterMask(FilterResult const& fres);
+
+	static const size_t MaxFiltersInMask = 64;
+
 private:
+	size_t GetCutIndex(std::string const& filterName);
+
 	CutCount m_cutCount;
+	WeightedCutCount m_weightedCutCount;
+	// counter index per position in the filter result
+	std::vector<size_t> m_cutIndices;
 	long m_overallEventCount;
+	double m_overallWeightedEventCount;
 };
@@ -6,13 +6,19 @@
 #include "ProducerBase.h"
 #include "ConsumerBase.h"
 #include "FilterBase.h"
+#include "NodeRegistry.h"
 
+/**
+   Base class of the factories creating the processors and consumers by their ID.
+   By default, the nodes registered in the NodeRegistry are created. Derived factories
+   can override these methods for nodes that cannot be registered.
+*/
 class FactoryBase: public boost::noncopyable {
 public:
 
 	virtual ~FactoryBase();
 
-	// these virtual methods offer no default objects, so far
+	// return nullptr for unknown IDs
 	virtual ProducerBaseUntemplated * createProducer ( std::string const& id );
 	virtual FilterBaseUntemplated * createFilter ( std::string const& id );
 	virtual ConsumerBaseUntemplated * createConsumer ( std::string const& id );
@@ -15,6 +15,13 @@
 
 class FilterBaseAccess;
 
+/// quantities the decision of a filter depends on
+enum class FilterGranularity {
+	Event,
+	Lumisection, // run and lumi section numbers (and per lumi section metadata) only
+	Run // run number (and per run metadata) only
+};
+
 class FilterBaseUntemplated : public ProcessNodeBase {
 public:
 
@@ -29,6 +36,13 @@ public:
 	 */
 	virtual std::string GetFilterId() const = 0;
 
+	/*
+	 * Filters returning Lumisection or Run are evaluated only for the first event
+	 * of a lumi section or run, their decision is reused for the following events.
+	 * The granularity must not change after Init.
+	 */
+	virtual FilterGranularity GetFilterGranularity() const { return FilterGranularity::Event; }
+
 protected:
 
 	virtual bool baseDoesEventPass(EventBase const& event,
@@ -37,12 +51,20 @@ protected:
 	virtual void baseOnLumi(EventBase const& event, SettingsBase const& settings) = 0;
 	virtual void baseInit ( SettingsBase const& settings ) = 0;
 
+private:
+
+	// decision cached by FilterBaseAccess for lumi section or run granular filters
+	uint64_t m_cachedDecisionIndex = 0;
+	bool m_cachedDecision = false;
+
 };
 
 class FilterBaseAccess  {
 public:
 	explicit FilterBaseAccess(FilterBaseUntemplated& cb);
 
+	/// evaluates the filter or reuses the decision for the current lumi section or run
+	/// according to the granularity of the filter
 	bool DoesEventPass(EventBase const& event,
 			ProductBase const& product, SettingsBase const& settings) const;
 	void Init(SettingsBase const& settings);
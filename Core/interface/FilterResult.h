@@ -37,6 +37,17 @@ public:
 	// name is not in the list before
 	void AddFilterNames( FilterNames const& fn);
 	void AddFilterNames( FilterNames const& fn, FilterNames const& taggingFilters);
+
+	// reset all decisions to undefined for the next event,
+	// the list of filter names is kept (no allocations)
+	void Reset();
+	// take over the decisions of another filter result (e.g. the global one) for the next event,
+	// entries not contained in the initial result are reset to undefined.
+	// the tagging filters of the initial result are added to the tagging filters of this result
+	// (only the first time this initial result is used)
+	// the entries are updated in place, such that a filter result reused for all events
+	// does not allocate memory as long as the initial result has the same filter names
+	void Reset( FilterResult const& initialResult );
 	
 	// list of all filter names as a vector of strings
 	FilterNames GetFilterNames() const;
@@ -56,6 +67,9 @@ private:
 	FilterNames m_taggingFilters;
 	FilterDecisions m_filterDecisions;
 
+	// initial result whose tagging filters have already been added in Reset
+	FilterResult const* m_taggingFiltersMergedFrom;
+
 	mutable bool m_cacheHasPassed;
 	mutable bool m_IsCachedHasPassed;
 };
@@ -0,0 +1,144 @@
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+#include "ProducerBase.h"
+#include "FilterBase.h"
+#include "ConsumerBase.h"
+
+
+/**
+   \brief Registry of the producers, filters or consumers that can be created by their ID.
+
+   Nodes are registered at library load time with the REGISTER_ARTUS_PRODUCER,
+   REGISTER_ARTUS_FILTER and REGISTER_ARTUS_CONSUMER macros, which are placed in the
+   source file of the factory providing these nodes (e.g. KappaFactory.cc or the factory
+   of an analysis deriving from it). The FactoryBase create methods look up this registry.
+
+   The IDs are only available from instances, therefore every registered node is
+   constructed exactly once when a node is requested for the first time after its
+   registration. Afterwards, creating a node is a single hash lookup.
+   Registering two nodes with the same ID is a fatal error.
+*/
+template<class TNodeBase>
+class NodeRegistry {
+public:
+
+	typedef std::function<TNodeBase*()> creator_type;
+
+	template<class TNode>
+	static bool Register(std::string const& typeName)
+	{
+		GetRegistrations().push_back(std::make_pair(typeName, creator_type([]() -> TNodeBase* {
+			return new TNode();
+		})));
+		return true;
+	}
+
+	// returns nullptr if no node with this ID is registered
+	static TNodeBase* Create(std::string const& id)
+	{
+		ResolveIds();
+		typename creator_map::const_iterator creator = GetCreators().find(id);
+		if (creator == GetCreators().end())
+		{
+			return nullptr;
+		}
+		return creator->second.second();
+	}
+
+	static std::vector<std::string> GetIds()
+	{
+		ResolveIds();
+		std::vector<std::string> ids;
+		for (typename creator_map::const_iterator creator = GetCreators().begin(); creator != GetCreators().end(); ++creator)
+		{
+			ids.push_back(creator->first);
+		}
+		return ids;
+	}
+
+private:
+
+	typedef std::pair<std::string, creator_type> registration;
+	typedef std::unordered_map<std::string, registration> creator_map;
+
+	// function-local statics, such that registration works independent of the static initialisation order
+	static std::vector<registration>& GetRegistrations()
+	{
+		static std::vector<registration> registrations;
+		return registrations;
+	}
+
+	static creator_map& GetCreators()
+	{
+		static creator_map creators;
+		return creators;
+	}
+
+	static size_t& GetNResolvedRegistrations()
+	{
+		static size_t nResolvedRegistrations = 0;
+		return nResolvedRegistrations;
+	}
+
+	// registrations can also be added later by libraries loaded at runtime
+	static void ResolveIds()
+	{
+		std::vector<registration> const& registrations = GetRegistrations();
+		for (size_t index = GetNResolvedRegistrations(); index < registrations.size(); ++index)
+		{
+			std::unique_ptr<TNodeBase> node(registrations[index].second());
+			std::string id = GetNodeId(*node);
+
+			std::pair<typename creator_map::iterator, bool> inserted = GetCreators().insert(std::make_pair(id, registrations[index]));
+			if (! inserted.second)
+			{
+				LOG(FATAL) << "The ID \"" << id << "\" is registered for both " << inserted.first->second.first
+				           << " and " << registrations[index].first << "!";
+			}
+		}
+		GetNResolvedRegistrations() = registrations.size();
+	}
+
+	static std::string GetNodeId(ProducerBaseUntemplated const& node)
+	{
+		return node.GetProducerId();
+	}
+
+	static std::string GetNodeId(FilterBaseUntemplated const& node)
+	{
+		return node.GetFilterId();
+	}
+
+	static std::string GetNodeId(ConsumerBaseUntemplated const& node)
+	{
+		return node.GetConsumerId();
+	}
+};
+
+#define ARTUS_REGISTRY_CONCAT_IMPL(A, B) A##B
+#define ARTUS_REGISTRY_CONCAT(A, B) ARTUS_REGISTRY_CONCAT_IMPL(A, B)
+
+/// register a producer type with a default constructor, e.g. REGISTER_ARTUS_PRODUCER(ValidJetsProducer)
+#define REGISTER_ARTUS_PRODUCER(...) \
+static const bool ARTUS_REGISTRY_CONCAT(artusProducerRegistration, __LINE__) = \
+		NodeRegistry<ProducerBaseUntemplated>::Register<__VA_ARGS__>(#__VA_ARGS__);
+
+/// register a filter type with a default constructor
+#define REGISTER_ARTUS_FILTER(...) \
+static const bool ARTUS_REGISTRY_CONCAT(artusFilterRegistration, __LINE__) = \
+		NodeRegistry<FilterBaseUntemplated>::Register<__VA_ARGS__>(#__VA_ARGS__);
+
+/// register a consumer type with a default constructor
+#define REGISTER_ARTUS_CONSUMER(...) \
+static const bool ARTUS_REGISTRY_CONCAT(artusConsumerRegistration, __LINE__) = \
+		NodeRegistry<ConsumerBaseUntemplated>::Register<__VA_ARGS__>(#__VA_ARGS__);
@@ -101,17 +101,19 @@ public:
 		LOG(DEBUG) << "";
 		LOG(DEBUG) << "Initialize pipeline \"" << pset.GetName() << "\".";
 
+		// initialise everything with the settings object stored in the pipeline,
+		// such that all settings read during the initialisation stay cached
 		m_pipelineSettings = pset;
-		initializer.InitPipeline(this, pset);
+		initializer.InitPipeline(this, m_pipelineSettings);
 
 		for(ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
 			if ( it->GetProcessNodeType () == ProcessNodeType::Producer ){
 				ProducerBaseAccess(	static_cast< ProducerForThisPipeline &> ( *it )	)
-						. Init ( pset );
+						. Init ( m_pipelineSettings );
 			}
 			else if ( it->GetProcessNodeType () == ProcessNodeType::Filter ) {
 				FilterBaseAccess( static_cast< FilterForThisPipeline &> ( *it ) )
-						. Init ( pset );
+						. Init ( m_pipelineSettings );
 			}
 			else {
 				LOG(FATAL) << "ProcessNodeType not supported by the pipeline!";
@@ -120,12 +122,17 @@ public:
 
 		// init Consumers
 		for (auto & it : m_consumer) {
-			ConsumerBaseAccess(it).Init( pset );
+			ConsumerBaseAccess(it).Init( m_pipelineSettings );
 		}
 
 		// store the filter names for later use in RunEvent
-		m_filterNames = pset.GetFilters();
-		m_taggingFilters = pset.GetTaggingFilters();
+		m_filterNames = m_pipelineSettings.GetFilters();
+		m_taggingFilters = m_pipelineSettings.GetTaggingFilters();
+		m_localFilterResult = FilterResult();
+		m_localFilterResult.AddFilterNames( m_filterNames, m_taggingFilters );
+
+		// settings read from now on are reported
+		m_pipelineSettings.Freeze();
 	}
 
 	/// Useful debug output of the Pipeline Content.
@@ -167,9 +174,11 @@ public:
 
 		// make a local copy of the global product/filter result
 		// and allow this one to be modified by local producers/filters.
-		product_type localProduct ( globalProduct );
-		FilterResult localFilterResult ( globalFilterResult );
-		localFilterResult.AddFilterNames( m_filterNames, m_taggingFilters );
+		// the local objects are reused for all events, such that their memory is kept (see ProductBase)
+		m_localProduct = globalProduct;
+		m_localFilterResult.Reset( globalFilterResult );
+		product_type & localProduct = m_localProduct;
+		FilterResult & localFilterResult = m_localFilterResult;
 
 		// run Filters & Producers
 		for (ProcessNodeIterator it = m_nodes.begin(); it != m_nodes.end(); ++it) {
@@ -288,5 +297,9 @@ private:
 	setting_type m_pipelineSettings;
 	std::vector<std::string> m_filterNames;
 	std::vector<std::string> m_taggingFilters;
+
+	// reused for all events
+	product_type m_localProduct;
+	FilterResult m_localFilterResult;
 };
 
@@ -7,6 +7,7 @@
 #include <unistd.h>
 #include <map>
 #include <sys/time.h>
+#include <string>
 
 #include <boost/noncopyable.hpp>
 #include <boost/ptr_container/ptr_list.hpp>
@@ -16,6 +17,7 @@
 #include "ProgressReport.h"
 #include "FilterResult.h"
 #include "OsSignalHandler.h"
+#include "Artus/Utility/interface/MonotonicArena.h"
 
 /**
  \brief Class to manage all registered Pipelines and to connect them to the event.
@@ -104,8 +106,8 @@ public:
 		}
 	}
 
-	/// Run the Producers and all pipelines. Give any pipeline setting here: only the
-	/// producer will read from the settings ...
+	/// Run the Producers and all pipelines. Give the global settings here (ArtusConfig::GetGlobalSettings),
+	/// i.e. the instance the global producers were initialised with
 	template<class TEventProvider>
 	void RunPipelines(TEventProvider & evtProvider,
 			setting_type const& settings)
@@ -120,6 +122,9 @@ public:
 		const std::vector<std::string> globlalFilterIds = settings.GetFilters();
 		const std::vector<std::string> taggingFilters = settings.GetTaggingFilters();
 
+		// settings read for the first time from now on are reported
+		settings.Freeze();
+
 		// initialize pline filter decision
 		FilterResult::FilterNames pipelineResultNames(m_pipelines.size());
 		std::transform(m_pipelines.begin(), m_pipelines.end(),
@@ -141,6 +146,15 @@ public:
 				LOG(FATAL)<< "Pipeline name '" << *itUnq << "' is not unique, but pipeline names must be unique";
 			}
 		}
+		// product and filter results for all events
+		product_type initialProduct;
+		product_type & productGlobal = m_globalProduct;
+		// use the lit of filters to bootstrap the filter list names
+		FilterResult & globalFilterResult = m_globalFilterResult;
+		globalFilterResult = FilterResult( globlalFilterIds, taggingFilters );
+		FilterResult & pipelineFilterRes = m_pipelineFilterResult;
+		pipelineFilterRes = FilterResult( pipelineResultNames, taggingFilters );
+
 		// apparently evtProvider.GetEntries() is not reliable. Therefore, if 'ProcessNEvents' is not set (=-1), the loop condition
 		// always evaluates to true (processNEvents<0) = (-1<0) and is terminated via the 'if (!evtProvider.GetEntry(i)) break' statement
 		for (long long iEvent = firstEvent; (iEvent < (firstEvent + nEvents)); ++iEvent)
@@ -167,9 +181,25 @@ public:
 				it->update(iEvent-firstEvent, nEvents);
 			}
 
-			product_type productGlobal;
-			// use the lit of filters to bootstrap the filter list names
-			FilterResult globalFilterResult ( globlalFilterIds, taggingFilters );
+			// objects created during the previous event are not referenced anymore
+			m_eventArena.Reset();
+
+			// the product and filter results are reused for all events (see ProductBase)
+			productGlobal = initialProduct;
+			productGlobal.eventArena = &m_eventArena;
+			productGlobal.newRun = evtProvider.NewRun();
+			productGlobal.newLumisection = evtProvider.NewLumisection();
+			if (productGlobal.newRun)
+			{
+				++m_runIndex;
+			}
+			if (productGlobal.newRun || productGlobal.newLumisection)
+			{
+				++m_lumisectionIndex;
+			}
+			productGlobal.runIndex = m_runIndex;
+			productGlobal.lumisectionIndex = m_lumisectionIndex;
+			globalFilterResult.Reset();
 
 			for (ProcessNodesIterator it = m_globalNodes.begin(); it != m_globalNodes.end(); ++it)
 			{
@@ -188,8 +218,6 @@ public:
 					//LOG(DEBUG) << prod.GetProducerId() << "::Produce";
 					gettimeofday(&tStart, nullptr);
 					auto currentEvent = evtProvider.GetCurrentEvent();
-					productGlobal.newRun = evtProvider.NewRun();
-					productGlobal.newLumisection = evtProvider.NewLumisection();
 					if(evtProvider.NewRun())
 						ProducerBaseAccess(prod).OnRun(currentEvent, settings);
 					if(evtProvider.NewLumisection())
@@ -224,7 +252,7 @@ public:
 			}
 
 			// run the pipelines
-			FilterResult pipelineFilterRes(pipelineResultNames, taggingFilters);
+			pipelineFilterRes.Reset();
 
 			for (PipelinesIterator it = m_pipelines.begin(); it != m_pipelines.end(); ++it)
 			{
@@ -247,6 +275,20 @@ public:
 			it->finish();
 		}
 
+		// only the allocations of the arena are counted here, not those of the containers in the products
+		LOG(INFO) << "Event arena: " << m_eventArena.GetNBlocks() << " block(s) with " << m_eventArena.GetCapacity() << " bytes, "
+		          << "grown in " << m_eventArena.GetNGrowingRounds() << " of " << m_eventArena.GetNRounds() << " events"
+		          << ((m_eventArena.GetNGrowingRounds() > 0) ? (", last time in event no. " + std::to_string(m_eventArena.GetLastGrowingRound())) : "") << ".";
+
+		if (SettingsBase::GetSettingsReadAfterFreezing().size() > 0)
+		{
+			LOG(INFO) << "The following settings have not been read during the initialisation and required a lookup in the event loop:";
+			for (std::string const& setting : SettingsBase::GetSettingsReadAfterFreezing())
+			{
+				LOG(INFO) << "\t" << setting;
+			}
+		}
+
 		// first safe the results ( > plots ) from all level one pipelines
 		for (PipelinesIterator it = m_pipelines.begin();
 				!(it == m_pipelines.end()); ++it)
@@ -311,5 +353,17 @@ private:
 	ProcessNodes m_globalNodes;
 	ProgressReportList m_progressReport;
 	bool m_registerSignalHandler;
+
+	// memory for objects created by the producers during one event, see ProductBase::CreateEventObject
+	MonotonicArena m_eventArena;
+
+	// reused for all events
+	product_type m_globalProduct;
+	FilterResult m_globalFilterResult;
+	FilterResult m_pipelineFilterResult;
+
+	// counters of the processed runs and lumi sections (see ProductBase::runIndex)
+	uint64_t m_runIndex = 0;
+	uint64_t m_lumisectionIndex = 0;
 };
 
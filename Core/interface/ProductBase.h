@@ -1,15 +1,50 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
+#include <utility>
+
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/MonotonicArena.h"
+
 #include "FilterResult.h"
 
+/**
+   Base class for the products.
+
+   The PipelineRunner and the pipelines reuse their product objects for all events. A product is reset
+   by copy assignment from a default constructed product (global product) or from the global product
+   (pipeline products). The vectors, strings and flat maps therefore keep their capacity from event to event.
+   This does not hold for std::map members (e.g. processorRunTime or the maps of derived products), the nodes
+   of the entries added during an event are still allocated for every event.
+   Derived products have to be copy assignable and must not hold state that is not reset by this assignment.
+*/
 struct ProductBase
 {
 	// TODO: Is PreviousPipelinesResult really necessary?
 	FilterResult PreviousPipelinesResult;
 	FilterResult fres;
 	std::map<std::string, int> processorRunTime;
-	bool newLumisection;
-	bool newRun;
+	bool newLumisection = false;
+	bool newRun = false;
+
+	/// counters of the runs and lumi sections processed so far, set by the PipelineRunner for every event
+	/// zero if the event provider does not report new runs and lumi sections
+	uint64_t runIndex = 0;
+	uint64_t lumisectionIndex = 0;
+
+	/// set by the PipelineRunner, reset after each event; copies of the product share the arena
+	MonotonicArena* eventArena = nullptr;
+
+	/// create an object that is valid until the end of the event (e.g. corrected physics objects)
+	template<class T, class... TArgs>
+	T* CreateEventObject(TArgs&&... args)
+	{
+		if (eventArena == nullptr)
+		{
+			LOG(FATAL) << "No event arena available in the product. Products need to be created by the PipelineRunner.";
+		}
+		return eventArena->Create<T>(std::forward<TArgs>(args)...);
+	}
 };
 
@@ -1,41 +1,73 @@
 #include <sstream>
 #include <map>
 #include <iomanip>
+#include <algorithm>
 
 #include "Artus/Core/interface/CutFlow.h"
 
 
 CutFlow::CutFlow() :
-		m_overallEventCount(0)
+		m_overallEventCount(0),
+		m_overallWeightedEventCount(0.0)
 {
 }
 
 // sum up all passed events per filter
-void CutFlow::AddFilterResult(FilterResult const& fres)
+void CutFlow::AddFilterResult(FilterResult const& fres, double weight)
 {
 	++m_overallEventCount;
+	m_overallWeightedEventCount += weight;
 
 	auto const& dec = fres.GetFilterDecisions();
+
+	// the filter order is the same in every event of a pipeline, the names are
+	// only resolved to counter indices when the number of filters changes
+	if (m_cutIndices.size() != dec.size())
+	{
+		m_cutIndices.clear();
+		for (FilterResult::FilterDecisions::const_iterator it = dec.begin();
+		     it != dec.end(); ++it)
+		{
+			m_cutIndices.push_back(GetCutIndex(it->filterName));
+		}
+	}
+
+	std::vector<size_t>::const_iterator index = m_cutIndices.begin();
 	for (FilterResult::FilterDecisions::const_iterator it = dec.begin();
-	     it != dec.end(); ++it)
+	     it != dec.end(); ++it, ++index)
 	{
 		// only store, if passed
-		long addVal = 0;
 		if (it->filterDecision == FilterResult::Decision::Passed &&
 		    it->taggingMode == FilterResult::TaggingMode::Filtering) {
-			addVal = 1;
+			++(m_cutCount[*index].second);
+			m_weightedCutCount[*index] += weight;
 		}
+	}
+}
 
-		CutFlow::CutStat * stat = CutFlow::GetCutEntry(it->filterName);
-		if (stat == nullptr)
-		{
-			m_cutCount.push_back(std::make_pair(it->filterName, addVal));
-		}
-		else
-		{
-			stat->second += addVal;
-		}
+void CutFlow::Reset()
+{
+	for (CutFlow::CutCount::iterator it = m_cutCount.begin();
+	     it != m_cutCount.end(); ++it)
+	{
+		it->second = 0;
 	}
+	std::fill(m_weightedCutCount.begin(), m_weightedCutCount.end(), 0.0);
+	m_overallEventCount = 0;
+	m_overallWeightedEventCount = 0.0;
+}
+
+size_t CutFlow::GetCutIndex(std::string const& filterName)
+{
+	for (size_t index = 0; index < m_cutCount.size(); ++index)
+	{
+		if (filterName == m_cutCount[index].first)
+			return index;
+	}
+
+	m_cutCount.push_back(std::make_pair(filterName, 0l));
+	m_weightedCutCount.push_back(0.0);
+	return m_cutCount.size() - 1;
 }
 
 CutFlow::CutStat * CutFlow::GetCutEntry(std::string const& filterName)
@@ -55,11 +87,38 @@ CutFlow::CutCount const& CutFlow::GetCutCount() const
 	return m_cutCount;
 }
 
+CutFlow::WeightedCutCount const& CutFlow::GetWeightedCutCount() const
+{
+	return m_weightedCutCount;
+}
+
 long CutFlow::GetEventCount() const
 {
 	return m_overallEventCount;
 }
 
+double CutFlow::GetWeightedEventCount() const
+{
+	return m_overallWeightedEventCount;
+}
+
+uint64_t CutFlow::GetPassedFilterMask(FilterResult const& fres)
+{
+	uint64_t mask = 0;
+	size_t index = 0;
+	auto const& dec = fres.GetFilterDecisions();
+	for (FilterResult::FilterDecisions::const_iterator it = dec.begin();
+	     (it != dec.end()) && (index < MaxFiltersInMask); ++it)
+	{
+		if (it->filterDecision == FilterResult::Decision::Passed)
+		{
+			mask |= (uint64_t(1) << index);
+		}
+		++index;
+	}
+	return mask;
+}
+
 std::string CutFlow::ToString() const
 {
 	std::stringstream sOut;
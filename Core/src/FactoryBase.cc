@@ -6,13 +6,13 @@ FactoryBase::~FactoryBase() {
 }
 
 ProducerBaseUntemplated * FactoryBase::createProducer ( std::string const& id ) {
-	return nullptr;
+	return NodeRegistry<ProducerBaseUntemplated>::Create(id);
 }
 
 FilterBaseUntemplated * FactoryBase::createFilter ( std::string const& id ) {
-	return nullptr;
+	return NodeRegistry<FilterBaseUntemplated>::Create(id);
 }
 
 ConsumerBaseUntemplated * FactoryBase::createConsumer ( std::string const& id ) {
-	return nullptr;
+	return NodeRegistry<ConsumerBaseUntemplated>::Create(id);
 }
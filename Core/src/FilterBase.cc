@@ -15,7 +15,33 @@ FilterBaseAccess::FilterBaseAccess(FilterBaseUntemplated& cb) :
 bool FilterBaseAccess::DoesEventPass(EventBase const& event,
 		ProductBase const& product, SettingsBase const& settings) const
 {
-	return m_cb.baseDoesEventPass(event, product, settings);
+	uint64_t index = 0;
+	switch (m_cb.GetFilterGranularity())
+	{
+		case FilterGranularity::Lumisection:
+			index = product.lumisectionIndex;
+			break;
+		case FilterGranularity::Run:
+			index = product.runIndex;
+			break;
+		case FilterGranularity::Event:
+			break;
+		default:
+			break;
+	}
+
+	if ((index > 0) && (index == m_cb.m_cachedDecisionIndex))
+	{
+		return m_cb.m_cachedDecision;
+	}
+
+	bool decision = m_cb.baseDoesEventPass(event, product, settings);
+	if (index > 0)
+	{
+		m_cb.m_cachedDecisionIndex = index;
+		m_cb.m_cachedDecision = decision;
+	}
+	return decision;
 }
 
 void FilterBaseAccess::Init(SettingsBase const& settings)
@@ -21,19 +21,19 @@ FilterResult::DecisionEntry::DecisionEntry(std::string filterName, Decision filt
 
 FilterResult::FilterResult() :
 		// has passed by default
-		m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
+		m_taggingFiltersMergedFrom(nullptr), m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
 }
 
 FilterResult::FilterResult(FilterNames const& initialFilterNames ) :
 		// has passed by default
-		m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
+		m_taggingFiltersMergedFrom(nullptr), m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
 
 	AddFilterNames ( initialFilterNames );
 }
 
 FilterResult::FilterResult(FilterNames const& initialFilterNames, FilterNames const& taggingFilters ) :
 		// has passed by default
-		m_taggingFilters(taggingFilters), m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
+		m_taggingFilters(taggingFilters), m_taggingFiltersMergedFrom(nullptr), m_cacheHasPassed(true), m_IsCachedHasPassed(false) {
 	AddFilterNames ( initialFilterNames );
 }
 
@@ -83,6 +83,60 @@ void FilterResult::AddFilterNames( FilterNames const& fn ){
 	}
 }
 
+void FilterResult::Reset() {
+	for (FilterResult::FilterDecisions::iterator it = m_filterDecisions.begin();
+			it != m_filterDecisions.end(); ++it) {
+		it->filterDecision = Decision::Undefined;
+	}
+
+	// has passed by default
+	m_cacheHasPassed = true;
+	m_IsCachedHasPassed = false;
+}
+
+void FilterResult::Reset( FilterResult const& initialResult ) {
+	// the tagging filters of the initial result do not change from event to event
+	if ( m_taggingFiltersMergedFrom != &initialResult ) {
+		for (FilterResult::FilterNames::const_iterator taggingFilter = initialResult.m_taggingFilters.begin();
+				taggingFilter != initialResult.m_taggingFilters.end(); ++taggingFilter) {
+			if (std::find(m_taggingFilters.begin(), m_taggingFilters.end(), *taggingFilter) == m_taggingFilters.end())
+				m_taggingFilters.push_back( *taggingFilter );
+		}
+		m_taggingFiltersMergedFrom = &initialResult;
+	}
+
+	// the entries of the initial result are placed at the beginning, in the same order
+	FilterResult::FilterDecisions::iterator entry = m_filterDecisions.begin();
+	for (FilterResult::FilterDecisions::const_iterator initialEntry = initialResult.m_filterDecisions.begin();
+			initialEntry != initialResult.m_filterDecisions.end(); ++initialEntry) {
+		if ( (entry == m_filterDecisions.end()) || (entry->filterName != initialEntry->filterName) ) {
+			FilterResult::FilterDecisions::iterator existingEntry = entry;
+			while ( (existingEntry != m_filterDecisions.end()) && (existingEntry->filterName != initialEntry->filterName) )
+				++existingEntry;
+
+			if ( existingEntry == m_filterDecisions.end() ) {
+				entry = m_filterDecisions.insert( entry, *initialEntry );
+			} else {
+				// move the list node instead of creating a new one
+				m_filterDecisions.splice( entry, m_filterDecisions, existingEntry );
+				entry = existingEntry;
+			}
+		}
+
+		entry->filterDecision = initialEntry->filterDecision;
+		entry->taggingMode = initialEntry->taggingMode;
+		++entry;
+	}
+
+	// remaining (e.g. pipeline specific) filters
+	for (; entry != m_filterDecisions.end(); ++entry) {
+		entry->filterDecision = Decision::Undefined;
+	}
+
+	m_cacheHasPassed = true;
+	m_IsCachedHasPassed = false;
+}
+
 // list of all filter names as a vector of strings
 FilterResult::FilterNames FilterResult::GetFilterNames() const {
 	FilterNames filterNames;
@@ -38,9 +38,9 @@ public:
 	                             std::vector<TObject*> product_type::*validObjects,
 	                             bool (setting_type::*GetBranchGenMatchedObjects)(void) const,
 	                             TObjectMetaInfo* event_type::*objectMetaInfo = nullptr,
-	                             std::map<TObject*, KGenParticle*> product_type::*genParticleMatchedObjects = nullptr,
-	                             std::map<TObject*, KGenTau*> product_type::*genTauMatchedObjects = nullptr,
-	                             std::map<TObject*, KGenJet*> product_type::*genTauJetMatchedObjects = nullptr) :
+	                             FlatMap<TObject*, KGenParticle*> product_type::*genParticleMatchedObjects = nullptr,
+	                             FlatMap<TObject*, KGenTau*> product_type::*genTauMatchedObjects = nullptr,
+	                             FlatMap<TObject*, KGenJet*> product_type::*genTauJetMatchedObjects = nullptr) :
 		ConsumerBase<KappaTypes>(),
 		m_treeName(treeName),
 		m_validObjects(validObjects),
@@ -179,11 +179,11 @@ private:
 	bool (setting_type::*GetBranchGenMatchedObjects)(void) const;
 	TObjectMetaInfo* event_type::*m_objectMetaInfo;
 	bool m_objectMetaInfoAvailable = false;
-	std::map<TObject*, KGenParticle*> product_type::*m_genParticleMatchedObjects;
+	FlatMap<TObject*, KGenParticle*> product_type::*m_genParticleMatchedObjects;
 	bool m_genParticleMatchedObjectsAvailable = false;
-	std::map<TObject*, KGenTau*> product_type::*m_genTauMatchedObjects;
+	FlatMap<TObject*, KGenTau*> product_type::*m_genTauMatchedObjects;
 	bool m_genTauMatchedObjectsAvailable = false;
-	std::map<TObject*, KGenJet*> product_type::*m_genTauJetMatchedObjects;
+	FlatMap<TObject*, KGenJet*> product_type::*m_genTauJetMatchedObjects;
 	bool m_genTauJetMatchedObjectsAvailable = false;
 	
 	TTree* m_tree = nullptr;
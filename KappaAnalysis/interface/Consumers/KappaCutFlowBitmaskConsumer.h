@@ -0,0 +1,21 @@
+
+#pragma once
+
+#include "Artus/Consumer/interface/CutFlowBitmaskConsumer.h"
+#include "Artus/Utility/interface/SafeMap.h"
+#include "Artus/KappaAnalysis/interface/KappaTypes.h"
+
+
+/**
+   \brief CutFlow consumer writing one row per event with a bitmask of passed filters
+   Config tags:
+   - EventWeight, e.g. "eventWeight"
+
+   The weight is taken from the slot of settings.GetEventWeight() in product.m_weights.
+*/
+class KappaCutFlowBitmaskConsumer: public CutFlowBitmaskConsumer<KappaTypes> {
+
+public:
+
+	void Init(KappaSettings const& settings) override;
+};
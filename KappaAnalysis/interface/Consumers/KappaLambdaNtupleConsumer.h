@@ -107,7 +107,7 @@ public:
 		});
 
 		// loop over all quantities containing "weight" (case-insensitive)
-		// and try to find them in the weights map to write them out
+		// and try to find them in the event weights to write them out
 		for (auto const & quantity : settings.GetQuantities())
 		{
 			if (boost::algorithm::icontains(quantity, "weight") &&
@@ -115,9 +115,16 @@ public:
 			    (LambdaNtupleConsumer<TTypes>::GetDoubleQuantities().count(quantity) == 0))
 			{
 				LOG(DEBUG) << "\tQuantity \"" << quantity << "\" is tried to be taken from product.m_weights or product.m_optionalWeights.";
-				LambdaNtupleConsumer<TTypes>::AddFloatQuantity( quantity, [quantity](event_type const & event, product_type const & product)
+				// only weights registered by the producers have a slot, the slot is looked up until the
+				// weight is registered and then kept; weights without a slot are written as 1
+				size_t weightSlot = EventWeights::NotRegistered;
+				LambdaNtupleConsumer<TTypes>::AddFloatQuantity( quantity, [quantity, weightSlot](event_type const & event, product_type const & product) mutable
 				{
-					return SafeMap::GetWithDefault(product.m_weights, quantity, SafeMap::GetWithDefault(product.m_optionalWeights, quantity, 1.0));
+					if (weightSlot == EventWeights::NotRegistered)
+					{
+						weightSlot = EventWeights::GetSlot(quantity);
+					}
+					return product.m_weights.Get(weightSlot, product.m_optionalWeights.Get(weightSlot, 1.0));
 				} );
 			}
 			if ((boost::algorithm::icontains(quantity, "filter") || boost::algorithm::icontains(quantity, "cut")) &&
@@ -17,7 +17,7 @@ class GenMatchingFilterBase: public FilterBase<KappaTypes>
 
 public:
 	
-	GenMatchingFilterBase(std::map<TValidObject*, KGenParticle*> KappaProduct::*genParticleMatchedObjects,
+	GenMatchingFilterBase(FlatMap<TValidObject*, KGenParticle*> KappaProduct::*genParticleMatchedObjects,
 	                      std::vector<TValidObject*> KappaProduct::*validObjects) :
 		m_genParticleMatchedObjects(genParticleMatchedObjects),
 		m_validObjects(validObjects)
@@ -39,7 +39,7 @@ public:
 
 
 private:
-	std::map<TValidObject*, KGenParticle*> KappaProduct::*m_genParticleMatchedObjects;
+	FlatMap<TValidObject*, KGenParticle*> KappaProduct::*m_genParticleMatchedObjects;
 	std::vector<TValidObject*> KappaProduct::*m_validObjects;
 
 };
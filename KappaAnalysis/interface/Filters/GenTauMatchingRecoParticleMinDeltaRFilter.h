@@ -21,7 +21,7 @@ public:
 	typedef typename KappaTypes::product_type product_type;
 	typedef typename KappaTypes::setting_type setting_type;
 
-	GenTauMatchingRecoParticleMinDeltaRFilterBase(std::map<TValidObject*, KGenTau*> product_type::*genTauMatchedObjects,
+	GenTauMatchingRecoParticleMinDeltaRFilterBase(FlatMap<TValidObject*, KGenTau*> product_type::*genTauMatchedObjects,
 	                      float (setting_type::*GetMinDeltaRMatchedRecoObjects)(void) const) :
 		m_genTauMatchedObjects(genTauMatchedObjects),
 		GetMinDeltaRMatchedRecoObjects(GetMinDeltaRMatchedRecoObjects)
@@ -34,10 +34,10 @@ public:
 		if ((product.*m_genTauMatchedObjects).size() >= 2)
 		{
 			float deltaRMatched = 0;
-			for (typename std::map<TValidObject*, KGenTau*>::const_iterator validMatchedObject1 = (product.*m_genTauMatchedObjects).begin();
+			for (typename FlatMap<TValidObject*, KGenTau*>::const_iterator validMatchedObject1 = (product.*m_genTauMatchedObjects).begin();
 			validMatchedObject1 != (product.*m_genTauMatchedObjects).end(); ++validMatchedObject1)
 			{
-				for (typename std::map<TValidObject*, KGenTau*>::const_iterator validMatchedObject2 = (product.*m_genTauMatchedObjects).begin();
+				for (typename FlatMap<TValidObject*, KGenTau*>::const_iterator validMatchedObject2 = (product.*m_genTauMatchedObjects).begin();
 						validMatchedObject2 != (product.*m_genTauMatchedObjects).end(); ++validMatchedObject2)
 				{
 					//make sure not to match lepton with itself
@@ -57,7 +57,7 @@ public:
 	};
 
 private:
-	std::map<TValidObject*, KGenTau*> KappaProduct::*m_genTauMatchedObjects;
+	FlatMap<TValidObject*, KGenTau*> KappaProduct::*m_genTauMatchedObjects;
 	float (setting_type::*GetMinDeltaRMatchedRecoObjects)(void) const;
 };
 
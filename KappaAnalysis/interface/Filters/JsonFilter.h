@@ -13,6 +13,7 @@
  *	The filter returns false in case the events is not selected
  *  in order to fully skip this event in the following analysis.
  *  This filter can savely be run as global or local filter.
+ *  The decision is evaluated once per lumi section.
  */
 class JsonFilter : public FilterBase<KappaTypes> {
 
@@ -22,6 +23,8 @@ public:
 
     void Init(KappaSettings const &settings) override;
 
+    FilterGranularity GetFilterGranularity() const override;
+
     bool DoesEventPass(KappaEvent const &event, KappaProduct const &product,
                        KappaSettings const &settings) const override;
 
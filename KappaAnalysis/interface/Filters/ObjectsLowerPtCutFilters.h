@@ -3,11 +3,11 @@
 #include <limits>
 
 #include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
 
 #include "Artus/Filter/interface/CutFilterBase.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerPatternCache.h"
 
 
 /** Abstract Lepton Pt Filter
@@ -69,16 +69,17 @@ protected:
 				
 				for (std::vector<std::string>::iterator hltName = hltNames.begin(); hltName != hltNames.end(); ++hltName)
 				{
-					std::string tmpHltName(*hltName); // TODO
-					boost::regex pattern(tmpHltName, boost::regex::icase | boost::regex::extended);
+					// the pattern is matched against the HLT paths only once per lumi section
+					size_t hltPatternIndex = m_hltPatternCache.AddPattern(*hltName);
 					for (std::vector<int>::iterator index = defaultIndices.begin(); index != defaultIndices.end(); ++index)
 					{
 						size_t tmpIndex(*index);
 						this->m_cuts.push_back(std::pair<double_extractor_lambda, CutRange>(
-								[this, tmpHltName, pattern, tmpIndex](KappaEvent const& event, KappaProduct const& product) -> double {
-									bool hasMatch = false;
-									for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-										hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), pattern);
+								[this, hltPatternIndex, tmpIndex](KappaEvent const& event, KappaProduct const& product) -> double {
+									assert(event.m_eventInfo);
+									assert(event.m_lumiInfo);
+									m_hltPatternCache.SetNames(event.m_lumiInfo->hltNames, event.m_eventInfo->nRun, event.m_eventInfo->nLumi);
+									bool hasMatch = m_hltPatternCache.MatchesAny(hltPatternIndex, product.m_selectedHltPositions);
 
 									return (((product.*m_validLeptonsMember).size() > tmpIndex && hasMatch) ?
 									        (product.*m_validLeptonsMember).at(tmpIndex)->p4.Pt() :
@@ -95,6 +96,7 @@ protected:
 
 private:
 	std::vector<TLepton*> KappaProduct::*m_validLeptonsMember;
+	mutable TriggerPatternCache m_hltPatternCache;
 };
 
 
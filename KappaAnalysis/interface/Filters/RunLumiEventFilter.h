@@ -1,11 +1,13 @@
-
 #pragma once
 
+#include <unordered_set>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 #include "KappaTools/RootTools/interface/RunLumiReader.h"
 
 #include "Artus/Core/interface/FilterBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/Utility/interface/RunLumiEventIndex.h"
 
 
 /** Filter events by white/black lists for run/lumi/event numbers
@@ -17,6 +19,15 @@
  *   - EventWhitelist
  *   - EventBlacklist
  *   - MatchRunLumiEventTuples (optional)
+ *   - RunLumiEventWhitelistFiles, RunLumiEventBlacklistFiles (optional, binary lists of (run, lumi, event) tuples)
+ *   - RunLumiEventBloomFilterBitsPerEntry (optional, 0 disables the Bloom filters)
+ *
+ *  With MatchRunLumiEventTuples or list files, the (run, lumi, event) tuples of the settings and of the files are
+ *  stored in hashed indices (see RunLumiEventIndex). An event passes if it is not blacklisted and, if whitelists
+ *  are given, whitelisted. Otherwise, run, lumi and event numbers are checked separately against hashed sets.
+ *  All lists are read at Init, the lookups per event take O(1).
+ *
+ *  Without event lists, the decision is evaluated once per lumi section or, without lumi lists, once per run.
  */
 class RunLumiEventFilter: public FilterBase<KappaTypes>
 {
@@ -26,11 +37,36 @@ public:
 
 	std::string GetFilterId() const override;
 
+	void Init(KappaSettings const& settings) override;
+
+	FilterGranularity GetFilterGranularity() const override;
+
 	bool DoesEventPass(KappaEvent const& event, KappaProduct const& product,
 	                           KappaSettings const& settings) const override;
 
 
 private:
-	
-	bool MatchWhiteBlackLists(uint64_t item, std::vector<uint64_t> const& whitelist, std::vector<uint64_t> const& blacklist) const;
+
+	struct WhiteBlackList
+	{
+		std::unordered_set<uint64_t> whitelist;
+		std::unordered_set<uint64_t> blacklist;
+
+		void Fill(std::vector<uint64_t> const& whitelistItems, std::vector<uint64_t> const& blacklistItems);
+		bool Match(uint64_t item) const;
+	};
+
+	static void FillEntries(std::vector<uint64_t> const& runs, std::vector<uint64_t> const& lumis,
+	                        std::vector<uint64_t> const& events, std::vector<std::string> const& fileNames,
+	                        std::vector<RunLumiEventIndex::Entry>& entries);
+
+	FilterGranularity m_granularity = FilterGranularity::Event;
+
+	bool m_matchTuples = false;
+	RunLumiEventIndex m_whitelistIndex;
+	RunLumiEventIndex m_blacklistIndex;
+
+	WhiteBlackList m_runs;
+	WhiteBlackList m_lumis;
+	WhiteBlackList m_events;
 };
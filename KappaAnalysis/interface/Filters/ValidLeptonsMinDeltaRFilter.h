@@ -4,6 +4,7 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatching.h"
 #include "Artus/Core/interface/FilterBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaEnumTypes.h"
@@ -33,28 +34,11 @@ public:
 	{
 		if ((product.*m_validLeptons).size() >= 2)
 		{
-			float deltaRMatched = 0;
-			//int matchid1 = 0;
-			for (typename std::vector<TValidObject*>::const_iterator validObject1 = (product.*m_validLeptons).begin();
-			validObject1 != (product.*m_validLeptons).end(); ++validObject1)
+			m_leptonCoordinates.Clear();
+			m_leptonCoordinates.AddObjects(product.*m_validLeptons);
+			if (DeltaRMatcher::HasPairCloserThan(m_leptonCoordinates, (settings.*GetMinDeltaRValidLeptons)()))
 			{
-				//int matchid2 = 0;
-				for (typename std::vector<TValidObject*>::const_iterator validObject2 = (product.*m_validLeptons).begin();
-						validObject2 != (product.*m_validLeptons).end(); ++validObject2)
-				{
-					//make sure not to match lepton with itself
-					if (validObject1 != validObject2)
-					{
-						deltaRMatched = ROOT::Math::VectorUtil::DeltaR((*validObject1)->p4, (*validObject2)->p4);
-						if (deltaRMatched < (settings.*GetMinDeltaRValidLeptons)())
-						{
-							//std::cout << "Deleting event with DeltaR between particles of " << deltaRMatched << std::endl;
-							return false;
-						}
-					}
-					//matchid2 += 1;
-				}
-				//matchid1 += 1;
+				return false;
 			}
 		}
 		return true;
@@ -63,6 +47,8 @@ public:
 private:
 	std::vector<TValidObject*> KappaProduct::*m_validLeptons;
 	float (setting_type::*GetMinDeltaRValidLeptons)(void) const;
+	
+	mutable EtaPhiArrays m_leptonCoordinates;
 };
 
 /** Filter events with too close valid electrons
@@ -2,8 +2,12 @@
 
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
+#include "Artus/Utility/interface/CounterBasedRandom.h"
 
 class KappaProducerBase : public ProducerBase< KappaTypes > {
 
+protected:
+	/// reproducible random numbers for one object (e.g. the index of the jet in the event) of this producer,
+	/// keyed by run, lumi, event and producer ID (see RandomNumberService)
+	RandomStream GetRandomStream(KappaEvent const& event, uint32_t objectIndex=0) const;
 };
-
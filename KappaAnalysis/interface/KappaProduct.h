@@ -1,12 +1,21 @@
 #pragma once
 
+#include <boost/dynamic_bitset.hpp>
+
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "KappaTools/RootTools/interface/HLTTools.h"
 
 #include "Artus/Core/interface/ProductBase.h"
+#include "Artus/Utility/interface/FlatMap.h"
 #include "Artus/KappaAnalysis/interface/KappaEnumTypes.h"
+#include "Artus/KappaAnalysis/interface/Utility/EventWeights.h"
 #include "Artus/KappaAnalysis/interface/Utility/GenParticleDecayTree.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleView.h"
+#include "Artus/KappaAnalysis/interface/Utility/JetEnergyUncertaintyMatrix.h"
+#include "Artus/KappaAnalysis/interface/Utility/PFCandidateStore.h"
+#include "Artus/KappaAnalysis/interface/Utility/PFIsolation.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerMatchingResult.h"
 
 /**
    \brief Container class for everything that can be produced in pipeline.
@@ -19,6 +28,7 @@ class KappaProduct : public ProductBase {
 public:
 
 	// settings to be modified (e.g. in the case of run-dependent settings)
+	// m_settingsHltPaths is only filled by producers replacing the configured HltPaths, the HltProducer uses the settings otherwise
 	std::vector<std::string> m_settingsHltPaths;
 
 	std::map<size_t, std::vector<std::string> > m_settingsElectronTriggerFiltersByIndex;
@@ -41,12 +51,25 @@ public:
         bool m_isDoubleMuon = false;
         bool m_isMC = false;
 
-	// all weights in this map are multiplied into one "eventWeight" by the EventWeightProducer
-	// events in this map can be written out automatically by the KappaLambdaNtupleConsumer
-	std::map<std::string, double> m_weights;
+	// all weights set here are multiplied into one "eventWeight" by the EventWeightProducer
+	// the weights can be written out automatically by the KappaLambdaNtupleConsumer
+	EventWeights m_weights;
+
+	// variations of the weights (e.g. "crossSectionPerEventWeightUp"), not included in the "eventWeight"
+	// the weights can be written out automatically by the KappaLambdaNtupleConsumer
+	EventWeights m_optionalWeights;
+
+	// indexed view of event.m_genParticles, built by the first generator level producer that requests it
+	mutable GenParticleView m_genParticleView;
 
-	// events in this map can be written out automatically by the KappaLambdaNtupleConsumer
-	std::map<std::string, double> m_optionalWeights;
+	GenParticleView const& GetGenParticleView(std::vector<KGenParticle>* genParticles) const
+	{
+		if (! m_genParticleView.IsBuilt())
+		{
+			m_genParticleView.Build(genParticles);
+		}
+		return m_genParticleView;
+	}
 
 	// filled by the GenBosonProducers
 	KGenParticle* m_genBosonParticle = nullptr;
@@ -63,20 +86,20 @@ public:
 	std::map<KGenParticle*, KGenTau*> m_validGenTausMap;
 
 	// filled by the GenTauDecayProducer
-	GenParticleDecayTree m_genBosonTree;
-	std::map<KGenParticle*, GenParticleDecayTree*> m_genTauDecayTrees;
+	// decay chain of the boson or (with a virtual root) of its decay products
+	GenParticleDecayGraph m_genBosonDecayGraph;
 
 	/// added by ElectronCorrectionProducer
-	// needs to be a shared_ptr in order to be deleted when the product is deleted
-	std::vector<std::shared_ptr<KElectron> > m_correctedElectrons;
+	// copies of the input objects, created in the event arena (ProductBase::CreateEventObject)
+	std::vector<KElectron*> m_correctedElectrons;
 
 	/// added by ValidElectronsProducer
 	std::vector<KElectron*> m_validElectrons;
 	std::vector<KElectron*> m_invalidElectrons;
 
 	/// added by MuonCorrectionProducer
-	// needs to be a shared_ptr in order to be deleted when the product is deleted
-	std::vector<std::shared_ptr<KMuon> > m_correctedMuons;
+	// copies of the input objects, created in the event arena (ProductBase::CreateEventObject)
+	std::vector<KMuon*> m_correctedMuons;
 
 	/// added by ValidMuonsProducer
 	std::vector<KMuon*> m_validMuons;
@@ -87,11 +110,11 @@ public:
 	std::vector<double> m_MuonPt;
 
 	/// added by TauEnergyCorrectionProducer
-	// needs to be a shared_ptr in order to be deleted when the product is deleted
-	std::vector<std::shared_ptr<KTau> > m_correctedTaus;
+	// copies of the input objects, created in the event arena (ProductBase::CreateEventObject)
+	std::vector<KTau*> m_correctedTaus;
 
 	/// added by <Lepton>CorrectionProducers
-	std::map<const KLepton*, const KLepton*> m_originalLeptons; // key: corrected, value: original
+	FlatMap<const KLepton*, const KLepton*> m_originalLeptons; // key: corrected, value: original
 
 	/// added by ValidTausProducer
 	std::vector<KTau*> m_validTaus;
@@ -102,9 +125,15 @@ public:
 	std::vector<KLepton*> m_invalidLeptons;
 
 	/// added by JetEnergyCorrectionProducer
-	std::vector<std::shared_ptr<KBasicJet> > m_correctedJets;
-	std::vector<std::shared_ptr<KJet> > m_correctedTaggedJets;
-	std::map<const KBasicJet*, const KBasicJet*> m_originalJets; // key: corrected, value: original
+	// copies of the input objects, created in the event arena (ProductBase::CreateEventObject)
+	std::vector<KBasicJet*> m_correctedJets;
+	std::vector<KJet*> m_correctedTaggedJets;
+	FlatMap<const KBasicJet*, const KBasicJet*> m_originalJets; // key: corrected, value: original
+
+	/// added by JetCorrectionUncertaintyMatrixProducer and TaggedJetCorrectionUncertaintyMatrixProducer
+	// relative uncertainties of the corrected (tagged) jets for all split uncertainty sources
+	JetEnergyUncertaintyMatrix m_jetEnergyUncertaintyMatrix;
+	JetEnergyUncertaintyMatrix m_taggedJetEnergyUncertaintyMatrix;
 
 	/// added by ValidJetsProducer
 	std::vector<KBasicJet*> m_validJets;
@@ -134,19 +163,52 @@ public:
 	std::vector<KJet*> m_bTaggedJets;
 	std::vector<KJet*> m_nonBTaggedJets;
 	
+	/// added by HltProducer
 	// selected means fired (and unprescaled if requested)
-	std::vector<std::string> m_selectedHltNames;
+	// bits and positions refer to the HLT paths of the current lumi section (KLumiInfo::hltNames)
+	boost::dynamic_bitset<> m_selectedHltBits;
 	std::vector<int> m_selectedHltPositions;
 	std::vector<int> m_selectedHltPrescales;
+	std::vector<std::string> const* m_hltNames = nullptr;
+
+	bool IsHltSelected(size_t hltPosition) const
+	{
+		return ((hltPosition < m_selectedHltBits.size()) && m_selectedHltBits.test(hltPosition));
+	}
+
+	std::string const& GetSelectedHltName(size_t index) const
+	{
+		return m_hltNames->at(m_selectedHltPositions.at(index));
+	}
+
+	// the names are only materialised on the first request per event
+	std::vector<std::string> const& GetSelectedHltNames() const
+	{
+		if (! m_selectedHltNamesValid)
+		{
+			m_selectedHltNames.clear();
+			m_selectedHltNames.reserve(m_selectedHltPositions.size());
+			for (size_t index = 0; index < m_selectedHltPositions.size(); ++index)
+			{
+				m_selectedHltNames.push_back(GetSelectedHltName(index));
+			}
+			m_selectedHltNamesValid = true;
+		}
+		return m_selectedHltNames;
+	}
+
+	// filled by GetSelectedHltNames, to be invalidated whenever m_selectedHltPositions changes
+	mutable std::vector<std::string> m_selectedHltNames;
+	mutable bool m_selectedHltNamesValid = false;
 
 	/// added by TriggerMatchingProducer
-	std::map<KElectron*, KLV*> m_triggerMatchedElectrons;
-	std::map<KMuon*, KLV*> m_triggerMatchedMuons;
-	std::map<KTau*, KLV*> m_triggerMatchedTaus;
-	std::map<KBasicJet*, KLV*> m_triggerMatchedJets;
-	std::map<KJet*, KLV*> m_triggerMatchedTaggedJets;
+	FlatMap<KElectron*, KLV*> m_triggerMatchedElectrons;
+	FlatMap<KMuon*, KLV*> m_triggerMatchedMuons;
+	FlatMap<KTau*, KLV*> m_triggerMatchedTaus;
+	FlatMap<KBasicJet*, KLV*> m_triggerMatchedJets;
+	FlatMap<KJet*, KLV*> m_triggerMatchedTaggedJets;
 
-	std::map<KLepton*, KLV*> m_triggerMatchedLeptons;
+	FlatMap<KLepton*, KLV*> m_triggerMatchedLeptons;
 
 	/// added by TriggerMatchingProducer
 	// m_detailedTriggerMatchedElectrons[reco lepton][HLT name][filter name] = {trigger objects}
@@ -158,27 +220,34 @@ public:
 
 	std::map<KLepton*, std::map<std::string, std::map<std::string, std::vector<KLV*> > >* > m_detailedTriggerMatchedLeptons;
 
+	/// added by TriggerMatchingProducer
+	// flat results of the trigger matching, see TriggerMatchingResult
+	TriggerMatchingResult<KElectron> m_triggerMatchingResultElectrons;
+	TriggerMatchingResult<KMuon> m_triggerMatchingResultMuons;
+	TriggerMatchingResult<KTau> m_triggerMatchingResultTaus;
+	TriggerMatchingResult<KBasicJet> m_triggerMatchingResultJets;
+
 	/// added by GenMatchingProducer
-	std::map<KElectron*, KGenParticle*> m_genParticleMatchedElectrons;
-	std::map<KMuon*, KGenParticle*> m_genParticleMatchedMuons;
-	std::map<KTau*, KGenParticle*> m_genParticleMatchedTaus;
-	std::map<KBasicJet*, KGenParticle*> m_genParticleMatchedJets;
-	std::map<KLepton*, KGenParticle*> m_genParticleMatchedLeptons;
+	FlatMap<KElectron*, KGenParticle*> m_genParticleMatchedElectrons;
+	FlatMap<KMuon*, KGenParticle*> m_genParticleMatchedMuons;
+	FlatMap<KTau*, KGenParticle*> m_genParticleMatchedTaus;
+	FlatMap<KBasicJet*, KGenParticle*> m_genParticleMatchedJets;
+	FlatMap<KLepton*, KGenParticle*> m_genParticleMatchedLeptons;
 	float m_ratioGenParticleMatched;
 	float m_genParticleMatchDeltaR;
 
 	/// added by GenTauMatchingProducers
-	std::map<KElectron*, KGenTau*> m_genTauMatchedElectrons;
-	std::map<KMuon*, KGenTau*> m_genTauMatchedMuons;
-	std::map<KTau*, KGenTau*> m_genTauMatchedTaus;
-	std::map<KLepton*, KGenTau*> m_genTauMatchedLeptons;
+	FlatMap<KElectron*, KGenTau*> m_genTauMatchedElectrons;
+	FlatMap<KMuon*, KGenTau*> m_genTauMatchedMuons;
+	FlatMap<KTau*, KGenTau*> m_genTauMatchedTaus;
+	FlatMap<KLepton*, KGenTau*> m_genTauMatchedLeptons;
 	float m_ratioGenTauMatched;
 	float m_genTauMatchDeltaR;
 
 	/// added by GenTauJetMatchingProducers
-	std::map<KElectron*, KGenJet*> m_genTauJetMatchedElectrons;
-	std::map<KMuon*, KGenJet*> m_genTauJetMatchedMuons;
-	std::map<KTau*, KGenJet*> m_genTauJetMatchedTaus;
+	FlatMap<KElectron*, KGenJet*> m_genTauJetMatchedElectrons;
+	FlatMap<KMuon*, KGenJet*> m_genTauJetMatchedMuons;
+	FlatMap<KTau*, KGenJet*> m_genTauJetMatchedTaus;
 
 	/// added by ZProducer
 	KLV m_z;
@@ -189,6 +258,10 @@ public:
 	std::pair<const KPFCandidate*, const KPFCandidate*> m_zPFLeptonsMatched;
 
 	/// added by PFCandidatesProducer
+	// all candidates as separate arrays with an eta-phi grid
+	PFCandidateStore m_pfCandidates;
+
+	// pointer collections per type, only filled with FillPFCandidateCollections = true
 	std::vector<const KPFCandidate*> m_pfChargedHadrons;
 	std::vector<const KPFCandidate*> m_pfNeutralHadrons;
 	std::vector<const KPFCandidate*> m_pfPhotons;
@@ -206,6 +279,10 @@ public:
 	std::vector<const KPFCandidate*> m_pfPhotonsFromFirstPV;
 	std::vector<const KPFCandidate*> m_pfPhotonsNotFromFirstPV;
 
+	/// added by ValidLeptonsPFIsolationProducer
+	// in the order of m_validLeptons, cones in the order of PFIsolationConeSizes
+	PFIsolationSums m_validLeptonsPFIsolation;
+
 	// added by NumberOfParticlesProducer
 	unsigned int m_NLooseElectrons = 0;
 	unsigned int m_NLooseElectronsRelaxedVtxCriteria = 0;
@@ -127,6 +127,9 @@ public:
 	IMPL_SETTING_UINT64LIST_DEFAULT(EventWhitelist, {});
 	IMPL_SETTING_UINT64LIST_DEFAULT(EventBlacklist, {});
 	IMPL_SETTING_DEFAULT(bool, MatchRunLumiEventTuples, false);
+	IMPL_SETTING_STRINGLIST_DEFAULT(RunLumiEventWhitelistFiles, {});
+	IMPL_SETTING_STRINGLIST_DEFAULT(RunLumiEventBlacklistFiles, {});
+	IMPL_SETTING_DEFAULT(int, RunLumiEventBloomFilterBitsPerEntry, 0);
 
 	IMPL_SETTING_STRINGLIST_DEFAULT(HltPaths, {});
 	IMPL_SETTING_DEFAULT(bool, AllowPrescaledTrigger, true);
@@ -145,6 +148,9 @@ public:
 
 	IMPL_SETTING_DEFAULT(float, TriggerObjectLowerPtCut, -1.0);
 
+	// the flat results are always filled, the nested maps m_detailedTriggerMatched... only on request
+	IMPL_SETTING_DEFAULT(bool, FillDetailedTriggerMatchingMaps, true);
+
 	IMPL_SETTING_DEFAULT(bool, InvalidateNonMatchingElectrons, true);
 	IMPL_SETTING_DEFAULT(bool, InvalidateNonMatchingMuons, true);
 	IMPL_SETTING_DEFAULT(bool, InvalidateNonMatchingTaus, true);
@@ -356,6 +362,7 @@ public:
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaInputQuantities, {});
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaMethods, {});
 	IMPL_SETTING_STRINGLIST_DEFAULT(TmvaWeights, {});
+	IMPL_SETTING_DEFAULT(bool, TmvaNativeBdtEvaluation, false);
 
 	// KappaCollectionsConsumer settings
 	IMPL_SETTING_DEFAULT(bool, BranchGenMatchedElectrons, false);
@@ -367,6 +374,18 @@ public:
 	IMPL_SETTING_DEFAULT(bool, AddGenMatchedTaus, true);
 	IMPL_SETTING_DEFAULT(bool, AddGenMatchedTauJets, true);
 
+	// PFCandidatesProducer and ValidLeptonsPFIsolationProducer
+	IMPL_SETTING_DEFAULT(bool, FillPFCandidateCollections, true);
+	std::vector<float> PFIsolationConeSizes = {0.3f, 0.4f};
+	IMPL_SETTING_FLOATLIST_DEFAULT(PFIsolationConeSizes, PFIsolationConeSizes);
+	IMPL_SETTING_DEFAULT(float, PFIsolationChargedVetoCone, 0.0001f);
+	IMPL_SETTING_DEFAULT(float, PFIsolationNeutralVetoCone, 0.01f);
+	IMPL_SETTING_DEFAULT(float, PFIsolationPhotonVetoCone, 0.01f);
+	IMPL_SETTING_DEFAULT(float, PFIsolationPileUpVetoCone, 0.01f);
+	IMPL_SETTING_DEFAULT(float, PFIsolationNeutralMinPt, 0.5f);
+	IMPL_SETTING_DEFAULT(float, PFIsolationPhotonMinPt, 0.5f);
+	IMPL_SETTING_DEFAULT(float, PFIsolationPileUpMinPt, 0.5f);
+
 	// ZProducer
 	IMPL_SETTING_DEFAULT(float, ZMass, 91.1876f);
 	IMPL_SETTING(float, ZMassRange);
@@ -6,10 +6,12 @@
    \brief CrossSectionWeightProducer
    Config tags:
    - CrossSection, e.g. "1234"
+   - CrossSectionUp, CrossSectionDown (optional variations)
    If config tag available, provided value is used as weight.
    If not available, external or internal cross section of the
    LumiSection is used.
 
+   The weights are constant and determined once per run.
 */
 
 class CrossSectionWeightProducer : public KappaProducerBase {
@@ -17,8 +19,24 @@ public:
 
 	std::string GetProducerId() const override;
 
+	void Init(KappaSettings const& settings) override;
+
+	void OnRun(KappaEvent const& event, KappaSettings const& settings) override;
+
 	void Produce( KappaEvent const& event,
 			KappaProduct & product,
 			KappaSettings const& settings) const override;
 
+private:
+	void UpdateWeights(KappaSettings const& settings);
+
+	size_t m_weightSlot = EventWeights::NotRegistered;
+	size_t m_weightUpSlot = EventWeights::NotRegistered;
+	size_t m_weightDownSlot = EventWeights::NotRegistered;
+
+	double m_weight = 1.0;
+	bool m_hasVariations = false;
+	double m_weightUp = 1.0;
+	double m_weightDown = 1.0;
+
 };
@@ -9,8 +9,10 @@
    Config tags:
    - EventWeight, e.g. "eventWeight"
    
-   Multiplies all entries in the map product.m_weights with m_baseWeight
-   and writes the result to product.m_weights[settings.GetEventWeight()]
+   Multiplies all weights set in product.m_weights with the BaseWeight
+   and writes the result to the slot of settings.GetEventWeight() in product.m_weights.
+   The weights registered as constant (see EventWeights::RegisterWeight) are folded
+   together with the BaseWeight into one factor once per run.
    
    By adding the weight quantity names to the Quantity config setting,
    they will be individually written to the ntuple by the LambdaNtupleConsumer
@@ -24,6 +26,8 @@ public:
 	~EventWeightProducer();
 	
 	void Init(KappaSettings const& settings) override;
+
+	void OnRun(KappaEvent const& event, KappaSettings const& settings) override;
 	
 	void Produce(KappaEvent const& event, KappaProduct& product,
 	                     KappaSettings const& settings) const override;
@@ -32,5 +36,12 @@ public:
 private:
 	std::string pipelineName;
 	mutable std::vector<std::string> m_weightNames;
+
+	size_t m_eventWeightSlot = EventWeights::NotRegistered;
+
+	// product of the BaseWeight and the constant weights set in the product
+	mutable bool m_constantFactorValid = false;
+	mutable uint64_t m_constantFactorMask = 0;
+	mutable double m_constantFactor = 1.0;
 };
 
@@ -40,7 +40,7 @@ public:
 
 protected:
 
-	std::vector<KGenParticle*> FindMothersWithDifferentPdgId(KGenParticles* genParticles, unsigned int currentIndex, int currentPdgId) const;
+	std::vector<KGenParticle*> FindMothersWithDifferentPdgId(GenParticleView const& genParticleView, size_t currentIndex, int currentPdgId) const;
 };
 
 
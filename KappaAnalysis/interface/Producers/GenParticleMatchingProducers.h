@@ -9,6 +9,7 @@
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatching.h"
 #include "Artus/Utility/interface/Utility.h"
 
 
@@ -47,10 +48,19 @@ public:
                         setting_type const& settings, KLV* const recoJet) const;
 
 private:
+	void FillGenPartons(event_type const& event, product_type const& product) const;
+	KGenParticle* MatchGenPartons(setting_type const& settings, KLV* const recoJet) const;
+
 	JetMatchingAlgorithm m_jetMatchingAlgorithm;
 	float m_DeltaRMatchingRecoJetGenParticle;
 	bool m_InvalidateNonGenParticleMatchingRecoJets;
 	bool m_InvalidateGenParticleMatchingRecoJets;
+
+	// gen partons (quarks and gluons) of the current event, filled once per event
+	mutable std::vector<uint32_t> m_genPartonIndices;
+	mutable std::vector<KGenParticle*> m_genPartons;
+	mutable EtaPhiArrays m_genPartonCoordinates;
+	mutable std::vector<float> m_genPartonDeltaR2;
 };
 
 
@@ -69,7 +79,7 @@ public:
 	typedef typename KappaTypes::product_type product_type;
 	typedef typename KappaTypes::setting_type setting_type;
 	
-	RecoLeptonGenParticleMatchingProducerBase(std::map<TLepton*, KGenParticle*> product_type::*genParticleMatchedLeptons,
+	RecoLeptonGenParticleMatchingProducerBase(FlatMap<TLepton*, KGenParticle*> product_type::*genParticleMatchedLeptons,
 	                                          std::vector<TLepton>* event_type::*leptons,
 	                                          std::vector<TLepton*> product_type::*validLeptons,
 	                                          std::vector<TLepton*> product_type::*invalidLeptons,
@@ -149,57 +159,67 @@ public:
 				}
 			}
 			
+			// only use genParticles that will decay into comparable particles
+			// and only use genParticles with the required status if requested
+			m_selectedGenParticles.clear();
+			m_genParticleCoordinates.Clear();
+			GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
+			if ((settings.*GetRecoLeptonMatchingGenParticlePdgIds)().empty())
+			{
+				m_selectedGenParticleIndices.resize(genParticleView.GetNParticles());
+				for (size_t index = 0; index < m_selectedGenParticleIndices.size(); ++index)
+				{
+					m_selectedGenParticleIndices[index] = static_cast<uint32_t>(index);
+				}
+			}
+			else
+			{
+				genParticleView.GetParticlesWithAbsPdgIds((settings.*GetRecoLeptonMatchingGenParticlePdgIds)(), m_selectedGenParticleIndices);
+			}
+			for (std::vector<uint32_t>::const_iterator index = m_selectedGenParticleIndices.begin();
+			     index != m_selectedGenParticleIndices.end(); ++index)
+			{
+				if ((settings.*GetRecoLeptonMatchingGenParticleStatus)() == -1 ||
+				    (settings.*GetRecoLeptonMatchingGenParticleStatus)() == genParticleView.GetStatus(*index))
+				{
+					KGenParticle* genParticle = genParticleView.GetParticle(*index);
+					m_selectedGenParticles.push_back(genParticle);
+					m_genParticleCoordinates.AddObject(*genParticle);
+				}
+			}
+			
+			// match every lepton to the nearest of these genParticles
+			m_leptonCoordinates.Clear();
+			m_leptonCoordinates.AddObjects(leptons);
+			m_matcher.Compute(m_leptonCoordinates, m_genParticleCoordinates);
+			std::vector<int> const& matches = m_matcher.Match(DeltaRMatcher::Strategy::GREEDY_NEAREST,
+			                                                  (settings.*GetDeltaRMatchingRecoLeptonsGenParticle)());
+			
 			// loop over all chosen leptons to check
-			for (typename std::vector<TLepton*>::iterator lepton = leptons.begin();
-				 lepton != leptons.end();)
+			product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
+			for (size_t leptonIndex = 0; leptonIndex < leptons.size(); ++leptonIndex)
 			{
-				bool leptonMatched = false;
-				float deltaR = 0.0f;
-				float deltaRmin = std::numeric_limits<float>::max();
-
-				// loop over all genParticles
-				for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-					genParticle != event.m_genParticles->end(); ++genParticle)
+				TLepton* lepton = leptons[leptonIndex];
+				bool leptonMatched = (matches[leptonIndex] != DeltaRMatcher::NoMatch);
+				if (leptonMatched)
 				{
-					// only use genParticles that will decay into comparable particles
-					if ((settings.*GetRecoLeptonMatchingGenParticlePdgIds)().empty() ||
-					    Utility::Contains((settings.*GetRecoLeptonMatchingGenParticlePdgIds)(), std::abs(genParticle->pdgId)))
-					{
-						// only use genParticles with the required status if requested
-						if ((settings.*GetRecoLeptonMatchingGenParticleStatus)() == -1 ||
-						    (settings.*GetRecoLeptonMatchingGenParticleStatus)() == genParticle->status())
-						{
-							deltaR = ROOT::Math::VectorUtil::DeltaR((*lepton)->p4, genParticle->p4);
-							if(deltaR<(settings.*GetDeltaRMatchingRecoLeptonsGenParticle)() && deltaR<deltaRmin)
-							{
-								(product.*m_genParticleMatchedLeptons)[*lepton] = &(*genParticle);
-								ratioGenParticleMatched += (1.0f / leptons.size());
-								product.m_genParticleMatchDeltaR = deltaR;
-								deltaRmin = deltaR;
-								leptonMatched = true;
-								if (settings.GetDebugVerbosity() > 0) {
-									LOG(DEBUG) << "(event " << event.m_eventInfo->nEvent << "): " << (*lepton)->p4 << " --> " << genParticle->p4
-										<< ", pdg=" << genParticle->pdgId << ", status=" << genParticle->status();
-								}
-							}
-							else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
-						}
-						else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
+					KGenParticle* genParticle = m_selectedGenParticles[matches[leptonIndex]];
+					(product.*m_genParticleMatchedLeptons)[lepton] = genParticle;
+					ratioGenParticleMatched += (1.0f / leptons.size());
+					product.m_genParticleMatchDeltaR = std::sqrt(m_matcher.GetDeltaR2(leptonIndex, matches[leptonIndex]));
+					if (settings.GetDebugVerbosity() > 0) {
+						LOG(DEBUG) << "(event " << event.m_eventInfo->nEvent << "): " << lepton->p4 << " --> " << genParticle->p4
+							<< ", pdg=" << genParticle->pdgId << ", status=" << genParticle->status();
 					}
-					else product.m_genParticleMatchDeltaR = DefaultValues::UndefinedFloat;
 				}
 				// invalidate (non) matching lepton if requested
 				if (!(settings.*GetRecoLeptonMatchingGenParticleMatchAllLeptons)() &&
 					(((! leptonMatched) && (settings.*GetInvalidateNonGenParticleMatchingLeptons)()) ||
 					(leptonMatched && (settings.*GetInvalidateGenParticleMatchingLeptons)())))
 				{
-					LOG(DEBUG) << "Invalidating (non) matching lepton: " << (*lepton)->p4;
-					(product.*m_invalidLeptons).push_back(*lepton);
-					lepton = (product.*m_validLeptons).erase(lepton);
-				}
-				else
-				{
-					++lepton;
+					LOG(DEBUG) << "Invalidating (non) matching lepton: " << lepton->p4;
+					(product.*m_invalidLeptons).push_back(lepton);
+					(product.*m_validLeptons).erase(std::find((product.*m_validLeptons).begin(), (product.*m_validLeptons).end(), lepton));
 				}
 			}
 			// preserve sorting of invalid leptons
@@ -221,7 +241,7 @@ public:
 
 
 private:
-	std::map<TLepton*, KGenParticle*> product_type::*m_genParticleMatchedLeptons; //changed to KGenParticle from const KDataLV
+	FlatMap<TLepton*, KGenParticle*> product_type::*m_genParticleMatchedLeptons; //changed to KGenParticle from const KDataLV
 	std::vector<TLepton>* event_type::*m_leptons;
 	std::vector<TLepton*> product_type::*m_validLeptons;
 	std::vector<TLepton*> product_type::*m_invalidLeptons;
@@ -232,6 +252,12 @@ private:
 	bool (setting_type::*GetInvalidateGenParticleMatchingLeptons)(void) const;
 	bool (setting_type::*GetRecoLeptonMatchingGenParticleMatchAllLeptons)(void) const;
 	
+	mutable std::vector<uint32_t> m_selectedGenParticleIndices;
+	mutable std::vector<KGenParticle*> m_selectedGenParticles;
+	mutable EtaPhiArrays m_genParticleCoordinates;
+	mutable EtaPhiArrays m_leptonCoordinates;
+	mutable DeltaRMatcher m_matcher;
+	
 	std::map<size_t, std::vector<std::string> > m_leptonTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > m_leptonTriggerFiltersByHltName;
 
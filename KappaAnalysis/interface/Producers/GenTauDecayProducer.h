@@ -16,6 +16,7 @@
    this collection :
 
    - tree with three generations of decay products : Boson, Bosondaughters, Bosongranddaughters  
+     (stored as flat GenParticleDecayGraph in the product)
 
    If need arises to store other decay trees, this code can be made more general and
    configurable.
@@ -33,7 +34,6 @@ public:
 	             KappaSettings const& settings) const override;
 
 private:
-	void BuildDecayTree(GenParticleDecayTree& currentDecayTree, KGenParticle* currentGenParticle, event_type const& event) const;
 	int BosonPdgId;
 	int BosonStatus;
 };
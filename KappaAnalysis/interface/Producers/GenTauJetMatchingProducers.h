@@ -5,6 +5,7 @@
 
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatching.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 
@@ -31,7 +32,7 @@ public:
 	typedef typename KappaTypes::product_type product_type;
 	typedef typename KappaTypes::setting_type setting_type;
 	
-	GenTauJetMatchingProducerBase(std::map<TValidObject*, KGenJet*> product_type::*genTauJetMatchedObjects,
+	GenTauJetMatchingProducerBase(FlatMap<TValidObject*, KGenJet*> product_type::*genTauJetMatchedObjects,
 	                           std::vector<TValidObject*> product_type::*validObjects,
 	                           std::vector<TValidObject*> product_type::*invalidObjects,
 	                           TauDecayMode tauDecayMode,
@@ -60,29 +61,26 @@ public:
 		
 		if ((settings.*GetDeltaRMatchingRecoObjectGenTauJet)() > 0.0)
 		{
+			// TODO: maybe need to match to visible component of genTauJet
+			// depends on setting for TauGenJetProducer.includeNeutrinos
+			// PhysicsTools/JetMCAlgos/python/TauGenJets_cfi.py
+			m_objectCoordinates.Clear();
+			m_objectCoordinates.AddObjects(product.*m_validObjects);
+			m_genTauJetCoordinates.Clear();
+			m_genTauJetCoordinates.AddObjects(*event.m_genTauJets);
+			m_matcher.Compute(m_objectCoordinates, m_genTauJetCoordinates);
+			std::vector<int> const& matches = m_matcher.Match(DeltaRMatcher::Strategy::GREEDY_NEAREST,
+			                                                  (settings.*GetDeltaRMatchingRecoObjectGenTauJet)());
+			
 			// loop over all valid objects to check
+			size_t objectIndex = 0;
 			for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
-				 validObject != (product.*m_validObjects).end();)
+				 validObject != (product.*m_validObjects).end(); ++objectIndex)
 			{
-				bool objectMatched = false;
-				float deltaR = 0;
-				float deltaRmin = std::numeric_limits<float>::max();
-				
-				// loop over all genTauJets
-				for (typename std::vector<KGenJet>::iterator genTauJet = event.m_genTauJets->begin();
-					genTauJet != event.m_genTauJets->end(); ++genTauJet) 
+				bool objectMatched = (matches[objectIndex] != DeltaRMatcher::NoMatch);
+				if (objectMatched)
 				{
-					// TODO: maybe need to match to visible component of genTauJet
-					// depends on setting for TauGenJetProducer.includeNeutrinos
-					// PhysicsTools/JetMCAlgos/python/TauGenJets_cfi.py
-					deltaR = ROOT::Math::VectorUtil::DeltaR((*validObject)->p4, genTauJet->p4);
-					if(deltaR<(settings.*GetDeltaRMatchingRecoObjectGenTauJet)() && deltaR<deltaRmin)
-					{
-						(product.*m_genTauJetMatchedObjects)[*validObject] = &(*genTauJet);
-						deltaRmin = deltaR;
-						objectMatched = true;
-						//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*validObject)->p4 << " --> " << genTauJet->p4;
-					}
+					(product.*m_genTauJetMatchedObjects)[*validObject] = &(event.m_genTauJets->at(matches[objectIndex]));
 				}
 				// invalidate the object if it has not matched
 				if (((! objectMatched) && (settings.*GetInvalidateNonGenTauJetMatchingObjects)()) ||
@@ -107,7 +105,7 @@ public:
 	}
 	
 private:
-	std::map<TValidObject*, KGenJet*> product_type::*m_genTauJetMatchedObjects; //changed to KGenParticle from const KDataLV
+	FlatMap<TValidObject*, KGenJet*> product_type::*m_genTauJetMatchedObjects; //changed to KGenParticle from const KDataLV
 	std::vector<TValidObject*> product_type::*m_validObjects;
 	std::vector<TValidObject*> product_type::*m_invalidObjects;
 	TauDecayMode tauDecayMode;
@@ -115,6 +113,10 @@ private:
 	bool (setting_type::*GetInvalidateNonGenTauJetMatchingObjects)(void) const;
 	bool (setting_type::*GetInvalidateGenTauJetMatchingObjects)(void) const;
 	
+	mutable EtaPhiArrays m_objectCoordinates;
+	mutable EtaPhiArrays m_genTauJetCoordinates;
+	mutable DeltaRMatcher m_matcher;
+	
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndex;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltName;
 
@@ -5,6 +5,7 @@
 
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/DeltaRMatching.h"
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 
@@ -31,7 +32,7 @@ public:
 	typedef typename KappaTypes::product_type product_type;
 	typedef typename KappaTypes::setting_type setting_type;
 	
-	GenTauMatchingProducerBase(std::map<TValidObject*, KGenTau*> product_type::*genTauMatchedObjects, //changed to KGenParticle from const KDataLV
+	GenTauMatchingProducerBase(FlatMap<TValidObject*, KGenTau*> product_type::*genTauMatchedObjects, //changed to KGenParticle from const KDataLV
 	                           std::vector<TValidObject>* event_type::*objects,
 	                           std::vector<TValidObject*> product_type::*validObjects,
 	                           std::vector<TValidObject*> product_type::*invalidObjects,
@@ -100,47 +101,47 @@ public:
 					++objectIndex;
 				}
 			}
+			// if configured: only use genTaus that will decay into comparable particles
+			m_selectedGenTaus.clear();
+			m_genTauCoordinates.Clear();
+			for (typename std::vector<KGenTau>::iterator genTau = event.m_genTaus->begin();
+				genTau != event.m_genTaus->end(); ++genTau)
+			{
+				if (!(settings.*GetMatchGenTauDecayMode)() || MatchDecayMode(*genTau, tauDecayMode))
+				{
+					m_selectedGenTaus.push_back(&(*genTau));
+					m_genTauCoordinates.Add(genTau->visible.p4.Eta(), genTau->visible.p4.Phi());
+				}
+			}
+			
+			// match every object to the nearest visible genTau
+			m_objectCoordinates.Clear();
+			m_objectCoordinates.AddObjects(objects);
+			m_matcher.Compute(m_objectCoordinates, m_genTauCoordinates);
+			std::vector<int> const& matches = m_matcher.Match(DeltaRMatcher::Strategy::GREEDY_NEAREST,
+			                                                  (settings.*GetDeltaRMatchingRecoObjectGenTau)());
+			
 			// loop over all chosen objects to check
-			for (typename std::vector<TValidObject*>::iterator object = objects.begin();
-				 object != objects.end();)
+			product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
+			for (size_t objectIndex = 0; objectIndex < objects.size(); ++objectIndex)
 			{
-				bool objectMatched = false;
-				float deltaR = 0;
-				float deltaRmin = std::numeric_limits<float>::max();
-				
-				// loop over all genTaus
-				for (typename std::vector<KGenTau>::iterator genTau = event.m_genTaus->begin(); 
-					genTau != event.m_genTaus->end(); ++genTau) 
+				TValidObject* object = objects[objectIndex];
+				bool objectMatched = (matches[objectIndex] != DeltaRMatcher::NoMatch);
+				if (objectMatched)
 				{
-					// if configured: only use genTaus that will decay into comparable particles
-					if (!(settings.*GetMatchGenTauDecayMode)() || ((settings.*GetMatchGenTauDecayMode)() && MatchDecayMode(*genTau, tauDecayMode)))
-					{
-						deltaR = static_cast<float>(ROOT::Math::VectorUtil::DeltaR((*object)->p4, genTau->visible.p4));
-						if(deltaR<(settings.*GetDeltaRMatchingRecoObjectGenTau)() && deltaR<deltaRmin)
-						{
-							(product.*m_genTauMatchedObjects)[*object] = &(*genTau);
-							product.m_genTauMatchedLeptons[*object] = &(*genTau);
-							ratioGenTauMatched += 1.0 / objects.size();
-							product.m_genTauMatchDeltaR = deltaR;
-							deltaRmin = deltaR;
-							objectMatched = true;
-							//LOG(INFO) << this->GetProducerId() << " (event " << event.m_eventInfo->nEvent << "): " << (*object)->p4 << " --> " << genTau->visible.p4;
-						}
-						else product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
-					}
-					else product.m_genTauMatchDeltaR = DefaultValues::UndefinedFloat;
+					KGenTau* genTau = m_selectedGenTaus[matches[objectIndex]];
+					(product.*m_genTauMatchedObjects)[object] = genTau;
+					product.m_genTauMatchedLeptons[object] = genTau;
+					ratioGenTauMatched += 1.0 / objects.size();
+					product.m_genTauMatchDeltaR = std::sqrt(m_matcher.GetDeltaR2(objectIndex, matches[objectIndex]));
 				}
 				// invalidate the object if it has not matched
 				if (!(settings.*GetMatchAllObjectsGenTau)() &&
 					(((! objectMatched) && (settings.*GetInvalidateNonGenTauMatchingObjects)()) ||
 					(objectMatched && (settings.*GetInvalidateGenTauMatchingObjects)())))
 				{
-					(product.*m_invalidObjects).push_back(*object);
-					object = (product.*m_validObjects).erase(object);
-				}
-				else
-				{
-					++object;
+					(product.*m_invalidObjects).push_back(object);
+					(product.*m_validObjects).erase(std::find((product.*m_validObjects).begin(), (product.*m_validObjects).end(), object));
 				}
 			}
 			// preserve sorting of invalid objects
@@ -167,7 +168,7 @@ public:
 	}
 	
 private:
-	std::map<TValidObject*, KGenTau*> product_type::*m_genTauMatchedObjects; //changed to KGenParticle from const KDataLV
+	FlatMap<TValidObject*, KGenTau*> product_type::*m_genTauMatchedObjects; //changed to KGenParticle from const KDataLV
 	std::vector<TValidObject>* event_type::*m_objects;
 	std::vector<TValidObject*> product_type::*m_validObjects;
 	std::vector<TValidObject*> product_type::*m_invalidObjects;
@@ -177,6 +178,11 @@ private:
 	bool (setting_type::*GetInvalidateGenTauMatchingObjects)(void) const;
 	bool (setting_type::*GetMatchAllObjectsGenTau)(void) const;
 	bool (setting_type::*GetMatchGenTauDecayMode)(void) const;
+	
+	mutable std::vector<KGenTau*> m_selectedGenTaus;
+	mutable EtaPhiArrays m_genTauCoordinates;
+	mutable EtaPhiArrays m_objectCoordinates;
+	mutable DeltaRMatcher m_matcher;
 };
 
 
@@ -7,8 +7,13 @@ public:
 
 	std::string GetProducerId() const override;
 
+	void Init(KappaSettings const& settings) override;
+
 	void Produce(KappaEvent const& event,
 			KappaProduct& product,
 			KappaSettings const& settings) const override;
 
+private:
+	size_t m_weightSlot = EventWeights::NotRegistered;
+
 };
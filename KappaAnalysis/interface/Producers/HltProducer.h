@@ -10,9 +10,12 @@
 #include "Artus/Utility/interface/DefaultValues.h"
 
 
-/** 
+/** Producer selecting the fired (and unprescaled if requested) HLT paths
  *
- *	
+ *	The configured paths are resolved to their positions in KLumiInfo::hltNames and to their
+ *	prescales once per lumi section. Per event, only the trigger bits of these positions are tested.
+ *	The selection is stored in KappaProduct::m_selectedHltBits and m_selectedHltPositions,
+ *	the names can be obtained via KappaProduct::GetSelectedHltNames, which builds them on the first request.
  */
 class HltProducer : public KappaProducerBase {
 public:
@@ -20,11 +23,30 @@ public:
 
     void Init(KappaSettings const &settings) override;
 
+    void OnLumi(KappaEvent const &event, KappaSettings const &settings) override;
+
     void Produce(KappaEvent const &event, KappaProduct &product,
                  KappaSettings const &settings) const override;
 
 private:
+    struct ResolvedHltPath {
+        size_t position;
+        int prescale;
+    };
+
+    void ResolveHltPaths(KappaEvent const &event, std::vector<std::string> const &hltPaths,
+                         bool hltPathsFromSettings) const;
+
     mutable HLTTools m_hltInfo;
+    size_t m_weightSlot = EventWeights::NotRegistered;
 
-};
+    // state of the current lumi section
+    mutable std::vector<ResolvedHltPath> m_resolvedHltPaths;
+    mutable uint64_t m_resolvedRun = 0;
+    mutable uint64_t m_resolvedLumi = 0;
+    mutable bool m_hltPathsResolved = false;
+    mutable bool m_hltPathsResolvedFromSettings = false;
+    mutable int m_lowestPrescale = std::numeric_limits<int>::max();
+    mutable size_t m_lowestPrescalePosition = 0;
 
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <memory>
+
+#include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+#include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
+#include "Artus/KappaAnalysis/interface/Utility/JetCorrectionEngine.h"
+#include "Artus/Utility/interface/DefaultValues.h"
+
+/**
+   \brief Producer for the jet energy uncertainties of all split uncertainty sources
+
+   Loads all sources once and fills product::m_jetEnergyUncertaintyMatrix (m_taggedJetEnergyUncertaintyMatrix
+   for the tagged jets) with the up and down uncertainties of all corrected jets, such that the shifts of all sources can be evaluated in one pipeline
+   (instead of one pipeline per source with JetEnergyCorrectionUncertaintySource).
+   Needs to run after the JetCorrectionsProducer. The matrix is addressed by the pointers to the
+   corrected jets and can therefore be used for the valid jets as well.
+
+   Required config tags:
+   - JetEnergyCorrectionSplitUncertaintyParameters (file containing the uncertainty sources)
+   - JetEnergyCorrectionSplitUncertaintyParameterNames (names of the sources in the file)
+
+   Provides the quantities leadingJetPt_<source>Up/Down and trailingJetPt_<source>Up/Down for the valid jets.
+*/
+template<class TJet>
+class JetCorrectionUncertaintyMatrixProducerBase: public KappaProducerBase
+{
+
+public:
+
+	JetCorrectionUncertaintyMatrixProducerBase(std::vector<TJet*> KappaProduct::*correctedJets,
+	                                           JetEnergyUncertaintyMatrix KappaProduct::*uncertaintyMatrix) :
+		KappaProducerBase(),
+		m_correctedJetsMember(correctedJets),
+		m_uncertaintyMatrixMember(uncertaintyMatrix)
+	{
+	}
+
+	void Init(KappaSettings const& settings) override
+	{
+		KappaProducerBase::Init(settings);
+
+		m_sources = settings.GetJetEnergyCorrectionSplitUncertaintyParameterNames();
+		LOG(DEBUG) << "\tLoading " << m_sources.size() << " jet energy correction uncertainty sources from "
+		           << settings.GetJetEnergyCorrectionSplitUncertaintyParameters() << "...";
+		for (std::vector<std::string>::const_iterator source = m_sources.begin(); source != m_sources.end(); ++source)
+		{
+			JetCorrectorParameters parameters(settings.GetJetEnergyCorrectionSplitUncertaintyParameters(), *source);
+			if ((! parameters.isValid()) || (parameters.size() == 0))
+			{
+				LOG(FATAL) << "Invalid definition " << *source << " in file " << settings.GetJetEnergyCorrectionSplitUncertaintyParameters();
+			}
+			m_uncertaintyTables.push_back(std::unique_ptr<JetCorrectionUncertaintyTable>(new JetCorrectionUncertaintyTable(parameters)));
+		}
+
+		// add possible quantities for the lambda ntuples consumers
+		// the valid jets are either untagged or tagged jets, the matrix containing them is used
+		for (size_t sourceIndex = 0; sourceIndex < m_sources.size(); ++sourceIndex)
+		{
+			for (float shift : { 1.0f, -1.0f })
+			{
+				std::string shiftName = m_sources[sourceIndex] + ((shift > 0.0f) ? "Up" : "Down");
+				for (size_t jetIndex : { 0, 1 })
+				{
+					std::string quantity = std::string((jetIndex == 0) ? "leadingJetPt_" : "trailingJetPt_") + shiftName;
+					LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity(quantity, [sourceIndex, shift, jetIndex](KappaEvent const& event, KappaProduct const& product) -> float
+					{
+						if (product.m_validJets.size() <= jetIndex)
+						{
+							return DefaultValues::UndefinedFloat;
+						}
+						KBasicJet const* jet = product.m_validJets[jetIndex];
+						JetEnergyUncertaintyMatrix const& matrix = (product.m_jetEnergyUncertaintyMatrix.HasJet(jet) ?
+						                                            product.m_jetEnergyUncertaintyMatrix :
+						                                            product.m_taggedJetEnergyUncertaintyMatrix);
+						return matrix.GetShiftedP4(jet, sourceIndex, shift).Pt();
+					});
+				}
+			}
+		}
+	}
+
+	void Produce(KappaEvent const& event, KappaProduct& product,
+	             KappaSettings const& settings) const override
+	{
+		std::vector<TJet*> const& correctedJets = product.*m_correctedJetsMember;
+		JetEnergyUncertaintyMatrix& uncertaintyMatrix = product.*m_uncertaintyMatrixMember;
+
+		m_jetCorrectionInputs.Clear();
+		uncertaintyMatrix.Reset(&m_sources, correctedJets.size());
+		for (typename std::vector<TJet*>::const_iterator jet = correctedJets.begin(); jet != correctedJets.end(); ++jet)
+		{
+			m_jetCorrectionInputs.AddJet(**jet);
+			uncertaintyMatrix.AddJet(*jet);
+		}
+
+		// one pass over all jets per source, filling one column of the matrix
+		for (size_t sourceIndex = 0; sourceIndex < m_uncertaintyTables.size(); ++sourceIndex)
+		{
+			m_uncertaintyTables[sourceIndex]->GetUncertainties(m_jetCorrectionInputs,
+			                                                   uncertaintyMatrix.GetUncertaintiesUp(sourceIndex),
+			                                                   uncertaintyMatrix.GetUncertaintiesDown(sourceIndex),
+			                                                   m_sources.size());
+		}
+	}
+
+
+private:
+	std::vector<TJet*> KappaProduct::*m_correctedJetsMember;
+	JetEnergyUncertaintyMatrix KappaProduct::*m_uncertaintyMatrixMember;
+
+	std::vector<std::string> m_sources;
+	std::vector<std::unique_ptr<JetCorrectionUncertaintyTable> > m_uncertaintyTables;
+
+	// buffer reused for all events
+	mutable JetCorrectionInputs m_jetCorrectionInputs;
+};
+
+
+
+/**
+   \brief Producer for the jet energy uncertainty matrix
+
+   Operates on the vector product::m_correctedJets and fills product::m_jetEnergyUncertaintyMatrix.
+*/
+class JetCorrectionUncertaintyMatrixProducer: public JetCorrectionUncertaintyMatrixProducerBase<KBasicJet>
+{
+public:
+	JetCorrectionUncertaintyMatrixProducer();
+
+	std::string GetProducerId() const override;
+};
+
+
+
+/**
+   \brief Producer for the jet energy uncertainty matrix
+
+   Operates on the vector product::m_correctedTaggedJets and fills product::m_taggedJetEnergyUncertaintyMatrix.
+*/
+class TaggedJetCorrectionUncertaintyMatrixProducer: public JetCorrectionUncertaintyMatrixProducerBase<KJet>
+{
+public:
+	TaggedJetCorrectionUncertaintyMatrixProducer();
+
+	std::string GetProducerId() const override;
+};
+
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -17,6 +18,7 @@
 #include "KappaTools/RootTools/interface/JECTools.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/JetCorrectionEngine.h"
 #include "Artus/Utility/interface/Utility.h"
 
 /**
@@ -31,6 +33,9 @@
    Required packages (unfortunately, nobody knows a tag):
    git cms-addpkg CondFormats/JetMETObjects
    
+   The corrections are evaluated by the JetCorrectionEngine for all jets of an event at once. The
+   FactorizedJetCorrector (via KappaTools) is only used for correction levels not supported by the engine.
+
    Documentation:
    https://twiki.cern.ch/twiki/bin/view/CMSPublic/WorkBookJetEnergyCorrections#JetEnCorFWLite
 
@@ -46,7 +51,7 @@ class JetCorrectionsProducerBase: public KappaProducerBase
 public:
 	
 	JetCorrectionsProducerBase(std::vector<TJet>* KappaEvent::*jets,
-	                           std::vector<std::shared_ptr<TJet> > KappaProduct::*correctedJets) :
+	                           std::vector<TJet*> KappaProduct::*correctedJets) :
 		KappaProducerBase(),
 		m_basicJetsMember(jets),
 		m_correctedJetsMember(correctedJets)
@@ -73,7 +78,18 @@ public:
 		}
 		if (jecParameters.size() > 0)
 		{
-			factorizedJetCorrector = new FactorizedJetCorrector(jecParameters);
+			jetCorrectionEngine.reset(new JetCorrectionEngine(jecParameters));
+			if (! jetCorrectionEngine->IsSupported())
+			{
+				LOG(WARNING) << "\tFalling back to the FactorizedJetCorrector for the jet energy corrections.";
+				jetCorrectionEngine.reset();
+				factorizedJetCorrector = new FactorizedJetCorrector(jecParameters);
+			}
+		}
+		else
+		{
+			// no corrections, only the uncertainty shift is applied
+			jetCorrectionEngine.reset(new JetCorrectionEngine(jecParameters));
 		}
 		
 		// initialise uncertainty calculation
@@ -107,48 +123,63 @@ public:
 		assert(event.m_pileupDensity);
 		assert(event.m_vertexSummary);
 		
-		// create a copy of all jets in the event (first temporarily for the JEC)
-		(product.*m_correctedJetsMember).clear();
-		std::vector<TJet> correctJetsForJecTools((event.*m_basicJetsMember)->size());
-		size_t jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = (event.*m_basicJetsMember)->begin();
-			 jet != (event.*m_basicJetsMember)->end(); ++jet)
-		{
-			correctJetsForJecTools[jetIndex] = *jet;
-			++jetIndex;
-		}
+		std::vector<TJet> const& jets = *(event.*m_basicJetsMember);
+		std::vector<TJet*>& correctedJets = product.*m_correctedJetsMember;
+		correctedJets.resize(jets.size());
 		
-		// apply jet energy corrections and uncertainty shift (if uncertainties are not to be splitted into individual contributions)
+		// uncertainty shift (if uncertainties are not to be splitted into individual contributions)
 		float shift = settings.GetJetEnergyCorrectionSplitUncertainty() ? 0.0 : settings.GetJetEnergyCorrectionUncertaintyShift();
-		correctJets(&correctJetsForJecTools, factorizedJetCorrector, jetCorrectionUncertainty,
-		            event.m_pileupDensity->rho, event.m_vertexSummary->nVertices, -1,
-		            shift);
 		
-		// create the shared pointers to store in the product
-		(product.*m_correctedJetsMember).clear();
-		(product.*m_correctedJetsMember).resize(correctJetsForJecTools.size());
-		jetIndex = 0;
-		for (typename std::vector<TJet>::const_iterator jet = correctJetsForJecTools.begin();
-			 jet != correctJetsForJecTools.end(); ++jet)
+		if (jetCorrectionEngine)
 		{
-			(product.*m_correctedJetsMember)[jetIndex] = std::shared_ptr<TJet>(new TJet(*jet));
-			product.m_originalJets[(product.*m_correctedJetsMember)[jetIndex].get()] = &(*jet);
-			++jetIndex;
+			// evaluate the jet energy corrections for all jets at once
+			m_jetCorrectionInputs.Clear();
+			m_jetCorrectionInputs.rho = event.m_pileupDensity->rho;
+			m_jetCorrectionInputs.nVertices = event.m_vertexSummary->nVertices;
+			for (typename std::vector<TJet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet)
+			{
+				m_jetCorrectionInputs.AddJet(*jet);
+			}
+			jetCorrectionEngine->GetCorrections(m_jetCorrectionInputs, m_jetCorrections);
+			
+			// the corrections are applied to the copies in the product
+			for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
+			{
+				TJet* correctedJet = product.CreateEventObject<TJet>(jets[jetIndex]);
+				correctedJet->p4 *= m_jetCorrections[jetIndex];
+				if ((jetCorrectionUncertainty != nullptr) && (shift != 0.0))
+				{
+					jetCorrectionUncertainty->setJetEta(correctedJet->p4.Eta());
+					jetCorrectionUncertainty->setJetPt(correctedJet->p4.Pt());
+					correctedJet->p4 *= (1.0 + shift * jetCorrectionUncertainty->getUncertainty(shift > 0.0));
+				}
+				correctedJets[jetIndex] = correctedJet;
+			}
 		}
-		
-		// perform corrections on copied jets
-		for (typename std::vector<std::shared_ptr<TJet> >::iterator jet = (product.*m_correctedJetsMember).begin();
-			 jet != (product.*m_correctedJetsMember).end(); ++jet)
+		else
 		{
-			// No general correction available
+			// apply the corrections with KappaTools on a temporary copy of the jets
+			m_jetsForJecTools.assign(jets.begin(), jets.end());
+			correctJets(&m_jetsForJecTools, factorizedJetCorrector, jetCorrectionUncertainty,
+			            event.m_pileupDensity->rho, event.m_vertexSummary->nVertices, -1,
+			            shift);
+			for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
+			{
+				correctedJets[jetIndex] = product.CreateEventObject<TJet>(m_jetsForJecTools[jetIndex]);
+			}
+		}
 		
+		for (size_t jetIndex = 0; jetIndex < jets.size(); ++jetIndex)
+		{
+			product.m_originalJets[correctedJets[jetIndex]] = &(jets[jetIndex]);
+			
 			// perform possible analysis-specific corrections
-			AdditionalCorrections(jet->get(), event, product, settings);
+			AdditionalCorrections(correctedJets[jetIndex], event, product, settings);
 		}
 		
 		// sort vectors of corrected jets by pt
-		std::sort((product.*m_correctedJetsMember).begin(), (product.*m_correctedJetsMember).end(),
-		          [](std::shared_ptr<TJet> jet1, std::shared_ptr<TJet> jet2) -> bool
+		std::sort(correctedJets.begin(), correctedJets.end(),
+		          [](TJet* jet1, TJet* jet2) -> bool
 		          { return jet1->p4.Pt() > jet2->p4.Pt(); });
 	}
 
@@ -163,10 +194,16 @@ protected:
 
 private:
 	std::vector<TJet>* KappaEvent::*m_basicJetsMember;
-	std::vector<std::shared_ptr<TJet> > KappaProduct::*m_correctedJetsMember;
+	std::vector<TJet*> KappaProduct::*m_correctedJetsMember;
 
+	std::unique_ptr<JetCorrectionEngine> jetCorrectionEngine;
 	FactorizedJetCorrector* factorizedJetCorrector = nullptr;
 	JetCorrectionUncertainty* jetCorrectionUncertainty = nullptr;
+
+	// buffers reused for all events
+	mutable JetCorrectionInputs m_jetCorrectionInputs;
+	mutable std::vector<double> m_jetCorrections;
+	mutable std::vector<TJet> m_jetsForJecTools;
 };
 
 
@@ -2,13 +2,31 @@
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
+/**
+   \brief LuminosityWeightProducer
+   Config tags:
+   - IntLuminosity
+
+   The weight 1/IntLuminosity is constant and computed once per run.
+*/
+
 class LuminosityWeightProducer : public KappaProducerBase {
 public:
 
 	std::string GetProducerId() const override;
 
+	void Init(KappaSettings const& settings) override;
+
+	void OnRun(KappaEvent const& event, KappaSettings const& settings) override;
+
 	void Produce(KappaEvent const& event,
 			KappaProduct& product,
 			KappaSettings const& settings) const override;
 
+private:
+	void UpdateWeight(KappaSettings const& settings);
+
+	size_t m_weightSlot = EventWeights::NotRegistered;
+	double m_weight = 1.0;
+
 };
@@ -6,7 +6,6 @@
 
 #include "Artus/Utility/interface/RoccoR.h"
 #include "Artus/Utility/interface/rochcor2015.h"
-#include "TRandom3.h"
 
 #include <memory>  // Hinzufügen für Smart Pointers
 
@@ -49,5 +48,4 @@ private:
     MuonEnergyCorrection muonEnergyCorrection = MuonEnergyCorrection::NONE;
     std::unique_ptr<rochcor2015> rmcor2015 = nullptr;
     std::unique_ptr<RoccoR> rmcor = nullptr;
-    std::unique_ptr<TRandom3> random = nullptr;
 };
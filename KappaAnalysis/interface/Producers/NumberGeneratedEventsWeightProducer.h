@@ -7,6 +7,7 @@
    Config tags:
    - NumberGeneratedEvents, e.g. "1234"
 
+   The weight 1/NumberGeneratedEvents is constant and computed once per run.
 */
 
 class NumberGeneratedEventsWeightProducer : public KappaProducerBase {
@@ -14,8 +15,18 @@ public:
 
 	std::string GetProducerId() const override;
 
+	void Init(KappaSettings const& settings) override;
+
+	void OnRun(KappaEvent const& event, KappaSettings const& settings) override;
+
 	void Produce(KappaEvent const& event,
 	                     KappaProduct & product,
 	                     KappaSettings const& settings) const override;
 
+private:
+	void UpdateWeight(KappaSettings const& settings);
+
+	size_t m_weightSlot = EventWeights::NotRegistered;
+	double m_weight = 1.0;
+
 };
@@ -7,6 +7,10 @@
 /**
    \brief Producer, that devides packedPFCandidates according to pddId. Source :
    https://twiki.cern.ch/twiki/bin/view/CMSPublic/WorkBookMiniAOD2016
+
+   All candidates are transposed into product.m_pfCandidates (PFCandidateStore), whose eta-phi grid covers the
+   PFIsolationConeSizes and deltaRTolleranceForPF. The pointer collections per type are filled in addition
+   if FillPFCandidateCollections is true.
 */
 
 class PFCandidatesProducer : public KappaProducerBase
@@ -17,5 +21,30 @@ class PFCandidatesProducer : public KappaProducerBase
 		std::string GetProducerId() const override { return "PFCandidatesProducer"; };
 		void Produce(KappaEvent const& event, KappaProduct& product, KappaSettings const& settings) const override;
 	private:
-		void fill_pfCandidate(std::vector<const KPFCandidate*>&, std::vector<const KPFCandidate*>&, std::vector<const KPFCandidate*>&, const KPFCandidate*) const;
+		void fill_pfCandidate(std::vector<const KPFCandidate*>&, std::vector<const KPFCandidate*>&, std::vector<const KPFCandidate*>&, const KPFCandidate*, bool) const;
+
+		float m_gridCellSize = 0.0f;
+};
+
+
+/**
+   \brief Producer for the PF isolation sums of the valid leptons in all PFIsolationConeSizes.
+
+   Needs to run after the PFCandidatesProducer and the ValidLeptonsProducer. The charged (from the first PV),
+   neutral, photon and pile-up sums are computed in one pass over the PF candidates near each lepton
+   (see PFIsolationEngine) and stored in product.m_validLeptonsPFIsolation.
+   Veto cones and pt thresholds: PFIsolation[Charged|Neutral|Photon|PileUp]VetoCone, PFIsolation[Neutral|Photon|PileUp]MinPt
+*/
+class ValidLeptonsPFIsolationProducer : public KappaProducerBase
+{
+	public:
+
+		void Init(KappaSettings const& settings) override;
+		std::string GetProducerId() const override { return "ValidLeptonsPFIsolationProducer"; };
+		void Produce(KappaEvent const& event, KappaProduct& product, KappaSettings const& settings) const override;
+	private:
+		PFIsolationEngine m_isolationEngine;
+
+		mutable std::vector<float> m_leptonEtas;
+		mutable std::vector<float> m_leptonPhis;
 };
@@ -31,6 +31,7 @@ public:
 private:
 		std::vector<double> m_pileupWeights;
 		double m_bins;
+		size_t m_weightSlot = EventWeights::NotRegistered;
 
 };
 
@@ -11,6 +11,8 @@
    Config tags:
    - Fill me with something meaningful
 
+   The stitching weights are divided by the crossSectionPerEventWeight and numberGeneratedEventsWeight of the product.
+   The CrossSectionWeightProducer and NumberGeneratedEventsWeightProducer need to run before.
 */
 
 class SampleStitchingWeightProducer : public KappaProducerBase {
@@ -31,4 +33,8 @@ private:
 	std::map<std::string, std::vector<double> > stitchingWeightsByName;
 	std::map<std::string, std::vector<double> > stitchingWeightsHighMassByName;
 
+	size_t m_weightSlot = EventWeights::NotRegistered;
+	size_t m_crossSectionWeightSlot = EventWeights::NotRegistered;
+	size_t m_numberGeneratedEventsWeightSlot = EventWeights::NotRegistered;
+
 };
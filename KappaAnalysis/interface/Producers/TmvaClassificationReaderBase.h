@@ -1,19 +1,29 @@
 
 #pragma once
 
+#include <cmath>
+#include <memory>
+
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 
+#include <TMVA/MethodBase.h>
 #include <TMVA/Reader.h>
 
 #include "Artus/Core/interface/ProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/Utility/interface/TmvaBdtEvaluator.h"
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 
 
 /**
    \brief Abstract producer base for reading/applying TMVA classifications.
+   
+   The methods are booked in Init and evaluated via their handles, the input variables are read by the
+   TMVA::Reader from a buffer that is filled in every event.
+   Optionally, BDT methods are evaluated by the TmvaBdtEvaluator instead of TMVA. The outputs of the first
+   evaluations are compared to TMVA, in case of differences the method is evaluated by TMVA again.
 */
 template<class TTypes>
 class TmvaClassificationReaderBase: public ProducerBase<TTypes>
@@ -35,11 +45,13 @@ public:
 	TmvaClassificationReaderBase(std::vector<std::string>& (setting_type::*GetTmvaInputQuantities)(void) const,
 								 std::vector<std::string>& (setting_type::*GetTmvaMethods)(void) const,
 								 std::vector<std::string>& (setting_type::*GetTmvaWeights)(void) const,
-								 std::vector<double> product_type::*mvaOutputs) :
+								 std::vector<double> product_type::*mvaOutputs,
+								 bool const& (setting_type::*GetTmvaNativeBdtEvaluation)(void) const = nullptr) :
 		ProducerBase<TTypes>(),
 		GetTmvaInputQuantities(GetTmvaInputQuantities),
 		GetTmvaMethods(GetTmvaMethods),
 		GetTmvaWeights(GetTmvaWeights),
+		GetTmvaNativeBdtEvaluation(GetTmvaNativeBdtEvaluation),
 		m_mvaOutputsMember(mvaOutputs)
 	{
 	}
@@ -73,44 +85,96 @@ public:
 			}
 		}
 		
-		// register TMVA input variables
+		// register TMVA input variables, the reader reads them from the input buffer
+		m_tmvaInputs.assign(m_inputExtractors.size(), 0.0f);
+		size_t inputQuantityIndex = 0;
 		for (std::vector<std::string>::const_iterator quantity = (settings.*GetTmvaInputQuantities)().begin();
 			 quantity != (settings.*GetTmvaInputQuantities)().end(); ++quantity)
 		{
-			tmvaReader.AddVariable(*quantity, static_cast<float*>(nullptr));
+			tmvaReader.AddVariable(*quantity, &(m_tmvaInputs[inputQuantityIndex]));
+			++inputQuantityIndex;
 		}
 		
 		// loading TMVA weight files
 		assert((settings.*GetTmvaMethods)().size() == (settings.*GetTmvaWeights)().size());
+		bool useNativeBdtEvaluation = ((GetTmvaNativeBdtEvaluation != nullptr) && (settings.*GetTmvaNativeBdtEvaluation)());
+		m_tmvaMethods.clear();
+		m_bdtEvaluators.clear();
+		m_nValidatedEvaluations.clear();
 		LOG(INFO) << "\tLoading TMVA weight files...";
 		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
 		{
 			std::string tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex]+ boost::lexical_cast<std::string>(mvaMethodIndex);
 			std::string tmvaWeights = (settings.*GetTmvaWeights)()[mvaMethodIndex];
 			LOG(INFO) << "\t\tmethod: " << tmvaMethod << ", weight file: " << tmvaWeights;
-			tmvaReader.BookMVA(tmvaMethod, tmvaWeights);
+			TMVA::MethodBase* method = dynamic_cast<TMVA::MethodBase*>(tmvaReader.BookMVA(tmvaMethod, tmvaWeights));
+			if (method == nullptr)
+			{
+				LOG(FATAL) << "Could not book TMVA method " << tmvaMethod << " from " << tmvaWeights << "!";
+			}
+			m_tmvaMethods.push_back(method);
+			
+			std::unique_ptr<TmvaBdtEvaluator> bdtEvaluator;
+			if (useNativeBdtEvaluation)
+			{
+				bdtEvaluator.reset(new TmvaBdtEvaluator(tmvaWeights));
+				if (! bdtEvaluator->IsSupported())
+				{
+					LOG(INFO) << "\t\t\tnative BDT evaluation not possible (" << bdtEvaluator->GetReason() << "), use TMVA.";
+					bdtEvaluator.reset();
+				}
+				else if (bdtEvaluator->GetNVariables() != m_tmvaInputs.size())
+				{
+					LOG(FATAL) << "The weight file " << tmvaWeights << " expects " << bdtEvaluator->GetNVariables()
+					           << " input variables, but " << m_tmvaInputs.size() << " are configured!";
+				}
+				else
+				{
+					LOG(INFO) << "\t\t\tnative BDT evaluation of " << bdtEvaluator->GetNTrees() << " trees.";
+				}
+			}
+			m_bdtEvaluators.push_back(std::move(bdtEvaluator));
+			m_nValidatedEvaluations.push_back(0);
 		}
 	}
 
 	void Produce(event_type const& event, product_type& product,
 						 setting_type const& settings) const override
 	{
-		// construct and fill input vector
-		std::vector<double> tmvaInputs(m_inputExtractors.size());
-		size_t inputQuantityIndex = 0;
-		for(typename std::vector<float_extractor_lambda>::const_iterator inputExtractor = m_inputExtractors.begin();
-			inputExtractor != m_inputExtractors.end(); ++inputExtractor)
+		// fill input buffer
+		for (size_t inputQuantityIndex = 0; inputQuantityIndex < m_inputExtractors.size(); ++inputQuantityIndex)
 		{
-			tmvaInputs[inputQuantityIndex] = (*inputExtractor)(event, product);
-			++inputQuantityIndex;
+			m_tmvaInputs[inputQuantityIndex] = m_inputExtractors[inputQuantityIndex](event, product);
 		}
 		
 		// retrieve MVA outputs
-		(product.*m_mvaOutputsMember) = std::vector<double>((settings.*GetTmvaMethods)().size());
-		for (size_t mvaMethodIndex = 0; mvaMethodIndex < (settings.*GetTmvaMethods)().size(); ++mvaMethodIndex)
+		std::vector<double>& mvaOutputs = (product.*m_mvaOutputsMember);
+		mvaOutputs.resize(m_tmvaMethods.size());
+		for (size_t mvaMethodIndex = 0; mvaMethodIndex < m_tmvaMethods.size(); ++mvaMethodIndex)
 		{
-			std::string tmvaMethod = (settings.*GetTmvaMethods)()[mvaMethodIndex]+ boost::lexical_cast<std::string>(mvaMethodIndex);
-			(product.*m_mvaOutputsMember)[mvaMethodIndex] = tmvaReader.EvaluateMVA(tmvaInputs, tmvaMethod.c_str());
+			TmvaBdtEvaluator const* bdtEvaluator = m_bdtEvaluators[mvaMethodIndex].get();
+			if (bdtEvaluator == nullptr)
+			{
+				mvaOutputs[mvaMethodIndex] = tmvaReader.EvaluateMVA(m_tmvaMethods[mvaMethodIndex]);
+			}
+			else
+			{
+				mvaOutputs[mvaMethodIndex] = bdtEvaluator->Evaluate(m_tmvaInputs.data());
+				
+				// compare to TMVA for the first evaluations and switch back to TMVA in case of differences
+				if (m_nValidatedEvaluations[mvaMethodIndex] < m_nValidationEvaluations)
+				{
+					++m_nValidatedEvaluations[mvaMethodIndex];
+					double tmvaOutput = tmvaReader.EvaluateMVA(m_tmvaMethods[mvaMethodIndex]);
+					if (std::abs(mvaOutputs[mvaMethodIndex] - tmvaOutput) > (1e-6 * std::max(1.0, std::abs(tmvaOutput))))
+					{
+						LOG(WARNING) << "Native BDT evaluation of " << m_tmvaMethods[mvaMethodIndex]->GetMethodName().Data()
+						             << " differs from TMVA (" << mvaOutputs[mvaMethodIndex] << " vs. " << tmvaOutput << "), use TMVA.";
+						m_bdtEvaluators[mvaMethodIndex].reset();
+						mvaOutputs[mvaMethodIndex] = tmvaOutput;
+					}
+				}
+			}
 		}
 	}
 
@@ -119,10 +183,19 @@ private:
 	std::vector<std::string>& (setting_type::*GetTmvaInputQuantities)(void) const;
 	std::vector<std::string>& (setting_type::*GetTmvaMethods)(void) const;
 	std::vector<std::string>& (setting_type::*GetTmvaWeights)(void) const;
+	bool const& (setting_type::*GetTmvaNativeBdtEvaluation)(void) const;
 	std::vector<double> product_type::*m_mvaOutputsMember;
 	
 	std::vector<float_extractor_lambda> m_inputExtractors;
 	mutable TMVA::Reader tmvaReader;
+	
+	// the reader holds pointers to the elements of the input buffer, it must not be resized after Init
+	mutable std::vector<float> m_tmvaInputs;
+	std::vector<TMVA::MethodBase*> m_tmvaMethods;
+	
+	static const size_t m_nValidationEvaluations = 100;
+	mutable std::vector<std::unique_ptr<TmvaBdtEvaluator> > m_bdtEvaluators;
+	mutable std::vector<size_t> m_nValidatedEvaluations;
 
 };
 
@@ -134,6 +207,9 @@ private:
    - TmvaInputQuantities
    - TmvaMethods
    - TmvaWeights (same length as for TmvaMethods required)
+   
+   Optional config tags:
+   - TmvaNativeBdtEvaluation (default: false)
 */
 class GeneralTmvaClassificationReader: public TmvaClassificationReaderBase<KappaTypes>
 {
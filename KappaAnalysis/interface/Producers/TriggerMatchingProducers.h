@@ -4,6 +4,9 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerPatternCache.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerMatchingResult.h"
+#include "Artus/Utility/interface/EtaPhiGrid.h"
 
 #include <boost/regex.hpp>
 
@@ -12,6 +15,11 @@
 /** Abstract Producer class for trigger matching valid objects
  *
  *	Needs to run after the valid object producers.
+ *
+ *	The trigger objects of a filter are put into an eta-phi grid once per event, such that every
+ *	valid object is only compared to the trigger objects in the neighbouring cells. The result is
+ *	stored in a flat TriggerMatchingResult. The nested maps m_detailedTriggerMatched... are only
+ *	filled from it if FillDetailedTriggerMatchingMaps is true.
  */
 template<class TValidObject>
 class TriggerMatchingProducerBase: public KappaProducerBase
@@ -45,8 +53,9 @@ public:
 		return hltNames;
 	}
 	
-	TriggerMatchingProducerBase(std::map<TValidObject*, KLV*> KappaProduct::*triggerMatchedObjects,
+	TriggerMatchingProducerBase(FlatMap<TValidObject*, KLV*> KappaProduct::*triggerMatchedObjects,
 	                            std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > KappaProduct::*detailedTriggerMatchedObjects,
+	                            TriggerMatchingResult<TValidObject> KappaProduct::*triggerMatchingResult,
 	                            std::vector<TValidObject*> KappaProduct::*validObjects,
 	                            std::vector<TValidObject*> KappaProduct::*invalidObjects,
 	                            std::map<size_t, std::vector<std::string> > KappaProduct::*settingsObjectTriggerFiltersByIndex,
@@ -56,6 +65,7 @@ public:
 	                            bool (KappaSettings::*GetInvalidateNonMatchingObjects)(void) const) :
 		m_triggerMatchedObjects(triggerMatchedObjects),
 		m_detailedTriggerMatchedObjects(detailedTriggerMatchedObjects),
+		m_triggerMatchingResult(triggerMatchingResult),
 		m_validObjects(validObjects),
 		m_invalidObjects(invalidObjects),
 		m_settingsObjectTriggerFiltersByIndex(settingsObjectTriggerFiltersByIndex),
@@ -70,6 +80,16 @@ public:
 		KappaProducerBase::Init(settings);
 		
 		m_objectTriggerFiltersByIndexFromSettings = Utility::ParseMapTypes<size_t, std::string>(Utility::ParseVectorToMap((settings.*GetObjectTriggerFilterNames)()), m_objectTriggerFiltersByHltNameFromSettings);
+		
+		// compile the configured patterns once, patterns set in the product by other producers are added on demand
+		m_hltPatternIndicesFromSettings.clear();
+		m_filterPatternIndicesFromSettings.clear();
+		for (std::map<std::string, std::vector<std::string> >::const_iterator objectTriggerFilterByHltName = m_objectTriggerFiltersByHltNameFromSettings.begin();
+		     objectTriggerFilterByHltName != m_objectTriggerFiltersByHltNameFromSettings.end(); ++objectTriggerFilterByHltName)
+		{
+			m_hltPatternIndicesFromSettings.push_back(m_hltPatternCache.AddPattern(objectTriggerFilterByHltName->first));
+			m_filterPatternIndicesFromSettings.push_back(m_filterPatternCache.AddPatterns(objectTriggerFilterByHltName->second));
+		}
 	}
 
 	void Produce(KappaEvent const& event, KappaProduct& product,
@@ -83,85 +103,93 @@ public:
 			(product.*m_settingsObjectTriggerFiltersByIndex).insert(m_objectTriggerFiltersByIndexFromSettings.begin(),
 			                                                        m_objectTriggerFiltersByIndexFromSettings.end());
 		}
-		if ((product.*m_settingsObjectTriggerFiltersByHltName).empty())
+		// the pattern indices compiled in Init can be used if the product contains the configured HLT names
+		bool objectTriggerFiltersFromSettings = (product.*m_settingsObjectTriggerFiltersByHltName).empty();
+		if (objectTriggerFiltersFromSettings)
 		{
 			(product.*m_settingsObjectTriggerFiltersByHltName).insert(m_objectTriggerFiltersByHltNameFromSettings.begin(),
 			                                                          m_objectTriggerFiltersByHltNameFromSettings.end());
 		}
 		
+		TriggerMatchingResult<TValidObject>& result = product.*m_triggerMatchingResult;
+		result.Clear();
 		(product.*m_triggerMatchedObjects).clear();
 		(product.*m_detailedTriggerMatchedObjects).clear();
-		if ((! product.m_selectedHltNames.empty()) && ((settings.*GetDeltaRTriggerMatchingObjects)() > 0.0))
+		if ((! product.m_selectedHltPositions.empty()) && ((settings.*GetDeltaRTriggerMatchingObjects)() > 0.0))
 		{
 			bool hasAllHltMatches = true;
 			bool hasHltAndFilterMatch = false;
 			
+			// the patterns are matched against the HLT paths and filters of the current lumi section only once
+			assert(event.m_eventInfo);
+			assert(event.m_lumiInfo);
+			m_hltPatternCache.SetNames(event.m_lumiInfo->hltNames, event.m_eventInfo->nRun, event.m_eventInfo->nLumi);
+			m_filterPatternCache.SetNames(event.m_triggerObjectMetadata->toFilter, event.m_eventInfo->nRun, event.m_eventInfo->nLumi);
+			
+			// coordinates of the valid objects, the trigger objects are put into grids per filter on demand
+			result.m_objects = (product.*m_validObjects);
+			m_objectEtas.resize(result.m_objects.size());
+			m_objectPhis.resize(result.m_objects.size());
+			for (size_t objectIndex = 0; objectIndex < result.m_objects.size(); ++objectIndex)
+			{
+				m_objectEtas[objectIndex] = result.m_objects[objectIndex]->p4.Eta();
+				m_objectPhis[objectIndex] = result.m_objects[objectIndex]->p4.Phi();
+			}
+			++m_gridGeneration;
+			if (m_triggerObjectGrids.size() < event.m_triggerObjectMetadata->toFilter.size())
+			{
+				m_triggerObjectGrids.resize(event.m_triggerObjectMetadata->toFilter.size());
+			}
+			
 			// loop over the hlt names given in the config file
+			size_t hltNameIndex = 0;
 			for (std::map<std::string, std::vector<std::string>>::const_iterator objectTriggerFilterByHltName = (product.*m_settingsObjectTriggerFiltersByHltName).begin();
 			     objectTriggerFilterByHltName != (product.*m_settingsObjectTriggerFiltersByHltName).end();
-			     ++objectTriggerFilterByHltName)
+			     ++objectTriggerFilterByHltName, ++hltNameIndex)
 			{
-				//LOG(DEBUG) << "objectTriggerFilterByHltName->first = " << objectTriggerFilterByHltName->first;
+				size_t hltPatternIndex = 0;
+				std::vector<size_t> const* filterPatternIndicesPtr = nullptr;
+				if (objectTriggerFiltersFromSettings)
+				{
+					hltPatternIndex = m_hltPatternIndicesFromSettings[hltNameIndex];
+					filterPatternIndicesPtr = &(m_filterPatternIndicesFromSettings[hltNameIndex]);
+				}
+				else
+				{
+					hltPatternIndex = m_hltPatternCache.AddPattern(objectTriggerFilterByHltName->first);
+					m_filterPatternIndices.clear();
+					for (std::vector<std::string>::const_iterator filterName = objectTriggerFilterByHltName->second.begin();
+					     filterName != objectTriggerFilterByHltName->second.end(); ++filterName)
+					{
+						m_filterPatternIndices.push_back(m_filterPatternCache.AddPattern(*filterName));
+					}
+					filterPatternIndicesPtr = &m_filterPatternIndices;
+				}
+				std::vector<size_t> const& filterPatternIndices = *filterPatternIndicesPtr;
 				
 				// loop over all fired HLT paths
-				for (unsigned int firedHltIndex = 0; firedHltIndex < product.m_selectedHltNames.size(); ++firedHltIndex)
+				for (unsigned int firedHltIndex = 0; firedHltIndex < product.m_selectedHltPositions.size(); ++firedHltIndex)
 				{
-					std::string firedHltName = product.m_selectedHltNames.at(firedHltIndex);
-					int firedHltPosition = product.m_selectedHltPositions.at(firedHltIndex);
-					//LOG(DEBUG) << "\tfiredFilterIndex, firedHltName, firedHltPosition = " << firedHltIndex << ", " << firedHltName << ", " << firedHltPosition;
+					size_t firedHltPosition = static_cast<size_t>(product.m_selectedHltPositions.at(firedHltIndex));
 					
 					// check that the hlt name given in the config matches the hlt which fired in the event
-					if (boost::regex_search(firedHltName, boost::regex(objectTriggerFilterByHltName->first, boost::regex::icase | boost::regex::extended)))
+					if (m_hltPatternCache.Matches(hltPatternIndex, firedHltPosition))
 					{
-						//LOG(DEBUG) << "\t\thltMatched";
-						
 						// loop over the filter regexp associated with the given hlt in the config
-						for (std::vector<std::string>::const_iterator filterName = objectTriggerFilterByHltName->second.begin();
-						     filterName != objectTriggerFilterByHltName->second.end();
-						     ++filterName)
+						for (std::vector<size_t>::const_iterator filterPatternIndex = filterPatternIndices.begin();
+						     filterPatternIndex != filterPatternIndices.end();
+						     ++filterPatternIndex)
 						{
-							//LOG(DEBUG) << "\t\t\tfilterName = " << *filterName;
-							
 							// loop over all filters for the fired HLT
 							for (size_t firedFilterIndex = event.m_triggerObjectMetadata->getMinFilterIndex(firedHltPosition);
 							     firedFilterIndex < event.m_triggerObjectMetadata->getMaxFilterIndex(firedHltPosition);
 							     ++firedFilterIndex)
 							{
-								std::string firedFilterName = event.m_triggerObjectMetadata->toFilter[firedFilterIndex];
-								//LOG(DEBUG) << "\t\t\t\tfiredFilterIndex, firedFilterName = " << firedFilterIndex << ", " << firedFilterName;
-								
 								// check that the filter regexp given in the config matches the fired filter
-								if (boost::regex_search(firedFilterName, boost::regex(*filterName, boost::regex::icase | boost::regex::extended)))
+								if (m_filterPatternCache.Matches(*filterPatternIndex, firedFilterIndex))
 								{
 									hasHltAndFilterMatch = true;
-									//LOG(DEBUG) << "\t\t\t\t\tfilterMatched";
-									
-									// loop over all valid objects to check
-									for (typename std::vector<TValidObject*>::iterator validObject = (product.*m_validObjects).begin();
-									     validObject != (product.*m_validObjects).end(); ++validObject)
-									{
-										std::vector<KLV*> matchedTriggerObjects;
-										//LOG(DEBUG) << "\t\t\t\t\t\tvalidObject = " << *validObject << ", (pt, eta, phi) = (" << (*validObject)->p4.Pt() << ", " << (*validObject)->p4.Eta() << ", " << (*validObject)->p4.Phi() << ")";
-										
-										// loop over all trigger objects for the fired filter
-										for (std::vector<int>::const_iterator triggerObjectIndex = event.m_triggerObjects->toIdxFilter[firedFilterIndex].begin();
-										     triggerObjectIndex != event.m_triggerObjects->toIdxFilter[firedFilterIndex].end();
-										     ++triggerObjectIndex)
-										{
-											KLV* triggerObject = &event.m_triggerObjects->trgObjects.at(*triggerObjectIndex);
-											//LOG(DEBUG) << "\t\t\t\t\t\t\ttriggerObjectIndex, triggerObject = " << *triggerObjectIndex << ", " << triggerObject << ", (pt, eta, phi) = (" << triggerObject->p4.Pt() << ", " << triggerObject->p4.Eta() << ", " << triggerObject->p4.Phi() << ")";
-											
-											// check the matching
-											if (ROOT::Math::VectorUtil::DeltaR(triggerObject->p4, (*validObject)->p4) < (settings.*GetDeltaRTriggerMatchingObjects)() && triggerObject->p4.Pt() > settings.GetTriggerObjectLowerPtCut())
-											{
-												//LOG(DEBUG) << "\t\t\t\t\t\t\t\tobjectMatched";
-												
-												matchedTriggerObjects.push_back(triggerObject);
-											}
-										}
-										
-										(product.*m_detailedTriggerMatchedObjects)[*validObject][firedHltName][firedFilterName] = matchedTriggerObjects;
-									}
+									MatchTriggerObjects(event, settings, firedHltPosition, firedFilterIndex, result);
 								}
 							}
 						}
@@ -173,23 +201,29 @@ public:
 				}
 			}
 			
-			for (typename std::pair<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > triggerMatchingResult : (product.*m_detailedTriggerMatchedObjects))
+			// check matching results for having passed all configured filters
+			EvaluateTriggerMatchingResult(event, result);
+			for (size_t objectIndex = 0; objectIndex < result.m_objects.size(); ++objectIndex)
 			{
-				// check matching results for having passed all configured filters
-				std::vector<std::string> hltNamesWhereAllFiltersMatched = TriggerMatchingProducerBase::GetHltNamesWhereAllFiltersMatched(triggerMatchingResult.second);
-				if (hltNamesWhereAllFiltersMatched.size() > 0)
+				if (m_firstMatchedTriggerObjects[objectIndex] >= 0)
 				{
 					// store first trigger object of first filter of first HLT name
-					(product.*m_triggerMatchedObjects)[triggerMatchingResult.first] = ((triggerMatchingResult.second)[hltNamesWhereAllFiltersMatched.front()].begin()->second).front();
+					(product.*m_triggerMatchedObjects)[result.m_objects[objectIndex]] = &event.m_triggerObjects->trgObjects.at(m_firstMatchedTriggerObjects[objectIndex]);
 				}
-				else if (hasAllHltMatches && hasHltAndFilterMatch && (settings.*GetInvalidateNonMatchingObjects)())
+				else if (hasAllHltMatches && hasHltAndFilterMatch && (settings.*GetInvalidateNonMatchingObjects)() &&
+				         m_hasTriggerMatchingEntries[objectIndex])
 				{
 					// invalidate the object if the trigger has not matched
-					(product.*m_invalidObjects).push_back(triggerMatchingResult.first);
-					(product.*m_validObjects).erase(std::find((product.*m_validObjects).begin(), (product.*m_validObjects).end(), &(*triggerMatchingResult.first)));
+					(product.*m_invalidObjects).push_back(result.m_objects[objectIndex]);
+					(product.*m_validObjects).erase(std::find((product.*m_validObjects).begin(), (product.*m_validObjects).end(), result.m_objects[objectIndex]));
 				}
 			}
 			
+			if (settings.GetFillDetailedTriggerMatchingMaps())
+			{
+				FillDetailedTriggerMatchedObjects(event, result, product.*m_detailedTriggerMatchedObjects);
+			}
+			
 			// preserve sorting of invalid objects
 			std::sort((product.*m_invalidObjects).begin(), (product.*m_invalidObjects).end(),
 			          [](TValidObject const* object1, TValidObject const* object2) -> bool
@@ -221,8 +255,158 @@ public:
 
 
 private:
-	std::map<TValidObject*, KLV*> KappaProduct::*m_triggerMatchedObjects;
+
+	// trigger objects of one filter passing the pt cut, positions refer to KTriggerObjects::toIdxFilter[filterIndex]
+	struct TriggerObjectGrid
+	{
+		EtaPhiGrid grid;
+		std::vector<size_t> positions;
+		std::vector<float> etas;
+		std::vector<float> phis;
+		unsigned long long generation = 0;
+	};
+
+	EtaPhiGrid const& GetTriggerObjectGrid(KappaEvent const& event, KappaSettings const& settings, size_t filterIndex) const
+	{
+		TriggerObjectGrid& triggerObjectGrid = m_triggerObjectGrids[filterIndex];
+		if (triggerObjectGrid.generation != m_gridGeneration)
+		{
+			std::vector<int> const& triggerObjectIndices = event.m_triggerObjects->toIdxFilter[filterIndex];
+			triggerObjectGrid.positions.clear();
+			triggerObjectGrid.etas.clear();
+			triggerObjectGrid.phis.clear();
+			for (size_t position = 0; position < triggerObjectIndices.size(); ++position)
+			{
+				KLV const& triggerObject = event.m_triggerObjects->trgObjects.at(triggerObjectIndices[position]);
+				if (triggerObject.p4.Pt() > settings.GetTriggerObjectLowerPtCut())
+				{
+					triggerObjectGrid.positions.push_back(position);
+					triggerObjectGrid.etas.push_back(triggerObject.p4.Eta());
+					triggerObjectGrid.phis.push_back(triggerObject.p4.Phi());
+				}
+			}
+			triggerObjectGrid.grid.Fill(triggerObjectGrid.etas, triggerObjectGrid.phis, (settings.*GetDeltaRTriggerMatchingObjects)());
+			triggerObjectGrid.generation = m_gridGeneration;
+		}
+		return triggerObjectGrid.grid;
+	}
+
+	// add one entry per valid object for the given HLT path and filter
+	void MatchTriggerObjects(KappaEvent const& event, KappaSettings const& settings,
+	                         size_t hltPosition, size_t filterIndex,
+	                         TriggerMatchingResult<TValidObject>& result) const
+	{
+		EtaPhiGrid const& grid = GetTriggerObjectGrid(event, settings, filterIndex);
+		std::vector<size_t> const& positions = m_triggerObjectGrids[filterIndex].positions;
+		std::vector<int> const& triggerObjectIndices = event.m_triggerObjects->toIdxFilter[filterIndex];
+		float deltaRMax = (settings.*GetDeltaRTriggerMatchingObjects)();
+		
+		for (size_t objectIndex = 0; objectIndex < result.m_objects.size(); ++objectIndex)
+		{
+			TValidObject const* validObject = result.m_objects[objectIndex];
+			m_candidatePositions.clear();
+			grid.ForEachCandidate(m_objectEtas[objectIndex], m_objectPhis[objectIndex], [&](size_t gridIndex) {
+				KLV const& triggerObject = event.m_triggerObjects->trgObjects.at(triggerObjectIndices[positions[gridIndex]]);
+				if (ROOT::Math::VectorUtil::DeltaR(triggerObject.p4, validObject->p4) < deltaRMax)
+				{
+					m_candidatePositions.push_back(positions[gridIndex]);
+				}
+			});
+			
+			// keep the order of the trigger objects in the filter
+			std::sort(m_candidatePositions.begin(), m_candidatePositions.end());
+			
+			typename TriggerMatchingResult<TValidObject>::Entry entry;
+			entry.objectIndex = objectIndex;
+			entry.hltPosition = hltPosition;
+			entry.filterIndex = filterIndex;
+			entry.firstTriggerObject = result.m_triggerObjectIndices.size();
+			entry.nTriggerObjects = m_candidatePositions.size();
+			for (std::vector<size_t>::const_iterator position = m_candidatePositions.begin(); position != m_candidatePositions.end(); ++position)
+			{
+				result.m_triggerObjectIndices.push_back(static_cast<size_t>(triggerObjectIndices[*position]));
+			}
+			result.m_entries.push_back(entry);
+		}
+	}
+
+	// the entries are evaluated in the order of the nested maps (object, HLT name, filter name),
+	// such that the stored trigger object does not depend on the storage of the results
+	void EvaluateTriggerMatchingResult(KappaEvent const& event, TriggerMatchingResult<TValidObject> const& result) const
+	{
+		std::vector<std::string> const& hltNames = event.m_lumiInfo->hltNames;
+		std::vector<std::string> const& filterNames = event.m_triggerObjectMetadata->toFilter;
+		std::vector<typename TriggerMatchingResult<TValidObject>::Entry> const& entries = result.m_entries;
+		
+		m_sortedEntries.resize(entries.size());
+		for (size_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex)
+		{
+			m_sortedEntries[entryIndex] = entryIndex;
+		}
+		std::sort(m_sortedEntries.begin(), m_sortedEntries.end(), [&](size_t entryIndex1, size_t entryIndex2) -> bool
+		{
+			typename TriggerMatchingResult<TValidObject>::Entry const& entry1 = entries[entryIndex1];
+			typename TriggerMatchingResult<TValidObject>::Entry const& entry2 = entries[entryIndex2];
+			if (entry1.objectIndex != entry2.objectIndex)
+			{
+				return entry1.objectIndex < entry2.objectIndex;
+			}
+			int hltNameComparison = hltNames[entry1.hltPosition].compare(hltNames[entry2.hltPosition]);
+			if (hltNameComparison != 0)
+			{
+				return hltNameComparison < 0;
+			}
+			return filterNames[entry1.filterIndex] < filterNames[entry2.filterIndex];
+		});
+		
+		m_firstMatchedTriggerObjects.assign(result.m_objects.size(), -1);
+		m_hasTriggerMatchingEntries.assign(result.m_objects.size(), false);
+		size_t begin = 0;
+		while (begin < m_sortedEntries.size())
+		{
+			typename TriggerMatchingResult<TValidObject>::Entry const& firstEntry = entries[m_sortedEntries[begin]];
+			m_hasTriggerMatchingEntries[firstEntry.objectIndex] = true;
+			
+			// all entries of this object and HLT path need at least one matched trigger object
+			bool allFiltersMatched = true;
+			size_t end = begin;
+			while ((end < m_sortedEntries.size()) &&
+			       (entries[m_sortedEntries[end]].objectIndex == firstEntry.objectIndex) &&
+			       (entries[m_sortedEntries[end]].hltPosition == firstEntry.hltPosition))
+			{
+				if (entries[m_sortedEntries[end]].nTriggerObjects == 0)
+				{
+					allFiltersMatched = false;
+				}
+				++end;
+			}
+			
+			if (allFiltersMatched && (m_firstMatchedTriggerObjects[firstEntry.objectIndex] < 0))
+			{
+				m_firstMatchedTriggerObjects[firstEntry.objectIndex] = static_cast<int>(result.m_triggerObjectIndices[firstEntry.firstTriggerObject]);
+			}
+			begin = end;
+		}
+	}
+
+	static void FillDetailedTriggerMatchedObjects(KappaEvent const& event, TriggerMatchingResult<TValidObject> const& result,
+	                                              std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > >& detailedTriggerMatchedObjects)
+	{
+		for (typename std::vector<typename TriggerMatchingResult<TValidObject>::Entry>::const_iterator entry = result.m_entries.begin();
+		     entry != result.m_entries.end(); ++entry)
+		{
+			std::vector<KLV*>& matchedTriggerObjects = detailedTriggerMatchedObjects[result.m_objects[entry->objectIndex]][event.m_lumiInfo->hltNames[entry->hltPosition]][event.m_triggerObjectMetadata->toFilter[entry->filterIndex]];
+			matchedTriggerObjects.clear();
+			for (size_t triggerObject = entry->firstTriggerObject; triggerObject < entry->firstTriggerObject + entry->nTriggerObjects; ++triggerObject)
+			{
+				matchedTriggerObjects.push_back(&event.m_triggerObjects->trgObjects.at(result.m_triggerObjectIndices[triggerObject]));
+			}
+		}
+	}
+
+	FlatMap<TValidObject*, KLV*> KappaProduct::*m_triggerMatchedObjects;
 	std::map<TValidObject*, std::map<std::string, std::map<std::string, std::vector<KLV*> > > > KappaProduct::*m_detailedTriggerMatchedObjects;
+	TriggerMatchingResult<TValidObject> KappaProduct::*m_triggerMatchingResult;
 	std::vector<TValidObject*> KappaProduct::*m_validObjects;
 	std::vector<TValidObject*> KappaProduct::*m_invalidObjects;
 	std::map<size_t, std::vector<std::string> > KappaProduct::*m_settingsObjectTriggerFiltersByIndex;
@@ -233,6 +417,23 @@ private:
 	
 	std::map<size_t, std::vector<std::string> > m_objectTriggerFiltersByIndexFromSettings;
 	std::map<std::string, std::vector<std::string> > m_objectTriggerFiltersByHltNameFromSettings;
+	
+	mutable TriggerPatternCache m_hltPatternCache;
+	mutable TriggerPatternCache m_filterPatternCache;
+	// pattern indices of the entries of m_objectTriggerFiltersByHltNameFromSettings (in the order of the map)
+	std::vector<size_t> m_hltPatternIndicesFromSettings;
+	std::vector<std::vector<size_t> > m_filterPatternIndicesFromSettings;
+	mutable std::vector<size_t> m_filterPatternIndices;
+	
+	// per-event buffers, the capacities are kept between the events
+	mutable std::vector<TriggerObjectGrid> m_triggerObjectGrids;
+	mutable unsigned long long m_gridGeneration = 0;
+	mutable std::vector<float> m_objectEtas;
+	mutable std::vector<float> m_objectPhis;
+	mutable std::vector<size_t> m_candidatePositions;
+	mutable std::vector<size_t> m_sortedEntries;
+	mutable std::vector<int> m_firstMatchedTriggerObjects;
+	mutable std::vector<bool> m_hasTriggerMatchingEntries;
 
 };
 
@@ -11,6 +11,7 @@
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/KappaAnalysis/interface/Utility/BTagSF.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataHandles.h"
 
 
 /**
@@ -42,4 +43,6 @@ private:
 	std::map<std::string, float> m_bTagWorkingPoints;
 	std::map<std::string, BTagSF> m_bTagSfMap;
 
+	mutable JetTagHandle m_bTaggedJetCSVHandle;
+
 };
@@ -12,6 +12,7 @@
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataHandles.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
 #include "Artus/Utility/interface/DefaultValues.h"
@@ -203,14 +204,7 @@ public:
 		{
 			LOG(DEBUG) << "Using corrected Electrons as input; Number of m_correctedElectrons: "
 				<< product.m_correctedElectrons.size();
-			electrons.resize(product.m_correctedElectrons.size());
-			size_t electronIndex = 0;
-			for (std::vector<std::shared_ptr<KElectron> >::iterator electron = product.m_correctedElectrons.begin();
-			     electron != product.m_correctedElectrons.end(); ++electron)
-			{
-				electrons[electronIndex] = electron->get();
-				++electronIndex;
-			}
+			electrons = product.m_correctedElectrons;
 		}
 		else
 		{
@@ -223,6 +217,12 @@ public:
 			}
 		}
 
+		// the MVA IDs are only looked up in the metadata if it has changed
+		if (electronID == ElectronID::MVANONTRIG)
+			m_mvaNonTrigIdHandle.Resolve(event.m_electronMetadata);
+		else if (electronID == ElectronID::MVATRIG)
+			m_mvaTrigIdHandle.Resolve(event.m_electronMetadata);
+
 		for (std::vector<KElectron*>::iterator electron = electrons.begin(); electron != electrons.end(); ++electron)
 		{
 			bool valid = true;
@@ -235,9 +235,9 @@ public:
 
 			// Electron IDs
 			if (electronID == ElectronID::MVANONTRIG)
-				valid = valid && IsMVANonTrigElectron(*electron, event.m_electronMetadata);
+				valid = valid && IsMVANonTrigElectron(*electron, m_mvaNonTrigIdHandle.Get(**electron, event.m_electronMetadata));
 			else if (electronID == ElectronID::MVATRIG)
-				valid = valid && IsMVATrigElectron(*electron, event.m_electronMetadata);
+				valid = valid && IsMVATrigElectron(*electron, m_mvaTrigIdHandle.Get(**electron, event.m_electronMetadata));
 			else if (electronID == ElectronID::VBTF95_VETO)
 				valid = valid && IsVetoVbtf95Electron(*electron, event, product);
 			else if (electronID == ElectronID::VBTF95_LOOSE)
@@ -329,6 +329,12 @@ public:
 	}
 
 	static bool IsMVANonTrigElectron(const KElectron* electron, const KElectronMetadata* electronMeta)
+	{
+		return IsMVANonTrigElectron(electron, electron->getId("idMvaNonTrigV0", electronMeta));
+	}
+
+	/// mvaValue: value of the ID "idMvaNonTrigV0" of the electron
+	static bool IsMVANonTrigElectron(const KElectron* electron, float mvaValue)
 	{
 		// Electron ID mva non trig (run 1)
 		// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Non_triggering_MVA
@@ -336,21 +342,27 @@ public:
 		if (electron->p4.Pt() < 10.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.47f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaNonTrigV0", electronMeta) > 0.004f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.295f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaValue > 0.47f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaValue > 0.004f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaValue > 0.295f));
 		}
 		else if (electron->p4.Pt() >= 10.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaNonTrigV0", electronMeta) > -0.34f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaNonTrigV0", electronMeta) > -0.65f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaNonTrigV0", electronMeta) > 0.6f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaValue > -0.34f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaValue > -0.65f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaValue > 0.6f));
 		}
 		return false;
 	}
 
 	static bool IsMVATrigElectron(const KElectron* electron, const KElectronMetadata* electronMeta)
+	{
+		return IsMVATrigElectron(electron, electron->getId("idMvaTrigV0", electronMeta));
+	}
+
+	/// mvaValue: value of the ID "idMvaTrigV0" of the electron
+	static bool IsMVATrigElectron(const KElectron* electron, float mvaValue)
 	{
 		// Electron ID mva trig (run 1)
 		// https://twiki.cern.ch/twiki/bin/viewauth/CMS/MultivariateElectronIdentification#Triggering_MVA
@@ -358,16 +370,16 @@ public:
 		if (electron->p4.Pt() >= 10.0f && electron->p4.Pt() < 20.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) <= 0.8f && electron->getId("idMvaTrigV0", electronMeta) > 0.0f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) <= DefaultValues::EtaBorderEB && electron->getId("idMvaTrigV0", electronMeta) > 0.1f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) <= 2.5f && electron->getId("idMvaTrigV0", electronMeta) > 0.62f));
+				(std::abs(electron->p4.Eta()) <= 0.8f && mvaValue > 0.0f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) <= DefaultValues::EtaBorderEB && mvaValue > 0.1f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) <= 2.5f && mvaValue > 0.62f));
 		}
 		else if (electron->p4.Pt() >= 20.0f)
 		{
 			return (
-				(std::abs(electron->p4.Eta()) < 0.8f && electron->getId("idMvaTrigV0", electronMeta) > 0.94f) ||
-				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && electron->getId("idMvaTrigV0", electronMeta) > 0.85f) ||
-				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && electron->getId("idMvaTrigV0", electronMeta) > 0.92f));
+				(std::abs(electron->p4.Eta()) < 0.8f && mvaValue > 0.94f) ||
+				(std::abs(electron->p4.Eta()) > 0.8f && std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB && mvaValue > 0.85f) ||
+				(std::abs(electron->p4.Eta()) > DefaultValues::EtaBorderEB && std::abs(electron->p4.Eta()) < 2.5f && mvaValue > 0.92f));
 		}
 		return false;
 	}
@@ -528,6 +540,9 @@ private:
 
 	ValidElectronsInput validElectronsInput;
 
+	mutable ElectronIdHandle m_mvaNonTrigIdHandle = ElectronIdHandle("idMvaNonTrigV0");
+	mutable ElectronIdHandle m_mvaTrigIdHandle = ElectronIdHandle("idMvaTrigV0");
+
 	bool IsFakeableElectron(KElectron* electron, event_type const& event, product_type& product) const
 	{
 		if (std::abs(electron->p4.Eta()) < DefaultValues::EtaBorderEB)
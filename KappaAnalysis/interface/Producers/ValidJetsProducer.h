@@ -20,8 +20,10 @@
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataHandles.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
+#include "Artus/Utility/interface/DeltaRMatching.h"
 #include "Artus/KappaAnalysis/interface/KappaProduct.h"
 
 /**
@@ -42,7 +44,7 @@ class ValidJetsProducerBase : public KappaProducerBase, public ValidPhysicsObjec
 public:
 
     ValidJetsProducerBase(std::vector <TJet> *KappaEvent::*jets,
-                          std::vector <std::shared_ptr<TJet>> KappaProduct::*correctJets,
+                          std::vector<TJet *> KappaProduct::*correctJets,
                           std::vector<TValidJet *> KappaProduct::*validJets) :
             KappaProducerBase(),
             ValidPhysicsObjectTools<KappaTypes, TValidJet>(&KappaSettings::GetJetLowerPtCuts,
@@ -303,14 +305,8 @@ public:
         if ((validJetsInput == KappaEnumTypes::ValidJetsInput::AUTO && ((product.*m_correctedJetsMember).size() > 0)) ||
             (validJetsInput == KappaEnumTypes::ValidJetsInput::CORRECTED)) {
             LOG(DEBUG) << "Use m_correctedJetsMember as input.";
-            jets.resize((product.*m_correctedJetsMember).size());
             LOG(DEBUG) << "Number of m_correctedJetsMember: " << (product.*m_correctedJetsMember).size();
-            size_t jetIndex = 0;
-            for (typename std::vector<std::shared_ptr < TJet> > ::iterator jet = (product.*m_correctedJetsMember).begin();
-                    jet != (product.*m_correctedJetsMember).end(); ++jet) {
-                jets[jetIndex] = jet->get();
-                ++jetIndex;
-            }
+            jets = (product.*m_correctedJetsMember);
         } else {
             LOG(DEBUG) << "Use m_basicJetsMember as input.";
             LOG(DEBUG) << "Number of m_basicJetsMember: " << (event.*m_basicJetsMember)->size();
@@ -341,8 +337,23 @@ public:
         }
 
 
+        // DeltaR^2 between all jets and the leptons to be removed from the list of jets
+        m_jetCoordinates.Clear();
+        m_jetCoordinates.AddObjects(jets);
+        m_cleaningLeptonCoordinates.Clear();
+        if (settings.GetOnlyCleanZLeptons()) {
+            if (product.m_zValid) {
+                m_cleaningLeptonCoordinates.AddObject(*product.m_zLeptons.first);
+                m_cleaningLeptonCoordinates.AddObject(*product.m_zLeptons.second);
+            }
+        } else {
+            m_cleaningLeptonCoordinates.AddObjects(product.m_validLeptons);
+        }
+        m_jetLeptonMatcher.Compute(m_jetCoordinates, m_cleaningLeptonCoordinates);
+
         for (typename std::vector<TJet *>::iterator jet = jets.begin(); jet != jets.end(); ++jet) {
             bool validJet = true;
+            float const* jetLeptonDeltaR2 = m_jetLeptonMatcher.GetDeltaR2Row(static_cast<size_t>(jet - jets.begin()));
             validJet = validJet && passesJetID(*jet, jetIDVersion, jetID, settings);
 
             if (settings.GetDebugVerbosity() > 0) {
@@ -366,29 +377,25 @@ public:
             if (settings.GetOnlyCleanZLeptons()) {
                 // remove the two valid Z-leptons from list of jets via simple DeltaR isolation
                 if (product.m_zValid) {
-                    if (ROOT::Math::VectorUtil::DeltaR((*jet)->p4, product.m_zLeptons.first->p4) 
-                          < settings.GetJetLeptonLowerDeltaRCut()) {
-                        validJet = false;
-                        LOG(DEBUG) << "Jet invalidated and removed due to delta R cut ("
-                                   << settings.GetJetLeptonLowerDeltaRCut() << ")";
-                    }
-                    if (ROOT::Math::VectorUtil::DeltaR((*jet)->p4, product.m_zLeptons.second->p4) 
-                          < settings.GetJetLeptonLowerDeltaRCut()) {
-                        validJet = false;
-                        LOG(DEBUG) << "Jet invalidated and removed due to delta R cut ("
-                                   << settings.GetJetLeptonLowerDeltaRCut() << ")";
+                    float jetLeptonDeltaR2Cut = DeltaRMatcher::GetDeltaR2Cut(settings.GetJetLeptonLowerDeltaRCut());
+                    for (size_t zLeptonIndex = 0; zLeptonIndex < 2; ++zLeptonIndex) {
+                        if (jetLeptonDeltaR2[zLeptonIndex] < jetLeptonDeltaR2Cut) {
+                            validJet = false;
+                            LOG(DEBUG) << "Jet invalidated and removed due to delta R cut ("
+                                       << settings.GetJetLeptonLowerDeltaRCut() << ")";
+                        }
                     }
                 }
             } else {
                 // remove ALL valid leptons from list of jets via simple DeltaR isolation
-                for (std::vector<KLepton *>::const_iterator lepton = product.m_validLeptons.begin();
-                      validJet && lepton != product.m_validLeptons.end(); ++lepton) {
-                    validJet = validJet && ROOT::Math::VectorUtil::DeltaR((*jet)->p4, (*lepton)->p4) >
-                    settings.GetJetLeptonLowerDeltaRCut(); 
+                for (size_t leptonIndex = 0; validJet && leptonIndex < product.m_validLeptons.size(); ++leptonIndex) {
+                    KLepton const* lepton = product.m_validLeptons[leptonIndex];
+                    validJet = validJet && jetLeptonDeltaR2[leptonIndex] >
+                    DeltaRMatcher::GetDeltaR2Cut(settings.GetJetLeptonLowerDeltaRCut());
                     if (settings.GetDebugVerbosity() > 1) {
-                        LOG(DEBUG) << "Check lepton with pt: " << (*lepton)->p4.Pt() << " eta: " << (*lepton)->p4.Pt()
-                                   << " phi: " << (*lepton)->p4.Pt() << " Delta R: " 
-                                   << ROOT::Math::VectorUtil::DeltaR((*jet)->p4, (*lepton)->p4);
+                        LOG(DEBUG) << "Check lepton with pt: " << lepton->p4.Pt() << " eta: " << lepton->p4.Eta()
+                                   << " phi: " << lepton->p4.Phi() << " Delta R: "
+                                   << std::sqrt(jetLeptonDeltaR2[leptonIndex]);
                         if (validJet == false) {
                             LOG(DEBUG) << "Jet invalidated and removed due to delta R cut (" 
                                        << settings.GetJetLeptonLowerDeltaRCut() << ")";
@@ -403,8 +410,8 @@ public:
                 LOG(WARNING) << "Jet does not pass (OLD) KinematicCuts. Please verify!!\n";
             }
             // check possible analysis-specific criteria
-            validJet = validJet && AdditionalCriteria(*jet, event, product, settings);
-            if (AdditionalCriteria(*jet, event, product, settings) == false) {
+            if (validJet && (! AdditionalCriteria(*jet, event, product, settings))) {
+                validJet = false;
                 LOG(DEBUG) << "Jet does not pass AdditionalCriteria. Please verify!\n";
             }
             if (validJet) {
@@ -1031,11 +1038,15 @@ protected:
 
 private:
     std::vector <TJet> *KappaEvent::*m_basicJetsMember;
-    std::vector <std::shared_ptr<TJet>> KappaProduct::*m_correctedJetsMember;
+    std::vector<TJet *> KappaProduct::*m_correctedJetsMember;
 
     KappaEnumTypes::ValidJetsInput validJetsInput;
     KappaEnumTypes::JetIDVersion jetIDVersion;
     KappaEnumTypes::JetID jetID;
+
+    mutable EtaPhiArrays m_jetCoordinates;
+    mutable EtaPhiArrays m_cleaningLeptonCoordinates;
+    mutable DeltaRMatcher m_jetLeptonMatcher;
 };
 
 
@@ -1054,9 +1065,11 @@ public:
 /**
    \brief Producer for valid jets (tagged PF jets).
    Operates on the vector event.m_tjets.
-   Required config tags:
-   - PuJetIDs
-   - JetTaggerLowerCuts
+   Optional config tags:
+   - PuJetIDs (by jet index or "default" for all jets)
+   - JetTaggerLowerCuts, JetTaggerUpperCuts (by tagger name)
+   The PU jet IDs and tagger names are resolved to their indices in the jet metadata
+   once per lumi section (see MetadataHandles.h).
 */
 class ValidTaggedJetsProducer : public ValidJetsProducerBase<KJet, KBasicJet> {
 public:
@@ -1066,6 +1079,9 @@ public:
 
     void Init(KappaSettings const &settings) override;
 
+    void Produce(KappaEvent const &event, KappaProduct &product,
+                 KappaSettings const &settings) const override;
+
 protected:
     // Can be overwritten for analysis-specific use cases
     virtual bool AdditionalCriteria(KJet *jet, KappaEvent const &event,
@@ -1077,6 +1093,14 @@ private:
     std::map <std::string, std::vector<float>> jetTaggerLowerCutsByTaggerName;
     std::map <std::string, std::vector<float>> jetTaggerUpperCutsByTaggerName;
 
-    bool PassPuJetIds(KJet *jet, std::vector <std::string> const &puJetIds, KJetMetadata *taggerMetadata) const;
+    // handles for the PU jet IDs and taggers, with the tightest cut per tagger
+    mutable std::map <size_t, std::vector<JetIdHandle>> m_puJetIdHandlesByIndex;
+    mutable std::vector<JetIdHandle> m_defaultPuJetIdHandles;
+    mutable std::vector<JetTagHandle> m_jetTaggerLowerCutHandles;
+    std::vector<float> m_jetTaggerLowerCuts;
+    mutable std::vector<JetTagHandle> m_jetTaggerUpperCutHandles;
+    std::vector<float> m_jetTaggerUpperCuts;
+
+    bool PassPuJetIds(KJet const &jet, std::vector<JetIdHandle> const &puJetIds, KJetMetadata const *jetMetadata) const;
 };
 
@@ -238,15 +238,7 @@ public:
             (validMuonsInput == ValidMuonsInput::CORRECTED)) {
             LOG(DEBUG) << "Using corrected Muons as input; Number of m_correctedMuons: "
                        << product.m_correctedMuons.size();
-            muons.resize(product.m_correctedMuons.size());
-            size_t muonIndex = 0;
-            for (std::vector < std::shared_ptr < KMuon > > ::iterator muon = product.m_correctedMuons.begin();
-                    muon != product.m_correctedMuons.end();
-            ++muon)
-            {
-                muons[muonIndex] = muon->get();
-                ++muonIndex;
-            }
+            muons = product.m_correctedMuons;
         } else {
             LOG(DEBUG) << "Standard input (uncorrected); Number of m_muons: " << event.m_muons->size();
             muons.resize(event.m_muons->size());
@@ -11,6 +11,7 @@
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
 #include "Artus/KappaAnalysis/interface/Utility/ValidPhysicsObjectTools.h"
+#include "Artus/KappaAnalysis/interface/Utility/MetadataHandles.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/Utility/interface/Utility.h"
@@ -81,6 +82,20 @@ public:
 		// parse additional config tags
 		discriminatorsByIndex = Utility::ParseMapTypes<size_t, std::string>(Utility::ParseVectorToMap(settings.GetTauDiscriminators()),
 		                                                                    discriminatorsByHltName);
+		discriminatorHltPatternIndices.clear();
+		discriminatorHandlesByHltName.clear();
+		for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
+		     discriminatorByHltName != discriminatorsByHltName.end(); ++discriminatorByHltName)
+		{
+			discriminatorHltPatternIndices.push_back(m_hltPatternCache.AddPattern(discriminatorByHltName->first));
+			discriminatorHandlesByHltName.push_back(CreateDiscriminatorHandles(discriminatorByHltName->second));
+		}
+		discriminatorHandlesByIndex.clear();
+		for (std::map<size_t, std::vector<std::string> >::const_iterator discriminatorByIndex = discriminatorsByIndex.begin();
+		     discriminatorByIndex != discriminatorsByIndex.end(); ++discriminatorByIndex)
+		{
+			discriminatorHandlesByIndex[discriminatorByIndex->first] = CreateDiscriminatorHandles(discriminatorByIndex->second);
+		}
 		tauID = ToTauID(settings.GetTauID());
 		oldTauDMs = settings.GetTauUseOldDMs();
 
@@ -213,14 +228,7 @@ public:
 		std::vector<KTau*> taus;
 		if ((validTausInput == ValidTausInput::AUTO && (product.m_correctedTaus.size() > 0)) || (validTausInput == ValidTausInput::CORRECTED))
 		{
-			taus.resize(product.m_correctedTaus.size());
-			size_t tauIndex = 0;
-			for (std::vector<std::shared_ptr<KTau> >::iterator tau = product.m_correctedTaus.begin();
-			     tau != product.m_correctedTaus.end(); ++tau)
-			{
-				taus[tauIndex] = tau->get();
-				++tauIndex;
-			}
+			taus = product.m_correctedTaus;
 		}
 		else
 		{
@@ -233,13 +241,38 @@ public:
 			}
 		}
 		
+		// the HLT patterns are matched against the HLT paths of the current lumi section only once
+		if ((! product.m_selectedHltPositions.empty()) && (! discriminatorsByHltName.empty()))
+		{
+			assert(event.m_eventInfo);
+			assert(event.m_lumiInfo);
+			m_hltPatternCache.SetNames(event.m_lumiInfo->hltNames, event.m_eventInfo->nRun, event.m_eventInfo->nLumi);
+		}
+
+		// the discriminator names are only looked up in the metadata if it has changed
+		for (std::map<size_t, std::vector<TauBinaryDiscriminatorHandle> >::iterator discriminatorHandles = discriminatorHandlesByIndex.begin();
+		     discriminatorHandles != discriminatorHandlesByIndex.end(); ++discriminatorHandles)
+		{
+			ResolveMetadataHandles(discriminatorHandles->second, event.m_tauMetadata);
+		}
+		for (std::vector<std::vector<TauBinaryDiscriminatorHandle> >::iterator discriminatorHandles = discriminatorHandlesByHltName.begin();
+		     discriminatorHandles != discriminatorHandlesByHltName.end(); ++discriminatorHandles)
+		{
+			ResolveMetadataHandles(*discriminatorHandles, event.m_tauMetadata);
+		}
+		if (tauID != TauID::NONE)
+		{
+			decayModeFindingHandle.Resolve(event.m_tauMetadata);
+			decayModeFindingNewDMsHandle.Resolve(event.m_tauMetadata);
+		}
+
 		for (std::vector<KTau*>::iterator tau = taus.begin(); tau != taus.end(); ++tau)
 		{
 			bool validTau = true;
 			
 			// check discriminators
-			for (std::map<size_t, std::vector<std::string> >::const_iterator discriminatorByIndex = discriminatorsByIndex.begin();
-				 validTau && (discriminatorByIndex != discriminatorsByIndex.end()); ++discriminatorByIndex)
+			for (std::map<size_t, std::vector<TauBinaryDiscriminatorHandle> >::const_iterator discriminatorByIndex = discriminatorHandlesByIndex.begin();
+				 validTau && (discriminatorByIndex != discriminatorHandlesByIndex.end()); ++discriminatorByIndex)
 			{
 				if (discriminatorByIndex->first == product.m_validTaus.size())
 				{
@@ -247,16 +280,17 @@ public:
 				}
 			}
 			
+			std::vector<size_t>::const_iterator discriminatorHltPatternIndex = discriminatorHltPatternIndices.begin();
+			std::vector<std::vector<TauBinaryDiscriminatorHandle> >::const_iterator discriminatorHandles = discriminatorHandlesByHltName.begin();
 			for (std::map<std::string, std::vector<std::string> >::const_iterator discriminatorByHltName = discriminatorsByHltName.begin();
-				 validTau && (discriminatorByHltName != discriminatorsByHltName.end()); ++discriminatorByHltName)
+				 validTau && (discriminatorByHltName != discriminatorsByHltName.end());
+				 ++discriminatorByHltName, ++discriminatorHltPatternIndex, ++discriminatorHandles)
 			{
-				bool hasMatch = false;
-				for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-					hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(discriminatorByHltName->first, boost::regex::icase | boost::regex::extended));
+				bool hasMatch = m_hltPatternCache.MatchesAny(*discriminatorHltPatternIndex, product.m_selectedHltPositions);
 
 				if ((discriminatorByHltName->first == "default") || hasMatch)
 				{
-					validTau = validTau && ApplyDiscriminators(*tau, discriminatorByHltName->second, event);
+					validTau = validTau && ApplyDiscriminators(*tau, *discriminatorHandles, event);
 				}
 			}
 			
@@ -298,16 +332,28 @@ private:
 	
 	std::map<size_t, std::vector<std::string> > discriminatorsByIndex;
 	std::map<std::string, std::vector<std::string> > discriminatorsByHltName;
+	std::vector<size_t> discriminatorHltPatternIndices;
+
+	// discriminators resolved to their indices in the metadata, same structure as above
+	mutable std::map<size_t, std::vector<TauBinaryDiscriminatorHandle> > discriminatorHandlesByIndex;
+	mutable std::vector<std::vector<TauBinaryDiscriminatorHandle> > discriminatorHandlesByHltName;
+	mutable TauFloatDiscriminatorHandle decayModeFindingHandle = TauFloatDiscriminatorHandle("decayModeFinding");
+	mutable TauFloatDiscriminatorHandle decayModeFindingNewDMsHandle = TauFloatDiscriminatorHandle("decayModeFindingNewDMs");
+	
+	static std::vector<TauBinaryDiscriminatorHandle> CreateDiscriminatorHandles(std::vector<std::string> const& discriminators)
+	{
+		return std::vector<TauBinaryDiscriminatorHandle>(discriminators.begin(), discriminators.end());
+	}
 	
-	bool ApplyDiscriminators(KTau* tau, std::vector<std::string> const& discriminators,
+	bool ApplyDiscriminators(KTau* tau, std::vector<TauBinaryDiscriminatorHandle> const& discriminators,
 	                         KappaEvent const& event) const
 	{
 		bool validTau = true;
 		
-		for (std::vector<std::string>::const_iterator discriminator = discriminators.begin();
+		for (std::vector<TauBinaryDiscriminatorHandle>::const_iterator discriminator = discriminators.begin();
 		     validTau && (discriminator != discriminators.end()); ++discriminator)
 		{
-			validTau = validTau && tau->getId(*discriminator, event.m_tauMetadata);
+			validTau = validTau && discriminator->Get(*tau, event.m_tauMetadata);
 		}
 		
 		return validTau;
@@ -319,8 +365,8 @@ private:
 	bool IsTauIDRecommendation13TeV(KTau* tau, KappaEvent const& event, bool const& oldTauDMs, bool const& isAOD=false) const
 	{
 		const KVertex vertex = KVertex(event.m_vertexSummary->pv);
-		float decayModeDiscriminator = (oldTauDMs ? tau->getDiscriminator("decayModeFinding", event.m_tauMetadata)
-							  : tau->getDiscriminator("decayModeFindingNewDMs", event.m_tauMetadata));
+		float decayModeDiscriminator = (oldTauDMs ? decayModeFindingHandle.Get(*tau, event.m_tauMetadata)
+							  : decayModeFindingNewDMsHandle.Get(*tau, event.m_tauMetadata));
 		if(isAOD)
 		{
 			return ( decayModeDiscriminator > 0.5
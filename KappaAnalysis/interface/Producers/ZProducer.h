@@ -4,6 +4,7 @@
 #include "Artus/Utility/interface/Utility.h"
 
 #include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+#include "Artus/KappaAnalysis/interface/Utility/ResonanceCandidateBuilder.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 
 /** Producer class for Z boson reconstruction from muons/electrons.
@@ -43,6 +44,15 @@ class ZProducerBase : public KappaProducerBase
 	{
 		KappaProducerBase::Init(settings);
 
+		// opposite (or same) charge, |m(ll) - ZMass| < ZMassRange
+		ResonanceCandidateBuilder<KLepton>::Config zCandidateConfig;
+		zCandidateConfig.chargeRequirement = (settings.GetRequireOSZBoson() ?
+		                                      ResonanceCandidateBuilder<KLepton>::ChargeRequirement::NOT_SAME_SIGN :
+		                                      ResonanceCandidateBuilder<KLepton>::ChargeRequirement::SAME_SIGN);
+		zCandidateConfig.referenceMass = settings.GetZMass();
+		zCandidateConfig.massWindow = settings.GetZMassRange();
+		m_zCandidateBuilder.SetConfig(zCandidateConfig);
+
 		LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("ZMass", [](KappaEvent const & event, KappaProduct const & product)
 		{
 			return product.m_z.p4.M();
@@ -104,48 +114,18 @@ class ZProducerBase : public KappaProducerBase
 	product.m_found_zs = 0;
 	resetZ(product);
 
-	if (check_first_ll_collection){
-		for (unsigned int i = 0; i < (product.*m_validLeptonsMember1).size(); ++i) {
-			for (unsigned int j = 0; j < i; ++j){
-				KLepton* const lep1 = (product.*m_validLeptonsMember1).at(i);
-				KLepton* const lep2 = (product.*m_validLeptonsMember1).at(j);
-				if (lepton_pair_onZ(lep1,lep2,settings)){
-					product.m_found_zs++;
-					if (is_closer_to_Z((lep1->p4+lep2->p4).M(),product,settings))
-						setZ(product,lep1,lep2,settings);
-				}
-			}
-		}
-	}
-
-	// OK not the most elegant way, but at least it is understandable.
-	// If you have time you can also bring this double loop into a function which takes carre of differnt types of m_validLeptonsMember1/2
-	if (check_second_ll_collection){
-		for (unsigned int i = 0; i < (product.*m_validLeptonsMember2).size(); ++i) {
-			for (unsigned int j = 0; j < i; ++j){
-				KLepton* const lep1 = (product.*m_validLeptonsMember2).at(i);
-				KLepton* const lep2 = (product.*m_validLeptonsMember2).at(j);
-				if (lepton_pair_onZ(lep1,lep2,settings)){
-					product.m_found_zs++;
-					if (is_closer_to_Z((lep1->p4+lep2->p4).M(),product,settings))
-						setZ(product,lep1,lep2,settings);
-				}
-			}
-		}
-	}
+	m_zCandidates.clear();
+	if (check_first_ll_collection) m_zCandidateBuilder.AddPairs(product.*m_validLeptonsMember1, m_zCandidates);
+	if (check_second_ll_collection) m_zCandidateBuilder.AddPairs(product.*m_validLeptonsMember2, m_zCandidates);
+	if (check_cross_ll_collection) m_zCandidateBuilder.AddPairs(product.*m_validLeptonsMember1, product.*m_validLeptonsMember2, m_zCandidates);
 
-	if (check_cross_ll_collection){
-		for (unsigned int i = 0; i < (product.*m_validLeptonsMember1).size(); ++i) {
-			for (unsigned int j = 0; j < (product.*m_validLeptonsMember2).size(); ++j){
-				KLepton* const lep1 = (product.*m_validLeptonsMember1).at(i);
-				KLepton* const lep2 = (product.*m_validLeptonsMember2).at(j);
-				if (lepton_pair_onZ(lep1,lep2,settings)){
-					product.m_found_zs++;
-					if (is_closer_to_Z((lep1->p4+lep2->p4).M(),product,settings))
-						setZ(product,lep1,lep2,settings);
-				}
-			}
-		}
+	// the candidates are in the order of the former loops over the lepton pairs
+	product.m_found_zs = m_zCandidates.size();
+	for (typename std::vector<ResonanceCandidate<KLepton> >::const_iterator zCandidate = m_zCandidates.begin();
+	     zCandidate != m_zCandidates.end(); ++zCandidate)
+	{
+		if (is_closer_to_Z(zCandidate->mass, product, settings))
+			setZ(product, zCandidate->first, zCandidate->second, settings);
 	}
 
 	if (product.m_found_zs >1 && settings.GetVetoMultipleZs()) resetZ(product);
@@ -170,14 +150,8 @@ class ZProducerBase : public KappaProducerBase
 		bool check_first_ll_collection;
 		bool check_second_ll_collection;
 		bool check_cross_ll_collection;
-		bool lepton_pair_onZ(KLepton* const lep1, KLepton* const lep2, KappaSettings const& settings) const
-		{
-			if ((lep1->charge() * lep2->charge() > 0) == settings.GetRequireOSZBoson()) return false; // if charge not 0 can't be from Z
-			KLV z_test;
-			z_test.p4 = lep1->p4 + lep2->p4;
-			double test_mass_diff = fabs(z_test.p4.M() - settings.GetZMass());
-			return (test_mass_diff < settings.GetZMassRange()); // test if invM is in Z Range
-		}
+		mutable ResonanceCandidateBuilder<KLepton> m_zCandidateBuilder;
+		mutable std::vector<ResonanceCandidate<KLepton> > m_zCandidates;
 		bool is_closer_to_Z(double zCandidate_mass, KappaProduct& product, KappaSettings const& settings) const{
 			if (!product.m_zValid) return true;
 			return (fabs(zCandidate_mass-settings.GetZMass()) < fabs(product.m_z.p4.M()-settings.GetZMass()));
@@ -206,24 +180,27 @@ class ZProducerBase : public KappaProducerBase
 			bool first_lepton) const
 		{
 			KLepton* reference_lepton;
-			std::vector<const KPFCandidate*>* pf_candidate_collection = nullptr;
+			PFCandidateStore::Type pf_candidate_type;
 			if(first_lepton) reference_lepton = product.m_zLeptons.first;
 			else reference_lepton = product.m_zLeptons.second;
-			if(reference_lepton->flavour() == KLeptonFlavour::ELECTRON) pf_candidate_collection = &product.m_pfElectrons;
-			else if(product.m_zLeptons.first->flavour() == KLeptonFlavour::MUON) pf_candidate_collection = &product.m_pfMuons;
+			if(reference_lepton->flavour() == KLeptonFlavour::ELECTRON) pf_candidate_type = PFCandidateStore::Type::ELECTRON;
+			else if(product.m_zLeptons.first->flavour() == KLeptonFlavour::MUON) pf_candidate_type = PFCandidateStore::Type::MUON;
 			else return nullptr;
 
-			if(pf_candidate_collection != nullptr)
+			// first candidate of the type (in the order of the PF candidates) within the tolerances
+			PFCandidateStore const& pf_candidates = product.m_pfCandidates;
+			const float eta = reference_lepton->p4.Eta();
+			const float phi = reference_lepton->p4.Phi();
+			const float maxDeltaR2 = DeltaRMatcher::GetDeltaR2Cut(settings.GetdeltaRTolleranceForPF());
+			size_t matched_index = pf_candidates.GetNCandidates();
+			pf_candidates.ForEachCandidateNear(eta, phi, settings.GetdeltaRTolleranceForPF(), [&](size_t index)
 			{
-				for(unsigned int i = 0; i < pf_candidate_collection->size(); i++)
-				{
-					if(ROOT::Math::VectorUtil::DeltaR(reference_lepton->p4,pf_candidate_collection->at(i)->p4) < settings.GetdeltaRTolleranceForPF()
-						&& std::abs(reference_lepton->p4.Pt() - pf_candidate_collection->at(i)->p4.Pt()) < settings.GetPtTolleranceForPF())
-							return pf_candidate_collection->at(i);
-				}
-				return nullptr;
-			}
-			else return nullptr;
+				if(index < matched_index && pf_candidates.GetType(index) == pf_candidate_type
+					&& pf_candidates.GetDeltaR2(index, eta, phi) < maxDeltaR2
+					&& std::abs(reference_lepton->p4.Pt() - pf_candidates.GetPt(index)) < settings.GetPtTolleranceForPF())
+						matched_index = index;
+			});
+			return (matched_index < pf_candidates.GetNCandidates()) ? pf_candidates.GetCandidate(matched_index) : nullptr;
 		}
 		double calculate_theta_Z_LepMinus(KappaProduct& product) const
 		{
@@ -139,11 +139,62 @@ protected:
 #ifndef BTagCalibrationReader_H
 #define BTagCalibrationReader_H
 
+/**
+ * BTagFormula
+ *
+ * Formula of a BTagEntry (function of x) compiled into a small stack
+ * based bytecode. Supports numbers, x, + - * / ^, comparisons, && || !,
+ * the ternary operator (as written by th1ToFormulaLin/BinTree) and the
+ * functions log, log10, exp, sqrt, abs, pow, min, max, tanh, atan
+ * (also with the TMath:: prefix). Evaluation does not allocate memory
+ * and is thread-safe.
+ *
+ ************************************************************/
+
+#include <string>
+#include <vector>
+
+class BTagFormula
+{
+public:
+	BTagFormula() {}
+
+	// returns false if the formula uses unsupported features
+	bool compile(const std::string &formula);
+	bool isCompiled() const {return !code_.empty();}
+
+	double eval(double x) const;
+
+protected:
+	enum OpCode {
+		OP_CONST, OP_X,
+		OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_NEG, OP_NOT,
+		OP_LT, OP_LE, OP_GT, OP_GE, OP_EQ, OP_NE, OP_AND, OP_OR,
+		OP_LOG, OP_LOG10, OP_EXP, OP_SQRT, OP_ABS, OP_TANH, OP_ATAN, OP_MIN, OP_MAX,
+		OP_JUMP, OP_JUMP_IF_FALSE,
+	};
+	struct Instruction {
+		OpCode op;
+		double value;
+		size_t target;
+	};
+	static const size_t maxStackSize = 64;
+
+	class Parser;
+
+	std::vector<Instruction> code_;
+};
+
+
 /**
  * BTagCalibrationReader
  *
  * Helper class to pull out a specific set of BTagEntry's out of a
- * BTagCalibration. TF1 functions are set up at initialization time.
+ * BTagCalibration. The formulas are compiled at initialization time
+ * (TF1 functions are only used for formulas BTagFormula cannot compile).
+ * The entries are found via a sorted grid of all eta, pt (and discr)
+ * boundaries per jet flavour, which gives the first matching entry in
+ * O(log n).
  *
  ************************************************************/
 
@@ -176,14 +227,23 @@ protected:
 		float ptMax;
 		float discrMin;
 		float discrMax;
+		BTagFormula formula;
 		TF1 func;
 	};
+	struct EntryIndex {
+		std::vector<float> etaEdges;
+		std::vector<float> ptEdges;
+		std::vector<float> discrEdges;
+		// [(etaBin * nPtBins + ptBin) * nDiscrBins + discrBin], -1 if no entry
+		std::vector<int> cells;
+	};
 	void setupTmpData(const BTagCalibration* c);
+	void setupIndex();
 
 	BTagEntry::Parameters params;
 	std::map<BTagEntry::JetFlavor, std::vector<TmpEntry> > tmpData_;
+	std::map<BTagEntry::JetFlavor, EntryIndex> index_;
 	std::vector<bool> useAbsEta;
 };
 
 #endif  // BTagCalibrationReader_H
-
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "TRandom3.h"
 #include <TFile.h>
 #include <TH2.h>
 #include <TString.h>
@@ -8,6 +7,7 @@
 #include <iostream>
 
 #include "Artus/KappaAnalysis/interface/Utility/BTagCalibrationStandalone.h"
+#include "Artus/Utility/interface/CounterBasedRandom.h"
 
 class BTagSF
 {
@@ -20,8 +20,13 @@ public:
 	
 	void initBtagwp(std::string btagwp);
 
+	// the random numbers for the promotion/demotion are derived from the eta of the jet
 	bool isbtagged(double pt, float eta, float csv, Int_t jetflavor,
 	               unsigned int btagsys, unsigned int mistagsys, int year, float btagWP) const;
+	// the random number for the promotion/demotion is taken from the given stream
+	bool isbtagged(double pt, float eta, float csv, Int_t jetflavor,
+	               unsigned int btagsys, unsigned int mistagsys, int year, float btagWP,
+	               RandomStream& random) const;
 	double getSFb(double pt, float eta, unsigned int btagsys, int year) const;
 	double getSFc(double pt, float eta, unsigned int btagsys, int year) const;
 	double getSFl(double pt, float eta, unsigned int mistagsys, int year) const;
@@ -31,7 +36,6 @@ public:
 	enum { kNo, kDown, kUp }; // systematic variations
 
 private:
-	mutable TRandom3 randm;
 	BTagCalibration calib;
 	TFile* effFile = nullptr;
 	BTagCalibrationReader reader_mujets;
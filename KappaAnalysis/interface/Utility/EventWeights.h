@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Event weights stored in fixed slots instead of a map indexed by the weight names.
+
+   The names of the weights are registered once (usually in the Init functions of the producers and consumers)
+   in a registry shared by all pipelines, which assigns one slot per name. Registering the same name again
+   returns the same slot. Per event, setting and reading a weight is an array access, copying the weights
+   (e.g. from the global product to the local products) copies one fixed size array.
+
+   Weights can be registered as constant, i.e. they are the same for all events of a run (e.g. cross section
+   or number of generated events). The EventWeightProducer folds all constant weights into one factor once
+   per run.
+
+   Slots that are not set in an event are reported as not set, Get returns the default value for them.
+*/
+class EventWeights
+{
+public:
+
+	static const size_t MaxSlots = 64;
+	static const size_t NotRegistered = static_cast<size_t>(-1);
+
+	/// slot for the weight with this name, the weight is registered if needed
+	static size_t RegisterWeight(std::string const& name, bool isConstant=false);
+
+	/// slot for the weight with this name or NotRegistered
+	static size_t GetSlot(std::string const& name);
+
+	static std::string const& GetName(size_t slot);
+	static bool IsConstant(size_t slot);
+
+	/// bit mask of all slots registered as constant
+	static uint64_t GetConstantMask();
+
+	void Set(size_t slot, double value)
+	{
+		m_values[slot] = value;
+		m_setMask |= (uint64_t(1) << slot);
+	}
+
+	bool IsSet(size_t slot) const
+	{
+		return ((slot < MaxSlots) && ((m_setMask & (uint64_t(1) << slot)) != 0));
+	}
+
+	double Get(size_t slot, double defaultValue=1.0) const
+	{
+		return (IsSet(slot) ? m_values[slot] : defaultValue);
+	}
+
+	/// access via the weight names, requires a lookup in the registry and should not be used per event
+	void Set(std::string const& name, double value) { Set(RegisterWeight(name), value); }
+	bool IsSet(std::string const& name) const { return IsSet(GetSlot(name)); }
+	double Get(std::string const& name, double defaultValue=1.0) const { return Get(GetSlot(name), defaultValue); }
+
+	/// reference to one weight as returned by operator[]
+	class WeightReference
+	{
+	public:
+		WeightReference(EventWeights& weights, size_t slot) : m_weights(weights), m_slot(slot) {}
+
+		operator double() const { return m_weights.Get(m_slot); }
+
+		WeightReference& operator=(double value) { m_weights.Set(m_slot, value); return *this; }
+		WeightReference& operator=(WeightReference const& other) { return (*this = static_cast<double>(other)); }
+		WeightReference& operator+=(double value) { return (*this = (static_cast<double>(*this) + value)); }
+		WeightReference& operator-=(double value) { return (*this = (static_cast<double>(*this) - value)); }
+		WeightReference& operator*=(double value) { return (*this = (static_cast<double>(*this) * value)); }
+		WeightReference& operator/=(double value) { return (*this = (static_cast<double>(*this) / value)); }
+
+	private:
+		EventWeights& m_weights;
+		size_t m_slot;
+	};
+
+	/// map-like access as with the former std::map<std::string, double> (product.m_weights["name"] = value),
+	/// registers the name and sets unset weights to 0 as the insertion by a map, should not be used per event
+	WeightReference operator[](std::string const& name)
+	{
+		size_t slot = RegisterWeight(name);
+		if (! IsSet(slot))
+		{
+			Set(slot, 0.0);
+		}
+		return WeightReference(*this, slot);
+	}
+
+	/// bit mask of all slots set in this event
+	uint64_t GetSetMask() const { return m_setMask; }
+
+	/// names of all weights set in this event, ordered by slot
+	std::vector<std::string> GetSetNames() const;
+
+	void Clear() { m_setMask = 0; }
+
+private:
+
+	double m_values[MaxSlots] = {};
+	uint64_t m_setMask = 0;
+};
+
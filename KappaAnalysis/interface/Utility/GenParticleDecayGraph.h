@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Flat decay graph of generator particles.
+
+   The nodes are stored in breadth-first order and refer to the particles by their index in event.m_genParticles.
+   The daughters of a node are the consecutive nodes [GetDaughtersBegin(node), GetDaughtersEnd(node))
+   (compressed sparse row format). The root can be a virtual node (particle index -1), which only groups several
+   particles (e.g. the leptons from a boson decay). Particles that can be reached via several paths appear as
+   several nodes. The graph is built iteratively and Clear keeps the capacity of all arrays.
+
+   The classification of GenParticleDecayTree (charges, final states, prongs and decay modes) is done
+   by passes over the nodes, the charges and the detectability are looked up in compile time tables.
+*/
+class GenParticleDecayGraph
+{
+public:
+
+	static const size_t NoNode = static_cast<size_t>(-1);
+	static const int UnknownCharge = 5;
+
+	enum class DecayMode : int
+	{
+		NONE = -1,
+		E   = 1,
+		M   = 2,
+		//Greater 3 is hadronic
+		PI = 4,
+		KPLUS = 5,
+		KSTAR = 6,
+		RHO = 7,
+		AONE   = 8,
+		//These should appear for HiggsBoson
+		TAU = 10,
+		TAUTAU = 11
+	};
+
+	/// +1, -1, 0 or UnknownCharge for particles that are not listed
+	static int GetChargeFromPdgId(int pdgId);
+	static bool IsDetectablePdgId(int pdgId);
+	/// decay mode that is indicated by a decay product with this PDG ID, or DecayMode::NONE
+	static DecayMode GetDecayModeFromPdgId(int pdgId);
+
+	void Clear();
+
+	/// graph of the full decay chain of the particle
+	void Build(std::vector<KGenParticle>* genParticles, KGenParticle const* root);
+
+	/// graph with a virtual root node, whose daughters are the given particles
+	void Build(std::vector<KGenParticle>* genParticles, std::vector<KGenParticle*> const& rootDaughters);
+
+	size_t GetNNodes() const { return m_genParticleIndices.size(); }
+	size_t GetRoot() const { return (m_genParticleIndices.empty() ? NoNode : 0); }
+
+	/// the accessors for nodes accept NoNode and return NoNode, nullptr or zero daughters in this case
+	size_t GetMother(size_t node) const;
+	size_t GetDaughtersBegin(size_t node) const;
+	size_t GetDaughtersEnd(size_t node) const;
+	size_t GetNDaughters(size_t node) const;
+	size_t GetDaughter(size_t node, size_t daughterIndex) const;
+
+	/// node reached from the root via the given daughter indices, e.g. {0, 1} for the second daughter of the first daughter
+	size_t GetDescendant(std::initializer_list<size_t> daughterIndices) const;
+
+	/// first node that refers to the particle, or NoNode
+	size_t FindNode(KGenParticle const* genParticle) const;
+
+	/// index in event.m_genParticles, -1 for the virtual root node
+	int GetGenParticleIndex(size_t node) const;
+	KGenParticle* GetGenParticle(size_t node) const;
+
+	int GetCharge(size_t node) const;
+	bool IsDetectable(size_t node) const;
+	/// nodes without daughters (except for a virtual root)
+	bool IsFinalState(size_t node) const;
+
+	/// final states in the subtree of the node in depth-first order (as GenParticleDecayTree::CreateFinalStates)
+	void GetFinalStates(size_t node, std::vector<size_t>& finalStates) const;
+
+	/// number of final states with charge +-1 in the subtree of the node
+	int GetNProngs(size_t node) const;
+
+	/// decay mode of the particle (as GenParticleDecayTree::DetermineDecayMode): the daughters are visited
+	/// in depth-first order, the first recognised decay product of a branch stops the descent into it
+	DecayMode DetermineDecayMode(size_t node) const;
+
+private:
+
+	void AddNode(int genParticleIndex, size_t mother);
+	int GetIndex(KGenParticle const* genParticle) const;
+
+	/// adds the daughters of all nodes starting with firstNode in breadth-first order
+	void ExpandNodes(size_t firstNode);
+
+	std::vector<KGenParticle>* m_genParticles = nullptr;
+
+	// per node
+	std::vector<int> m_genParticleIndices;
+	std::vector<size_t> m_mothers;
+	std::vector<int> m_charges;
+	std::vector<char> m_detectable;
+	// size nNodes + 1
+	std::vector<size_t> m_daughterOffsets;
+
+	// scratch space for the depth-first passes
+	mutable std::vector<std::pair<size_t, size_t> > m_stack;
+};
+
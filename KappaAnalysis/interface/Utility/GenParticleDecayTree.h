@@ -5,11 +5,15 @@
 #include "KappaTools/RootTools/interface/HLTTools.h"
 
 #include "Artus/Utility/interface/DefaultValues.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleDecayGraph.h"
+
+
 /**
    \brief Extended class for genParticles in HiggsAnalysis
    This class implements additional quantities: m_charge, final states in the decay 
    subtree of considered particles. The final states can be devided into one, three and five prongs.
-  
+   The GenTauDecayProducer uses the flat GenParticleDecayGraph instead, which shares the PDG ID tables
+   with this class.
 */
 class GenParticleDecayTree {
 public:
@@ -26,21 +30,7 @@ public:
 	// will have 0 entries, if there are no daughters
 	std::vector<GenParticleDecayTree> m_daughters;
 
-	enum class DecayMode : int
-	{
-		NONE = -1,
-		E   = 1,
-		M   = 2,
-		//Greater 3 is hadronic
-		PI = 4,
-		KPLUS = 5,
-		KSTAR = 6,
-		RHO = 7,
-		AONE   = 8,
-		//These should appear for HiggsBoson
-		TAU = 10,
-		TAUTAU = 11
-	};
+	typedef GenParticleDecayGraph::DecayMode DecayMode;
 
 	DecayMode m_decayMode = DecayMode::NONE;
 
@@ -56,57 +46,4 @@ public:
 private:
 	int m_charge = 5;
 	bool m_detectable = false;
-	std::vector<int> m_positiveChargedParticlePdgIds = 
-	{
-		-DefaultValues::pdgIdElectron,
-		-DefaultValues::pdgIdMuon,
-		-DefaultValues::pdgIdTau, 
-		DefaultValues::pdgIdW, 
-		DefaultValues::pdgIdPiPlus,
-		DefaultValues::pdgIdRhoPlus770, 
-		DefaultValues::pdgIdKPlus, 
-		DefaultValues::pdgIdKStar, 
-		DefaultValues::pdgIdAOnePlus1260
-	};
-	
-	std::vector<int> m_negativeChargedParticlePdgIds =
-	{
-		DefaultValues::pdgIdElectron,
-		DefaultValues::pdgIdMuon,
-		DefaultValues::pdgIdTau, 
-		-DefaultValues::pdgIdW, 
-		-DefaultValues::pdgIdPiPlus,
-		-DefaultValues::pdgIdRhoPlus770,
-		-DefaultValues::pdgIdKPlus, 
-		-DefaultValues::pdgIdKStar, 
-		-DefaultValues::pdgIdAOnePlus1260
-	};
-	
-	std::vector<int> m_neutralParticlePdgIds =
-	{
-		DefaultValues::pdgIdNuE,
-		-DefaultValues::pdgIdNuE,
-		DefaultValues::pdgIdNuMu,
-		-DefaultValues::pdgIdNuMu,
-		DefaultValues::pdgIdNuTau,
-		-DefaultValues::pdgIdNuTau,
-		DefaultValues::pdgIdGamma,
-		DefaultValues::pdgIdPiZero, 
-		DefaultValues::pdgIdKLong, 
-		DefaultValues::pdgIdEta,
-		DefaultValues::pdgIdKShort
-	};
-	
-	std::vector<int> m_detectableParticlePdgIds = 
-	{
-		DefaultValues::pdgIdGamma,
-		DefaultValues::pdgIdPiPlus,
-		-DefaultValues::pdgIdPiPlus,
-		DefaultValues::pdgIdElectron,
-		-DefaultValues::pdgIdElectron,
-		DefaultValues::pdgIdMuon,
-		-DefaultValues::pdgIdMuon,
-		DefaultValues::pdgIdTau,
-		-DefaultValues::pdgIdTau
-	};
 };
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Indexed view of the generator particles of one event.
+
+   The view is built once per event (see KappaProduct::GetGenParticleView) and replaces the scans over
+   event.m_genParticles with their own pdgId and status conditions in the generator level producers.
+   It contains
+   - buckets of particle indices per absolute pdgId in one flat table, ordered by the index within a bucket,
+   - the status and a mask of the status flags (hard process, last copy, ...) per particle,
+   - the mothers and daughters of each particle (compressed sparse row format).
+   All arrays keep their capacity when the view is rebuilt.
+*/
+class GenParticleView
+{
+public:
+
+	enum Flag : uint16_t
+	{
+		IS_PROMPT = 1 << 0,
+		IS_HARD_PROCESS = 1 << 1,
+		FROM_HARD_PROCESS = 1 << 2,
+		IS_LAST_COPY = 1 << 3,
+		IS_DIRECT_PROMPT_TAU_DECAY_PRODUCT = 1 << 4
+	};
+
+	/// contiguous range of particle indices, usable in range based for loops
+	class IndexRange
+	{
+	public:
+		IndexRange(uint32_t const* begin = nullptr, uint32_t const* end = nullptr) : m_begin(begin), m_end(end) {}
+		uint32_t const* begin() const { return m_begin; }
+		uint32_t const* end() const { return m_end; }
+		size_t size() const { return (m_end - m_begin); }
+		bool empty() const { return (m_begin == m_end); }
+	private:
+		uint32_t const* m_begin;
+		uint32_t const* m_end;
+	};
+
+	bool IsBuilt() const { return m_isBuilt; }
+	void Build(std::vector<KGenParticle>* genParticles);
+
+	size_t GetNParticles() const { return m_status.size(); }
+	KGenParticle* GetParticle(size_t index) const { return &((*m_genParticles)[index]); }
+	size_t GetIndex(KGenParticle const* genParticle) const { return static_cast<size_t>(genParticle - m_genParticles->data()); }
+
+	int GetStatus(size_t index) const { return m_status[index]; }
+	uint16_t GetFlags(size_t index) const { return m_flags[index]; }
+	bool HasFlags(size_t index, uint16_t flags) const { return ((m_flags[index] & flags) == flags); }
+
+	/// indices of the particles with the absolute pdgId in ascending order
+	IndexRange GetParticlesWithAbsPdgId(int absPdgId) const;
+
+	/// indices of the particles with one of the absolute pdgIds in ascending order
+	void GetParticlesWithAbsPdgIds(std::vector<int> const& absPdgIds, std::vector<uint32_t>& indices) const;
+
+	/// first index >= startIndex of a particle with one of the absolute pdgIds and the status (-1: any status)
+	/// and all of the flags, or GetNParticles() if there is none
+	size_t FindFirst(std::vector<int> const& absPdgIds, int status=-1, uint16_t flags=0, size_t startIndex=0) const;
+
+	/// mothers in ascending order, every mother appears once
+	IndexRange GetMothers(size_t index) const;
+	IndexRange GetDaughters(size_t index) const;
+
+private:
+
+	bool m_isBuilt = false;
+	std::vector<KGenParticle>* m_genParticles = nullptr;
+
+	// per particle
+	std::vector<int> m_status;
+	std::vector<uint16_t> m_flags;
+
+	// sorted absolute pdgIds, the particles of m_bucketAbsPdgIds[i] are [m_bucketOffsets[i], m_bucketOffsets[i+1]) in m_bucketParticles
+	std::vector<int> m_bucketAbsPdgIds;
+	std::vector<uint32_t> m_bucketOffsets;
+	std::vector<uint32_t> m_bucketParticles;
+
+	// size nParticles + 1
+	std::vector<uint32_t> m_motherOffsets;
+	std::vector<uint32_t> m_mothers;
+	std::vector<uint32_t> m_daughterOffsets;
+	std::vector<uint32_t> m_daughters;
+
+	// scratch space for building
+	std::vector<std::pair<int, uint32_t> > m_sortedAbsPdgIds;
+	std::vector<uint32_t> m_lastMothers;
+};
+
@@ -2,9 +2,11 @@
 #pragma once
 
 #include "Kappa/DataFormats/interface/Kappa.h"
+#include "Artus/Utility/interface/FlatMap.h"
 #include "Artus/Utility/interface/SafeMap.h"
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
 #include "Artus/KappaAnalysis/interface/KappaEnumTypes.h"
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleView.h"
 
 /**
    \brief Place to collect functions of general use
@@ -20,10 +22,23 @@ public:
 	
 	static KGenParticle* GetGenMatchedParticle(
 			KLepton* lepton,
-			std::map<KLepton*, KGenParticle*> const& leptonGenParticleMap,
-			std::map<KLepton*, KGenTau*> const& leptonGenTauMap
+			FlatMap<KLepton*, KGenParticle*> const& leptonGenParticleMap,
+			FlatMap<KLepton*, KGenTau*> const& leptonGenTauMap
 	);
 
+	/// genTaus have to be built with BuildGenTausUW once per event
+	static KappaEnumTypes::GenMatchingCode GetGenMatchingCodeUW(
+			GenParticleView const& genParticleView,
+			std::vector<RMFLV> const& genTaus,
+			KLepton* lepton
+	);
+	static void BuildGenTausUW(
+			GenParticleView const& genParticleView,
+			std::vector<RMFLV>& genTaus
+	);
+
+	/// these versions index the generator particles for every call,
+	/// use the versions with a GenParticleView (KappaProduct::GetGenParticleView) instead
 	static KappaEnumTypes::GenMatchingCode GetGenMatchingCodeUW(
 			KappaTypes::event_type const& event,
 			KLepton* lepton
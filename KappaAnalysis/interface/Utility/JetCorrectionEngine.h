@@ -0,0 +1,156 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TFormula.h>
+
+#include "CondFormats/JetMETObjects/interface/JetCorrectorParameters.h"
+
+
+/**
+   \brief Input variables of the jet energy corrections for all jets of one event (structure of arrays).
+
+   The vectors are reused from event to event, Clear keeps their capacity.
+*/
+struct JetCorrectionInputs
+{
+	std::vector<double> pt;
+	std::vector<double> eta;
+	std::vector<double> phi;
+	std::vector<double> energy;
+	std::vector<double> area;
+
+	double rho = 0.0;
+	int nVertices = 0;
+
+	size_t size() const { return pt.size(); }
+
+	void Clear();
+
+	template<class TJet>
+	void AddJet(TJet const& jet)
+	{
+		pt.push_back(jet.p4.Pt());
+		eta.push_back(jet.p4.Eta());
+		phi.push_back(jet.p4.Phi());
+		energy.push_back(jet.p4.E());
+		area.push_back(jet.area);
+	}
+};
+
+
+/**
+   \brief One level of the jet energy corrections (e.g. L2Relative) stored in flat tables.
+
+   The records of the JetCorrectorParameters are converted into contiguous arrays of bin boundaries,
+   ranges of the formula variables and formula parameters. The formula is compiled once and evaluated
+   with the parameters of the bin (TFormula::EvalPar), as done by SimpleJetCorrector for single jets.
+   With one binning variable (usually the jet eta), the bin is found by a binary search in the sorted
+   lower bin edges, otherwise the bins are searched linearly starting with the bin found for the previous jet.
+*/
+class JetCorrectionLevelTable
+{
+public:
+
+	enum class Variable : int
+	{
+		NONE = -1,
+		JET_PT = 0,
+		JET_ETA = 1,
+		JET_PHI = 2,
+		JET_E = 3,
+		JET_AREA = 4,
+		RHO = 5,
+		N_VERTICES = 6
+	};
+	static Variable ToVariable(std::string const& variableName);
+
+	explicit JetCorrectionLevelTable(JetCorrectorParameters const& parameters);
+
+	/// false, if the level uses features that are not implemented here (response functions, unknown variables)
+	bool IsSupported() const { return m_isSupported; }
+	std::string const& GetLevel() const { return m_level; }
+
+	/// multiply the corrections for all jets by the correction of this level
+	/// and update pt and energy of the jets accordingly
+	void Apply(JetCorrectionInputs& inputs, std::vector<double>& corrections) const;
+
+private:
+
+	/// returns -1 if the jet is outside of the binning
+	int FindBin(double const* binValues, int& previousBin) const;
+
+	std::string m_level;
+	bool m_isSupported = true;
+
+	std::vector<Variable> m_binVariables;
+	std::vector<Variable> m_formulaVariables;
+	std::unique_ptr<TFormula> m_formula;
+
+	size_t m_nBins = 0;
+	// [bin * nBinVariables + variable], sorted by the lower edges for one binning variable
+	std::vector<double> m_binLowerEdges;
+	std::vector<double> m_binUpperEdges;
+	// [bin * nFormulaVariables + variable]
+	std::vector<double> m_formulaVariableMinima;
+	std::vector<double> m_formulaVariableMaxima;
+	// [bin * m_nParameters + parameter]
+	std::vector<double> m_parameters;
+	size_t m_nParameters = 0;
+};
+
+
+/**
+   \brief Evaluation of all levels of the jet energy corrections for all jets of an event in one pass.
+
+   Replacement for FactorizedJetCorrector, which is configured and evaluated jet by jet via string keyed setters.
+   The levels are applied in the given order, the pt and energy of the jets are updated after each level.
+   The results are the total correction factors for the p4 of the uncorrected jets.
+*/
+class JetCorrectionEngine
+{
+public:
+
+	explicit JetCorrectionEngine(std::vector<JetCorrectorParameters> const& parameters);
+
+	/// false, if at least one level cannot be evaluated by the engine
+	bool IsSupported() const;
+	size_t GetNLevels() const { return m_levels.size(); }
+
+	/// the inputs are modified (pt and energy are the corrected values afterwards)
+	void GetCorrections(JetCorrectionInputs& inputs, std::vector<double>& corrections) const;
+
+private:
+	std::vector<std::unique_ptr<JetCorrectionLevelTable> > m_levels;
+};
+
+
+/**
+   \brief One source of the jet energy correction uncertainties stored in flat tables.
+
+   Replacement for JetCorrectionUncertainty for the evaluation of many jets. The uncertainty parameters are
+   binned in the jet eta and contain (pt, up, down) nodes, between which the uncertainties are interpolated
+   linearly (as in SimpleJetCorrectionUncertainty). Jets outside of the eta binning get an uncertainty of zero.
+*/
+class JetCorrectionUncertaintyTable
+{
+public:
+
+	explicit JetCorrectionUncertaintyTable(JetCorrectorParameters const& parameters);
+
+	/// relative uncertainties (positive) for all jets, written with the given stride
+	void GetUncertainties(JetCorrectionInputs const& inputs, float* uncertaintiesUp, float* uncertaintiesDown, size_t stride) const;
+
+private:
+
+	// sorted lower and upper eta edges
+	std::vector<double> m_binLowerEdges;
+	std::vector<double> m_binUpperEdges;
+	// nodes of all bins, the nodes of bin i are in [m_nodeOffsets[i], m_nodeOffsets[i+1])
+	std::vector<size_t> m_nodeOffsets;
+	std::vector<float> m_nodePt;
+	std::vector<float> m_nodeUp;
+	std::vector<float> m_nodeDown;
+};
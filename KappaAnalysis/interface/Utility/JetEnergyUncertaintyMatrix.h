@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+#include "Artus/Utility/interface/FlatMap.h"
+
+
+/**
+   \brief Relative jet energy uncertainties of all jets of an event for all uncertainty sources.
+
+   Filled by the JetCorrectionUncertaintyMatrixProducer for the corrected jets. The rows are addressed by
+   the pointers to the corrected jets (e.g. the valid jets), the columns by the index of the source
+   (see GetSourceIndex). The uncertainties are stored as positive numbers for the up and down shifts.
+   Reset keeps the capacity of all arrays.
+*/
+class JetEnergyUncertaintyMatrix
+{
+public:
+
+	static const size_t NotAvailable = static_cast<size_t>(-1);
+
+	/// the names are not copied, they need to live as long as the matrix is used
+	void Reset(std::vector<std::string> const* sources, size_t nJets);
+
+	/// adds a row for the jet and returns its index
+	size_t AddJet(KLV const* jet);
+
+	std::vector<std::string> const& GetSources() const;
+	size_t GetNSources() const { return ((m_sources == nullptr) ? 0 : m_sources->size()); }
+	size_t GetNJets() const { return m_jetRows.size(); }
+
+	/// index of the source or NotAvailable
+	size_t GetSourceIndex(std::string const& source) const;
+
+	bool HasJet(KLV const* jet) const { return (m_jetRows.count(jet) > 0); }
+
+	/// relative uncertainty of the jet or zero for unknown jets
+	float GetUncertainty(KLV const* jet, size_t sourceIndex, bool up) const;
+
+	/// p4 * (1 + shift * uncertainty), the sign of the shift selects the up or down uncertainty
+	RMFLV GetShiftedP4(KLV const* jet, size_t sourceIndex, float shift) const;
+
+	/// columns for the up and down uncertainties of one source, the stride between the jets is the number of sources
+	float* GetUncertaintiesUp(size_t sourceIndex) { return (m_uncertaintiesUp.data() + sourceIndex); }
+	float* GetUncertaintiesDown(size_t sourceIndex) { return (m_uncertaintiesDown.data() + sourceIndex); }
+
+private:
+
+	std::vector<std::string> const* m_sources = nullptr;
+	FlatMap<KLV const*, size_t> m_jetRows;
+
+	// [row * nSources + source]
+	std::vector<float> m_uncertaintiesUp;
+	std::vector<float> m_uncertaintiesDown;
+};
+
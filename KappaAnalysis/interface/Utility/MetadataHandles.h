@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Name of a Kappa tag/discriminator/ID resolved to its index in the list of names in the metadata.
+
+   The string based accessors of the Kappa objects (e.g. KJet::getTag) search the names in the metadata
+   for every call. A handle only searches the names if the metadata has changed (new file or lumi section).
+   Resolve has to be called once per event before the values are read from the objects. It only compares
+   the list (address and size) and the name at the resolved index with the previous call.
+
+   Names that are not available in the metadata are passed on to the string based accessors,
+   such that the behaviour in this case (default values, error messages) does not change.
+*/
+class MetadataNameHandle
+{
+public:
+
+	static const size_t NotAvailable = static_cast<size_t>(-1);
+
+	explicit MetadataNameHandle(std::string const& name = "");
+
+	/// returns true if the name is available in the list
+	bool Resolve(std::vector<std::string> const& names);
+
+	std::string const& GetName() const { return m_name; }
+	bool IsAvailable() const { return (m_index != NotAvailable); }
+	size_t GetIndex() const { return m_index; }
+
+private:
+	std::string m_name;
+
+	std::vector<std::string> const* m_names = nullptr;
+	size_t m_nNames = 0;
+	size_t m_index = NotAvailable;
+};
+
+
+/// handle for KJet::getTag (b-tag discriminators, PU jet ID discriminators)
+class JetTagHandle : public MetadataNameHandle
+{
+public:
+	explicit JetTagHandle(std::string const& name = "") : MetadataNameHandle(name) {}
+
+	bool Resolve(KJetMetadata const* metadata)
+	{
+		return MetadataNameHandle::Resolve(metadata->tagNames);
+	}
+
+	float Get(KJet const& jet, KJetMetadata const* metadata) const
+	{
+		return (IsAvailable() ? jet.tags[GetIndex()] : jet.getTag(GetName(), metadata));
+	}
+};
+
+
+/// handle for KJet::getId (binary IDs, e.g. PU jet IDs)
+class JetIdHandle : public MetadataNameHandle
+{
+public:
+	explicit JetIdHandle(std::string const& name = "") : MetadataNameHandle(name) {}
+
+	bool Resolve(KJetMetadata const* metadata)
+	{
+		return MetadataNameHandle::Resolve(metadata->idNames);
+	}
+
+	bool Get(KJet const& jet, KJetMetadata const* metadata) const
+	{
+		return (IsAvailable() ? ((jet.binaryIds & (1u << GetIndex())) != 0) : jet.getId(GetName(), metadata));
+	}
+};
+
+
+/// handle for KElectron::getId (MVA IDs and other float values stored by name)
+class ElectronIdHandle : public MetadataNameHandle
+{
+public:
+	explicit ElectronIdHandle(std::string const& name = "") : MetadataNameHandle(name) {}
+
+	bool Resolve(KElectronMetadata const* metadata)
+	{
+		return MetadataNameHandle::Resolve(metadata->idNames);
+	}
+
+	float Get(KElectron const& electron, KElectronMetadata const* metadata) const
+	{
+		return (IsAvailable() ? electron.getId(GetIndex()) : electron.getId(GetName(), metadata));
+	}
+};
+
+
+/// handle for KTau::getId (binary discriminators)
+class TauBinaryDiscriminatorHandle : public MetadataNameHandle
+{
+public:
+	explicit TauBinaryDiscriminatorHandle(std::string const& name = "") : MetadataNameHandle(name) {}
+
+	bool Resolve(KTauMetadata const* metadata)
+	{
+		return MetadataNameHandle::Resolve(metadata->binaryDiscriminatorNames);
+	}
+
+	bool Get(KTau const& tau, KTauMetadata const* metadata) const
+	{
+		return (IsAvailable() ? ((tau.binaryDiscriminators & (1ull << GetIndex())) != 0) : tau.getId(GetName(), metadata));
+	}
+};
+
+
+/// handle for KTau::getDiscriminator (float discriminators)
+class TauFloatDiscriminatorHandle : public MetadataNameHandle
+{
+public:
+	explicit TauFloatDiscriminatorHandle(std::string const& name = "") : MetadataNameHandle(name) {}
+
+	bool Resolve(KTauMetadata const* metadata)
+	{
+		return MetadataNameHandle::Resolve(metadata->floatDiscriminatorNames);
+	}
+
+	float Get(KTau const& tau, KTauMetadata const* metadata) const
+	{
+		return (IsAvailable() ? tau.floatDiscriminators[GetIndex()] : tau.getDiscriminator(GetName(), metadata));
+	}
+};
+
+
+/// resolve all handles of a collection
+template<class THandle, class TMetadata>
+void ResolveMetadataHandles(std::vector<THandle>& handles, TMetadata const* metadata)
+{
+	for (typename std::vector<THandle>::iterator handle = handles.begin(); handle != handles.end(); ++handle)
+	{
+		handle->Resolve(metadata);
+	}
+}
+
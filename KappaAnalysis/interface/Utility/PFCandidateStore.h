@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+#include "Artus/Utility/interface/EtaPhiGrid.h"
+
+
+/**
+   \brief PF candidates of one event, transposed into separate arrays.
+
+   Filled once per event by the PFCandidatesProducer. Per candidate, the arrays contain pt, eta, phi,
+   the type (from the absolute pdgId) and whether the candidate is associated to the first PV
+   (fromFirstPVFlag > 1). The candidates are bucketed into an EtaPhiGrid with a cell size given at filling,
+   which is used by ForEachCandidateNear for search distances up to this size.
+   The indices refer to the order in event.m_packedPFCandidates. Fill keeps the capacity of all arrays.
+*/
+class PFCandidateStore
+{
+public:
+
+	enum class Type : uint8_t
+	{
+		CHARGED_HADRON = 0,
+		NEUTRAL_HADRON = 1,
+		ELECTRON = 2,
+		MUON = 3,
+		PHOTON = 4,
+		HADRONIC_HF = 5,
+		ELECTROMAGNETIC_HF = 6,
+		UNKNOWN = 7
+	};
+	static const size_t NTypes = 8;
+
+	static Type GetTypeFromPdgId(int pdgId);
+
+	void Fill(std::vector<KPFCandidate> const* candidates, float gridCellSize);
+
+	size_t GetNCandidates() const { return m_pts.size(); }
+	size_t GetNCandidates(Type type) const { return m_nCandidatesPerType[static_cast<size_t>(type)]; }
+
+	KPFCandidate const* GetCandidate(size_t index) const { return &((*m_candidates)[index]); }
+	float GetPt(size_t index) const { return m_pts[index]; }
+	float GetEta(size_t index) const { return m_etas[index]; }
+	float GetPhi(size_t index) const { return m_phis[index]; }
+	Type GetType(size_t index) const { return m_types[index]; }
+	bool IsFromFirstPV(size_t index) const { return (m_fromFirstPV[index] != 0); }
+
+	/// DeltaR^2 of the candidate to (eta, phi)
+	float GetDeltaR2(size_t index, float eta, float phi) const
+	{
+		float deltaEta = m_etas[index] - eta;
+		float deltaPhi = std::abs(m_phis[index] - phi);
+		if (deltaPhi > static_cast<float>(M_PI))
+		{
+			deltaPhi = static_cast<float>(2.0 * M_PI) - deltaPhi;
+		}
+		return (deltaEta * deltaEta + deltaPhi * deltaPhi);
+	}
+
+	float GetGridCellSize() const { return m_gridCellSize; }
+
+	/// call function(index) for all candidates that can be closer than maxDeltaR to (eta, phi),
+	/// the distance itself has to be checked by the caller; the order of the candidates is not defined
+	template<class TFunction>
+	void ForEachCandidateNear(float eta, float phi, float maxDeltaR, TFunction function) const
+	{
+		if (maxDeltaR <= m_gridCellSize)
+		{
+			m_grid.ForEachCandidate(eta, phi, function);
+		}
+		else
+		{
+			for (size_t index = 0; index < m_pts.size(); ++index)
+			{
+				function(index);
+			}
+		}
+	}
+
+private:
+
+	std::vector<KPFCandidate> const* m_candidates = nullptr;
+
+	// per candidate
+	std::vector<float> m_pts;
+	std::vector<float> m_etas;
+	std::vector<float> m_phis;
+	std::vector<Type> m_types;
+	std::vector<uint8_t> m_fromFirstPV;
+
+	size_t m_nCandidatesPerType[NTypes] = {};
+
+	float m_gridCellSize = 0.0f;
+	EtaPhiGrid m_grid;
+};
+
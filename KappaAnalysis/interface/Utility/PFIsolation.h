@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Artus/KappaAnalysis/interface/Utility/PFCandidateStore.h"
+
+
+/**
+   \brief PF isolation sums of several objects for several cone sizes.
+
+   The sums are stored in one flat array [object][cone][component]. Reset keeps the capacity.
+*/
+class PFIsolationSums
+{
+public:
+
+	enum Component : size_t
+	{
+		CHARGED = 0, // charged hadrons from the first PV
+		NEUTRAL = 1, // neutral hadrons
+		PHOTON = 2,
+		PILEUP = 3, // charged hadrons not from the first PV
+	};
+	static const size_t NComponents = 4;
+
+	void Reset(size_t nObjects, size_t nCones);
+
+	size_t GetNObjects() const { return m_nObjects; }
+	size_t GetNCones() const { return m_nCones; }
+
+	float GetSum(size_t objectIndex, size_t coneIndex, Component component) const
+	{
+		return m_sums[(objectIndex * m_nCones + coneIndex) * NComponents + component];
+	}
+
+	/// sums of one object and cone, indexed by Component
+	float* GetSums(size_t objectIndex, size_t coneIndex)
+	{
+		return (m_sums.data() + (objectIndex * m_nCones + coneIndex) * NComponents);
+	}
+
+	/// (charged + max(0, neutral + photon - deltaBetaFactor * pileUp)) / pt
+	float GetRelativeIsolationDeltaBeta(size_t objectIndex, size_t coneIndex, float pt, float deltaBetaFactor=0.5f) const;
+
+private:
+
+	size_t m_nObjects = 0;
+	size_t m_nCones = 0;
+	std::vector<float> m_sums;
+};
+
+
+/**
+   \brief Computes the PF isolation sums of several objects for all cone sizes in one pass over the candidates.
+
+   For every object, the candidates of the PFCandidateStore near the object are visited once, their DeltaR^2 is
+   computed once and they are added to all cones they are contained in. Candidates within the veto cone of their
+   component or below its pt threshold are not counted. All cuts are exclusive (DeltaR < cone size).
+*/
+class PFIsolationEngine
+{
+public:
+
+	struct Config
+	{
+		std::vector<float> coneSizes;
+		float vetoCones[PFIsolationSums::NComponents] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float minPts[PFIsolationSums::NComponents] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	};
+
+	void Init(Config const& config);
+
+	Config const& GetConfig() const { return m_config; }
+	float GetMaxConeSize() const { return m_maxConeSize; }
+
+	void Compute(PFCandidateStore const& pfCandidates, std::vector<float> const& etas, std::vector<float> const& phis,
+	             PFIsolationSums& sums) const;
+
+private:
+
+	Config m_config;
+	float m_maxConeSize = 0.0f;
+
+	std::vector<float> m_coneSizes2;
+	float m_vetoCones2[PFIsolationSums::NComponents] = { 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
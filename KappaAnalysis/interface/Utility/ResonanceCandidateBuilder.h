@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "Kappa/DataFormats/interface/Kappa.h"
+
+
+/**
+   \brief Pair of objects forming a resonance candidate, e.g. the two leptons of a Z boson candidate.
+
+   The indices refer to the positions in the collections given to ResonanceCandidateBuilder::AddPairs.
+*/
+template<class TObject>
+struct ResonanceCandidate
+{
+	TObject* first = nullptr;
+	TObject* second = nullptr;
+	size_t firstIndex = 0;
+	size_t secondIndex = 0;
+	float mass = 0.0f;
+	/// ranking criterion, smaller values are better (see ResonanceCandidateBuilder::Ranking)
+	float rankingValue = 0.0f;
+};
+
+
+/**
+   \brief Builds resonance candidates from all pairs of objects of one or two collections.
+
+   The kinematics of the objects (four-momentum, eta, phi, pt, charge, flavour) are copied
+   into separate arrays once per collection, the pairs are then pruned in the order of increasing cost:
+   charge and flavour requirements, mass window, minimum DeltaR. The mass of a pair is taken from the
+   sum of the two RMFLV four-momenta, as (lep1->p4 + lep2->p4).M() in the producers.
+   The accepted pairs are appended to the candidate list in the order of enumeration:
+   - pairs of one collection: (objects[i], objects[j]) for all j < i,
+   - pairs of two collections: (objects1[i], objects2[j]) for all i, j.
+   Rank sorts the candidates (stable) according to the configured ranking and optionally keeps only
+   the best ones. The charge and flavour are taken from KLepton::charge and KLepton::flavour, other objects
+   are treated as neutral objects without flavour.
+
+   TObject is the common base class of the objects in the candidates (e.g. KLepton or KBasicJet).
+   The arrays keep their capacity between the events.
+*/
+template<class TObject>
+class ResonanceCandidateBuilder
+{
+public:
+
+	enum class ChargeRequirement : int
+	{
+		ANY = 0,
+		NOT_SAME_SIGN = 1, // charge1 * charge2 <= 0
+		SAME_SIGN = 2, // charge1 * charge2 > 0
+	};
+
+	enum class FlavourRequirement : int
+	{
+		ANY = 0,
+		SAME = 1,
+		DIFFERENT = 2,
+	};
+
+	enum class Ranking : int
+	{
+		NONE = 0, // order of enumeration
+		CLOSEST_MASS = 1, // |mass - referenceMass|
+		HIGHEST_SCALAR_PT_SUM = 2, // pt1 + pt2
+		HIGHEST_PT = 3, // pt of the candidate
+	};
+
+	struct Config
+	{
+		ChargeRequirement chargeRequirement = ChargeRequirement::ANY;
+		FlavourRequirement flavourRequirement = FlavourRequirement::ANY;
+		float referenceMass = 0.0f;
+		/// |mass - referenceMass| < massWindow, no cut for negative values
+		float massWindow = -1.0f;
+		/// DeltaR(first, second) > minDeltaR, no cut for negative values
+		float minDeltaR = -1.0f;
+		Ranking ranking = Ranking::NONE;
+		/// number of candidates kept by Rank, zero keeps all candidates
+		size_t maxCandidates = 0;
+	};
+
+	void SetConfig(Config const& config)
+	{
+		m_config = config;
+	}
+
+	Config const& GetConfig() const { return m_config; }
+
+	/// pairs of different objects of one collection
+	template<class TDerived>
+	void AddPairs(std::vector<TDerived*> const& objects, std::vector<ResonanceCandidate<TObject> >& candidates)
+	{
+		static_assert(std::is_base_of<TObject, TDerived>::value, "The objects need to derive from TObject.");
+		m_kinematics1.Fill(objects);
+		for (size_t index1 = 0; index1 < objects.size(); ++index1)
+		{
+			for (size_t index2 = 0; index2 < index1; ++index2)
+			{
+				AddPair(m_kinematics1, index1, m_kinematics1, index2, objects[index1], objects[index2], candidates);
+			}
+		}
+	}
+
+	/// pairs of one object of each collection, the collections must not contain the same objects
+	template<class TDerived1, class TDerived2>
+	void AddPairs(std::vector<TDerived1*> const& objects1, std::vector<TDerived2*> const& objects2,
+	              std::vector<ResonanceCandidate<TObject> >& candidates)
+	{
+		static_assert(std::is_base_of<TObject, TDerived1>::value && std::is_base_of<TObject, TDerived2>::value,
+		              "The objects need to derive from TObject.");
+		m_kinematics1.Fill(objects1);
+		m_kinematics2.Fill(objects2);
+		for (size_t index1 = 0; index1 < objects1.size(); ++index1)
+		{
+			for (size_t index2 = 0; index2 < objects2.size(); ++index2)
+			{
+				AddPair(m_kinematics1, index1, m_kinematics2, index2, objects1[index1], objects2[index2], candidates);
+			}
+		}
+	}
+
+	/// sort the candidates by the ranking value (keeping the order of equally ranked candidates)
+	/// and keep the maxCandidates best ones
+	void Rank(std::vector<ResonanceCandidate<TObject> >& candidates) const
+	{
+		if (m_config.ranking != Ranking::NONE)
+		{
+			std::stable_sort(candidates.begin(), candidates.end(),
+			                 [](ResonanceCandidate<TObject> const& candidate1, ResonanceCandidate<TObject> const& candidate2) -> bool
+			                 { return candidate1.rankingValue < candidate2.rankingValue; });
+		}
+		if ((m_config.maxCandidates > 0) && (candidates.size() > m_config.maxCandidates))
+		{
+			candidates.resize(m_config.maxCandidates);
+		}
+	}
+
+private:
+
+	struct Kinematics
+	{
+		std::vector<RMFLV> p4;
+		std::vector<float> eta;
+		std::vector<float> phi;
+		std::vector<float> pt;
+		std::vector<int> charge;
+		std::vector<int> flavour;
+
+		template<class TDerived>
+		void Fill(std::vector<TDerived*> const& objects)
+		{
+			size_t nObjects = objects.size();
+			p4.resize(nObjects);
+			eta.resize(nObjects);
+			phi.resize(nObjects);
+			pt.resize(nObjects);
+			charge.resize(nObjects);
+			flavour.resize(nObjects);
+			for (size_t index = 0; index < nObjects; ++index)
+			{
+				p4[index] = objects[index]->p4;
+				eta[index] = p4[index].Eta();
+				phi[index] = p4[index].Phi();
+				pt[index] = p4[index].Pt();
+				charge[index] = GetCharge(objects[index]);
+				flavour[index] = GetFlavour(objects[index]);
+			}
+		}
+	};
+
+	template<class TDerived>
+	static typename std::enable_if<std::is_base_of<KLepton, TDerived>::value, int>::type GetCharge(TDerived const* object)
+	{
+		return object->charge();
+	}
+	template<class TDerived>
+	static typename std::enable_if<! std::is_base_of<KLepton, TDerived>::value, int>::type GetCharge(TDerived const*)
+	{
+		return 0;
+	}
+	template<class TDerived>
+	static typename std::enable_if<std::is_base_of<KLepton, TDerived>::value, int>::type GetFlavour(TDerived const* object)
+	{
+		return static_cast<int>(object->flavour());
+	}
+	template<class TDerived>
+	static typename std::enable_if<! std::is_base_of<KLepton, TDerived>::value, int>::type GetFlavour(TDerived const*)
+	{
+		return 0;
+	}
+
+	void AddPair(Kinematics const& kinematics1, size_t index1, Kinematics const& kinematics2, size_t index2,
+	             TObject* object1, TObject* object2, std::vector<ResonanceCandidate<TObject> >& candidates) const
+	{
+		int chargeProduct = kinematics1.charge[index1] * kinematics2.charge[index2];
+		if (((m_config.chargeRequirement == ChargeRequirement::NOT_SAME_SIGN) && (chargeProduct > 0)) ||
+		    ((m_config.chargeRequirement == ChargeRequirement::SAME_SIGN) && (chargeProduct <= 0)))
+		{
+			return;
+		}
+
+		bool sameFlavour = (kinematics1.flavour[index1] == kinematics2.flavour[index2]);
+		if (((m_config.flavourRequirement == FlavourRequirement::SAME) && (! sameFlavour)) ||
+		    ((m_config.flavourRequirement == FlavourRequirement::DIFFERENT) && sameFlavour))
+		{
+			return;
+		}
+
+		RMFLV p4 = kinematics1.p4[index1] + kinematics2.p4[index2];
+		float mass = p4.M();
+		if ((m_config.massWindow >= 0.0f) && (! (std::abs(mass - m_config.referenceMass) < m_config.massWindow)))
+		{
+			return;
+		}
+
+		if (m_config.minDeltaR >= 0.0f)
+		{
+			float deltaEta = kinematics1.eta[index1] - kinematics2.eta[index2];
+			float deltaPhi = std::abs(kinematics1.phi[index1] - kinematics2.phi[index2]);
+			if (deltaPhi > static_cast<float>(M_PI))
+			{
+				deltaPhi = static_cast<float>(2.0 * M_PI) - deltaPhi;
+			}
+			if (deltaEta * deltaEta + deltaPhi * deltaPhi <= m_config.minDeltaR * m_config.minDeltaR)
+			{
+				return;
+			}
+		}
+
+		ResonanceCandidate<TObject> candidate;
+		candidate.first = object1;
+		candidate.second = object2;
+		candidate.firstIndex = index1;
+		candidate.secondIndex = index2;
+		candidate.mass = mass;
+		switch (m_config.ranking)
+		{
+			case Ranking::CLOSEST_MASS:
+				candidate.rankingValue = std::abs(candidate.mass - m_config.referenceMass);
+				break;
+			case Ranking::HIGHEST_SCALAR_PT_SUM:
+				candidate.rankingValue = -(kinematics1.pt[index1] + kinematics2.pt[index2]);
+				break;
+			case Ranking::HIGHEST_PT:
+				candidate.rankingValue = -p4.Pt();
+				break;
+			case Ranking::NONE:
+				candidate.rankingValue = 0.0f;
+				break;
+			default:
+				candidate.rankingValue = 0.0f;
+				break;
+		}
+		candidates.push_back(candidate);
+	}
+
+	Config m_config;
+
+	Kinematics m_kinematics1;
+	Kinematics m_kinematics2;
+};
+
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+   \brief Flat, index-addressed result of the trigger matching of one type of reco objects.
+
+   One entry is stored for every tested combination of a reco object, a fired HLT path and a
+   filter of this path that matches the configured patterns. The entry refers to the object by its
+   index in m_objects, to the HLT path by its position in KLumiInfo::hltNames and to the filter by
+   its index in KTriggerObjectMetadata::toFilter. The trigger objects matched within the entry are
+   m_triggerObjectIndices[firstTriggerObject, firstTriggerObject + nTriggerObjects), given as
+   indices in KTriggerObjects::trgObjects.
+*/
+template<class TObject>
+class TriggerMatchingResult
+{
+public:
+
+	struct Entry
+	{
+		size_t objectIndex;
+		size_t hltPosition;
+		size_t filterIndex;
+		size_t firstTriggerObject;
+		size_t nTriggerObjects;
+	};
+
+	/// the valid objects at the time of the matching
+	std::vector<TObject*> m_objects;
+
+	std::vector<Entry> m_entries;
+	std::vector<size_t> m_triggerObjectIndices;
+
+	/// the capacities are kept for the next event
+	void Clear()
+	{
+		m_objects.clear();
+		m_entries.clear();
+		m_triggerObjectIndices.clear();
+	}
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+
+/**
+   \brief Cache for matching configured (regular expression) patterns against HLT path or filter names.
+
+   The patterns are compiled once (case insensitive, POSIX extended syntax) and are matched against
+   the list of names of the current run/lumi section (e.g. KLumiInfo::hltNames or
+   KTriggerObjectMetadata::toFilter). The results are stored as a pattern x name index matrix,
+   which is only recomputed if the list of names changes. Per event, only lookups by index are needed.
+   The rows of the matrix are filled lazily, such that patterns that are not needed in a lumi section
+   are never matched.
+*/
+class TriggerPatternCache
+{
+public:
+
+	/// compile a pattern and return its index, patterns already known are not compiled again
+	size_t AddPattern(std::string const& pattern);
+	std::vector<size_t> AddPatterns(std::vector<std::string> const& patterns);
+
+	/// set the names to match against; the names are only compared to the previous ones
+	/// if run or lumi section changed
+	void SetNames(std::vector<std::string> const& names, uint64_t run, uint64_t lumi);
+
+	bool Matches(size_t patternIndex, size_t nameIndex) const;
+
+	/// true if the pattern matches any of the names with the given indices
+	bool MatchesAny(size_t patternIndex, std::vector<int> const& nameIndices) const;
+
+	std::vector<std::string> const& GetNames() const;
+
+private:
+
+	std::vector<std::string> m_patterns;
+	std::vector<boost::regex> m_regularExpressions;
+	std::unordered_map<std::string, size_t> m_patternIndices;
+
+	std::vector<std::string> m_names;
+	uint64_t m_run = 0;
+	uint64_t m_lumi = 0;
+	bool m_namesSet = false;
+
+	// [pattern][name] = 0: not matching, 1: matching, empty row: not yet computed
+	mutable std::vector<std::vector<char> > m_matches;
+
+	std::vector<char> const& GetMatches(size_t patternIndex) const;
+};
@@ -10,6 +10,7 @@
 #include "Kappa/DataFormats/interface/Kappa.h"
 
 #include "Artus/Utility/interface/Utility.h"
+#include "Artus/KappaAnalysis/interface/Utility/TriggerPatternCache.h"
 
 
 /**
@@ -38,6 +39,20 @@ public:
 		                                                           lowerPtCutsByHltName);
 		upperAbsEtaCutsByIndex = Utility::ParseMapTypes<size_t, float>(Utility::ParseVectorToMap((settings.*GetUpperAbsEtaCuts)()),
 		                                                               upperAbsEtaCutsByHltName);
+
+		// compile the HLT patterns once, in the order of the maps
+		lowerPtCutHltPatternIndices.clear();
+		for (std::map<std::string, std::vector<float> >::const_iterator lowerPtCutByHltName = lowerPtCutsByHltName.begin();
+		     lowerPtCutByHltName != lowerPtCutsByHltName.end(); ++lowerPtCutByHltName)
+		{
+			lowerPtCutHltPatternIndices.push_back(m_hltPatternCache.AddPattern(lowerPtCutByHltName->first));
+		}
+		upperAbsEtaCutHltPatternIndices.clear();
+		for (std::map<std::string, std::vector<float> >::const_iterator upperAbsEtaCutByHltName = upperAbsEtaCutsByHltName.begin();
+		     upperAbsEtaCutByHltName != upperAbsEtaCutsByHltName.end(); ++upperAbsEtaCutByHltName)
+		{
+			upperAbsEtaCutHltPatternIndices.push_back(m_hltPatternCache.AddPattern(upperAbsEtaCutByHltName->first));
+		}
 	}
 
 	virtual ~ValidPhysicsObjectTools() = default;
@@ -69,12 +84,19 @@ protected:
 			}
 		}
 
+		// the HLT patterns are matched against the HLT paths of the current lumi section only once
+		if ((! product.m_selectedHltPositions.empty()) && ((! lowerPtCutsByHltName.empty()) || (! upperAbsEtaCutsByHltName.empty())))
+		{
+			assert(event.m_eventInfo);
+			assert(event.m_lumiInfo);
+			m_hltPatternCache.SetNames(event.m_lumiInfo->hltNames, event.m_eventInfo->nRun, event.m_eventInfo->nLumi);
+		}
+
+		std::vector<size_t>::const_iterator lowerPtCutHltPatternIndex = lowerPtCutHltPatternIndices.begin();
 		for (std::map<std::string, std::vector<float> >::const_iterator lowerPtCutByHltName = lowerPtCutsByHltName.begin();
-		     lowerPtCutByHltName != lowerPtCutsByHltName.end() && validObject; ++lowerPtCutByHltName)
+		     lowerPtCutByHltName != lowerPtCutsByHltName.end() && validObject; ++lowerPtCutByHltName, ++lowerPtCutHltPatternIndex)
 		{
-			bool hasMatch = false;
-			for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-				hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(lowerPtCutByHltName->first, boost::regex::icase | boost::regex::extended));
+			bool hasMatch = m_hltPatternCache.MatchesAny(*lowerPtCutHltPatternIndex, product.m_selectedHltPositions);
 
 			if ((physicsObject->p4.Pt() < *std::max_element(lowerPtCutByHltName->second.begin(), lowerPtCutByHltName->second.end()))
 			    && (lowerPtCutByHltName->first == "default" || hasMatch)
@@ -84,12 +106,11 @@ protected:
 			}
 		}
 
+		std::vector<size_t>::const_iterator upperAbsEtaCutHltPatternIndex = upperAbsEtaCutHltPatternIndices.begin();
 		for (std::map<std::string, std::vector<float> >::const_iterator upperAbsEtaCutByHltName = upperAbsEtaCutsByHltName.begin();
-		     upperAbsEtaCutByHltName != upperAbsEtaCutsByHltName.end() && validObject; ++upperAbsEtaCutByHltName)
+		     upperAbsEtaCutByHltName != upperAbsEtaCutsByHltName.end() && validObject; ++upperAbsEtaCutByHltName, ++upperAbsEtaCutHltPatternIndex)
 		{
-			bool hasMatch = false;
-			for (unsigned int iHlt = 0; iHlt < product.m_selectedHltNames.size(); ++iHlt)
-				hasMatch = hasMatch || boost::regex_search(product.m_selectedHltNames.at(iHlt), boost::regex(upperAbsEtaCutByHltName->first, boost::regex::icase | boost::regex::extended));
+			bool hasMatch = m_hltPatternCache.MatchesAny(*upperAbsEtaCutHltPatternIndex, product.m_selectedHltPositions);
 
 			if ((std::abs(physicsObject->p4.Eta()) > *std::min_element(upperAbsEtaCutByHltName->second.begin(), upperAbsEtaCutByHltName->second.end()))
 			    &&
@@ -116,5 +137,11 @@ private:
 	std::map<size_t, std::vector<float> > upperAbsEtaCutsByIndex;
 	std::map<std::string, std::vector<float> > upperAbsEtaCutsByHltName;
 
+	std::vector<size_t> lowerPtCutHltPatternIndices;
+	std::vector<size_t> upperAbsEtaCutHltPatternIndices;
+
+protected:
+	mutable TriggerPatternCache m_hltPatternCache;
+
 };
 
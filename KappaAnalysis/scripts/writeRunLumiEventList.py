@@ -0,0 +1,49 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import logging
+import Artus.Utility.logger as logger
+log = logging.getLogger(__name__)
+
+import argparse
+import re
+import struct
+
+
+def main():
+	
+	parser = argparse.ArgumentParser(description="Convert text lists of run:lumi:event numbers into a binary list for the RunLumiEventFilter (RunLumiEventWhitelistFiles/RunLumiEventBlacklistFiles).",
+	                                 parents=[logger.loggingParser])
+
+	parser.add_argument("files", nargs="+", help="Input text files with one run, lumi and event number per line, separated by colons, commas or spaces.")
+	parser.add_argument("-o", "--output", required=True, help="Output binary list file.")
+
+	args = parser.parse_args()
+	logger.initLogger(args)
+	
+	entries = []
+	for file_name in args.files:
+		with open(file_name) as input_file:
+			for line in input_file:
+				line = line.split("#")[0].strip()
+				if line == "":
+					continue
+				numbers = [int(number) for number in re.split(r"[:,\s]+", line)]
+				if len(numbers) != 3:
+					log.critical("Line \"%s\" in file \"%s\" does not contain run, lumi and event number!" % (line, file_name))
+					return 1
+				entries.append(numbers)
+	
+	# format as read by RunLumiEventIndex::ReadBinaryFile
+	with open(args.output, "wb") as output_file:
+		output_file.write(b"ARTUSRLE")
+		output_file.write(struct.pack("<Q", len(entries)))
+		for run, lumi, event in entries:
+			output_file.write(struct.pack("<IIQ", run, lumi, event))
+	
+	log.info("Wrote %d entries to \"%s\"." % (len(entries), args.output))
+
+
+if __name__ == "__main__":
+	main()
+
@@ -0,0 +1,23 @@
+
+#include "Artus/KappaAnalysis/interface/Consumers/KappaCutFlowBitmaskConsumer.h"
+
+
+void KappaCutFlowBitmaskConsumer::Init(KappaSettings const& settings)
+{
+	CutFlowBitmaskConsumer<KappaTypes>::Init(settings);
+
+	size_t weightSlot = EventWeights::RegisterWeight(settings.GetEventWeight());
+
+	this->m_runExtractor = [](event_type const& event, product_type const& product, setting_type const& setting) -> uint64_t {
+		return event.m_eventInfo->nRun;
+	};
+	this->m_lumiExtractor = [](event_type const& event, product_type const& product, setting_type const& setting) -> uint64_t {
+		return event.m_eventInfo->nLumi;
+	};
+	this->m_eventExtractor = [](event_type const& event, product_type const& product, setting_type const& setting) -> uint64_t {
+		return event.m_eventInfo->nEvent;
+	};
+	this->m_weightExtractor = [weightSlot](event_type const& event, product_type const& product, setting_type const& setting) -> double {
+		return product.m_weights.Get(weightSlot, 1.0);
+	};
+}
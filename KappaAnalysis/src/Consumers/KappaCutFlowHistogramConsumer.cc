@@ -6,8 +6,10 @@ void KappaCutFlowHistogramConsumer::Init(KappaSettings const& settings)
 {
 	CutFlowHistogramConsumer<KappaTypes>::Init(settings);
 
-	this->weightExtractor = [](event_type const& event, product_type const& product, setting_type const& setting) -> double {
-		return SafeMap::GetWithDefault(product.m_weights, setting.GetEventWeight(), 1.0);
+	size_t weightSlot = EventWeights::RegisterWeight(settings.GetEventWeight());
+
+	this->weightExtractor = [weightSlot](event_type const& event, product_type const& product, setting_type const& setting) -> double {
+		return product.m_weights.Get(weightSlot, 1.0);
 	};
 
 	this->m_addWeightedCutFlow = true;
@@ -19,10 +19,10 @@ bool HltFilter::DoesEventPass(KappaEvent const &event, KappaProduct const &produ
         LOG(DEBUG) << "No Hlt filtering applied! (cfg: 'NoHltFiltering')";
         return true;
     }
-    if (!product.m_selectedHltNames.empty()) {
+    if (!product.m_selectedHltPositions.empty()) {
         LOG(DEBUG) << "Hlt Filter passed!\n";
     } else {
         LOG(DEBUG) << "Hlt Filter not passed!\n";
     }
-    return (!product.m_selectedHltNames.empty());
+    return (!product.m_selectedHltPositions.empty());
 }
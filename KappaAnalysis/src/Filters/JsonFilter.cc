@@ -19,6 +19,10 @@ void JsonFilter::Init(KappaSettings const &settings) {
                                         settings.GetPassRunHigh());
 }
 
+FilterGranularity JsonFilter::GetFilterGranularity() const {
+    return FilterGranularity::Lumisection;
+}
+
 bool JsonFilter::DoesEventPass(KappaEvent const &event, KappaProduct const &product,
                                KappaSettings const &settings) const {
     LOG(DEBUG) << "\n[JsonFilter]";
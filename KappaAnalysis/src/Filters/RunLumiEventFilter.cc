@@ -4,50 +4,75 @@ std::string RunLumiEventFilter::GetFilterId() const {
 	return "RunLumiEventFilter";
 }
 
+void RunLumiEventFilter::Init(KappaSettings const& settings)
+{
+	FilterBase<KappaTypes>::Init(settings);
+
+	m_matchTuples = (settings.GetMatchRunLumiEventTuples() ||
+	                 (! settings.GetRunLumiEventWhitelistFiles().empty()) ||
+	                 (! settings.GetRunLumiEventBlacklistFiles().empty()));
+	if (m_matchTuples)
+	{
+		size_t bloomFilterBitsPerEntry = static_cast<size_t>(std::max(settings.GetRunLumiEventBloomFilterBitsPerEntry(), 0));
+		std::vector<RunLumiEventIndex::Entry> entries;
+
+		FillEntries(settings.GetRunWhitelist(), settings.GetLumiWhitelist(), settings.GetEventWhitelist(),
+		            settings.GetRunLumiEventWhitelistFiles(), entries);
+		m_whitelistIndex.Build(entries, bloomFilterBitsPerEntry);
+
+		entries.clear();
+		FillEntries(settings.GetRunBlacklist(), settings.GetLumiBlacklist(), settings.GetEventBlacklist(),
+		            settings.GetRunLumiEventBlacklistFiles(), entries);
+		m_blacklistIndex.Build(entries, bloomFilterBitsPerEntry);
+
+		LOG(INFO) << "RunLumiEventFilter: " << m_whitelistIndex.GetNEntries() << " whitelisted and "
+		          << m_blacklistIndex.GetNEntries() << " blacklisted events, indices use "
+		          << (m_whitelistIndex.GetMemorySize() + m_blacklistIndex.GetMemorySize()) << " bytes.";
+	}
+	else
+	{
+		m_runs.Fill(settings.GetRunWhitelist(), settings.GetRunBlacklist());
+		m_lumis.Fill(settings.GetLumiWhitelist(), settings.GetLumiBlacklist());
+		m_events.Fill(settings.GetEventWhitelist(), settings.GetEventBlacklist());
+	}
+
+	if (m_matchTuples || (! m_events.whitelist.empty()) || (! m_events.blacklist.empty()))
+	{
+		m_granularity = FilterGranularity::Event;
+	}
+	else if ((! m_lumis.whitelist.empty()) || (! m_lumis.blacklist.empty()))
+	{
+		m_granularity = FilterGranularity::Lumisection;
+	}
+	else
+	{
+		m_granularity = FilterGranularity::Run;
+	}
+}
+
+FilterGranularity RunLumiEventFilter::GetFilterGranularity() const
+{
+	return m_granularity;
+}
+
 bool RunLumiEventFilter::DoesEventPass(KappaEvent const& event, KappaProduct const& product,
                                        KappaSettings const& settings) const 
 {
 	assert(event.m_eventInfo);
 	
 	bool match = false;
-	
-	if (settings.GetMatchRunLumiEventTuples())
+
+	if (m_matchTuples)
 	{
-		match = true;
-		for (size_t index = 0; index < std::min(std::min(settings.GetRunBlacklist().size(),
-		                                                 settings.GetLumiBlacklist().size()),
-		                                        settings.GetEventBlacklist().size()); ++index)
-		{
-			if ((event.m_eventInfo->nRun == settings.GetRunBlacklist()[index]) &&
-			    (event.m_eventInfo->nLumi == settings.GetLumiBlacklist()[index]) &&
-			    (event.m_eventInfo->nEvent == settings.GetEventBlacklist()[index]))
-			{
-				match = false;
-				break;
-			}
-		}
-		if (match)
-		{
-			match = false;
-			for (size_t index = 0; index < std::min(std::min(settings.GetRunWhitelist().size(),
-			                                                 settings.GetLumiWhitelist().size()),
-			                                        settings.GetEventWhitelist().size()); ++index)
-			{
-				if ((event.m_eventInfo->nRun == settings.GetRunWhitelist()[index]) &&
-					(event.m_eventInfo->nLumi == settings.GetLumiWhitelist()[index]) &&
-					(event.m_eventInfo->nEvent == settings.GetEventWhitelist()[index]))
-				{
-					match = true;
-					break;
-				}
-			}
-		}
+		match = ((! m_blacklistIndex.Contains(event.m_eventInfo->nRun, event.m_eventInfo->nLumi, event.m_eventInfo->nEvent)) &&
+		         (m_whitelistIndex.IsEmpty() ||
+		          m_whitelistIndex.Contains(event.m_eventInfo->nRun, event.m_eventInfo->nLumi, event.m_eventInfo->nEvent)));
 	}
 	else
 	{
-		match = (MatchWhiteBlackLists(event.m_eventInfo->nRun, settings.GetRunWhitelist(), settings.GetRunBlacklist()) &&
-		         MatchWhiteBlackLists(event.m_eventInfo->nLumi, settings.GetLumiWhitelist(), settings.GetLumiBlacklist()) &&
-		         MatchWhiteBlackLists(event.m_eventInfo->nEvent, settings.GetEventWhitelist(), settings.GetEventBlacklist()));
+		match = (m_runs.Match(event.m_eventInfo->nRun) &&
+		         m_lumis.Match(event.m_eventInfo->nLumi) &&
+		         m_events.Match(event.m_eventInfo->nEvent));
 	}
 	if (match)
 	{
@@ -59,15 +84,37 @@ bool RunLumiEventFilter::DoesEventPass(KappaEvent const& event, KappaProduct con
 	return match;
 }
 
-bool RunLumiEventFilter::MatchWhiteBlackLists(uint64_t item, std::vector<uint64_t> const& whitelist, std::vector<uint64_t> const& blacklist) const
+void RunLumiEventFilter::FillEntries(std::vector<uint64_t> const& runs, std::vector<uint64_t> const& lumis,
+                                     std::vector<uint64_t> const& events, std::vector<std::string> const& fileNames,
+                                     std::vector<RunLumiEventIndex::Entry>& entries)
+{
+	const size_t nEntries = std::min(std::min(runs.size(), lumis.size()), events.size());
+	for (size_t index = 0; index < nEntries; ++index)
+	{
+		entries.push_back(RunLumiEventIndex::Entry{ runs[index], lumis[index], events[index] });
+	}
+	for (std::vector<std::string>::const_iterator fileName = fileNames.begin(); fileName != fileNames.end(); ++fileName)
+	{
+		RunLumiEventIndex::ReadBinaryFile(*fileName, entries);
+	}
+}
+
+void RunLumiEventFilter::WhiteBlackList::Fill(std::vector<uint64_t> const& whitelistItems, std::vector<uint64_t> const& blacklistItems)
 {
-	if ((whitelist.size() > 0) && (std::find(whitelist.begin(), whitelist.end(), item) == whitelist.end()))
+	whitelist = std::unordered_set<uint64_t>(whitelistItems.begin(), whitelistItems.end());
+	blacklist = std::unordered_set<uint64_t>(blacklistItems.begin(), blacklistItems.end());
+}
+
+bool RunLumiEventFilter::WhiteBlackList::Match(uint64_t item) const
+{
+	if ((! whitelist.empty()) && (whitelist.count(item) == 0))
 	{
 		return false;
 	}
-	if ((blacklist.size() > 0) && (std::find(blacklist.begin(), blacklist.end(), item) != blacklist.end()))
+	if ((! blacklist.empty()) && (blacklist.count(item) != 0))
 	{
 		return false;
 	}
 	return true;
 }
+
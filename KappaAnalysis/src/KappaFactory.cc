@@ -10,6 +10,7 @@
 #include "Artus/KappaAnalysis/interface/Producers/MuonCorrectionsProducer.h"
 #include "Artus/KappaAnalysis/interface/Producers/TauCorrectionsProducer.h"
 #include "Artus/KappaAnalysis/interface/Producers/JetCorrectionsProducer.h"
+#include "Artus/KappaAnalysis/interface/Producers/JetCorrectionUncertaintyMatrixProducer.h"
 #include "Artus/KappaAnalysis/interface/Producers/ValidElectronsProducer.h"
 #include "Artus/KappaAnalysis/interface/Producers/ValidMuonsProducer.h"
 #include "Artus/KappaAnalysis/interface/Producers/ValidTausProducer.h"
@@ -66,13 +67,155 @@
 // consumer
 #include "Artus/KappaAnalysis/interface/Consumers/KappaCutFlowHistogramConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaCutFlowTreeConsumer.h"
+#include "Artus/KappaAnalysis/interface/Consumers/KappaCutFlowBitmaskConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaLambdaNtupleConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/KappaCollectionsConsumers.h"
 #include "Artus/KappaAnalysis/interface/Consumers/PrintHltConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/PrintEventsConsumer.h"
 #include "Artus/KappaAnalysis/interface/Consumers/PrintGenParticleDecayTreeConsumer.h"
 #include "Artus/Consumer/interface/RunTimeConsumer.h"
-#include "Artus/Consumer/interface/RunTimeConsumer.h"
+
+
+// producer
+REGISTER_ARTUS_PRODUCER(GenTauDecayProducer)
+REGISTER_ARTUS_PRODUCER(GenParticleProducer)
+REGISTER_ARTUS_PRODUCER(GenTauJetProducer)
+REGISTER_ARTUS_PRODUCER(HltProducer)
+REGISTER_ARTUS_PRODUCER(ElectronCorrectionsProducer)
+REGISTER_ARTUS_PRODUCER(MuonCorrectionsProducer)
+REGISTER_ARTUS_PRODUCER(TauCorrectionsProducer)
+REGISTER_ARTUS_PRODUCER(JetCorrectionsProducer)
+REGISTER_ARTUS_PRODUCER(TaggedJetCorrectionsProducer)
+REGISTER_ARTUS_PRODUCER(JetCorrectionUncertaintyMatrixProducer)
+REGISTER_ARTUS_PRODUCER(TaggedJetCorrectionUncertaintyMatrixProducer)
+REGISTER_ARTUS_PRODUCER(ValidElectronsProducer<KappaTypes>)
+REGISTER_ARTUS_PRODUCER(ValidMuonsProducer<KappaTypes>)
+REGISTER_ARTUS_PRODUCER(ValidTausProducer)
+REGISTER_ARTUS_PRODUCER(ValidJetsProducer)
+REGISTER_ARTUS_PRODUCER(ValidTaggedJetsProducer)
+REGISTER_ARTUS_PRODUCER(ValidBTaggedJetsProducer)
+REGISTER_ARTUS_PRODUCER(ValidGenElectronsProducer)
+REGISTER_ARTUS_PRODUCER(ValidGenMuonsProducer)
+REGISTER_ARTUS_PRODUCER(ValidGenTausProducer)
+REGISTER_ARTUS_PRODUCER(ElectronTriggerMatchingProducer)
+REGISTER_ARTUS_PRODUCER(MuonTriggerMatchingProducer)
+REGISTER_ARTUS_PRODUCER(TauTriggerMatchingProducer)
+REGISTER_ARTUS_PRODUCER(JetTriggerMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoElectronGenParticleMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoMuonGenParticleMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoTauGenParticleMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoJetGenParticleMatchingProducer)
+REGISTER_ARTUS_PRODUCER(MatchedLeptonsProducer)
+REGISTER_ARTUS_PRODUCER(ValidLeptonsProducer)
+REGISTER_ARTUS_PRODUCER(PUWeightProducer)
+REGISTER_ARTUS_PRODUCER(EventWeightProducer)
+REGISTER_ARTUS_PRODUCER(GeneratorWeightProducer)
+REGISTER_ARTUS_PRODUCER(LuminosityWeightProducer)
+REGISTER_ARTUS_PRODUCER(CrossSectionWeightProducer)
+REGISTER_ARTUS_PRODUCER(NumberGeneratedEventsWeightProducer)
+REGISTER_ARTUS_PRODUCER(SampleStitchingWeightProducer)
+REGISTER_ARTUS_PRODUCER(GenMuonFSRProducer)
+// todo: uses setting not in KappaSettings
+REGISTER_ARTUS_PRODUCER(GeneralTmvaClassificationReader)
+REGISTER_ARTUS_PRODUCER(GenDiLeptonDecayModeProducer)
+REGISTER_ARTUS_PRODUCER(GenPartonCounterProducer)
+REGISTER_ARTUS_PRODUCER(EmbeddingWeightProducer)
+REGISTER_ARTUS_PRODUCER(NicknameProducer)
+REGISTER_ARTUS_PRODUCER(RecoElectronGenTauMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoMuonGenTauMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoTauGenTauMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoElectronGenTauJetMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoMuonGenTauJetMatchingProducer)
+REGISTER_ARTUS_PRODUCER(RecoTauGenTauJetMatchingProducer)
+REGISTER_ARTUS_PRODUCER(ZmmProducer)
+REGISTER_ARTUS_PRODUCER(ZeeProducer)
+REGISTER_ARTUS_PRODUCER(ZemProducer)
+REGISTER_ARTUS_PRODUCER(ZeemmProducer)
+REGISTER_ARTUS_PRODUCER(GenBosonFromGenParticlesProducer)
+REGISTER_ARTUS_PRODUCER(GenBosonProductionProducer)
+REGISTER_ARTUS_PRODUCER(GenBosonDiLeptonDecayModeProducer)
+REGISTER_ARTUS_PRODUCER(PFCandidatesProducer)
+REGISTER_ARTUS_PRODUCER(ValidLeptonsPFIsolationProducer)
+REGISTER_ARTUS_PRODUCER(NumberOfParticlesProducer)
+REGISTER_ARTUS_PRODUCER(ValidGenJetsProducer)
+REGISTER_ARTUS_PRODUCER(PrintGenParticleDecayTreeProducer)
+
+// filter
+REGISTER_ARTUS_FILTER(RunLumiEventFilter)
+REGISTER_ARTUS_FILTER(JsonFilter)
+REGISTER_ARTUS_FILTER(HltFilter)
+REGISTER_ARTUS_FILTER(ValidElectronsFilter)
+REGISTER_ARTUS_FILTER(ValidMuonsFilter)
+REGISTER_ARTUS_FILTER(ValidTausFilter)
+REGISTER_ARTUS_FILTER(ValidJetsFilter)
+REGISTER_ARTUS_FILTER(ValidBTaggedJetsFilter)
+REGISTER_ARTUS_FILTER(GenElectronsFilter)
+REGISTER_ARTUS_FILTER(GenMuonsFilter)
+REGISTER_ARTUS_FILTER(GenTausFilter)
+REGISTER_ARTUS_FILTER(GenTauJetsFilter)
+REGISTER_ARTUS_FILTER(ElectronsCountFilter)
+REGISTER_ARTUS_FILTER(MuonsCountFilter)
+REGISTER_ARTUS_FILTER(TausCountFilter)
+REGISTER_ARTUS_FILTER(JetsCountFilter)
+REGISTER_ARTUS_FILTER(BTaggedJetsCountFilter)
+REGISTER_ARTUS_FILTER(NonBTaggedJetsCountFilter)
+REGISTER_ARTUS_FILTER(MinElectronsCountFilter)
+REGISTER_ARTUS_FILTER(MinMuonsCountFilter)
+REGISTER_ARTUS_FILTER(MinTausCountFilter)
+REGISTER_ARTUS_FILTER(MinJetsCountFilter)
+REGISTER_ARTUS_FILTER(MinBTaggedJetsCountFilter)
+REGISTER_ARTUS_FILTER(MinNonBTaggedJetsCountFilter)
+REGISTER_ARTUS_FILTER(MaxElectronsCountFilter)
+REGISTER_ARTUS_FILTER(MaxMuonsCountFilter)
+REGISTER_ARTUS_FILTER(MaxTausCountFilter)
+REGISTER_ARTUS_FILTER(MaxJetsCountFilter)
+REGISTER_ARTUS_FILTER(MaxBTaggedJetsCountFilter)
+REGISTER_ARTUS_FILTER(MaxNonBTaggedJetsCountFilter)
+REGISTER_ARTUS_FILTER(ElectronLowerPtCutsFilter)
+REGISTER_ARTUS_FILTER(MuonLowerPtCutsFilter)
+REGISTER_ARTUS_FILTER(TauLowerPtCutsFilter)
+REGISTER_ARTUS_FILTER(JetLowerPtCutsFilter)
+REGISTER_ARTUS_FILTER(NonBTaggedJetLowerPtCutsFilter)
+REGISTER_ARTUS_FILTER(ElectronUpperAbsEtaCutsFilter)
+REGISTER_ARTUS_FILTER(MuonUpperAbsEtaCutsFilter)
+REGISTER_ARTUS_FILTER(TauUpperAbsEtaCutsFilter)
+REGISTER_ARTUS_FILTER(JetUpperAbsEtaCutsFilter)
+REGISTER_ARTUS_FILTER(ElectronTriggerMatchingFilter)
+REGISTER_ARTUS_FILTER(MuonTriggerMatchingFilter)
+REGISTER_ARTUS_FILTER(TauTriggerMatchingFilter)
+REGISTER_ARTUS_FILTER(JetTriggerMatchingFilter)
+REGISTER_ARTUS_FILTER(ElectronGenMatchingFilter)
+REGISTER_ARTUS_FILTER(MuonGenMatchingFilter)
+REGISTER_ARTUS_FILTER(TauGenMatchingFilter)
+REGISTER_ARTUS_FILTER(JetGenMatchingFilter)
+REGISTER_ARTUS_FILTER(GenTauMatchingRecoElectronMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(GenTauMatchingRecoMuonMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(GenTauMatchingRecoTauMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(ValidElectronsMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(ValidMuonsMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(ValidTausMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(ValidLeptonsMinDeltaRFilter)
+REGISTER_ARTUS_FILTER(GenDiLeptonDecayModeFilter)
+REGISTER_ARTUS_FILTER(GoodPrimaryVertexFilter)
+REGISTER_ARTUS_FILTER(HCALNoiseFilter)
+REGISTER_ARTUS_FILTER(BeamScrapingFilter)
+REGISTER_ARTUS_FILTER(nPUFilter)
+REGISTER_ARTUS_FILTER(ZFilter)
+
+// consumer
+REGISTER_ARTUS_CONSUMER(KappaCutFlowHistogramConsumer)
+REGISTER_ARTUS_CONSUMER(KappaCutFlowTreeConsumer)
+REGISTER_ARTUS_CONSUMER(KappaCutFlowBitmaskConsumer)
+REGISTER_ARTUS_CONSUMER(KappaLambdaNtupleConsumer<KappaTypes>)
+REGISTER_ARTUS_CONSUMER(KappaElectronsConsumer)
+REGISTER_ARTUS_CONSUMER(KappaMuonsConsumer)
+REGISTER_ARTUS_CONSUMER(KappaTausConsumer)
+REGISTER_ARTUS_CONSUMER(KappaJetsConsumer)
+REGISTER_ARTUS_CONSUMER(KappaTaggedJetsConsumer)
+REGISTER_ARTUS_CONSUMER(PrintHltConsumer)
+REGISTER_ARTUS_CONSUMER(PrintGenParticleDecayTreeConsumer)
+REGISTER_ARTUS_CONSUMER(PrintEventsConsumer)
+REGISTER_ARTUS_CONSUMER(RunTimeConsumer<KappaTypes>)
 
 
 KappaFactory::KappaFactory() :
@@ -86,279 +229,15 @@ KappaFactory::~KappaFactory()
 
 ProducerBaseUntemplated * KappaFactory::createProducer ( std::string const& id )
 {
-	if(id == GenTauDecayProducer().GetProducerId())
-		return new GenTauDecayProducer();
-	else if(id == GenParticleProducer().GetProducerId())
-		return new GenParticleProducer();
-	else if(id == GenTauJetProducer().GetProducerId())
-		return new GenTauJetProducer();
-	else if(id == HltProducer().GetProducerId())
-		return new HltProducer();
-	else if(id == ElectronCorrectionsProducer().GetProducerId())
-		return new ElectronCorrectionsProducer();
-	else if(id == MuonCorrectionsProducer().GetProducerId())
-		return new MuonCorrectionsProducer();
-	else if(id == TauCorrectionsProducer().GetProducerId())
-		return new TauCorrectionsProducer();
-	else if(id == JetCorrectionsProducer().GetProducerId())
-		return new JetCorrectionsProducer();
-	else if(id == TaggedJetCorrectionsProducer().GetProducerId())
-		return new TaggedJetCorrectionsProducer();
-	else if(id == ValidElectronsProducer<KappaTypes>().GetProducerId())
-		return new ValidElectronsProducer<KappaTypes>();
-	else if(id == ValidMuonsProducer<KappaTypes>().GetProducerId())
-		return new ValidMuonsProducer<KappaTypes>();
-	else if(id == ValidTausProducer().GetProducerId())
-		return new ValidTausProducer();
-	else if(id == ValidJetsProducer().GetProducerId())
-		return new ValidJetsProducer();
-	else if(id == ValidTaggedJetsProducer().GetProducerId())
-		return new ValidTaggedJetsProducer();
-	else if(id == ValidBTaggedJetsProducer().GetProducerId())
-		return new ValidBTaggedJetsProducer();
-	else if(id == ValidGenElectronsProducer().GetProducerId())
-		return new ValidGenElectronsProducer();
-	else if(id == ValidGenMuonsProducer().GetProducerId())
-		return new ValidGenMuonsProducer();
-	else if(id == ValidGenTausProducer().GetProducerId())
-		return new ValidGenTausProducer();
-	else if(id == ElectronTriggerMatchingProducer().GetProducerId())
-		return new ElectronTriggerMatchingProducer();
-	else if(id == MuonTriggerMatchingProducer().GetProducerId())
-		return new MuonTriggerMatchingProducer();
-	else if(id == TauTriggerMatchingProducer().GetProducerId())
-		return new TauTriggerMatchingProducer();
-	else if(id == JetTriggerMatchingProducer().GetProducerId())
-		return new JetTriggerMatchingProducer();
-	else if(id == RecoElectronGenParticleMatchingProducer().GetProducerId())
-		return new RecoElectronGenParticleMatchingProducer();
-	else if(id == RecoMuonGenParticleMatchingProducer().GetProducerId())
-		return new RecoMuonGenParticleMatchingProducer();
-	else if(id == RecoTauGenParticleMatchingProducer().GetProducerId())
-		return new RecoTauGenParticleMatchingProducer();
-	else if(id == RecoJetGenParticleMatchingProducer().GetProducerId())
-		return new RecoJetGenParticleMatchingProducer();
-	else if(id == MatchedLeptonsProducer().GetProducerId())
-		return new MatchedLeptonsProducer();
-	else if(id == ValidLeptonsProducer().GetProducerId())
-		return new ValidLeptonsProducer();
-	else if(id == PUWeightProducer().GetProducerId())
-		return new PUWeightProducer();
-	else if(id == EventWeightProducer().GetProducerId())
-		return new EventWeightProducer();
-	else if(id == GeneratorWeightProducer().GetProducerId())
-		return new GeneratorWeightProducer();
-	else if(id == LuminosityWeightProducer().GetProducerId())
-		return new LuminosityWeightProducer();
-	else if(id == CrossSectionWeightProducer().GetProducerId())
-		return new CrossSectionWeightProducer();
-	else if(id == NumberGeneratedEventsWeightProducer().GetProducerId())
-		return new NumberGeneratedEventsWeightProducer();
-	else if(id == SampleStitchingWeightProducer().GetProducerId())
-		return new SampleStitchingWeightProducer();
-	else if(id == GenMuonFSRProducer().GetProducerId())
-		return new GenMuonFSRProducer();
-	// todo: uses setting not in KappaSettings
-	else if(id == GeneralTmvaClassificationReader().GetProducerId())
-		return new GeneralTmvaClassificationReader();
-	else if(id == GenDiLeptonDecayModeProducer().GetProducerId())
-		return new GenDiLeptonDecayModeProducer();
-	else if(id == GenPartonCounterProducer().GetProducerId())
-		return new GenPartonCounterProducer();
-	else if(id == EmbeddingWeightProducer().GetProducerId())
-		return new EmbeddingWeightProducer();
-	else if(id == NicknameProducer().GetProducerId())
-		return new NicknameProducer();
-	else if(id == RecoElectronGenTauMatchingProducer().GetProducerId())
-		return new RecoElectronGenTauMatchingProducer();
-	else if(id == RecoMuonGenTauMatchingProducer().GetProducerId())
-		return new RecoMuonGenTauMatchingProducer();
-	else if(id == RecoTauGenTauMatchingProducer().GetProducerId())
-		return new RecoTauGenTauMatchingProducer();
-	else if(id == RecoElectronGenTauJetMatchingProducer().GetProducerId())
-		return new RecoElectronGenTauJetMatchingProducer();
-	else if(id == RecoMuonGenTauJetMatchingProducer().GetProducerId())
-		return new RecoMuonGenTauJetMatchingProducer();
-	else if(id == RecoTauGenTauJetMatchingProducer().GetProducerId())
-		return new RecoTauGenTauJetMatchingProducer();
-	else if(id == ZmmProducer().GetProducerId())
-		return new ZmmProducer();
-	else if(id == ZeeProducer().GetProducerId())
-		return new ZeeProducer();
-	else if(id == ZemProducer().GetProducerId())
-		return new ZemProducer();
-	else if(id == ZeemmProducer().GetProducerId())
-		return new ZeemmProducer();
-	else if(id == GenBosonFromGenParticlesProducer().GetProducerId())
-		return new GenBosonFromGenParticlesProducer();
-	else if(id == GenBosonProductionProducer().GetProducerId())
-		return new GenBosonProductionProducer();
-	else if(id == GenBosonDiLeptonDecayModeProducer().GetProducerId())
-		return new GenBosonDiLeptonDecayModeProducer();
-	else if(id == PFCandidatesProducer().GetProducerId())
-		return new PFCandidatesProducer();
-	else if(id == NumberOfParticlesProducer().GetProducerId())
-		return new NumberOfParticlesProducer();
-	else if(id == ValidGenJetsProducer().GetProducerId())
-		return new ValidGenJetsProducer();
-	else if(id == PrintGenParticleDecayTreeProducer().GetProducerId())
-		return new PrintGenParticleDecayTreeProducer();
-	else
-		return FactoryBase::createProducer( id );
+	return FactoryBase::createProducer( id );
 }
 
 FilterBaseUntemplated * KappaFactory::createFilter ( std::string const& id )
 {
-	if(id == RunLumiEventFilter().GetFilterId())
-		return new RunLumiEventFilter();
-	else if(id == JsonFilter().GetFilterId())
-		return new JsonFilter();
-	else if(id == HltFilter().GetFilterId())
-		return new HltFilter();
-	else if(id == ValidElectronsFilter().GetFilterId())
-		return new ValidElectronsFilter();
-	else if(id == ValidMuonsFilter().GetFilterId())
-		return new ValidMuonsFilter();
-	else if(id == ValidTausFilter().GetFilterId())
-		return new ValidTausFilter();
-	else if(id == ValidJetsFilter().GetFilterId())
-		return new ValidJetsFilter();
-	else if(id == ValidBTaggedJetsFilter().GetFilterId())
-		return new ValidBTaggedJetsFilter();
-	else if(id == GenElectronsFilter().GetFilterId())
-		return new GenElectronsFilter();
-	else if(id == GenMuonsFilter().GetFilterId())
-		return new GenMuonsFilter();
-	else if(id == GenTausFilter().GetFilterId())
-		return new GenTausFilter();
-	else if(id == GenTauJetsFilter().GetFilterId())
-		return new GenTauJetsFilter();
-	else if(id == ElectronsCountFilter().GetFilterId())
-		return new ElectronsCountFilter();
-	else if(id == MuonsCountFilter().GetFilterId())
-		return new MuonsCountFilter();
-	else if(id == TausCountFilter().GetFilterId())
-		return new TausCountFilter();
-	else if(id == JetsCountFilter().GetFilterId())
-		return new JetsCountFilter();
-	else if(id == BTaggedJetsCountFilter().GetFilterId())
-		return new BTaggedJetsCountFilter();
-	else if(id == NonBTaggedJetsCountFilter().GetFilterId())
-		return new NonBTaggedJetsCountFilter();
-	else if(id == MinElectronsCountFilter().GetFilterId())
-		return new MinElectronsCountFilter();
-	else if(id == MinMuonsCountFilter().GetFilterId())
-		return new MinMuonsCountFilter();
-	else if(id == MinTausCountFilter().GetFilterId())
-		return new MinTausCountFilter();
-	else if(id == MinJetsCountFilter().GetFilterId())
-		return new MinJetsCountFilter();
-	else if(id == MinBTaggedJetsCountFilter().GetFilterId())
-		return new MinBTaggedJetsCountFilter();
-	else if(id == MinNonBTaggedJetsCountFilter().GetFilterId())
-		return new MinNonBTaggedJetsCountFilter();
-	else if(id == MaxElectronsCountFilter().GetFilterId())
-		return new MaxElectronsCountFilter();
-	else if(id == MaxMuonsCountFilter().GetFilterId())
-		return new MaxMuonsCountFilter();
-	else if(id == MaxTausCountFilter().GetFilterId())
-		return new MaxTausCountFilter();
-	else if(id == MaxJetsCountFilter().GetFilterId())
-		return new MaxJetsCountFilter();
-	else if(id == MaxBTaggedJetsCountFilter().GetFilterId())
-		return new MaxBTaggedJetsCountFilter();
-	else if(id == MaxNonBTaggedJetsCountFilter().GetFilterId())
-		return new MaxNonBTaggedJetsCountFilter();
-	else if(id == ElectronLowerPtCutsFilter().GetFilterId())
-		return new ElectronLowerPtCutsFilter();
-	else if(id == MuonLowerPtCutsFilter().GetFilterId())
-		return new MuonLowerPtCutsFilter();
-	else if(id == TauLowerPtCutsFilter().GetFilterId())
-		return new TauLowerPtCutsFilter();
-	else if(id == JetLowerPtCutsFilter().GetFilterId())
-		return new JetLowerPtCutsFilter();
-	else if(id == NonBTaggedJetLowerPtCutsFilter().GetFilterId())
-		return new NonBTaggedJetLowerPtCutsFilter();
-	else if(id == ElectronUpperAbsEtaCutsFilter().GetFilterId())
-		return new ElectronUpperAbsEtaCutsFilter();
-	else if(id == MuonUpperAbsEtaCutsFilter().GetFilterId())
-		return new MuonUpperAbsEtaCutsFilter();
-	else if(id == TauUpperAbsEtaCutsFilter().GetFilterId())
-		return new TauUpperAbsEtaCutsFilter();
-	else if(id == JetUpperAbsEtaCutsFilter().GetFilterId())
-		return new JetUpperAbsEtaCutsFilter();
-	else if(id == ElectronTriggerMatchingFilter().GetFilterId())
-		return new ElectronTriggerMatchingFilter();
-	else if(id == MuonTriggerMatchingFilter().GetFilterId())
-		return new MuonTriggerMatchingFilter();
-	else if(id == TauTriggerMatchingFilter().GetFilterId())
-		return new TauTriggerMatchingFilter();
-	else if(id == JetTriggerMatchingFilter().GetFilterId())
-		return new JetTriggerMatchingFilter();
-	else if(id == ElectronGenMatchingFilter().GetFilterId())
-		return new ElectronGenMatchingFilter();
-	else if(id == MuonGenMatchingFilter().GetFilterId())
-		return new MuonGenMatchingFilter();
-	else if(id == TauGenMatchingFilter().GetFilterId())
-		return new TauGenMatchingFilter();
-	else if(id == JetGenMatchingFilter().GetFilterId())
-		return new JetGenMatchingFilter();
-	else if(id == GenTauMatchingRecoElectronMinDeltaRFilter().GetFilterId())
-		return new GenTauMatchingRecoElectronMinDeltaRFilter();
-	else if(id == GenTauMatchingRecoMuonMinDeltaRFilter().GetFilterId())
-		return new GenTauMatchingRecoMuonMinDeltaRFilter();
-	else if(id == GenTauMatchingRecoTauMinDeltaRFilter().GetFilterId())
-		return new GenTauMatchingRecoTauMinDeltaRFilter();
-	else if(id == ValidElectronsMinDeltaRFilter().GetFilterId())
-		return new ValidElectronsMinDeltaRFilter();
-	else if(id == ValidMuonsMinDeltaRFilter().GetFilterId())
-		return new ValidMuonsMinDeltaRFilter();
-	else if(id == ValidTausMinDeltaRFilter().GetFilterId())
-		return new ValidTausMinDeltaRFilter();
-	else if(id == ValidLeptonsMinDeltaRFilter().GetFilterId())
-		return new ValidLeptonsMinDeltaRFilter();
-	else if(id == GenDiLeptonDecayModeFilter().GetFilterId())
-		return new GenDiLeptonDecayModeFilter();
-	else if(id == GoodPrimaryVertexFilter().GetFilterId())
-		return new GoodPrimaryVertexFilter();
-	else if(id == HCALNoiseFilter().GetFilterId())
-		return new HCALNoiseFilter();
-	else if(id == BeamScrapingFilter().GetFilterId())
-		return new BeamScrapingFilter();
-	else if(id == nPUFilter().GetFilterId())
-		return new nPUFilter();
-	else if(id == ZFilter().GetFilterId())
-		return new ZFilter();
-	else
-		return FactoryBase::createFilter( id );
+	return FactoryBase::createFilter( id );
 }
 
 ConsumerBaseUntemplated * KappaFactory::createConsumer ( std::string const& id )
 {
-	if(id == KappaCutFlowHistogramConsumer().GetConsumerId())
-		return new KappaCutFlowHistogramConsumer();
-	if(id == KappaCutFlowTreeConsumer().GetConsumerId())
-		return new KappaCutFlowTreeConsumer();
-	else if(id == KappaLambdaNtupleConsumer<KappaTypes>().GetConsumerId())
-		return new KappaLambdaNtupleConsumer<KappaTypes>();
-	else if(id == KappaElectronsConsumer().GetConsumerId())
-		return new KappaElectronsConsumer();
-	else if(id == KappaMuonsConsumer().GetConsumerId())
-		return new KappaMuonsConsumer();
-	else if(id == KappaTausConsumer().GetConsumerId())
-		return new KappaTausConsumer();
-	else if(id == KappaJetsConsumer().GetConsumerId())
-		return new KappaJetsConsumer();
-	else if(id == KappaTaggedJetsConsumer().GetConsumerId())
-		return new KappaTaggedJetsConsumer();
-	else if(id == PrintHltConsumer().GetConsumerId())
-		return new PrintHltConsumer();
-	else if(id == PrintGenParticleDecayTreeConsumer().GetConsumerId())
-		return new PrintGenParticleDecayTreeConsumer();
-	else if(id == PrintEventsConsumer().GetConsumerId())
-		return new PrintEventsConsumer();
-	else if(id == RunTimeConsumer<KappaTypes>().GetConsumerId())
-		return new RunTimeConsumer<KappaTypes>();
-	else
-		return FactoryBase::createConsumer( id );
+	return FactoryBase::createConsumer( id );
 }
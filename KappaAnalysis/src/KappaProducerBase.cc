@@ -0,0 +1,12 @@
+
+#include <cassert>
+
+#include "Artus/KappaAnalysis/interface/KappaProducerBase.h"
+
+
+RandomStream KappaProducerBase::GetRandomStream(KappaEvent const& event, uint32_t objectIndex) const
+{
+	assert(event.m_eventInfo);
+	return RandomNumberService::GetStream(event.m_eventInfo->nRun, event.m_eventInfo->nLumi, event.m_eventInfo->nEvent,
+	                                      GetProducerId(), objectIndex);
+}
@@ -4,18 +4,41 @@ std::string CrossSectionWeightProducer::GetProducerId() const {
     return "CrossSectionWeightProducer";
 }
 
+void CrossSectionWeightProducer::Init(KappaSettings const &settings) {
+    KappaProducerBase::Init(settings);
+
+    m_weightSlot = EventWeights::RegisterWeight("crossSectionPerEventWeight", true);
+    m_weightUpSlot = EventWeights::RegisterWeight("crossSectionPerEventWeightUp");
+    m_weightDownSlot = EventWeights::RegisterWeight("crossSectionPerEventWeightDown");
+    UpdateWeights(settings);
+}
+
+void CrossSectionWeightProducer::OnRun(KappaEvent const &event, KappaSettings const &settings) {
+    UpdateWeights(settings);
+}
+
 void CrossSectionWeightProducer::Produce(KappaEvent const &event, KappaProduct &product,
                                          KappaSettings const &settings) const {
     assert(event.m_genLumiInfo);
+
+    product.m_weights.Set(m_weightSlot, m_weight);
+    if (m_hasVariations) {
+        product.m_optionalWeights.Set(m_weightUpSlot, m_weightUp);
+        product.m_optionalWeights.Set(m_weightDownSlot, m_weightDown);
+    }
+}
+
+void CrossSectionWeightProducer::UpdateWeights(KappaSettings const &settings) {
     LOG(DEBUG) << "\n[" << this->GetProducerId() << "]";
 
     if (!signbit(settings.GetCrossSection())) {
-        LOG(DEBUG) << "Adding crossSectionPerEventWeight: " << settings.GetCrossSection();
-        product.m_weights["crossSectionPerEventWeight"] = settings.GetCrossSection();
-        if (!signbit(settings.GetCrossSectionUp()) && !signbit(settings.GetCrossSectionDown())) {
-            LOG(DEBUG) << "Adding crossSectionPerEventWeight Variations";
-            product.m_optionalWeights["crossSectionPerEventWeightUp"] = settings.GetCrossSectionUp();
-            product.m_optionalWeights["crossSectionPerEventWeightDown"] = settings.GetCrossSectionDown();
+        LOG(DEBUG) << "Using crossSectionPerEventWeight: " << settings.GetCrossSection();
+        m_weight = settings.GetCrossSection();
+        m_hasVariations = (!signbit(settings.GetCrossSectionUp()) && !signbit(settings.GetCrossSectionDown()));
+        if (m_hasVariations) {
+            LOG(DEBUG) << "Using crossSectionPerEventWeight Variations";
+            m_weightUp = settings.GetCrossSectionUp();
+            m_weightDown = settings.GetCrossSectionDown();
         }
     } else {
         LOG(FATAL) << "No valid CrossSection specified: " << settings.GetCrossSection();
@@ -45,13 +45,22 @@ void ElectronCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct&
 	for (KElectrons::const_iterator electron = event.m_electrons->begin();
 		 electron != event.m_electrons->end(); ++electron)
 	{
-		product.m_correctedElectrons[electronIndex] = std::shared_ptr<KElectron>(new KElectron(*electron));
-		product.m_originalLeptons[product.m_correctedElectrons[electronIndex].get()] = &(*electron);
+		product.m_correctedElectrons[electronIndex] = product.CreateEventObject<KElectron>(*electron);
+		product.m_originalLeptons[product.m_correctedElectrons[electronIndex]] = &(*electron);
 		++electronIndex;
 	}
 	
+	// the UW gen matching uses the generator particle view and gen taus built once per event
+	GenParticleView const* genParticleView = nullptr;
+	std::vector<RMFLV> genTausUW;
+	if (settings.GetCorrectOnlyRealElectrons() && settings.GetUseUWGenMatching() && event.m_genParticles)
+	{
+		genParticleView = &(product.GetGenParticleView(event.m_genParticles));
+		GeneratorInfo::BuildGenTausUW(*genParticleView, genTausUW);
+	}
+
 	// perform corrections on copied electrons
-	for (std::vector<std::shared_ptr<KElectron> >::iterator electron = product.m_correctedElectrons.begin();
+	for (std::vector<KElectron*>::iterator electron = product.m_correctedElectrons.begin();
 		 electron != product.m_correctedElectrons.end(); ++electron)
 	{
 		// Check whether corrections should be applied at all
@@ -61,11 +70,14 @@ void ElectronCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct&
 			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 			if (settings.GetUseUWGenMatching())
 			{
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(product.m_originalLeptons[electron->get()]));
+				if (genParticleView)
+				{
+					genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(*genParticleView, genTausUW, const_cast<KLepton*>(product.m_originalLeptons[*electron]));
+				}
 			}
 			else
 			{
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[electron->get()]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[*electron]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
 				if (genParticle)
 				{
 					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
@@ -81,25 +93,25 @@ void ElectronCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct&
 	
 		// perform possible analysis-specific corrections
 		if ((!settings.GetCorrectOnlyRealElectrons() || (settings.GetCorrectOnlyRealElectrons() && isRealElectron)) && settings.GetApplyElectronEnergyCorrections())
-			AdditionalCorrections(electron->get(), event, product, settings);
+			AdditionalCorrections(*electron, event, product, settings);
 
 		// make sure to also save the corrected lepton and the matched genParticle in the map
 		// if we match genParticles to all leptons
 		if (settings.GetRecoElectronMatchingGenParticleMatchAllElectrons())
 		{
-			product.m_genParticleMatchedElectrons[electron->get()] =  &(*product.m_genParticleMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(product.m_originalLeptons[electron->get()]))]);
-			product.m_genParticleMatchedLeptons[electron->get()] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[electron->get()])]);
+			product.m_genParticleMatchedElectrons[*electron] =  &(*product.m_genParticleMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(product.m_originalLeptons[*electron]))]);
+			product.m_genParticleMatchedLeptons[*electron] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[*electron])]);
 		}
 		if (settings.GetMatchAllElectronsGenTau())
 		{
-			product.m_genTauMatchedElectrons[electron->get()] = &(*product.m_genTauMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(product.m_originalLeptons[electron->get()]))]);
-			product.m_genTauMatchedLeptons[electron->get()] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[electron->get()])]);
+			product.m_genTauMatchedElectrons[*electron] = &(*product.m_genTauMatchedElectrons[static_cast<KElectron*>(const_cast<KLepton*>(product.m_originalLeptons[*electron]))]);
+			product.m_genTauMatchedLeptons[*electron] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[*electron])]);
 		}
 	}
 	
 	// sort vectors of corrected electrons by pt
 	std::sort(product.m_correctedElectrons.begin(), product.m_correctedElectrons.end(),
-	          [](std::shared_ptr<KElectron> electron1, std::shared_ptr<KElectron> electron2) -> bool
+	          [](KElectron* electron1, KElectron* electron2) -> bool
 	          { return electron1->p4.Pt() > electron2->p4.Pt(); });
 }
 
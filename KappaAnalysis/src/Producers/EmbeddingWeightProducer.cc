@@ -6,12 +6,19 @@ std::string EmbeddingWeightProducer::GetProducerId() const {
 	return "EmbeddingWeightProducer";
 }
 
+void EmbeddingWeightProducer::Init(KappaSettings const& settings)
+{
+	KappaProducerBase::Init(settings);
+
+	m_weightSlot = EventWeights::RegisterWeight("embeddingWeight");
+}
+
 void EmbeddingWeightProducer::Produce(KappaEvent const& event,
 		KappaProduct& product,
 		KappaSettings const& settings) const
 {
 	assert(event.m_eventInfo);
 
-	product.m_weights["embeddingWeight"] = event.m_eventInfo->minVisPtFilterWeight;
+	product.m_weights.Set(m_weightSlot, event.m_eventInfo->minVisPtFilterWeight);
 }
 
@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include "boost/algorithm/string/join.hpp"
 
 #include "Artus/KappaAnalysis/interface/KappaTypes.h"
@@ -24,27 +26,54 @@ void EventWeightProducer::Init(KappaSettings const& settings)
 {
 	ProducerBase<KappaTypes>::Init(settings);
 	pipelineName = settings.GetName();
+
+	m_eventWeightSlot = EventWeights::RegisterWeight(settings.GetEventWeight());
+}
+
+void EventWeightProducer::OnRun(KappaEvent const& event, KappaSettings const& settings)
+{
+	m_constantFactorValid = false;
 }
 
 void EventWeightProducer::Produce(KappaEvent const& event, KappaProduct& product,
                                   KappaSettings const& settings) const
 {
-	double eventWeight = settings.GetBaseWeight();
-	bool firstRun = m_weightNames.empty();
+	uint64_t setMask = product.m_weights.GetSetMask() & ~(uint64_t(1) << m_eventWeightSlot);
+	uint64_t constantMask = setMask & EventWeights::GetConstantMask();
+
+	if (m_weightNames.empty())
+	{
+		m_weightNames = product.m_weights.GetSetNames();
+		m_weightNames.erase(std::remove(m_weightNames.begin(), m_weightNames.end(), settings.GetEventWeight()), m_weightNames.end());
+	}
+
+	// the constant weights only need to be multiplied once per run
+	if ((! m_constantFactorValid) || (constantMask != m_constantFactorMask))
+	{
+		m_constantFactor = settings.GetBaseWeight();
+		for (size_t slot = 0; slot < EventWeights::MaxSlots; ++slot)
+		{
+			if ((constantMask & (uint64_t(1) << slot)) != 0)
+			{
+				m_constantFactor *= product.m_weights.Get(slot);
+			}
+		}
+		m_constantFactorMask = constantMask;
+		m_constantFactorValid = true;
+	}
 
-	// loop over all previously calculated weights and multiply them
-	for(std::map<std::string, double>::const_iterator weight = product.m_weights.begin();
-		weight != product.m_weights.end(); ++weight)
+	// multiply all other previously calculated weights
+	double eventWeight = m_constantFactor;
+	uint64_t eventMask = setMask & ~constantMask;
+	for (size_t slot = 0; eventMask != 0; ++slot, eventMask >>= 1)
 	{
-		eventWeight *= weight->second;
-		
-		if (firstRun)
+		if ((eventMask & uint64_t(1)) != 0)
 		{
-			m_weightNames.push_back(weight->first);
+			eventWeight *= product.m_weights.Get(slot);
 		}
 	}
 
-	product.m_weights[settings.GetEventWeight()] = eventWeight;
+	product.m_weights.Set(m_eventWeightSlot, eventWeight);
 }
 
 
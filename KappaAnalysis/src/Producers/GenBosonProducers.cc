@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include "Artus/KappaAnalysis/interface/Producers/GenBosonProducers.h"
 #include "Artus/Consumer/interface/LambdaNtupleConsumer.h"
 #include "Artus/Utility/interface/Utility.h"
@@ -60,17 +62,21 @@ void GenBosonFromGenParticlesProducer::FindGenBoson(KappaEvent const& event, Kap
 	product.m_genBosonLV = RMFLV();
 	product.m_genBosonLVFound = false;
 	
-	for (unsigned int genParticleIndex = startIndex; genParticleIndex < event.m_genParticles->size(); ++genParticleIndex)
+	// first last copy with one of the pdgIds and one of the statuses
+	GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
+	size_t bosonIndex = genParticleView.GetNParticles();
+	for (std::vector<int>::const_iterator status = settings.GetBosonStatuses().begin();
+	     status != settings.GetBosonStatuses().end(); ++status)
 	{
-		KGenParticle* genParticle = &(event.m_genParticles->at(genParticleIndex));
-		if (Utility::Contains(settings.GetBosonPdgIds(), std::abs(genParticle->pdgId)) && Utility::Contains(settings.GetBosonStatuses(), genParticle->status()) && genParticle->isLastCopy())
-		{
-			//if (!genParticle->isLastCopy()) std::cout << genParticle->isLastCopy() << std::endl;
-			product.m_genBosonParticle = genParticle;
-			product.m_genBosonLV = genParticle->p4;
-			product.m_genBosonLVFound = true;
-			break;
-		}
+		bosonIndex = std::min(bosonIndex, genParticleView.FindFirst(settings.GetBosonPdgIds(), *status, GenParticleView::IS_LAST_COPY, startIndex));
+	}
+	
+	if (bosonIndex < genParticleView.GetNParticles())
+	{
+		KGenParticle* genParticle = genParticleView.GetParticle(bosonIndex);
+		product.m_genBosonParticle = genParticle;
+		product.m_genBosonLV = genParticle->p4;
+		product.m_genBosonLVFound = true;
 	}
 }
 
@@ -89,45 +95,30 @@ void GenBosonProductionProducer::Produce(KappaEvent const& event, KappaProduct&
 {
 	assert(product.m_genBosonParticle != nullptr);
 	
-	// search for boson index
-	unsigned int bosonIndex = 0;
-	for (KGenParticles::const_iterator genParticle = event.m_genParticles->begin();
-		 genParticle != event.m_genParticles->end(); ++genParticle)
-	{
-		if (product.m_genBosonParticle == &(*genParticle))
-		{
-			break;
-		}
-		++bosonIndex;
-	}
-	
-	product.m_genParticlesProducingBoson = FindMothersWithDifferentPdgId(event.m_genParticles, bosonIndex, product.m_genBosonParticle->pdgId);
+	GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
+	size_t bosonIndex = genParticleView.GetIndex(product.m_genBosonParticle);
+	product.m_genParticlesProducingBoson = FindMothersWithDifferentPdgId(genParticleView, bosonIndex, product.m_genBosonParticle->pdgId);
 }
 
 std::vector<KGenParticle*> GenBosonProductionProducer::FindMothersWithDifferentPdgId(
-		KGenParticles* genParticles,
-		unsigned int currentIndex,
+		GenParticleView const& genParticleView,
+		size_t currentIndex,
 		int currentPdgId) const
 {
 	std::vector<KGenParticle*> mothers;
 	
-	unsigned int index = 0;
-	for (KGenParticles::iterator genParticle = genParticles->begin();
-		 genParticle != genParticles->end(); ++genParticle)
+	for (uint32_t motherIndex : genParticleView.GetMothers(currentIndex))
 	{
-		if (Utility::Contains(genParticle->daughterIndices, currentIndex))
+		KGenParticle* mother = genParticleView.GetParticle(motherIndex);
+		if (mother->pdgId == currentPdgId)
 		{
-			if (genParticle->pdgId == currentPdgId)
-			{
-				std::vector<KGenParticle*> tmpMothers = FindMothersWithDifferentPdgId(genParticles, index, currentPdgId);
-				mothers.insert(mothers.end(), tmpMothers.begin(), tmpMothers.end());
-			}
-			else
-			{
-				mothers.push_back(&(*genParticle));
-			}
+			std::vector<KGenParticle*> tmpMothers = FindMothersWithDifferentPdgId(genParticleView, motherIndex, currentPdgId);
+			mothers.insert(mothers.end(), tmpMothers.begin(), tmpMothers.end());
+		}
+		else
+		{
+			mothers.push_back(mother);
 		}
-		++index;
 	}
 	
 	return mothers;
@@ -245,18 +236,17 @@ void GenBosonDiLeptonDecayModeProducer::FindGenDiLeptons(KappaEvent const& event
 		size_t iDaughter = 0;
 		RMFLV genBosonLV;
 		
-		for (KGenParticles::iterator genParticle = event.m_genParticles->begin();
-		     genParticle != event.m_genParticles->end() && (iDaughter < 2); ++genParticle)
+		GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
+		static const std::vector<int> leptonPdgIds = { DefaultValues::pdgIdElectron, DefaultValues::pdgIdMuon, DefaultValues::pdgIdTau };
+		for (size_t leptonIndex = genParticleView.FindFirst(leptonPdgIds);
+		     (leptonIndex < genParticleView.GetNParticles()) && (iDaughter < 2);
+		     leptonIndex = genParticleView.FindFirst(leptonPdgIds, -1, 0, leptonIndex + 1))
+		// if (genParticle->isPrompt() && genParticle->isPromptDecayed())
 		{
-			if ((std::abs(genParticle->pdgId) == DefaultValues::pdgIdElectron) ||
-			    (std::abs(genParticle->pdgId) == DefaultValues::pdgIdMuon) ||
-			    (std::abs(genParticle->pdgId) == DefaultValues::pdgIdTau))
-			// if (genParticle->isPrompt() && genParticle->isPromptDecayed())
-			{
-				genBosonLV += (*genParticle).p4;
-				product.m_genLeptonsFromBosonDecay.push_back(&(*genParticle));
-				++iDaughter;
-			}
+			KGenParticle* genParticle = genParticleView.GetParticle(leptonIndex);
+			genBosonLV += genParticle->p4;
+			product.m_genLeptonsFromBosonDecay.push_back(genParticle);
+			++iDaughter;
 		}
 		
 		product.m_genBosonLV = genBosonLV;
@@ -290,17 +280,7 @@ void GenBosonDiLeptonDecayModeProducer::FindGenDiLeptons(KappaEvent const& event
 		
 		if (rerun)
 		{
-			// search for boson index
-			unsigned int bosonIndex = 0;
-			for (KGenParticles::const_iterator genParticle = event.m_genParticles->begin();
-				 genParticle != event.m_genParticles->end(); ++genParticle)
-			{
-				if (product.m_genBosonParticle == &(*genParticle))
-				{
-					break;
-				}
-				++bosonIndex;
-			}
+			size_t bosonIndex = product.GetGenParticleView(event.m_genParticles).GetIndex(product.m_genBosonParticle);
 			
 			// search for next boson
 			FindGenBoson(event, product, settings, bosonIndex+1);
@@ -32,11 +32,13 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 
 	if (m_DeltaRMatchingRecoJetGenParticle > 0.0f)
 	{
+		FillGenPartons(event, product);
+
 		// loop over all valid objects (jets) to check
 		for (std::vector<KBasicJet*>::iterator validJet = product.m_validJets.begin();
 			 validJet != product.m_validJets.end();)
 		{
-			KGenParticle* matchedParticle = Match(event, product, settings, static_cast<KLV*>(*validJet));
+			KGenParticle* matchedParticle = MatchGenPartons(settings, static_cast<KLV*>(*validJet));
 			if (matchedParticle != nullptr)
 			{
                 if (settings.GetDebugVerbosity() > 0) {
@@ -70,11 +72,37 @@ void RecoJetGenParticleMatchingProducer::Produce(event_type const& event, produc
 	}
 }
 
-// This is the actual reco jet gen particle matcher
 KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event, product_type const& product,
                                                         setting_type const& settings, KLV* const recoJet) const
 {
-	float deltaR = 0.0;
+	FillGenPartons(event, product);
+	return MatchGenPartons(settings, recoJet);
+}
+
+void RecoJetGenParticleMatchingProducer::FillGenPartons(event_type const& event, product_type const& product) const
+{
+	m_genPartons.clear();
+	m_genPartonCoordinates.Clear();
+
+	// only use genParticles with id 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5
+	static const std::vector<int> partonAbsPdgIds = { 1, 2, 3, 4, 5, 21 };
+	GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
+	genParticleView.GetParticlesWithAbsPdgIds(partonAbsPdgIds, m_genPartonIndices);
+	for (std::vector<uint32_t>::const_iterator index = m_genPartonIndices.begin(); index != m_genPartonIndices.end(); ++index)
+	{
+		KGenParticle* genParticle = genParticleView.GetParticle(*index);
+		if (genParticle->pdgId != -21)
+		{
+			m_genPartons.push_back(genParticle);
+			m_genPartonCoordinates.AddObject(*genParticle);
+		}
+	}
+	m_genPartonDeltaR2.resize(m_genPartons.size());
+}
+
+// This is the actual reco jet gen particle matcher
+KGenParticle* RecoJetGenParticleMatchingProducer::MatchGenPartons(setting_type const& settings, KLV* const recoJet) const
+{
 	size_t nMatchingAlgoPartons = 0;
 	size_t nMatchingPhysPartons = 0;
 	KGenParticle* hardestPhysParton = nullptr;
@@ -82,65 +110,58 @@ KGenParticle* RecoJetGenParticleMatchingProducer::Match(event_type const& event,
 	KGenParticle* hardestBQuark = nullptr;
 	KGenParticle* hardestCQuark = nullptr;
 
-	// loop over all genParticles 
-	for (std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-	     genParticle != event.m_genParticles->end(); ++genParticle)
+	DeltaRMatcher::ComputeDeltaR2(recoJet->p4.Eta(), recoJet->p4.Phi(), m_genPartonCoordinates, m_genPartonDeltaR2.data());
+	const float maxDeltaR2 = DeltaRMatcher::GetDeltaR2Cut(m_DeltaRMatchingRecoJetGenParticle);
+
+	// loop over all gen partons
+	for (size_t genPartonIndex = 0; genPartonIndex < m_genPartons.size(); ++genPartonIndex)
 	{
-		// only use genParticles with id 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5
-		if ((std::abs(genParticle->pdgId) == 1) ||
-		    (std::abs(genParticle->pdgId) == 2) ||
-		    (std::abs(genParticle->pdgId) == 3) ||
-		    (std::abs(genParticle->pdgId) == 4) ||
-		    (std::abs(genParticle->pdgId) == 5) ||
-		    (genParticle->pdgId) == 21)
+		KGenParticle* genParticle = m_genPartons[genPartonIndex];
+		if (m_genPartonDeltaR2[genPartonIndex] < maxDeltaR2)
 		{
-			deltaR = ROOT::Math::VectorUtil::DeltaR((recoJet)->p4, genParticle->p4);
-			if (deltaR < m_DeltaRMatchingRecoJetGenParticle)
+			// Algorithmic:
+			if (genParticle->status() != settings.GetRecoJetMatchingGenParticleStatus())
 			{
-				// Algorithmic:
-				if (genParticle->status() != settings.GetRecoJetMatchingGenParticleStatus())
-				{
-					++nMatchingAlgoPartons;
-					if (std::abs(genParticle->pdgId) == 5)
-					{ 
-						if (hardestBQuark == nullptr)
-						{
-							hardestBQuark = &(*genParticle);
-						}
-						else if (genParticle->p4.Pt() > hardestBQuark->p4.Pt())
-						{
-							hardestBQuark = &(*genParticle);
-						}
+				++nMatchingAlgoPartons;
+				if (std::abs(genParticle->pdgId) == 5)
+				{ 
+					if (hardestBQuark == nullptr)
+					{
+						hardestBQuark = genParticle;
 					}
-					else if (std::abs(genParticle->pdgId) == 4)
-					{ 
-						if (hardestCQuark == nullptr)
-						{
-							hardestCQuark = &(*genParticle);
-						}
-						else if (genParticle->p4.Pt() > hardestCQuark->p4.Pt())
-						{
-							hardestCQuark = &(*genParticle);
-						}
+					else if (genParticle->p4.Pt() > hardestBQuark->p4.Pt())
+					{
+						hardestBQuark = genParticle;
 					}
-					else if (hardestParton == nullptr)
+				}
+				else if (std::abs(genParticle->pdgId) == 4)
+				{ 
+					if (hardestCQuark == nullptr)
 					{
-						hardestParton = &(*genParticle);
+						hardestCQuark = genParticle;
 					}
-					else if (genParticle->p4.Pt() > hardestParton->p4.Pt())
+					else if (genParticle->p4.Pt() > hardestCQuark->p4.Pt())
 					{
-						hardestParton = &(*genParticle);
+						hardestCQuark = genParticle;
 					}
 				}
-
-				// Physics:
-				else
+				else if (hardestParton == nullptr)
 				{
-					++nMatchingPhysPartons;
-					hardestPhysParton = &(*genParticle);
+					hardestParton = genParticle;
 				}
-			} 
-		}
+				else if (genParticle->p4.Pt() > hardestParton->p4.Pt())
+				{
+					hardestParton = genParticle;
+				}
+			}
+
+			// Physics:
+			else
+			{
+				++nMatchingPhysPartons;
+				hardestPhysParton = genParticle;
+			}
+		} 
 	}
 
 	// ALGORITHMIC DEFINITION
@@ -22,6 +22,7 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
                      KappaSettings const& settings) const
 {
 	assert(event.m_genParticles);
+	GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
 	LOG(DEBUG) << "\n[GenParticleProducer]";
 	LOG(DEBUG) << "GenParticleTypes:";
 	for (auto type_it = settings.GetGenParticleTypes().begin(); type_it != settings.GetGenParticleTypes().end(); ++type_it) {
@@ -37,19 +38,24 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 		}
 		LOG(DEBUG) << "GenParticleStatus: " << settings.GetGenParticleStatus(); 
 		
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		for (std::vector<int>::const_iterator pdgId = settings.GetGenParticlePdgIds().begin();
+		     pdgId != settings.GetGenParticlePdgIds().end(); ++pdgId)
 		{
-			if (std::find(settings.GetGenParticlePdgIds().begin(), settings.GetGenParticlePdgIds().end(), part->pdgId)
-			    != settings.GetGenParticlePdgIds().end())
+			if (std::find(settings.GetGenParticlePdgIds().begin(), pdgId, *pdgId) != pdgId)
 			{
-				if ((settings.GetGenParticleStatus() == -1) || ( settings.GetGenParticleStatus() == part->status()))
+				continue;
+			}
+			for (uint32_t index : genParticleView.GetParticlesWithAbsPdgId(std::abs(*pdgId)))
+			{
+				KGenParticle* part = genParticleView.GetParticle(index);
+				if ((part->pdgId == *pdgId) &&
+				    ((settings.GetGenParticleStatus() == -1) || (settings.GetGenParticleStatus() == genParticleView.GetStatus(index))))
 				{
 					if (settings.GetDebugVerbosity() > 1) {
 						LOG(DEBUG) << "Found genParticle with pdgId " << part->pdgId
 							<< " and status " << part->status();
 					}
-					product.m_genParticlesMap[part->pdgId].push_back(&(*part));
+					product.m_genParticlesMap[part->pdgId].push_back(part);
 				}
 			}
 		}
@@ -67,25 +73,13 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 	{
 		LOG(DEBUG) << "Looking for genElectron with status " << settings.GetGenElectronStatus();
 		LOG(DEBUG) << "GenElectronFromTauDecay: (0:No | 1:Yes): " << settings.GetGenElectronFromTauDecay();
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		uint16_t electronFlags = (settings.GetGenElectronFromTauDecay() ? GenParticleView::IS_DIRECT_PROMPT_TAU_DECAY_PRODUCT : 0);
+		for (uint32_t index : genParticleView.GetParticlesWithAbsPdgId(11))
 		{
-			if (std::abs(part->pdgId) == 11)
+			if (((settings.GetGenElectronStatus() == -1) || (settings.GetGenElectronStatus() == genParticleView.GetStatus(index))) &&
+			    genParticleView.HasFlags(index, electronFlags))
 			{
-				if ((settings.GetGenElectronStatus() == -1) || ( settings.GetGenElectronStatus() == part->status()))
-				{
-					if (settings.GetGenElectronFromTauDecay())
-					{
-						if (part->isDirectPromptTauDecayProduct())
-						{
-							product.m_genElectrons.push_back(&(*part));
-						}
-					}
-					else
-					{
-						product.m_genElectrons.push_back(&(*part));
-					}
-				}
+				product.m_genElectrons.push_back(genParticleView.GetParticle(index));
 			}
 		}
 		LOG(DEBUG) << "Number m_genElectrons: " << product.m_genElectrons.size();
@@ -96,25 +90,13 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 	{
 		LOG(DEBUG) << "Looking for genMuons with status " << settings.GetGenMuonStatus();
 		LOG(DEBUG) << "GenMuonFromTauDecay (0:No | 1:Yes): " << settings.GetGenMuonFromTauDecay();
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		uint16_t muonFlags = (settings.GetGenMuonFromTauDecay() ? GenParticleView::IS_DIRECT_PROMPT_TAU_DECAY_PRODUCT : 0);
+		for (uint32_t index : genParticleView.GetParticlesWithAbsPdgId(13))
 		{
-			if (std::abs(part->pdgId) == 13)
+			if (((settings.GetGenMuonStatus() == -1) || (settings.GetGenMuonStatus() == genParticleView.GetStatus(index))) &&
+			    genParticleView.HasFlags(index, muonFlags))
 			{
-				if ((settings.GetGenMuonStatus() == -1) || ( settings.GetGenMuonStatus() == part->status()))
-				{
-					if (settings.GetGenMuonFromTauDecay())
-					{
-						if (part->isDirectPromptTauDecayProduct())
-						{
-							product.m_genMuons.push_back(&(*part));
-						}
-					}
-					else
-					{
-						product.m_genMuons.push_back(&(*part));
-					}
-				}
+				product.m_genMuons.push_back(genParticleView.GetParticle(index));
 			}
 		}
 		LOG(DEBUG) << "Number m_genMuons: " << product.m_genMuons.size();
@@ -124,15 +106,11 @@ void GenParticleProducer::Produce(KappaEvent const& event, KappaProduct& product
 	if (Utility::Contains(m_genParticleTypes, KappaEnumTypes::GenParticleType::GENTAU))
 	{
 		LOG(DEBUG) << "Looking for genTaus with status " << settings.GetGenTauStatus();
-		for (KGenParticles::iterator part = event.m_genParticles->begin();
-		     part != event.m_genParticles->end(); ++part)
+		for (uint32_t index : genParticleView.GetParticlesWithAbsPdgId(15))
 		{
-			if (std::abs(part->pdgId) == 15)
+			if ((settings.GetGenTauStatus() == -1) || (settings.GetGenTauStatus() == genParticleView.GetStatus(index)))
 			{
-				if ((settings.GetGenTauStatus() == -1) || ( settings.GetGenTauStatus() == part->status()))
-				{
-					product.m_genTaus.push_back(&(*part));
-				}
+				product.m_genTaus.push_back(genParticleView.GetParticle(index));
 			}
 		}
 		LOG(DEBUG) << "Number m_genTaus: " << product.m_genTaus.size();
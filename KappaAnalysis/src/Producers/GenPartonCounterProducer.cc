@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include "Artus/KappaAnalysis/interface/Producers/GenPartonCounterProducer.h"
 #include "Artus/Utility/interface/Utility.h"
 
@@ -17,32 +19,23 @@ void GenPartonCounterProducer::Produce(KappaEvent const& event, KappaProduct& pr
 {
 	assert(event.m_genParticles);
 
-	int nPartons = 0;
-	bool countPartons = false;
+	GenParticleView const& genParticleView = product.GetGenParticleView(event.m_genParticles);
 
-	for (KGenParticles::const_iterator genParticle = event.m_genParticles->begin();
-		 genParticle != event.m_genParticles->end(); ++genParticle)
-	{
-		if (genParticle->status() != settings.GetPartonStatus())
-			continue;
-
-		if (countPartons) {
-			// quarks and gluons
-			if (std::abs(genParticle->pdgId) == 1 ||
-			    std::abs(genParticle->pdgId) == 2 ||
-			    std::abs(genParticle->pdgId) == 3 ||
-			    std::abs(genParticle->pdgId) == 4 ||
-			    std::abs(genParticle->pdgId) == 5 ||
-			    std::abs(genParticle->pdgId) == 6 ||
-			    std::abs(genParticle->pdgId) == 21)
+	// start counting partons after finding a boson (for example W or Z)
+	size_t bosonIndex = genParticleView.FindFirst(settings.GetBosonPdgIds(), settings.GetPartonStatus());
 
-				++nPartons;
-		}
-
-		// start counting partons after finding a boson (for example W or Z)
-		if (Utility::Contains(settings.GetBosonPdgIds(), std::abs(genParticle->pdgId)))
+	// quarks and gluons
+	static const std::vector<int> partonAbsPdgIds = { 1, 2, 3, 4, 5, 6, 21 };
+	int nPartons = 0;
+	for (std::vector<int>::const_iterator partonAbsPdgId = partonAbsPdgIds.begin(); partonAbsPdgId != partonAbsPdgIds.end(); ++partonAbsPdgId)
+	{
+		GenParticleView::IndexRange partons = genParticleView.GetParticlesWithAbsPdgId(*partonAbsPdgId);
+		for (uint32_t const* index = std::upper_bound(partons.begin(), partons.end(), bosonIndex); index != partons.end(); ++index)
 		{
-			countPartons = true;
+			if (genParticleView.GetStatus(*index) == settings.GetPartonStatus())
+			{
+				++nPartons;
+			}
 		}
 	}
 
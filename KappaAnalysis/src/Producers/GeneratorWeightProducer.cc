@@ -6,6 +6,13 @@ std::string GeneratorWeightProducer::GetProducerId() const {
 	return "GeneratorWeightProducer";
 }
 
+void GeneratorWeightProducer::Init(KappaSettings const& settings)
+{
+	KappaProducerBase::Init(settings);
+
+	m_weightSlot = EventWeights::RegisterWeight("generatorWeight");
+}
+
 void GeneratorWeightProducer::Produce(KappaEvent const& event,
 		KappaProduct& product,
 		KappaSettings const& settings) const
@@ -23,13 +30,13 @@ void GeneratorWeightProducer::Produce(KappaEvent const& event,
 
 		// store this weight, normalizing it to the sum of weights (positive and negative) 
 		// computed before any selection is applied
-		product.m_weights["generatorWeight"] = (weight / settings.GetGeneratorWeight());
+		product.m_weights.Set(m_weightSlot, weight / settings.GetGeneratorWeight());
 	}
 	// otherwise retrieve it, on an event-basis, from the input file
 	else
 	{
         LOG(DEBUG) << "Adding generatorWeight from event: " << event.m_genEventInfo->weight;
-		product.m_weights["generatorWeight"] = event.m_genEventInfo->weight;
+		product.m_weights.Set(m_weightSlot, event.m_genEventInfo->weight);
 	}
 }
 
@@ -9,85 +9,127 @@ std::string HltProducer::GetProducerId() const {
 void HltProducer::Init(KappaSettings const &settings) {
     KappaProducerBase::Init(settings);
 
+    m_weightSlot = EventWeights::RegisterWeight("hltPrescaleWeight");
+
     // add possible quantities for the lambda ntuples consumers
     LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("nSelectedHltPaths",
                                                      [](KappaEvent const &event, KappaProduct const &product) {
-                                                         return static_cast<int>(product.m_selectedHltNames.size());
+                                                         return static_cast<int>(product.m_selectedHltPositions.size());
                                                      });
     LambdaNtupleConsumer<KappaTypes>::AddVStringQuantity("selectedHltPaths",
                                                          [](KappaEvent const &event, KappaProduct const &product) {
-                                                             return product.m_selectedHltNames;
+                                                             return product.GetSelectedHltNames();
                                                          });
 }
 
+void HltProducer::OnLumi(KappaEvent const &event, KappaSettings const &settings) {
+    assert(event.m_lumiInfo);
+    assert(event.m_eventInfo);
+
+    // the paths in the product can only differ from the settings if they are modified by other producers,
+    // which is checked again in Produce
+    if (!settings.GetHltPaths().empty()) {
+        ResolveHltPaths(event, settings.GetHltPaths(), true);
+    }
+}
+
 void HltProducer::Produce(KappaEvent const &event, KappaProduct &product,
                           KappaSettings const &settings) const {
     assert(event.m_lumiInfo);
     assert(event.m_eventInfo);
     LOG(DEBUG) << "\n[HltProducer]";
-    if (product.m_settingsHltPaths.empty()) {
-        product.m_settingsHltPaths.insert(product.m_settingsHltPaths.begin(),
-                                          settings.GetHltPaths().begin(),
-                                          settings.GetHltPaths().end());
-    }
-    if (product.m_settingsHltPaths.empty()) {
+    // the configured paths are used unless other producers filled the product with different ones
+    bool hltPathsFromSettings = product.m_settingsHltPaths.empty();
+    std::vector<std::string> const &hltPaths = (hltPathsFromSettings ? settings.GetHltPaths() : product.m_settingsHltPaths);
+    if (hltPaths.empty()) {
         LOG(FATAL) << "No Hlt Trigger path list (tag \"HltPaths\") configured!";
     }
 
-    // set LumiMetadat, needs to be done here for the case running over multiple files
-    m_hltInfo.setLumiInfo(event.m_lumiInfo);
-
-    // search (independently) for trigger with lowest prescale and for fired triggers
-    std::string lowestPrescaleHltName;
-    int lowestPrescale = std::numeric_limits<int>::max();
+    // OnLumi is not called if the first event of a lumi section is rejected before this producer.
+    // Paths modified by other producers (e.g. run-dependent paths) are assumed not to change
+    // within a lumi section, such that they are only resolved for the first event.
+    if ((!m_hltPathsResolved) ||
+        (event.m_eventInfo->nRun != m_resolvedRun) || (event.m_eventInfo->nLumi != m_resolvedLumi) ||
+        (hltPathsFromSettings != m_hltPathsResolvedFromSettings)) {
+        ResolveHltPaths(event, hltPaths, hltPathsFromSettings);
+    }
 
-    std::string lowestSelectedPrescaleHltName;
     int lowestSelectedPrescale = std::numeric_limits<int>::max();
 
-    product.m_selectedHltNames.clear();
+    product.m_hltNames = &(event.m_lumiInfo->hltNames);
+    product.m_selectedHltBits.resize(event.m_lumiInfo->hltNames.size());
+    product.m_selectedHltBits.reset();
     product.m_selectedHltPositions.clear();
     product.m_selectedHltPrescales.clear();
-    for (std::vector<std::string>::const_iterator hltPath = product.m_settingsHltPaths.begin();
-         hltPath != product.m_settingsHltPaths.end(); ++hltPath) {
-        std::string hltName = m_hltInfo.getHLTName(*hltPath);
-        if (!hltName.empty()) {
-            // look for trigger with lowest prescale
-            // do not use hltName here as a parameter because *hltPath is already cached.
-            int prescale = m_hltInfo.getPrescale(*hltPath);
-            if ((prescale < lowestPrescale) && (prescale > 0)) {
-                lowestPrescale = prescale;
-                lowestPrescaleHltName = hltName;
-            }
-
-            // look for (unprescaled if requested) fired trigger
-            if (event.m_eventInfo->hltFired(hltName, event.m_lumiInfo) &&
-                (settings.GetAllowPrescaledTrigger() || (prescale <= 1))) {
-                product.m_selectedHltNames.push_back(hltName);
-                LOG(DEBUG) << "Hlt: " << hltName;
-                // do not use hltName here as a parameter because *hltPath is already cached.
-                product.m_selectedHltPositions.push_back(static_cast<int>(m_hltInfo.getHLTPosition(*hltPath)));
-
-                product.m_selectedHltPrescales.push_back(prescale);
-                if ((prescale < lowestSelectedPrescale) && (prescale > 0)) {
-                    lowestSelectedPrescale = prescale;
-                    lowestSelectedPrescaleHltName = hltName;
-                }
+    product.m_selectedHltNamesValid = false;
+    for (std::vector<ResolvedHltPath>::const_iterator hltPath = m_resolvedHltPaths.begin();
+         hltPath != m_resolvedHltPaths.end(); ++hltPath) {
+        // look for (unprescaled if requested) fired trigger
+        if (event.m_eventInfo->hltFired(hltPath->position) &&
+            (settings.GetAllowPrescaledTrigger() || (hltPath->prescale <= 1))) {
+            LOG(DEBUG) << "Hlt: " << event.m_lumiInfo->hltNames[hltPath->position];
+            product.m_selectedHltBits.set(hltPath->position);
+            product.m_selectedHltPositions.push_back(static_cast<int>(hltPath->position));
+            product.m_selectedHltPrescales.push_back(hltPath->prescale);
+            if ((hltPath->prescale < lowestSelectedPrescale) && (hltPath->prescale > 0)) {
+                lowestSelectedPrescale = hltPath->prescale;
             }
         }
     }
 
-    if ((!settings.GetAllowPrescaledTrigger()) && (lowestPrescale > 1)) {
+    if ((!settings.GetAllowPrescaledTrigger()) && (m_lowestPrescale > 1)) {
         LOG(WARNING) << "No unprescaled trigger found for event " << event.m_eventInfo->nEvent
-                     << "! Lowest prescale: " << lowestPrescale << " (\"" << lowestPrescaleHltName << "\").";
+                     << "! Lowest prescale: " << m_lowestPrescale << " (\""
+                     << ((m_lowestPrescale < std::numeric_limits<int>::max()) ? event.m_lumiInfo->hltNames[m_lowestPrescalePosition] : "")
+                     << "\").";
     }
 
-    if (!(lowestPrescale > 0)) {
-        lowestPrescale = 1;
-    }
     if (!(lowestSelectedPrescale > 0) || (lowestSelectedPrescale == std::numeric_limits<int>::max())) {
         lowestSelectedPrescale = 1;
     }
 
     // TODO: how to define the HLT prescale eventweight when more than one HLT fires? The product of them? The min. or max. value? Maybe overwrite it later?
-    product.m_weights["hltPrescaleWeight"] = lowestSelectedPrescale;
+    product.m_weights.Set(m_weightSlot, lowestSelectedPrescale);
+}
+
+void HltProducer::ResolveHltPaths(KappaEvent const &event, std::vector<std::string> const &hltPaths,
+                                  bool hltPathsFromSettings) const {
+    // set LumiMetadata, needs to be done per lumi section for the case running over multiple files
+    m_hltInfo.setLumiInfo(event.m_lumiInfo);
+
+    m_resolvedHltPaths.clear();
+    m_lowestPrescale = std::numeric_limits<int>::max();
+    m_lowestPrescalePosition = 0;
+
+    for (std::vector<std::string>::const_iterator hltPath = hltPaths.begin(); hltPath != hltPaths.end(); ++hltPath) {
+        std::string hltName = m_hltInfo.getHLTName(*hltPath);
+        if (!hltName.empty()) {
+            // do not use hltName here as a parameter because *hltPath is already cached.
+            ResolvedHltPath resolvedHltPath;
+            resolvedHltPath.position = m_hltInfo.getHLTPosition(*hltPath);
+            resolvedHltPath.prescale = m_hltInfo.getPrescale(*hltPath);
+
+            // paths matching several configured patterns are only selected once
+            bool alreadyResolved = false;
+            for (std::vector<ResolvedHltPath>::const_iterator otherHltPath = m_resolvedHltPaths.begin();
+                 otherHltPath != m_resolvedHltPaths.end(); ++otherHltPath) {
+                alreadyResolved = alreadyResolved || (otherHltPath->position == resolvedHltPath.position);
+            }
+            if (alreadyResolved) {
+                continue;
+            }
+            m_resolvedHltPaths.push_back(resolvedHltPath);
+
+            // look for trigger with lowest prescale
+            if ((resolvedHltPath.prescale < m_lowestPrescale) && (resolvedHltPath.prescale > 0)) {
+                m_lowestPrescale = resolvedHltPath.prescale;
+                m_lowestPrescalePosition = resolvedHltPath.position;
+            }
+        }
+    }
+
+    m_resolvedRun = event.m_eventInfo->nRun;
+    m_resolvedLumi = event.m_eventInfo->nLumi;
+    m_hltPathsResolved = true;
+    m_hltPathsResolvedFromSettings = hltPathsFromSettings;
 }
@@ -0,0 +1,23 @@
+
+#include "Artus/KappaAnalysis/interface/Producers/JetCorrectionUncertaintyMatrixProducer.h"
+
+
+JetCorrectionUncertaintyMatrixProducer::JetCorrectionUncertaintyMatrixProducer() :
+	JetCorrectionUncertaintyMatrixProducerBase<KBasicJet>(&KappaProduct::m_correctedJets, &KappaProduct::m_jetEnergyUncertaintyMatrix)
+{
+}
+
+std::string JetCorrectionUncertaintyMatrixProducer::GetProducerId() const {
+	return "JetCorrectionUncertaintyMatrixProducer";
+}
+
+
+TaggedJetCorrectionUncertaintyMatrixProducer::TaggedJetCorrectionUncertaintyMatrixProducer() :
+	JetCorrectionUncertaintyMatrixProducerBase<KJet>(&KappaProduct::m_correctedTaggedJets, &KappaProduct::m_taggedJetEnergyUncertaintyMatrix)
+{
+}
+
+std::string TaggedJetCorrectionUncertaintyMatrixProducer::GetProducerId() const {
+	return "TaggedJetCorrectionUncertaintyMatrixProducer";
+}
+
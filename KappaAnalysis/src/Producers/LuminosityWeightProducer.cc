@@ -6,10 +6,28 @@ std::string LuminosityWeightProducer::GetProducerId() const {
 	return "LuminosityWeightProducer";
 }
 
+void LuminosityWeightProducer::Init(KappaSettings const& settings)
+{
+	KappaProducerBase::Init(settings);
+
+	m_weightSlot = EventWeights::RegisterWeight("luminosityWeight", true);
+	UpdateWeight(settings);
+}
+
+void LuminosityWeightProducer::OnRun(KappaEvent const& event, KappaSettings const& settings)
+{
+	UpdateWeight(settings);
+}
+
 void LuminosityWeightProducer::Produce(KappaEvent const& event,
 		KappaProduct& product,
 		KappaSettings const& settings) const
 {
-	product.m_weights["luminosityWeight"] = (1.0 / static_cast<double>(settings.GetIntLuminosity()));
+	product.m_weights.Set(m_weightSlot, m_weight);
+}
+
+void LuminosityWeightProducer::UpdateWeight(KappaSettings const& settings)
+{
+	m_weight = (1.0 / static_cast<double>(settings.GetIntLuminosity()));
 }
 
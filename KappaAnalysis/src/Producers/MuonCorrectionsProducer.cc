@@ -37,7 +37,6 @@ void MuonCorrectionsProducer::Init(KappaSettings const& settings)
 	if ((muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2016) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2017) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2018) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2016UL) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2017UL) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2018UL))	{
 		rmcor = std::make_unique<RoccoR>(settings.GetMuonRochesterCorrectionsFile());
 	}
-	random = std::make_unique<TRandom3>();
 }
 
 void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& product,
@@ -54,22 +53,32 @@ void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& pro
 	size_t muonIndex = 0;
 	for (KMuons::const_iterator muon = event.m_muons->begin();
 		 muon != event.m_muons->end(); ++muon) {
-		product.m_correctedMuons[muonIndex] = std::shared_ptr<KMuon>(new KMuon(*muon));
-		product.m_originalLeptons[product.m_correctedMuons[muonIndex].get()] = &(*muon);
+		product.m_correctedMuons[muonIndex] = product.CreateEventObject<KMuon>(*muon);
+		product.m_originalLeptons[product.m_correctedMuons[muonIndex]] = &(*muon);
 		++muonIndex;
 	}
 
+	// the UW gen matching uses the generator particle view and gen taus built once per event
+	GenParticleView const* genParticleView = nullptr;
+	std::vector<RMFLV> genTausUW;
+	if (settings.GetCorrectOnlyRealMuons() && settings.GetUseUWGenMatching() && event.m_genParticles) {
+		genParticleView = &(product.GetGenParticleView(event.m_genParticles));
+		GeneratorInfo::BuildGenTausUW(*genParticleView, genTausUW);
+	}
+
 	// perform corrections on copied muons
-	for (std::vector<std::shared_ptr<KMuon> >::iterator muon = product.m_correctedMuons.begin();
+	for (std::vector<KMuon*>::iterator muon = product.m_correctedMuons.begin();
 		 muon != product.m_correctedMuons.end(); ++muon) {
 		// Check whether corrections should be applied at all
 		bool isRealMuon = false;
 		if (settings.GetCorrectOnlyRealMuons()) {
 			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 			if (settings.GetUseUWGenMatching()) {
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(product.m_originalLeptons[muon->get()]));
+				if (genParticleView) {
+					genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(*genParticleView, genTausUW, const_cast<KLepton*>(product.m_originalLeptons[*muon]));
+				}
 			} else {
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]), 
+				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[*muon]), 
 						product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
 				if (genParticle) {
 					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
@@ -86,29 +95,29 @@ void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& pro
 
 		// perform possible analysis-specific corrections
 		if (muonEnergyCorrection == MuonEnergyCorrection::FALL2015) {
-		muon->get()->p4 = muon->get()->p4 * (1.0);
+		(*muon)->p4 = (*muon)->p4 * (1.0);
 		} else if (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2015) {
 			TLorentzVector mu;
-			mu.SetPtEtaPhiM(muon->get()->p4.Pt(),muon->get()->p4.Eta(),muon->get()->p4.Phi(),muon->get()->p4.mass());
+			mu.SetPtEtaPhiM((*muon)->p4.Pt(),(*muon)->p4.Eta(),(*muon)->p4.Phi(),(*muon)->p4.mass());
 
-			int q = muon->get()->charge();
+			int q = (*muon)->charge();
 			float qter = 1.0;
 
 			if (settings.GetInputIsData()) {
 				rmcor2015->momcor_data(mu, q, 0, qter);
-				muon->get()->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
+				(*muon)->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
 			} else {
-			int ntrk = muon->get()->track.nTrackerLayers();
+			int ntrk = (*muon)->track.nTrackerLayers();
 				rmcor2015->momcor_mc(mu, q, ntrk, qter);
-				muon->get()->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
+				(*muon)->p4.SetPxPyPzE(mu.Px(),mu.Py(),mu.Pz(),mu.E());
 			}
 		} else if ((muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2016) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2017) ||
 			       	(muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2018) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2016UL) ||
 			       	(muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2017UL) || (muonEnergyCorrection == MuonEnergyCorrection::ROCHCORR2018UL)) {
-			int q = muon->get()->charge();
-			float pt = muon->get()->p4.Pt();
-			float eta = muon->get()->p4.Eta();
-			float phi = muon->get()->p4.Phi();
+			int q = (*muon)->charge();
+			float pt = (*muon)->p4.Pt();
+			float eta = (*muon)->p4.Eta();
+			float phi = (*muon)->p4.Phi();
 
 			float scaleFactor = 1.0;
 			LOG(DEBUG) << "Muon properties: q: " << q << " pt: " << pt << " eta: " << eta << " phi: " << phi; 
@@ -116,15 +125,16 @@ void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& pro
 				scaleFactor = rmcor->kScaleDT(q, pt, eta, phi);
 				LOG(DEBUG) << "scaleFactor (kScaleDT used): " << scaleFactor;
 			} else {
-				int ntrk = muon->get()->track.nTrackerLayers();
+				int ntrk = (*muon)->track.nTrackerLayers();
 				if (settings.GetRecoMuonMatchingGenParticleMatchAllMuons() &&
-						&(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]) != nullptr) {
-					KGenParticle* genMuon = &(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]);
+						&(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[*muon]))]) != nullptr) {
+					KGenParticle* genMuon = &(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[*muon]))]);
 					float genPt = genMuon->p4.Pt();
 					scaleFactor = rmcor->kSpreadMC(q, pt, eta, phi, genPt);
 					LOG(DEBUG) << "scaleFactor (kSpreadMC used), recommended: " << scaleFactor;
 				} else {
-					double u1 = random->Rndm();
+					// reproducible random number for the muon (index in the event)
+					double u1 = GetRandomStream(event, static_cast<uint32_t>(muon - product.m_correctedMuons.begin())).Rndm();
 					scaleFactor = rmcor->kSmearMC(q, pt, eta, phi, ntrk, u1);
 					LOG(DEBUG) << "scaleFactor (kSmearMC used): " << scaleFactor;
 				}
@@ -133,13 +143,13 @@ void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& pro
 			// scale only three dimensional momentum
 			// -> need to manually calculate energy
 			float muonMass = 0.105658;
-			float scaledPx = muon->get()->p4.Px() * scaleFactor;
-			float scaledPy = muon->get()->p4.Py() * scaleFactor;
-			float scaledPz = muon->get()->p4.Pz() * scaleFactor;
+			float scaledPx = (*muon)->p4.Px() * scaleFactor;
+			float scaledPy = (*muon)->p4.Py() * scaleFactor;
+			float scaledPz = (*muon)->p4.Pz() * scaleFactor;
 			float scaledE = TMath::Sqrt(TMath::Power(scaledPx,2) + TMath::Power(scaledPy,2) + TMath::Power(scaledPz,2) + TMath::Power(muonMass,2));
-			muon->get()->p4.SetPxPyPzE(scaledPx, scaledPy, scaledPz, scaledE);
-            LOG(DEBUG) << "Corrected: " << "scaledPx: " << muon->get()->p4.Px() << " scaledPy: " << muon->get()->p4.Py() << " scaledPz: "
-                       << muon->get()->p4.Pz() << " scaledE: " << muon->get()->p4.E() << " Pt: " << muon->get()->p4.Pt();
+			(*muon)->p4.SetPxPyPzE(scaledPx, scaledPy, scaledPz, scaledE);
+            LOG(DEBUG) << "Corrected: " << "scaledPx: " << (*muon)->p4.Px() << " scaledPy: " << (*muon)->p4.Py() << " scaledPz: "
+                       << (*muon)->p4.Pz() << " scaledE: " << (*muon)->p4.E() << " Pt: " << (*muon)->p4.Pt();
 
 		} else if (muonEnergyCorrection == MuonEnergyCorrection::NONE) {
 			LOG(DEBUG) << "Muon energy correction skipped.";
@@ -148,7 +158,7 @@ void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& pro
 		}
 
 		if (!settings.GetCorrectOnlyRealMuons() || (settings.GetCorrectOnlyRealMuons() && isRealMuon)) {
-			AdditionalCorrections(muon->get(), event, product, settings);
+			AdditionalCorrections(*muon, event, product, settings);
 		}
 			
 
@@ -157,20 +167,20 @@ void MuonCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& pro
 		if (settings.GetRecoMuonMatchingGenParticleMatchAllMuons())
 		{
 			LOG(DEBUG) << "Updating MatchedLeptons.";
-			product.m_genParticleMatchedMuons[muon->get()] =  &(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]);
-			product.m_genParticleMatchedLeptons[muon->get()] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[muon->get()])]);
+			product.m_genParticleMatchedMuons[*muon] =  &(*product.m_genParticleMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[*muon]))]);
+			product.m_genParticleMatchedLeptons[*muon] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[*muon])]);
 		}
 		if (settings.GetMatchAllMuonsGenTau())
 		{
 			LOG(DEBUG) << "Updating genTauMatchedLeptons.";
-			product.m_genTauMatchedMuons[muon->get()] = &(*product.m_genTauMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[muon->get()]))]);
-			product.m_genTauMatchedLeptons[muon->get()] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[muon->get()])]);
+			product.m_genTauMatchedMuons[*muon] = &(*product.m_genTauMatchedMuons[static_cast<KMuon*>(const_cast<KLepton*>(product.m_originalLeptons[*muon]))]);
+			product.m_genTauMatchedLeptons[*muon] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[*muon])]);
 		}
 	}
 
 	// sort vectors of corrected muons by pt
 	std::sort(product.m_correctedMuons.begin(), product.m_correctedMuons.end(),
-	          [](std::shared_ptr<KMuon> muon1, std::shared_ptr<KMuon> muon2) -> bool
+	          [](KMuon* muon1, KMuon* muon2) -> bool
 	          { return muon1->p4.Pt() > muon2->p4.Pt(); });
 	if(settings.GetDebugVerbosity() > 0) {
 		LOG(DEBUG) << "List of all corrected muons:";
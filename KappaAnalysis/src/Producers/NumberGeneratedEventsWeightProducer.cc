@@ -6,12 +6,30 @@ std::string NumberGeneratedEventsWeightProducer::GetProducerId() const {
 	return "NumberGeneratedEventsWeightProducer";
 }
 
+void NumberGeneratedEventsWeightProducer::Init(KappaSettings const& settings)
+{
+	KappaProducerBase::Init(settings);
+
+	m_weightSlot = EventWeights::RegisterWeight("numberGeneratedEventsWeight", true);
+	UpdateWeight(settings);
+}
+
+void NumberGeneratedEventsWeightProducer::OnRun(KappaEvent const& event, KappaSettings const& settings)
+{
+	UpdateWeight(settings);
+}
+
 void NumberGeneratedEventsWeightProducer::Produce(KappaEvent const& event,
                      KappaProduct & product,
                      KappaSettings const& settings) const
+{
+	product.m_weights.Set(m_weightSlot, m_weight);
+}
+
+void NumberGeneratedEventsWeightProducer::UpdateWeight(KappaSettings const& settings)
 {
     LOG(DEBUG) << "\n[" << this->GetProducerId() << "]";
-    LOG(DEBUG) << "Adding numberGeneratedEventsWeight: 1.0/" << settings.GetNumberGeneratedEvents();
-	product.m_weights["numberGeneratedEventsWeight"] = (1.0 / settings.GetNumberGeneratedEvents());
+    LOG(DEBUG) << "Using numberGeneratedEventsWeight: 1.0/" << settings.GetNumberGeneratedEvents();
+	m_weight = (1.0 / settings.GetNumberGeneratedEvents());
 }
 
@@ -1,82 +1,165 @@
+#include <algorithm>
+#include <sstream>
+
+#include <boost/algorithm/string/erase.hpp>
+
 #include "Artus/KappaAnalysis/interface/Producers/PFCandidatesProducer.h"
+#include "Artus/Utility/interface/DefaultValues.h"
 
 void PFCandidatesProducer::Init(KappaSettings const& settings)
 {
 	KappaProducerBase::Init(settings);
+
+	// the grid needs to cover the largest distance searched for in the store
+	m_gridCellSize = settings.GetdeltaRTolleranceForPF();
+	for (std::vector<float>::const_iterator coneSize = settings.GetPFIsolationConeSizes().begin();
+	     coneSize != settings.GetPFIsolationConeSizes().end(); ++coneSize)
+	{
+		m_gridCellSize = std::max(m_gridCellSize, *coneSize);
+	}
+
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFChargedHadrons", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfChargedHadrons.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::CHARGED_HADRON);
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFNeutralHadrons", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfNeutralHadrons.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::NEUTRAL_HADRON);
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFElectrons", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfElectrons.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::ELECTRON);
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFMuons", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfMuons.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::MUON);
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFPhotons", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfPhotons.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::PHOTON);
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFHadronicHF", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfHadronicHF.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::HADRONIC_HF);
 	});
 	LambdaNtupleConsumer<KappaTypes>::AddIntQuantity("NPFElectromagneticHF", [](KappaEvent const& event, KappaProduct const& product)
 	{
-		return product.m_pfElectromagneticHF.size();
+		return product.m_pfCandidates.GetNCandidates(PFCandidateStore::Type::ELECTROMAGNETIC_HF);
 	});
 }
 
 void PFCandidatesProducer::Produce(KappaEvent const& event, KappaProduct& product, KappaSettings const& settings) const
 {
     LOG(DEBUG) << "\n[" << this->GetProducerId() << "]";
-	// Sane memroy allocation based on a few DY events
-	product.m_pfChargedHadrons.reserve(512);
-	product.m_pfNeutralHadrons.reserve(128);
-	product.m_pfPhotons.reserve(128);
-	product.m_pfElectromagneticHF.reserve(264);
-	for (KPFCandidates::const_iterator pfCandidate = event.m_packedPFCandidates->begin();
-		pfCandidate != event.m_packedPFCandidates->end(); ++pfCandidate)
+	PFCandidateStore& pfCandidates = product.m_pfCandidates;
+	pfCandidates.Fill(event.m_packedPFCandidates, m_gridCellSize);
+	if (pfCandidates.GetNCandidates(PFCandidateStore::Type::UNKNOWN) > 0)
 	{
-		if (std::abs(pfCandidate->pdgId) == 211)
-			fill_pfCandidate(product.m_pfChargedHadrons, product.m_pfChargedHadronsFromFirstPV,
-				product.m_pfChargedHadronsNotFromFirstPV, &(*pfCandidate));
-		else if (std::abs(pfCandidate->pdgId) == 130)
-			fill_pfCandidate(product.m_pfNeutralHadrons, product.m_pfNeutralHadronsFromFirstPV,
-				product.m_pfNeutralHadronsNotFromFirstPV, &(*pfCandidate));
-		else if (std::abs(pfCandidate->pdgId) == 11)
-			product.m_pfElectrons.push_back(&(*pfCandidate));
-		else if (std::abs(pfCandidate->pdgId) == 13)
-			product.m_pfMuons.push_back(&(*pfCandidate));
-		else if (std::abs(pfCandidate->pdgId) == 22)
-			fill_pfCandidate(product.m_pfPhotons, product.m_pfPhotonsFromFirstPV,
-				product.m_pfPhotonsNotFromFirstPV, &(*pfCandidate));
-		else if (std::abs(pfCandidate->pdgId) == 1)
-			product.m_pfHadronicHF.push_back(&(*pfCandidate));
-		else if (std::abs(pfCandidate->pdgId) == 2)
-			product.m_pfElectromagneticHF.push_back(&(*pfCandidate));
-		else
-			LOG(WARNING) << "Unknown PFCandidate! Has pdgId: " << pfCandidate->pdgId;
+		LOG(WARNING) << pfCandidates.GetNCandidates(PFCandidateStore::Type::UNKNOWN) << " unknown PFCandidates!";
 	}
-    LOG(DEBUG) << "Size m_pfChargedHadrons: " << product.m_pfChargedHadrons.size();
-    LOG(DEBUG) << "Size m_pfNeutralHadrons: " << product.m_pfNeutralHadrons.size();
-    LOG(DEBUG) << "Size m_pfElectrons: " << product.m_pfElectrons.size();
-    LOG(DEBUG) << "Size m_pfMuons: " << product.m_pfMuons.size();
-    LOG(DEBUG) << "Size m_pfPhotons: " << product.m_pfPhotons.size();
-    LOG(DEBUG) << "Size m_pfHadronicHF: " << product.m_pfHadronicHF.size();
-    LOG(DEBUG) << "Size m_pfElectromagneticHF: " << product.m_pfElectromagneticHF.size();
+
+	if (settings.GetFillPFCandidateCollections())
+	{
+		// the product keeps the capacity of the collections between the events
+		for (size_t index = 0; index < pfCandidates.GetNCandidates(); ++index)
+		{
+			const KPFCandidate* pfCandidate = pfCandidates.GetCandidate(index);
+			switch (pfCandidates.GetType(index))
+			{
+				case PFCandidateStore::Type::CHARGED_HADRON:
+					fill_pfCandidate(product.m_pfChargedHadrons, product.m_pfChargedHadronsFromFirstPV,
+						product.m_pfChargedHadronsNotFromFirstPV, pfCandidate, pfCandidates.IsFromFirstPV(index));
+					break;
+				case PFCandidateStore::Type::NEUTRAL_HADRON:
+					fill_pfCandidate(product.m_pfNeutralHadrons, product.m_pfNeutralHadronsFromFirstPV,
+						product.m_pfNeutralHadronsNotFromFirstPV, pfCandidate, pfCandidates.IsFromFirstPV(index));
+					break;
+				case PFCandidateStore::Type::ELECTRON:
+					product.m_pfElectrons.push_back(pfCandidate);
+					break;
+				case PFCandidateStore::Type::MUON:
+					product.m_pfMuons.push_back(pfCandidate);
+					break;
+				case PFCandidateStore::Type::PHOTON:
+					fill_pfCandidate(product.m_pfPhotons, product.m_pfPhotonsFromFirstPV,
+						product.m_pfPhotonsNotFromFirstPV, pfCandidate, pfCandidates.IsFromFirstPV(index));
+					break;
+				case PFCandidateStore::Type::HADRONIC_HF:
+					product.m_pfHadronicHF.push_back(pfCandidate);
+					break;
+				case PFCandidateStore::Type::ELECTROMAGNETIC_HF:
+					product.m_pfElectromagneticHF.push_back(pfCandidate);
+					break;
+				case PFCandidateStore::Type::UNKNOWN:
+					break;
+				default:
+					break;
+			}
+		}
+	}
+    LOG(DEBUG) << "Size m_pfChargedHadrons: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::CHARGED_HADRON);
+    LOG(DEBUG) << "Size m_pfNeutralHadrons: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::NEUTRAL_HADRON);
+    LOG(DEBUG) << "Size m_pfElectrons: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::ELECTRON);
+    LOG(DEBUG) << "Size m_pfMuons: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::MUON);
+    LOG(DEBUG) << "Size m_pfPhotons: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::PHOTON);
+    LOG(DEBUG) << "Size m_pfHadronicHF: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::HADRONIC_HF);
+    LOG(DEBUG) << "Size m_pfElectromagneticHF: " << pfCandidates.GetNCandidates(PFCandidateStore::Type::ELECTROMAGNETIC_HF);
 }
 
 
-void PFCandidatesProducer::fill_pfCandidate(std::vector<const KPFCandidate*>& full, std::vector<const KPFCandidate*>& fromFirstPV, std::vector<const KPFCandidate*>& notFromFirstPV, const KPFCandidate* currentCandidate) const
+void PFCandidatesProducer::fill_pfCandidate(std::vector<const KPFCandidate*>& full, std::vector<const KPFCandidate*>& fromFirstPV, std::vector<const KPFCandidate*>& notFromFirstPV, const KPFCandidate* currentCandidate, bool isFromFirstPV) const
 {
 	full.push_back(currentCandidate);
-	if (currentCandidate->fromFirstPVFlag > 1) fromFirstPV.push_back(currentCandidate);
+	if (isFromFirstPV) fromFirstPV.push_back(currentCandidate);
 	else notFromFirstPV.push_back(currentCandidate);
 }
+
+
+void ValidLeptonsPFIsolationProducer::Init(KappaSettings const& settings)
+{
+	KappaProducerBase::Init(settings);
+
+	PFIsolationEngine::Config config;
+	config.coneSizes = settings.GetPFIsolationConeSizes();
+	config.vetoCones[PFIsolationSums::CHARGED] = settings.GetPFIsolationChargedVetoCone();
+	config.vetoCones[PFIsolationSums::NEUTRAL] = settings.GetPFIsolationNeutralVetoCone();
+	config.vetoCones[PFIsolationSums::PHOTON] = settings.GetPFIsolationPhotonVetoCone();
+	config.vetoCones[PFIsolationSums::PILEUP] = settings.GetPFIsolationPileUpVetoCone();
+	config.minPts[PFIsolationSums::NEUTRAL] = settings.GetPFIsolationNeutralMinPt();
+	config.minPts[PFIsolationSums::PHOTON] = settings.GetPFIsolationPhotonMinPt();
+	config.minPts[PFIsolationSums::PILEUP] = settings.GetPFIsolationPileUpMinPt();
+	m_isolationEngine.Init(config);
+
+	// relative isolations (delta beta corrected) of the two leading valid leptons, e.g. leadingLeptonPFRelIsoDR03
+	for (size_t coneIndex = 0; coneIndex < config.coneSizes.size(); ++coneIndex)
+	{
+		std::ostringstream coneName;
+		coneName << config.coneSizes[coneIndex];
+		std::string coneSuffix = "DR" + boost::algorithm::erase_all_copy(coneName.str(), ".");
+
+		LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingLeptonPFRelIso"+coneSuffix, [coneIndex](KappaEvent const& event, KappaProduct const& product)
+		{
+			return ((product.m_validLeptonsPFIsolation.GetNObjects() > 0) ?
+			        product.m_validLeptonsPFIsolation.GetRelativeIsolationDeltaBeta(0, coneIndex, product.m_validLeptons[0]->p4.Pt()) :
+			        DefaultValues::UndefinedFloat);
+		});
+		LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingLeptonPFRelIso"+coneSuffix, [coneIndex](KappaEvent const& event, KappaProduct const& product)
+		{
+			return ((product.m_validLeptonsPFIsolation.GetNObjects() > 1) ?
+			        product.m_validLeptonsPFIsolation.GetRelativeIsolationDeltaBeta(1, coneIndex, product.m_validLeptons[1]->p4.Pt()) :
+			        DefaultValues::UndefinedFloat);
+		});
+	}
+}
+
+void ValidLeptonsPFIsolationProducer::Produce(KappaEvent const& event, KappaProduct& product, KappaSettings const& settings) const
+{
+	m_leptonEtas.clear();
+	m_leptonPhis.clear();
+	for (std::vector<KLepton*>::const_iterator lepton = product.m_validLeptons.begin(); lepton != product.m_validLeptons.end(); ++lepton)
+	{
+		m_leptonEtas.push_back((*lepton)->p4.Eta());
+		m_leptonPhis.push_back((*lepton)->p4.Phi());
+	}
+	m_isolationEngine.Compute(product.m_pfCandidates, m_leptonEtas, m_leptonPhis, product.m_validLeptonsPFIsolation);
+}
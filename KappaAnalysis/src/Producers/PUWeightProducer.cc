@@ -11,6 +11,8 @@ std::string PUWeightProducer::GetProducerId() const {
 void PUWeightProducer::Init(KappaSettings const& settings) {
 	KappaProducerBase::Init(settings);
 
+	m_weightSlot = EventWeights::RegisterWeight("puWeight");
+
 	const std::string histogramName = "pileup";
 	LOG(DEBUG) << "\tLoading pile-up weights from files...";
 	LOG(DEBUG) << "\t\t" << settings.GetPileupWeightFile() << "/" << histogramName;
@@ -38,8 +40,8 @@ void PUWeightProducer::Produce(KappaEvent const& event, KappaProduct& product,
 
 	unsigned int puBin = static_cast<unsigned int>(static_cast<double>(event.m_genEventInfo->nPUMean) * m_bins);
 	if (puBin < m_pileupWeights.size())
-		product.m_weights["puWeight"] = m_pileupWeights.at(puBin);
+		product.m_weights.Set(m_weightSlot, m_pileupWeights.at(puBin));
 	else
-		product.m_weights["puWeight"] = 1.0;
+		product.m_weights.Set(m_weightSlot, 1.0);
 }
 
@@ -20,6 +20,10 @@ void SampleStitchingWeightProducer::Init(KappaSettings const& settings)
 			Utility::ParseVectorToMap(settings.GetStitchingWeightsHighMass()),
 			stitchingWeightsHighMassByName
 	);
+
+	m_weightSlot = EventWeights::RegisterWeight("sampleStitchingWeight");
+	m_crossSectionWeightSlot = EventWeights::RegisterWeight("crossSectionPerEventWeight", true);
+	m_numberGeneratedEventsWeightSlot = EventWeights::RegisterWeight("numberGeneratedEventsWeight", true);
 }
 
 void SampleStitchingWeightProducer::Produce(
@@ -30,15 +34,18 @@ void SampleStitchingWeightProducer::Produce(
 {
 	assert(event.m_genEventInfo != nullptr);
 	
-	if (! Utility::Contains(product.m_weights, std::string("crossSectionPerEventWeight")))
+	if (! product.m_weights.IsSet(m_crossSectionWeightSlot))
 	{
 		LOG(FATAL) << "Cross section not available or 0. Make sure that CrossSectionWeightProducer is run before SampleStitchingWeightProducer!";
 	}
-	if (! Utility::Contains(product.m_weights, std::string("numberGeneratedEventsWeight")))
+	if (! product.m_weights.IsSet(m_numberGeneratedEventsWeightSlot))
 	{
 		LOG(FATAL) << "Number of generated events not available or 0. Make sure that NumberGeneratedEventsWeightProducer is run before SampleStitchingWeightProducer!";
 	}
 	
+	// the constant weights folded by the EventWeightProducer are still set in the product
+	double normalisation = product.m_weights.Get(m_numberGeneratedEventsWeightSlot) * product.m_weights.Get(m_crossSectionWeightSlot);
+
 	size_t nPartons = event.m_genEventInfo->lheNOutPartons >= 5 ? 0 : event.m_genEventInfo->lheNOutPartons;
 
 	// take overlap of phase space into account for DY samples with M50 & M150
@@ -47,17 +54,15 @@ void SampleStitchingWeightProducer::Produce(
 		// DYJetsToLL_M150 currently only simulated with Z->tautau
 		if (fabs(product.m_genLeptonsFromBosonDecay.at(0)->pdgId) == 15 && fabs(product.m_genLeptonsFromBosonDecay.at(1)->pdgId) == 15)
 		{
-			product.m_weights["sampleStitchingWeight"] = SafeMap::Get(stitchingWeightsHighMassByIndex, nPartons).at(0);
+			product.m_weights.Set(m_weightSlot, SafeMap::Get(stitchingWeightsHighMassByIndex, nPartons).at(0) / normalisation);
 		}
 		else
 		{
-			product.m_weights["sampleStitchingWeight"] = SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0);
+			product.m_weights.Set(m_weightSlot, SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0) / normalisation);
 		}
 	}
 	else
 	{
-		product.m_weights["sampleStitchingWeight"] = SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0);
+		product.m_weights.Set(m_weightSlot, SafeMap::Get(stitchingWeightsByIndex, nPartons).at(0) / normalisation);
 	}
-	
-	product.m_weights["sampleStitchingWeight"] /= (product.m_weights["numberGeneratedEventsWeight"] * product.m_weights["crossSectionPerEventWeight"]);
 }
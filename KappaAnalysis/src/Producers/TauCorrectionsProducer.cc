@@ -24,13 +24,22 @@ void TauCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& prod
 	for (KTaus::const_iterator tau = event.m_taus->begin();
 		 tau != event.m_taus->end(); ++tau)
 	{
-		product.m_correctedTaus[tauIndex] = std::shared_ptr<KTau>(new KTau(*tau));
-		product.m_originalLeptons[product.m_correctedTaus[tauIndex].get()] = &(*tau);
+		product.m_correctedTaus[tauIndex] = product.CreateEventObject<KTau>(*tau);
+		product.m_originalLeptons[product.m_correctedTaus[tauIndex]] = &(*tau);
 		++tauIndex;
 	}
 	
+	// the UW gen matching uses the generator particle view and gen taus built once per event
+	GenParticleView const* genParticleView = nullptr;
+	std::vector<RMFLV> genTausUW;
+	if (settings.GetCorrectOnlyRealTaus() && settings.GetUseUWGenMatching() && event.m_genParticles)
+	{
+		genParticleView = &(product.GetGenParticleView(event.m_genParticles));
+		GeneratorInfo::BuildGenTausUW(*genParticleView, genTausUW);
+	}
+
 	// perform corrections on copied taus
-	for (std::vector<std::shared_ptr<KTau> >::iterator tau = product.m_correctedTaus.begin();
+	for (std::vector<KTau*>::iterator tau = product.m_correctedTaus.begin();
 		 tau != product.m_correctedTaus.end(); ++tau)
 	{
 		// Check whether corrections should be applied at all
@@ -40,11 +49,14 @@ void TauCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& prod
 			KappaEnumTypes::GenMatchingCode genMatchingCode = KappaEnumTypes::GenMatchingCode::NONE;
 			if (settings.GetUseUWGenMatching())
 			{
-				genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(event, const_cast<KLepton*>(product.m_originalLeptons[tau->get()]));
+				if (genParticleView)
+				{
+					genMatchingCode = GeneratorInfo::GetGenMatchingCodeUW(*genParticleView, genTausUW, const_cast<KLepton*>(product.m_originalLeptons[*tau]));
+				}
 			}
 			else
 			{
-				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[tau->get()]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
+				KGenParticle* genParticle = GeneratorInfo::GetGenMatchedParticle(const_cast<KLepton*>(product.m_originalLeptons[*tau]), product.m_genParticleMatchedLeptons, product.m_genTauMatchedLeptons);
 				if (genParticle)
 				{
 					genMatchingCode = GeneratorInfo::GetGenMatchingCode(genParticle);
@@ -61,25 +73,25 @@ void TauCorrectionsProducer::Produce(KappaEvent const& event, KappaProduct& prod
 	
 		// perform possible analysis-specific corrections
 		if (!settings.GetCorrectOnlyRealTaus() || (settings.GetCorrectOnlyRealTaus() && isRealTau))
-			AdditionalCorrections(tau->get(), event, product, settings);
+			AdditionalCorrections(*tau, event, product, settings);
 
 		// make sure to also save the corrected lepton and the matched genParticle in the map
 		// if we match genParticles to all leptons
 		if (settings.GetRecoTauMatchingGenParticleMatchAllTaus())
 		{
-			product.m_genParticleMatchedTaus[tau->get()] =  &(*product.m_genParticleMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(product.m_originalLeptons[tau->get()]))]);
-			product.m_genParticleMatchedLeptons[tau->get()] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[tau->get()])]);
+			product.m_genParticleMatchedTaus[*tau] =  &(*product.m_genParticleMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(product.m_originalLeptons[*tau]))]);
+			product.m_genParticleMatchedLeptons[*tau] = &(*product.m_genParticleMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[*tau])]);
 		}
 		if (settings.GetMatchAllTausGenTau())
 		{
-			product.m_genTauMatchedTaus[tau->get()] = &(*product.m_genTauMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(product.m_originalLeptons[tau->get()]))]);
-			product.m_genTauMatchedLeptons[tau->get()] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[tau->get()])]);
+			product.m_genTauMatchedTaus[*tau] = &(*product.m_genTauMatchedTaus[static_cast<KTau*>(const_cast<KLepton*>(product.m_originalLeptons[*tau]))]);
+			product.m_genTauMatchedLeptons[*tau] = &(*product.m_genTauMatchedLeptons[const_cast<KLepton*>(product.m_originalLeptons[*tau])]);
 		}
 	}
 	
 	// sort vectors of corrected taus by pt
 	std::sort(product.m_correctedTaus.begin(), product.m_correctedTaus.end(),
-	          [](std::shared_ptr<KTau> tau1, std::shared_ptr<KTau> tau2) -> bool
+	          [](KTau* tau1, KTau* tau2) -> bool
 	          { return tau1->p4.Pt() > tau2->p4.Pt(); });
 }
 
@@ -11,7 +11,8 @@ GeneralTmvaClassificationReader::GeneralTmvaClassificationReader() :
 	TmvaClassificationReaderBase(&KappaSettings::GetTmvaInputQuantities,
 	                             &KappaSettings::GetTmvaMethods,
 	                             &KappaSettings::GetTmvaWeights,
-	                             &KappaProduct::m_discriminators)
+	                             &KappaProduct::m_discriminators,
+	                             &KappaSettings::GetTmvaNativeBdtEvaluation)
 {
 }
 
@@ -10,6 +10,7 @@ std::string ElectronTriggerMatchingProducer::GetProducerId() const
 ElectronTriggerMatchingProducer::ElectronTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KElectron>(&KappaProduct::m_triggerMatchedElectrons,
 	                                       &KappaProduct::m_detailedTriggerMatchedElectrons,
+	                                       &KappaProduct::m_triggerMatchingResultElectrons,
 	                                       &KappaProduct::m_validElectrons,
 	                                       &KappaProduct::m_invalidElectrons,
 	                                       &KappaProduct::m_settingsElectronTriggerFiltersByIndex,
@@ -25,7 +26,7 @@ void ElectronTriggerMatchingProducer::Produce(KappaEvent const& event, KappaProd
 {
 	TriggerMatchingProducerBase<KElectron>::Produce(event, product, settings);
 	
-	for (std::map<KElectron*, KLV*>::iterator it = product.m_triggerMatchedElectrons.begin();
+	for (FlatMap<KElectron*, KLV*>::iterator it = product.m_triggerMatchedElectrons.begin();
 	     it != product.m_triggerMatchedElectrons.end(); ++it)
 	{
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
@@ -47,6 +48,7 @@ std::string MuonTriggerMatchingProducer::GetProducerId() const
 MuonTriggerMatchingProducer::MuonTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KMuon>(&KappaProduct::m_triggerMatchedMuons,
 	                                   &KappaProduct::m_detailedTriggerMatchedMuons,
+	                                   &KappaProduct::m_triggerMatchingResultMuons,
 	                                   &KappaProduct::m_validMuons,
 	                                   &KappaProduct::m_invalidMuons,
 	                                   &KappaProduct::m_settingsMuonTriggerFiltersByIndex,
@@ -62,7 +64,7 @@ void MuonTriggerMatchingProducer::Produce(KappaEvent const& event, KappaProduct&
 {
 	TriggerMatchingProducerBase<KMuon>::Produce(event, product, settings);
 	
-	for (std::map<KMuon*, KLV*>::iterator it = product.m_triggerMatchedMuons.begin();
+	for (FlatMap<KMuon*, KLV*>::iterator it = product.m_triggerMatchedMuons.begin();
 	     it != product.m_triggerMatchedMuons.end(); ++it)
 	{
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
@@ -84,6 +86,7 @@ std::string TauTriggerMatchingProducer::GetProducerId() const
 TauTriggerMatchingProducer::TauTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KTau>(&KappaProduct::m_triggerMatchedTaus,
 	                                  &KappaProduct::m_detailedTriggerMatchedTaus,
+	                                  &KappaProduct::m_triggerMatchingResultTaus,
 	                                  &KappaProduct::m_validTaus,
 	                                  &KappaProduct::m_invalidTaus,
 	                                  &KappaProduct::m_settingsTauTriggerFiltersByIndex,
@@ -99,7 +102,7 @@ void TauTriggerMatchingProducer::Produce(KappaEvent const& event, KappaProduct&
 {
 	TriggerMatchingProducerBase<KTau>::Produce(event, product, settings);
 	
-	for (std::map<KTau*, KLV*>::iterator it = product.m_triggerMatchedTaus.begin();
+	for (FlatMap<KTau*, KLV*>::iterator it = product.m_triggerMatchedTaus.begin();
 	     it != product.m_triggerMatchedTaus.end(); ++it)
 	{
 		product.m_triggerMatchedLeptons[&(*(it->first))] = &(*(it->second));
@@ -120,6 +123,7 @@ std::string JetTriggerMatchingProducer::GetProducerId() const {
 JetTriggerMatchingProducer::JetTriggerMatchingProducer() :
 	TriggerMatchingProducerBase<KBasicJet>(&KappaProduct::m_triggerMatchedJets,
 	                                       &KappaProduct::m_detailedTriggerMatchedJets,
+	                                       &KappaProduct::m_triggerMatchingResultJets,
 	                                       &KappaProduct::m_validJets,
 	                                       &KappaProduct::m_invalidJets,
 	                                       &KappaProduct::m_settingsJetTriggerFiltersByIndex,
@@ -1,5 +1,6 @@
 
 #include "Artus/KappaAnalysis/interface/Producers/ValidBTaggedJetsProducer.h"
+#include <functional>
 #include "Artus/Utility/interface/SafeMap.h"
 
 
@@ -61,20 +62,41 @@ void ValidBTaggedJetsProducer::Init(KappaSettings const& settings)
 		return product.m_bTaggedJets.size() >= 2 ? product.m_bTaggedJets.at(1)->p4.Phi() : DefaultValues::UndefinedFloat;
 	});
 
-	std::string bTaggedJetCSVName = settings.GetBTaggedJetCombinedSecondaryVertexName();
-	std::string jetPuJetIDName = settings.GetPuJetIDFullDiscrName();
+	m_bTaggedJetCSVHandle = JetTagHandle(settings.GetBTaggedJetCombinedSecondaryVertexName());
+	JetTagHandle bTaggedJetCSVHandle(m_bTaggedJetCSVHandle);
+	JetTagHandle jetPuJetIDHandle(settings.GetPuJetIDFullDiscrName());
 
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingBJetCSV",[bTaggedJetCSVName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 1 ? static_cast<KJet*>(product.m_bTaggedJets.at(0))->getTag(bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingBJetCSV",[bTaggedJetCSVHandle](KappaEvent const& event, KappaProduct const& product) mutable -> float {
+		if (product.m_bTaggedJets.size() < 1)
+		{
+			return DefaultValues::UndefinedFloat;
+		}
+		bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+		return bTaggedJetCSVHandle.Get(*static_cast<KJet*>(product.m_bTaggedJets.at(0)), event.m_jetMetadata);
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingBJetPuID",[jetPuJetIDName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 1 ? static_cast<KJet*>(product.m_bTaggedJets.at(0))->getTag(jetPuJetIDName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingBJetPuID",[jetPuJetIDHandle](KappaEvent const& event, KappaProduct const& product) mutable -> float {
+		if (product.m_bTaggedJets.size() < 1)
+		{
+			return DefaultValues::UndefinedFloat;
+		}
+		jetPuJetIDHandle.Resolve(event.m_jetMetadata);
+		return jetPuJetIDHandle.Get(*static_cast<KJet*>(product.m_bTaggedJets.at(0)), event.m_jetMetadata);
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingBJetCSV",[bTaggedJetCSVName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 2 ? static_cast<KJet*>(product.m_bTaggedJets.at(1))->getTag(bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingBJetCSV",[bTaggedJetCSVHandle](KappaEvent const& event, KappaProduct const& product) mutable -> float {
+		if (product.m_bTaggedJets.size() < 2)
+		{
+			return DefaultValues::UndefinedFloat;
+		}
+		bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+		return bTaggedJetCSVHandle.Get(*static_cast<KJet*>(product.m_bTaggedJets.at(1)), event.m_jetMetadata);
 	});
-	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingBJetPuID",[jetPuJetIDName](KappaEvent const& event, KappaProduct const& product) {
-		return product.m_bTaggedJets.size() >= 2 ? static_cast<KJet*>(product.m_bTaggedJets.at(1))->getTag(jetPuJetIDName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+	LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingBJetPuID",[jetPuJetIDHandle](KappaEvent const& event, KappaProduct const& product) mutable -> float {
+		if (product.m_bTaggedJets.size() < 2)
+		{
+			return DefaultValues::UndefinedFloat;
+		}
+		jetPuJetIDHandle.Resolve(event.m_jetMetadata);
+		return jetPuJetIDHandle.Get(*static_cast<KJet*>(product.m_bTaggedJets.at(1)), event.m_jetMetadata);
 	});
 }
 
@@ -84,6 +106,8 @@ void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& pr
 	assert(event.m_jetMetadata);
 	assert(settings.GetBTagWPs().size() > 0);
 
+	m_bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+
 	for (std::vector<std::string>::const_iterator workingPoint = settings.GetBTagWPs().begin();
 	     workingPoint != settings.GetBTagWPs().end(); ++workingPoint)
 	{
@@ -93,7 +117,7 @@ void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& pr
 			bool validBJet = true;
 			KJet* tjet = static_cast<KJet*>(*jet);
 
-			float combinedSecondaryVertex = tjet->getTag(settings.GetBTaggedJetCombinedSecondaryVertexName(), event.m_jetMetadata);
+			float combinedSecondaryVertex = m_bTaggedJetCSVHandle.Get(*tjet, event.m_jetMetadata);
 			float bTagWorkingPoint = SafeMap::Get(m_bTagWorkingPoints, *workingPoint);
 
 			if (combinedSecondaryVertex < bTagWorkingPoint ||
@@ -124,6 +148,23 @@ void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& pr
 
 					LOG_N_TIMES(1, DEBUG) << "Btagging shifts tag/mistag : " << settings.GetBTagShift() << " " << settings.GetBMistagShift(); 
 					
+					// random numbers keyed by the index of the jet in the event, such that the decision
+					// does not depend on the order of the (corrected) jets
+					uint32_t jetIndex = static_cast<uint32_t>(jet - product.m_validJets.begin());
+					FlatMap<const KBasicJet*, const KBasicJet*>::const_iterator originalJet = product.m_originalJets.find(tjet);
+					if (event.m_tjets && (! event.m_tjets->empty()) && (originalJet != product.m_originalJets.end()))
+					{
+						// only use the position if the original jet really is an element of the event jets
+						KJet const* originalTJet = static_cast<KJet const*>(originalJet->second);
+						KJet const* firstTJet = event.m_tjets->data();
+						std::less<KJet const*> before;
+						if ((! before(originalTJet, firstTJet)) && before(originalTJet, firstTJet + event.m_tjets->size()))
+						{
+							jetIndex = static_cast<uint32_t>(originalTJet - firstTJet);
+						}
+					}
+					RandomStream random = GetRandomStream(event, jetIndex);
+
 					bool taggedBefore = validBJet;
 					validBJet = m_bTagSfMap.at(*workingPoint).isbtagged(
 							tjet->p4.pt(),
@@ -133,7 +174,8 @@ void ValidBTaggedJetsProducer::Produce(KappaEvent const& event, KappaProduct& pr
 							btagSys,
 							bmistagSys,
 							settings.GetYear(),
-							bTagWorkingPoint
+							bTagWorkingPoint,
+							random
 					);
 					
 					if (taggedBefore != validBJet)
@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include "Artus/KappaAnalysis/interface/Producers/ValidJetsProducer.h"
 
 
@@ -38,26 +40,69 @@ void ValidTaggedJetsProducer::Init(KappaSettings const &settings) {
             jetTaggerUpperCutsByTaggerName
     );
 
+    // the names are resolved to indices in the metadata once per lumi section in Produce
+    m_puJetIdHandlesByIndex.clear();
+    for (std::map<size_t, std::vector<std::string> >::const_iterator puJetIdByIndex = puJetIdsByIndex.begin();
+         puJetIdByIndex != puJetIdsByIndex.end(); ++puJetIdByIndex) {
+        m_puJetIdHandlesByIndex[puJetIdByIndex->first] = std::vector<JetIdHandle>(puJetIdByIndex->second.begin(),
+                                                                                   puJetIdByIndex->second.end());
+    }
+    m_defaultPuJetIdHandles.clear();
+    for (std::map<std::string, std::vector<std::string> >::const_iterator puJetIdByHltName = puJetIdsByHltName.begin();
+         puJetIdByHltName != puJetIdsByHltName.end(); ++puJetIdByHltName) {
+        if (puJetIdByHltName->first != "default") {
+            LOG(FATAL) << "HLT name dependent PU Jet is not yet implemented!";
+        }
+        for (std::vector<std::string>::const_iterator puJetId = puJetIdByHltName->second.begin();
+             puJetId != puJetIdByHltName->second.end(); ++puJetId) {
+            m_defaultPuJetIdHandles.push_back(JetIdHandle(*puJetId));
+        }
+    }
+
+    m_jetTaggerLowerCutHandles.clear();
+    m_jetTaggerLowerCuts.clear();
+    for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
+         jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end(); ++jetTaggerLowerCut) {
+        m_jetTaggerLowerCutHandles.push_back(JetTagHandle(jetTaggerLowerCut->first));
+        m_jetTaggerLowerCuts.push_back(*std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end()));
+    }
+    m_jetTaggerUpperCutHandles.clear();
+    m_jetTaggerUpperCuts.clear();
+    for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
+         jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end(); ++jetTaggerUpperCut) {
+        m_jetTaggerUpperCutHandles.push_back(JetTagHandle(jetTaggerUpperCut->first));
+        m_jetTaggerUpperCuts.push_back(*std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end()));
+    }
+
     // add possible quantities for the lambda ntuples consumers
-    std::string bTaggedJetCSVName = settings.GetBTaggedJetCombinedSecondaryVertexName();
-    std::string bTaggedJetTCHEName = settings.GetBTaggedJetTrackCountingHighEffName();
-    std::string jetPuJetIDName = settings.GetPuJetIDFullDiscrName();
-
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetCSV", [bTaggedJetCSVName](KappaEvent const &event,
-                                                                                            KappaProduct const &product) {
-        return product.m_validJets.size() >= 1 ? static_cast<KJet *>(product.m_validJets.at(0))->getTag(
-                bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+    // (the copies of the handles in the lambdas are resolved when the metadata changes)
+    JetTagHandle bTaggedJetCSVHandle(settings.GetBTaggedJetCombinedSecondaryVertexName());
+    JetTagHandle bTaggedJetTCHEHandle(settings.GetBTaggedJetTrackCountingHighEffName());
+    JetTagHandle jetPuJetIDHandle(settings.GetPuJetIDFullDiscrName());
+
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetCSV", [bTaggedJetCSVHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 1) {
+            return DefaultValues::UndefinedFloat;
+        }
+        bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+        return bTaggedJetCSVHandle.Get(*static_cast<KJet *>(product.m_validJets.at(0)), event.m_jetMetadata);
     });
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetTCHE", [bTaggedJetTCHEName](KappaEvent const &event,
-                                                                                              KappaProduct const &product) {
-        return product.m_validJets.size() >= 1 ? static_cast<KJet *>(product.m_validJets.at(0))->getTag(
-                bTaggedJetTCHEName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetTCHE", [bTaggedJetTCHEHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 1) {
+            return DefaultValues::UndefinedFloat;
+        }
+        bTaggedJetTCHEHandle.Resolve(event.m_jetMetadata);
+        return bTaggedJetTCHEHandle.Get(*static_cast<KJet *>(product.m_validJets.at(0)), event.m_jetMetadata);
     });
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetPuID", [jetPuJetIDName](KappaEvent const &event,
-                                                                                          KappaProduct const &product) {
-        return product.m_validJets.size() >= 1 ? static_cast<KJet *>(product.m_validJets.at(0))->getTag(jetPuJetIDName,
-                                                                                                        event.m_jetMetadata)
-                                               : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("leadingJetPuID", [jetPuJetIDHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 1) {
+            return DefaultValues::UndefinedFloat;
+        }
+        jetPuJetIDHandle.Resolve(event.m_jetMetadata);
+        return jetPuJetIDHandle.Get(*static_cast<KJet *>(product.m_validJets.at(0)), event.m_jetMetadata);
     });
     LambdaNtupleConsumer<KappaTypes>::AddBoolQuantity("leadingJetGenMatch",
                                                       [](KappaEvent const &event, KappaProduct const &product) {
@@ -66,21 +111,29 @@ void ValidTaggedJetsProducer::Init(KappaSettings const &settings) {
                                                                           0))->genMatch : false;
                                                       });
 
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetCSV", [bTaggedJetCSVName](KappaEvent const &event,
-                                                                                             KappaProduct const &product) {
-        return product.m_validJets.size() >= 2 ? static_cast<KJet *>(product.m_validJets.at(1))->getTag(
-                bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetCSV", [bTaggedJetCSVHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 2) {
+            return DefaultValues::UndefinedFloat;
+        }
+        bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+        return bTaggedJetCSVHandle.Get(*static_cast<KJet *>(product.m_validJets.at(1)), event.m_jetMetadata);
     });
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetTCHE", [bTaggedJetTCHEName](KappaEvent const &event,
-                                                                                               KappaProduct const &product) {
-        return product.m_validJets.size() >= 2 ? static_cast<KJet *>(product.m_validJets.at(1))->getTag(
-                bTaggedJetTCHEName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetTCHE", [bTaggedJetTCHEHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 2) {
+            return DefaultValues::UndefinedFloat;
+        }
+        bTaggedJetTCHEHandle.Resolve(event.m_jetMetadata);
+        return bTaggedJetTCHEHandle.Get(*static_cast<KJet *>(product.m_validJets.at(1)), event.m_jetMetadata);
     });
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetPuID", [jetPuJetIDName](KappaEvent const &event,
-                                                                                           KappaProduct const &product) {
-        return product.m_validJets.size() >= 2 ? static_cast<KJet *>(product.m_validJets.at(1))->getTag(jetPuJetIDName,
-                                                                                                        event.m_jetMetadata)
-                                               : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("trailingJetPuID", [jetPuJetIDHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 2) {
+            return DefaultValues::UndefinedFloat;
+        }
+        jetPuJetIDHandle.Resolve(event.m_jetMetadata);
+        return jetPuJetIDHandle.Get(*static_cast<KJet *>(product.m_validJets.at(1)), event.m_jetMetadata);
     });
     LambdaNtupleConsumer<KappaTypes>::AddBoolQuantity("trailingJetGenMatch",
                                                       [](KappaEvent const &event, KappaProduct const &product) {
@@ -89,81 +142,73 @@ void ValidTaggedJetsProducer::Init(KappaSettings const &settings) {
                                                                           1))->genMatch : false;
                                                       });
 
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("thirdJetCSV", [bTaggedJetCSVName](KappaEvent const &event,
-                                                                                          KappaProduct const &product) {
-        return product.m_validJets.size() >= 3 ? static_cast<KJet *>(product.m_validJets.at(2))->getTag(
-                bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("thirdJetCSV", [bTaggedJetCSVHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 3) {
+            return DefaultValues::UndefinedFloat;
+        }
+        bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+        return bTaggedJetCSVHandle.Get(*static_cast<KJet *>(product.m_validJets.at(2)), event.m_jetMetadata);
     });
-    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("fourthJetCSV", [bTaggedJetCSVName](KappaEvent const &event,
-                                                                                           KappaProduct const &product) {
-        return product.m_validJets.size() >= 4 ? static_cast<KJet *>(product.m_validJets.at(3))->getTag(
-                bTaggedJetCSVName, event.m_jetMetadata) : DefaultValues::UndefinedFloat;
+    LambdaNtupleConsumer<KappaTypes>::AddFloatQuantity("fourthJetCSV", [bTaggedJetCSVHandle](KappaEvent const &event,
+            KappaProduct const &product) mutable -> float {
+        if (product.m_validJets.size() < 4) {
+            return DefaultValues::UndefinedFloat;
+        }
+        bTaggedJetCSVHandle.Resolve(event.m_jetMetadata);
+        return bTaggedJetCSVHandle.Get(*static_cast<KJet *>(product.m_validJets.at(3)), event.m_jetMetadata);
     });
 }
 
+void ValidTaggedJetsProducer::Produce(KappaEvent const &event, KappaProduct &product,
+                                      KappaSettings const &settings) const {
+    bool hasJetCriteria = ((!m_puJetIdHandlesByIndex.empty()) || (!m_defaultPuJetIdHandles.empty()) ||
+                           (!m_jetTaggerLowerCutHandles.empty()) || (!m_jetTaggerUpperCutHandles.empty()));
+    if (hasJetCriteria) {
+        // the PU jet IDs and taggers are only looked up in the metadata if it has changed
+        assert(event.m_jetMetadata);
+        for (std::map<size_t, std::vector<JetIdHandle> >::iterator puJetIdHandles = m_puJetIdHandlesByIndex.begin();
+             puJetIdHandles != m_puJetIdHandlesByIndex.end(); ++puJetIdHandles) {
+            ResolveMetadataHandles(puJetIdHandles->second, event.m_jetMetadata);
+        }
+        ResolveMetadataHandles(m_defaultPuJetIdHandles, event.m_jetMetadata);
+        ResolveMetadataHandles(m_jetTaggerLowerCutHandles, event.m_jetMetadata);
+        ResolveMetadataHandles(m_jetTaggerUpperCutHandles, event.m_jetMetadata);
+    }
+
+    ValidJetsProducerBase<KJet, KBasicJet>::Produce(event, product, settings);
+}
+
 // Can be overwritten for analysis-specific use cases
 bool ValidTaggedJetsProducer::AdditionalCriteria(KJet *jet, KappaEvent const &event,
                                                  KappaProduct &product, KappaSettings const &settings) const {
-    return true;
-    // ++++++++++++ This code is depracated and not used anymore! ++++++++++++
-    // if PU jet ID should be applied by index, this has to be reimplemented
-    /*
-    assert(event.m_jetMetadata);
-
     bool validJet = ValidJetsProducerBase<KJet, KBasicJet>::AdditionalCriteria(jet, event, product, settings);
 
     // PU Jet ID
-    for (std::map<size_t, std::vector<std::string> >::const_iterator puJetIdByIndex = puJetIdsByIndex.begin();
-         puJetIdByIndex != puJetIdsByIndex.end() && validJet; ++puJetIdByIndex)
-    {
-        if (puJetIdByIndex->first == product.m_validJets.size())
-        {
-            validJet = validJet && PassPuJetIds(jet, puJetIdByIndex->second, event.m_jetMetadata);
-        }
-    }
-
-    for (std::map<std::string, std::vector<std::string> >::const_iterator puJetIdByHltName = puJetIdsByHltName.begin();
-         puJetIdByHltName != puJetIdsByHltName.end() && validJet; ++puJetIdByHltName)
-    {
-        if (puJetIdByHltName->first == "default")
-        {
-            validJet = validJet && PassPuJetIds(jet, puJetIdByHltName->second, event.m_jetMetadata);
-        }
-        else
-        {
-            LOG(FATAL) << "HLT name dependent PU Jet is not yet implemented!";
-        }
+    std::map<size_t, std::vector<JetIdHandle> >::const_iterator puJetIdHandles = m_puJetIdHandlesByIndex.find(
+            product.m_validJets.size());
+    if (validJet && (puJetIdHandles != m_puJetIdHandlesByIndex.end())) {
+        validJet = PassPuJetIds(*jet, puJetIdHandles->second, event.m_jetMetadata);
     }
+    validJet = validJet && PassPuJetIds(*jet, m_defaultPuJetIdHandles, event.m_jetMetadata);
 
     // Jet taggers
-    for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerLowerCut = jetTaggerLowerCutsByTaggerName.begin();
-         jetTaggerLowerCut != jetTaggerLowerCutsByTaggerName.end() && validJet; ++jetTaggerLowerCut)
-    {
-        float maxLowerCut = *std::max_element(jetTaggerLowerCut->second.begin(), jetTaggerLowerCut->second.end());
-        validJet = validJet && jet->getTag(jetTaggerLowerCut->first, event.m_jetMetadata) > maxLowerCut;
+    for (size_t taggerIndex = 0; (taggerIndex < m_jetTaggerLowerCutHandles.size()) && validJet; ++taggerIndex) {
+        validJet = (m_jetTaggerLowerCutHandles[taggerIndex].Get(*jet, event.m_jetMetadata) > m_jetTaggerLowerCuts[taggerIndex]);
     }
-
-    for (std::map<std::string, std::vector<float> >::const_iterator jetTaggerUpperCut = jetTaggerUpperCutsByTaggerName.begin();
-         jetTaggerUpperCut != jetTaggerUpperCutsByTaggerName.end() && validJet; ++jetTaggerUpperCut)
-    {
-        float minUpperCut = *std::min_element(jetTaggerUpperCut->second.begin(), jetTaggerUpperCut->second.end());
-        validJet = validJet && jet->getTag(jetTaggerUpperCut->first, event.m_jetMetadata) < minUpperCut;
+    for (size_t taggerIndex = 0; (taggerIndex < m_jetTaggerUpperCutHandles.size()) && validJet; ++taggerIndex) {
+        validJet = (m_jetTaggerUpperCutHandles[taggerIndex].Get(*jet, event.m_jetMetadata) < m_jetTaggerUpperCuts[taggerIndex]);
     }
 
     return validJet;
 }
 
-bool ValidTaggedJetsProducer::PassPuJetIds(KJet* jet, std::vector<std::string> const& puJetIds, KJetMetadata* taggerMetadata) const
-{
+bool ValidTaggedJetsProducer::PassPuJetIds(KJet const &jet, std::vector<JetIdHandle> const &puJetIds,
+                                           KJetMetadata const *jetMetadata) const {
     bool validJet = true;
-
-    for (std::vector<std::string>::const_iterator puJetId = puJetIds.begin();
-         puJetId != puJetIds.end() && validJet; ++puJetId)
-    {
-        validJet = validJet && jet->getId(*puJetId, taggerMetadata);
+    for (std::vector<JetIdHandle>::const_iterator puJetId = puJetIds.begin();
+         puJetId != puJetIds.end() && validJet; ++puJetId) {
+        validJet = puJetId->Get(jet, jetMetadata);
     }
-
     return validJet;
-    */
 }
-
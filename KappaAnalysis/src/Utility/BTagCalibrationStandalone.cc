@@ -1,7 +1,11 @@
 #include "Artus/KappaAnalysis/interface/Utility/BTagCalibrationStandalone.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
 #include <iostream>
 #include <exception>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <sstream>
 
 
@@ -362,6 +366,261 @@ std::string BTagCalibration::token(const BTagEntry::Parameters &par)
 
 
 
+// recursive descent parser for BTagFormula::compile
+// (precedence as in C++, ^ binds stronger than unary minus as in TFormula)
+class BTagFormula::Parser
+{
+public:
+	Parser(const std::string &formula, std::vector<BTagFormula::Instruction> &code):
+		formula_(formula), pos_(0), code_(code), depth_(0), maxDepth_(0) {}
+
+	bool parse() {
+		if (!parseTernary()) return false;
+		skipSpaces();
+		return (pos_ == formula_.size()) && (maxDepth_ <= BTagFormula::maxStackSize);
+	}
+
+private:
+	void skipSpaces() {
+		while (pos_ < formula_.size() && isspace(formula_[pos_])) ++pos_;
+	}
+	bool accept(const std::string &token) {
+		skipSpaces();
+		if (formula_.compare(pos_, token.size(), token) == 0) {
+			pos_ += token.size();
+			return true;
+		}
+		return false;
+	}
+	size_t emit(BTagFormula::OpCode op, double value=0.) {
+		BTagFormula::Instruction instruction = {op, value, 0};
+		code_.push_back(instruction);
+		return code_.size() - 1;
+	}
+	// stack bookkeeping: ops taking n operands and pushing one result
+	void push() {
+		++depth_;
+		maxDepth_ = std::max(maxDepth_, depth_);
+	}
+	void pop(size_t n) {depth_ -= n;}
+
+	bool parseTernary() {
+		if (!parseOr()) return false;
+		if (!accept("?")) return true;
+		size_t jumpIfFalse = emit(BTagFormula::OP_JUMP_IF_FALSE);
+		pop(1);
+		if (!parseTernary()) return false;
+		if (!accept(":")) return false;
+		size_t jump = emit(BTagFormula::OP_JUMP);
+		pop(1);  // only one of the branches is evaluated
+		code_[jumpIfFalse].target = code_.size();
+		if (!parseTernary()) return false;
+		code_[jump].target = code_.size();
+		return true;
+	}
+	bool parseOr() {
+		if (!parseAnd()) return false;
+		while (accept("||")) {
+			if (!parseAnd()) return false;
+			emit(BTagFormula::OP_OR); pop(1);
+		}
+		return true;
+	}
+	bool parseAnd() {
+		if (!parseComparison()) return false;
+		while (accept("&&")) {
+			if (!parseComparison()) return false;
+			emit(BTagFormula::OP_AND); pop(1);
+		}
+		return true;
+	}
+	bool parseComparison() {
+		if (!parseSum()) return false;
+		while (true) {
+			BTagFormula::OpCode op;
+			if (accept("<=")) op = BTagFormula::OP_LE;
+			else if (accept(">=")) op = BTagFormula::OP_GE;
+			else if (accept("==")) op = BTagFormula::OP_EQ;
+			else if (accept("!=")) op = BTagFormula::OP_NE;
+			else if (accept("<")) op = BTagFormula::OP_LT;
+			else if (accept(">")) op = BTagFormula::OP_GT;
+			else return true;
+			if (!parseSum()) return false;
+			emit(op); pop(1);
+		}
+	}
+	bool parseSum() {
+		if (!parseProduct()) return false;
+		while (true) {
+			BTagFormula::OpCode op;
+			if (accept("+")) op = BTagFormula::OP_ADD;
+			else if (accept("-")) op = BTagFormula::OP_SUB;
+			else return true;
+			if (!parseProduct()) return false;
+			emit(op); pop(1);
+		}
+	}
+	bool parseProduct() {
+		if (!parseUnary()) return false;
+		while (true) {
+			BTagFormula::OpCode op;
+			if (accept("*")) op = BTagFormula::OP_MUL;
+			else if (accept("/")) op = BTagFormula::OP_DIV;
+			else return true;
+			if (!parseUnary()) return false;
+			emit(op); pop(1);
+		}
+	}
+	bool parseUnary() {
+		if (accept("-")) {
+			if (!parseUnary()) return false;
+			emit(BTagFormula::OP_NEG);
+			return true;
+		}
+		if (accept("+")) return parseUnary();
+		if (accept("!")) {
+			if (!parseUnary()) return false;
+			emit(BTagFormula::OP_NOT);
+			return true;
+		}
+		return parsePower();
+	}
+	bool parsePower() {
+		if (!parsePrimary()) return false;
+		if (accept("^")) {
+			if (!parseUnary()) return false;
+			emit(BTagFormula::OP_POW); pop(1);
+		}
+		return true;
+	}
+	bool parsePrimary() {
+		skipSpaces();
+		if (pos_ >= formula_.size()) return false;
+
+		if (accept("(")) {
+			return parseTernary() && accept(")");
+		}
+
+		// number
+		if (isdigit(formula_[pos_]) || formula_[pos_] == '.') {
+			const char* begin = formula_.c_str() + pos_;
+			char* end = nullptr;
+			double value = strtod(begin, &end);
+			if (end == begin) return false;
+			pos_ += (end - begin);
+			emit(BTagFormula::OP_CONST, value); push();
+			return true;
+		}
+
+		// identifier: x or function
+		size_t begin = pos_;
+		while (pos_ < formula_.size()) {
+			if (isalnum(formula_[pos_]) || formula_[pos_] == '_') ++pos_;
+			else if (formula_.compare(pos_, 2, "::") == 0) pos_ += 2;
+			else break;
+		}
+		std::string name = formula_.substr(begin, pos_ - begin);
+		if (name.compare(0, 7, "TMath::") == 0) {
+			name = name.substr(7);
+			std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+			if (name == "power") name = "pow";
+		}
+		if (name == "x") {
+			emit(BTagFormula::OP_X); push();
+			return true;
+		}
+
+		BTagFormula::OpCode op;
+		size_t nArguments = 1;
+		if (name == "log") op = BTagFormula::OP_LOG;
+		else if (name == "log10") op = BTagFormula::OP_LOG10;
+		else if (name == "exp") op = BTagFormula::OP_EXP;
+		else if (name == "sqrt") op = BTagFormula::OP_SQRT;
+		else if (name == "abs" || name == "fabs") op = BTagFormula::OP_ABS;
+		else if (name == "tanh") op = BTagFormula::OP_TANH;
+		else if (name == "atan") op = BTagFormula::OP_ATAN;
+		else if (name == "pow") {op = BTagFormula::OP_POW; nArguments = 2;}
+		else if (name == "min") {op = BTagFormula::OP_MIN; nArguments = 2;}
+		else if (name == "max") {op = BTagFormula::OP_MAX; nArguments = 2;}
+		else return false;
+
+		if (!accept("(")) return false;
+		for (size_t argument = 0; argument < nArguments; ++argument) {
+			if (argument > 0 && !accept(",")) return false;
+			if (!parseTernary()) return false;
+		}
+		if (!accept(")")) return false;
+		emit(op); pop(nArguments - 1);
+		return true;
+	}
+
+	const std::string &formula_;
+	size_t pos_;
+	std::vector<BTagFormula::Instruction> &code_;
+	size_t depth_;
+	size_t maxDepth_;
+};
+
+bool BTagFormula::compile(const std::string &formula)
+{
+	code_.clear();
+	Parser parser(formula, code_);
+	if (!parser.parse()) {
+		code_.clear();
+		return false;
+	}
+	return true;
+}
+
+double BTagFormula::eval(double x) const
+{
+	double stack[maxStackSize];
+	size_t top = 0;  // number of values on the stack
+	for (size_t pc = 0; pc < code_.size(); ++pc) {
+		const Instruction &instruction = code_[pc];
+		switch (instruction.op) {
+			case OP_CONST: stack[top++] = instruction.value; break;
+			case OP_X: stack[top++] = x; break;
+			case OP_ADD: --top; stack[top-1] += stack[top]; break;
+			case OP_SUB: --top; stack[top-1] -= stack[top]; break;
+			case OP_MUL: --top; stack[top-1] *= stack[top]; break;
+			case OP_DIV: --top; stack[top-1] /= stack[top]; break;
+			case OP_POW: --top; stack[top-1] = std::pow(stack[top-1], stack[top]); break;
+			case OP_NEG: stack[top-1] = -stack[top-1]; break;
+			case OP_NOT: stack[top-1] = (stack[top-1] == 0.) ? 1. : 0.; break;
+			case OP_LT: --top; stack[top-1] = (stack[top-1] < stack[top]) ? 1. : 0.; break;
+			case OP_LE: --top; stack[top-1] = (stack[top-1] <= stack[top]) ? 1. : 0.; break;
+			case OP_GT: --top; stack[top-1] = (stack[top-1] > stack[top]) ? 1. : 0.; break;
+			case OP_GE: --top; stack[top-1] = (stack[top-1] >= stack[top]) ? 1. : 0.; break;
+			case OP_EQ: --top; stack[top-1] = (stack[top-1] == stack[top]) ? 1. : 0.; break;
+			case OP_NE: --top; stack[top-1] = (stack[top-1] != stack[top]) ? 1. : 0.; break;
+			case OP_AND: --top; stack[top-1] = (stack[top-1] != 0. && stack[top] != 0.) ? 1. : 0.; break;
+			case OP_OR: --top; stack[top-1] = (stack[top-1] != 0. || stack[top] != 0.) ? 1. : 0.; break;
+			case OP_LOG: stack[top-1] = std::log(stack[top-1]); break;
+			case OP_LOG10: stack[top-1] = std::log10(stack[top-1]); break;
+			case OP_EXP: stack[top-1] = std::exp(stack[top-1]); break;
+			case OP_SQRT: stack[top-1] = std::sqrt(stack[top-1]); break;
+			case OP_ABS: stack[top-1] = std::abs(stack[top-1]); break;
+			case OP_TANH: stack[top-1] = std::tanh(stack[top-1]); break;
+			case OP_ATAN: stack[top-1] = std::atan(stack[top-1]); break;
+			case OP_MIN: --top; stack[top-1] = std::min(stack[top-1], stack[top]); break;
+			case OP_MAX: --top; stack[top-1] = std::max(stack[top-1], stack[top]); break;
+			case OP_JUMP: pc = instruction.target - 1; break;
+			case OP_JUMP_IF_FALSE:
+				--top;
+				if (stack[top] == 0.) {
+					pc = instruction.target - 1;
+				}
+				break;
+			default:
+				LOG(FATAL) << "BTagFormula: unknown instruction " << static_cast<int>(instruction.op) << "!";
+				break;
+		}
+	}
+	return stack[0];
+}
+
+
 BTagCalibrationReader::BTagCalibrationReader(const BTagCalibration* c,
 	                                           BTagEntry::OperatingPoint op,
 	                                           std::string measurementType,
@@ -370,6 +629,18 @@ BTagCalibrationReader::BTagCalibrationReader(const BTagCalibration* c,
 	useAbsEta(true)
 {
 	setupTmpData(c);
+	setupIndex();
+}
+
+namespace {
+	// index of the bin [edges[i], edges[i+1]) containing the value, -1 if outside
+	int findBin(const std::vector<float> &edges, float value) {
+		std::vector<float>::const_iterator upperBound = std::upper_bound(edges.begin(), edges.end(), value);
+		if (upperBound == edges.begin() || upperBound == edges.end()) {
+			return -1;
+		}
+		return (upperBound - edges.begin()) - 1;
+	}
 }
 
 double BTagCalibrationReader::eval(BTagEntry::JetFlavor jf,
@@ -382,26 +653,25 @@ double BTagCalibrationReader::eval(BTagEntry::JetFlavor jf,
 		eta = -eta;
 	}
 
-	// search linearly through eta, pt and discr ranges and eval
-	// future: find some clever data structure based on intervals
+	// find the first matching entry in the grid of all eta, pt and discr ranges and eval
 	const std::vector<TmpEntry> &entries = tmpData_.at(jf);
-	for (unsigned i=0; i<entries.size(); ++i) {
-		const BTagCalibrationReader::TmpEntry &e = entries.at(i);
-		if (
-			e.etaMin <= eta && eta < e.etaMax                   // find eta
-			&& e.ptMin <= pt && pt < e.ptMax                    // check pt
-		){
-			if (use_discr) {                                    // discr. reshaping?
-				if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
-					return e.func.Eval(discr);
-				}
-			} else {
-				return e.func.Eval(pt);
-			}
-		}
+	const EntryIndex &index = index_.at(jf);
+	int etaBin = findBin(index.etaEdges, eta);
+	int ptBin = findBin(index.ptEdges, pt);
+	int discrBin = (use_discr ? findBin(index.discrEdges, discr) : 0);
+	if (etaBin < 0 || ptBin < 0 || discrBin < 0) {
+		return 0.;  // default value
+	}
+	size_t nPtBins = index.ptEdges.size() - 1;
+	size_t nDiscrBins = (use_discr ? index.discrEdges.size() - 1 : 1);
+	int entryIndex = index.cells[(etaBin * nPtBins + ptBin) * nDiscrBins + discrBin];
+	if (entryIndex < 0) {
+		return 0.;  // default value
 	}
 
-	return 0.;  // default value
+	const BTagCalibrationReader::TmpEntry &e = entries[entryIndex];
+	double x = (use_discr ? discr : pt);
+	return (e.formula.isCompiled() ? e.formula.eval(x) : e.func.Eval(x));
 }
 
 void BTagCalibrationReader::setupTmpData(const BTagCalibration* c)
@@ -418,12 +688,14 @@ void BTagCalibrationReader::setupTmpData(const BTagCalibration* c)
 		te.discrMin = be.params.discrMin;
 		te.discrMax = be.params.discrMax;
 
-		if (params.operatingPoint == BTagEntry::OP_RESHAPING) {
-			te.func = TF1("", be.formula.c_str(),
-			              be.params.discrMin, be.params.discrMax);
-		} else {
-			te.func = TF1("", be.formula.c_str(),
-			              be.params.ptMin, be.params.ptMax);
+		if (!te.formula.compile(be.formula)) {
+			if (params.operatingPoint == BTagEntry::OP_RESHAPING) {
+				te.func = TF1("", be.formula.c_str(),
+				              be.params.discrMin, be.params.discrMax);
+			} else {
+				te.func = TF1("", be.formula.c_str(),
+				              be.params.ptMin, be.params.ptMax);
+			}
 		}
 
 		tmpData_[be.params.jetFlavor].push_back(te);
@@ -432,3 +704,51 @@ void BTagCalibrationReader::setupTmpData(const BTagCalibration* c)
 		}
 	}
 }
+
+void BTagCalibrationReader::setupIndex()
+{
+	bool use_discr = (params.operatingPoint == BTagEntry::OP_RESHAPING);
+	for (std::map<BTagEntry::JetFlavor, std::vector<TmpEntry> >::const_iterator flavourData = tmpData_.begin();
+	     flavourData != tmpData_.end(); ++flavourData)
+	{
+		const std::vector<TmpEntry> &entries = flavourData->second;
+		EntryIndex &index = index_[flavourData->first];
+
+		// all boundaries of the entries
+		for (unsigned i=0; i<entries.size(); ++i) {
+			const TmpEntry &e = entries[i];
+			index.etaEdges.push_back(e.etaMin);
+			index.etaEdges.push_back(e.etaMax);
+			index.ptEdges.push_back(e.ptMin);
+			index.ptEdges.push_back(e.ptMax);
+			index.discrEdges.push_back(e.discrMin);
+			index.discrEdges.push_back(e.discrMax);
+		}
+		for (std::vector<float>* edges : {&index.etaEdges, &index.ptEdges, &index.discrEdges}) {
+			std::sort(edges->begin(), edges->end());
+			edges->erase(std::unique(edges->begin(), edges->end()), edges->end());
+		}
+
+		// each cell lies completely inside or outside of each entry,
+		// the first entry containing the cell is taken (as in a linear search)
+		size_t nEtaBins = index.etaEdges.size() - 1;
+		size_t nPtBins = index.ptEdges.size() - 1;
+		size_t nDiscrBins = (use_discr ? index.discrEdges.size() - 1 : 1);
+		index.cells.assign(nEtaBins * nPtBins * nDiscrBins, -1);
+		for (size_t etaBin = 0; etaBin < nEtaBins; ++etaBin) {
+			for (size_t ptBin = 0; ptBin < nPtBins; ++ptBin) {
+				for (size_t discrBin = 0; discrBin < nDiscrBins; ++discrBin) {
+					for (unsigned i=0; i<entries.size(); ++i) {
+						const TmpEntry &e = entries[i];
+						if (e.etaMin <= index.etaEdges[etaBin] && index.etaEdges[etaBin+1] <= e.etaMax
+						    && e.ptMin <= index.ptEdges[ptBin] && index.ptEdges[ptBin+1] <= e.ptMax
+						    && (!use_discr || (e.discrMin <= index.discrEdges[discrBin] && index.discrEdges[discrBin+1] <= e.discrMax))) {
+							index.cells[(etaBin * nPtBins + ptBin) * nDiscrBins + discrBin] = i;
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+}
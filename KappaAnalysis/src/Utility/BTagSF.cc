@@ -6,7 +6,6 @@ BTagSF::BTagSF()
 }
 
 BTagSF::BTagSF(std::string csvfile, std::string efficiencyfile) :
-	randm(TRandom3(0)),
 	calib(BTagCalibration("csvv2", csvfile)),
 	effFile(new TFile(efficiencyfile.c_str()))
 {
@@ -124,8 +123,16 @@ void BTagSF::initBtagwp(std::string btagwp)
 bool BTagSF::isbtagged(double pt, float eta, float csv, Int_t jetflavor,
 	                     unsigned int btagsys, unsigned int mistagsys, int year, float btagWP) const
 {
-	randm.SetSeed(static_cast<int>((eta + 5) * 100000.));
-	double randval = randm.Uniform();
+	// reproducible random number depending on the eta of the jet
+	RandomStream random = RandomNumberService::GetStream(0, 0, static_cast<uint64_t>((eta + 5) * 100000.), "BTagSF");
+	return isbtagged(pt, eta, csv, jetflavor, btagsys, mistagsys, year, btagWP, random);
+}
+
+bool BTagSF::isbtagged(double pt, float eta, float csv, Int_t jetflavor,
+	                     unsigned int btagsys, unsigned int mistagsys, int year, float btagWP,
+	                     RandomStream& random) const
+{
+	double randval = random.Uniform();
 
 	float csv_WP = 0.679;
 	if(year == 2015 || year == 2016 || year == 2017)
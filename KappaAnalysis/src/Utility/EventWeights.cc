@@ -0,0 +1,94 @@
+
+#include <map>
+
+#include "boost/algorithm/string/join.hpp"
+
+#include "Artus/KappaAnalysis/interface/Utility/EventWeights.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+namespace
+{
+	struct EventWeightsRegistry
+	{
+		std::map<std::string, size_t> slotsByName;
+		std::vector<std::string> names;
+		uint64_t constantMask = 0;
+	};
+
+	EventWeightsRegistry& GetRegistry()
+	{
+		static EventWeightsRegistry registry;
+		return registry;
+	}
+}
+
+
+const size_t EventWeights::MaxSlots;
+const size_t EventWeights::NotRegistered;
+
+size_t EventWeights::RegisterWeight(std::string const& name, bool isConstant)
+{
+	EventWeightsRegistry& registry = GetRegistry();
+	size_t slot = NotRegistered;
+
+	std::map<std::string, size_t>::const_iterator registeredSlot = registry.slotsByName.find(name);
+	if (registeredSlot != registry.slotsByName.end())
+	{
+		slot = registeredSlot->second;
+	}
+	else
+	{
+		if (registry.names.size() >= MaxSlots)
+		{
+			LOG(FATAL) << "Cannot register event weight \"" << name << "\", all " << MaxSlots << " slots of EventWeights "
+			           << "are already in use by the weights (" << boost::algorithm::join(registry.names, ", ") << "). "
+			           << "Reduce the number of weights in the configuration or increase EventWeights::MaxSlots!";
+		}
+		slot = registry.names.size();
+		registry.slotsByName[name] = slot;
+		registry.names.push_back(name);
+	}
+
+	if (isConstant)
+	{
+		registry.constantMask |= (uint64_t(1) << slot);
+	}
+	return slot;
+}
+
+size_t EventWeights::GetSlot(std::string const& name)
+{
+	EventWeightsRegistry const& registry = GetRegistry();
+	std::map<std::string, size_t>::const_iterator registeredSlot = registry.slotsByName.find(name);
+	return ((registeredSlot != registry.slotsByName.end()) ? registeredSlot->second : NotRegistered);
+}
+
+std::string const& EventWeights::GetName(size_t slot)
+{
+	return GetRegistry().names.at(slot);
+}
+
+bool EventWeights::IsConstant(size_t slot)
+{
+	return ((slot < MaxSlots) && ((GetRegistry().constantMask & (uint64_t(1) << slot)) != 0));
+}
+
+uint64_t EventWeights::GetConstantMask()
+{
+	return GetRegistry().constantMask;
+}
+
+std::vector<std::string> EventWeights::GetSetNames() const
+{
+	std::vector<std::string> names;
+	for (size_t slot = 0; slot < MaxSlots; ++slot)
+	{
+		if (IsSet(slot))
+		{
+			names.push_back(GetName(slot));
+		}
+	}
+	return names;
+}
+
@@ -0,0 +1,373 @@
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleDecayGraph.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+#include "Artus/Utility/interface/DefaultValues.h"
+
+
+namespace
+{
+	constexpr int positiveChargedParticlePdgIds[] =
+	{
+		-DefaultValues::pdgIdElectron,
+		-DefaultValues::pdgIdMuon,
+		-DefaultValues::pdgIdTau,
+		DefaultValues::pdgIdW,
+		DefaultValues::pdgIdPiPlus,
+		DefaultValues::pdgIdRhoPlus770,
+		DefaultValues::pdgIdKPlus,
+		DefaultValues::pdgIdKStar,
+		DefaultValues::pdgIdAOnePlus1260
+	};
+
+	constexpr int negativeChargedParticlePdgIds[] =
+	{
+		DefaultValues::pdgIdElectron,
+		DefaultValues::pdgIdMuon,
+		DefaultValues::pdgIdTau,
+		-DefaultValues::pdgIdW,
+		-DefaultValues::pdgIdPiPlus,
+		-DefaultValues::pdgIdRhoPlus770,
+		-DefaultValues::pdgIdKPlus,
+		-DefaultValues::pdgIdKStar,
+		-DefaultValues::pdgIdAOnePlus1260
+	};
+
+	constexpr int neutralParticlePdgIds[] =
+	{
+		DefaultValues::pdgIdNuE,
+		-DefaultValues::pdgIdNuE,
+		DefaultValues::pdgIdNuMu,
+		-DefaultValues::pdgIdNuMu,
+		DefaultValues::pdgIdNuTau,
+		-DefaultValues::pdgIdNuTau,
+		DefaultValues::pdgIdGamma,
+		DefaultValues::pdgIdPiZero,
+		DefaultValues::pdgIdKLong,
+		DefaultValues::pdgIdEta,
+		DefaultValues::pdgIdKShort
+	};
+
+	constexpr int detectableParticlePdgIds[] =
+	{
+		DefaultValues::pdgIdGamma,
+		DefaultValues::pdgIdPiPlus,
+		-DefaultValues::pdgIdPiPlus,
+		DefaultValues::pdgIdElectron,
+		-DefaultValues::pdgIdElectron,
+		DefaultValues::pdgIdMuon,
+		-DefaultValues::pdgIdMuon,
+		DefaultValues::pdgIdTau,
+		-DefaultValues::pdgIdTau
+	};
+
+	// absolute PDG IDs of decay products and the decay modes they indicate
+	constexpr std::pair<int, GenParticleDecayGraph::DecayMode> decayModePdgIds[] =
+	{
+		{ DefaultValues::pdgIdTau, GenParticleDecayGraph::DecayMode::TAU },
+		{ DefaultValues::pdgIdPiPlus, GenParticleDecayGraph::DecayMode::PI },
+		{ DefaultValues::pdgIdKPlus, GenParticleDecayGraph::DecayMode::KPLUS },
+		{ DefaultValues::pdgIdKStar, GenParticleDecayGraph::DecayMode::KSTAR },
+		{ DefaultValues::pdgIdRhoPlus770, GenParticleDecayGraph::DecayMode::RHO },
+		{ DefaultValues::pdgIdAOnePlus1260, GenParticleDecayGraph::DecayMode::AONE },
+		{ DefaultValues::pdgIdMuon, GenParticleDecayGraph::DecayMode::M },
+		{ DefaultValues::pdgIdElectron, GenParticleDecayGraph::DecayMode::E }
+	};
+
+	template<size_t N>
+	bool Contains(int const (&pdgIds)[N], int pdgId)
+	{
+		return (std::find(pdgIds, pdgIds + N, pdgId) != (pdgIds + N));
+	}
+}
+
+
+const size_t GenParticleDecayGraph::NoNode;
+const int GenParticleDecayGraph::UnknownCharge;
+
+int GenParticleDecayGraph::GetChargeFromPdgId(int pdgId)
+{
+	if (Contains(positiveChargedParticlePdgIds, pdgId))
+	{
+		return 1;
+	}
+	else if (Contains(negativeChargedParticlePdgIds, pdgId))
+	{
+		return -1;
+	}
+	else if (Contains(neutralParticlePdgIds, pdgId))
+	{
+		return 0;
+	}
+	return UnknownCharge;
+}
+
+bool GenParticleDecayGraph::IsDetectablePdgId(int pdgId)
+{
+	return Contains(detectableParticlePdgIds, pdgId);
+}
+
+GenParticleDecayGraph::DecayMode GenParticleDecayGraph::GetDecayModeFromPdgId(int pdgId)
+{
+	int absPdgId = std::abs(pdgId);
+	for (std::pair<int, DecayMode> const& decayModePdgId : decayModePdgIds)
+	{
+		if (decayModePdgId.first == absPdgId)
+		{
+			return decayModePdgId.second;
+		}
+	}
+	return DecayMode::NONE;
+}
+
+void GenParticleDecayGraph::Clear()
+{
+	m_genParticles = nullptr;
+	m_genParticleIndices.clear();
+	m_mothers.clear();
+	m_charges.clear();
+	m_detectable.clear();
+	m_daughterOffsets.clear();
+}
+
+void GenParticleDecayGraph::Build(std::vector<KGenParticle>* genParticles, KGenParticle const* root)
+{
+	Clear();
+	m_genParticles = genParticles;
+	AddNode(GetIndex(root), NoNode);
+	ExpandNodes(0);
+}
+
+void GenParticleDecayGraph::Build(std::vector<KGenParticle>* genParticles, std::vector<KGenParticle*> const& rootDaughters)
+{
+	Clear();
+	m_genParticles = genParticles;
+	AddNode(-1, NoNode);
+	m_daughterOffsets.push_back(1);
+	for (std::vector<KGenParticle*>::const_iterator rootDaughter = rootDaughters.begin();
+	     rootDaughter != rootDaughters.end(); ++rootDaughter)
+	{
+		AddNode(GetIndex(*rootDaughter), 0);
+	}
+	ExpandNodes(1);
+}
+
+size_t GenParticleDecayGraph::GetMother(size_t node) const
+{
+	return ((node < GetNNodes()) ? m_mothers[node] : NoNode);
+}
+
+size_t GenParticleDecayGraph::GetDaughtersBegin(size_t node) const
+{
+	return ((node < GetNNodes()) ? m_daughterOffsets[node] : 0);
+}
+
+size_t GenParticleDecayGraph::GetDaughtersEnd(size_t node) const
+{
+	return ((node < GetNNodes()) ? m_daughterOffsets[node + 1] : 0);
+}
+
+size_t GenParticleDecayGraph::GetNDaughters(size_t node) const
+{
+	return (GetDaughtersEnd(node) - GetDaughtersBegin(node));
+}
+
+size_t GenParticleDecayGraph::GetDaughter(size_t node, size_t daughterIndex) const
+{
+	return ((daughterIndex < GetNDaughters(node)) ? GetDaughtersBegin(node) + daughterIndex : NoNode);
+}
+
+size_t GenParticleDecayGraph::GetDescendant(std::initializer_list<size_t> daughterIndices) const
+{
+	size_t node = GetRoot();
+	for (std::initializer_list<size_t>::const_iterator daughterIndex = daughterIndices.begin();
+	     daughterIndex != daughterIndices.end(); ++daughterIndex)
+	{
+		node = GetDaughter(node, *daughterIndex);
+	}
+	return node;
+}
+
+size_t GenParticleDecayGraph::FindNode(KGenParticle const* genParticle) const
+{
+	if ((m_genParticles == nullptr) || (genParticle == nullptr))
+	{
+		return NoNode;
+	}
+	std::vector<int>::const_iterator node = std::find(m_genParticleIndices.begin(), m_genParticleIndices.end(),
+	                                                  static_cast<int>(genParticle - m_genParticles->data()));
+	return ((node == m_genParticleIndices.end()) ? NoNode : static_cast<size_t>(node - m_genParticleIndices.begin()));
+}
+
+int GenParticleDecayGraph::GetGenParticleIndex(size_t node) const
+{
+	return ((node < GetNNodes()) ? m_genParticleIndices[node] : -1);
+}
+
+KGenParticle* GenParticleDecayGraph::GetGenParticle(size_t node) const
+{
+	int genParticleIndex = GetGenParticleIndex(node);
+	return ((genParticleIndex < 0) ? nullptr : &((*m_genParticles)[genParticleIndex]));
+}
+
+int GenParticleDecayGraph::GetCharge(size_t node) const
+{
+	return ((node < GetNNodes()) ? m_charges[node] : UnknownCharge);
+}
+
+bool GenParticleDecayGraph::IsDetectable(size_t node) const
+{
+	return ((node < GetNNodes()) && m_detectable[node]);
+}
+
+bool GenParticleDecayGraph::IsFinalState(size_t node) const
+{
+	return ((GetGenParticleIndex(node) >= 0) && (GetNDaughters(node) == 0));
+}
+
+void GenParticleDecayGraph::GetFinalStates(size_t node, std::vector<size_t>& finalStates) const
+{
+	finalStates.clear();
+	if (node >= GetNNodes())
+	{
+		return;
+	}
+
+	if (IsFinalState(node))
+	{
+		finalStates.push_back(node);
+	}
+	m_stack.clear();
+	m_stack.push_back(std::make_pair(node, GetDaughtersBegin(node)));
+	while (! m_stack.empty())
+	{
+		std::pair<size_t, size_t>& current = m_stack.back();
+		if (current.second == GetDaughtersEnd(current.first))
+		{
+			m_stack.pop_back();
+			continue;
+		}
+		size_t daughter = current.second++;
+		if (IsFinalState(daughter))
+		{
+			finalStates.push_back(daughter);
+		}
+		m_stack.push_back(std::make_pair(daughter, GetDaughtersBegin(daughter)));
+	}
+}
+
+int GenParticleDecayGraph::GetNProngs(size_t node) const
+{
+	// the order of the final states does not matter for counting, the nodes of the subtree
+	// are collected breadth-first in the scratch space
+	if (node >= GetNNodes())
+	{
+		return 0;
+	}
+
+	int nProngs = 0;
+	m_stack.clear();
+	m_stack.push_back(std::make_pair(node, 0));
+	for (size_t subtreeNode = 0; subtreeNode < m_stack.size(); ++subtreeNode)
+	{
+		size_t current = m_stack[subtreeNode].first;
+		if (IsFinalState(current) && (std::abs(m_charges[current]) == 1))
+		{
+			++nProngs;
+		}
+		for (size_t daughter = GetDaughtersBegin(current); daughter < GetDaughtersEnd(current); ++daughter)
+		{
+			m_stack.push_back(std::make_pair(daughter, 0));
+		}
+	}
+	return nProngs;
+}
+
+GenParticleDecayGraph::DecayMode GenParticleDecayGraph::DetermineDecayMode(size_t node) const
+{
+	DecayMode decayMode = DecayMode::NONE;
+	if (node >= GetNNodes())
+	{
+		return decayMode;
+	}
+
+	m_stack.clear();
+	m_stack.push_back(std::make_pair(node, GetDaughtersBegin(node)));
+	while (! m_stack.empty())
+	{
+		std::pair<size_t, size_t>& current = m_stack.back();
+		if (current.second == GetDaughtersEnd(current.first))
+		{
+			m_stack.pop_back();
+			continue;
+		}
+		size_t daughter = current.second++;
+		DecayMode daughterDecayMode = GetDecayModeFromPdgId(GetGenParticle(daughter)->pdgId);
+		if (daughterDecayMode != DecayMode::NONE)
+		{
+			decayMode = daughterDecayMode;
+		}
+		if (decayMode == DecayMode::NONE)
+		{
+			m_stack.push_back(std::make_pair(daughter, GetDaughtersBegin(daughter)));
+		}
+	}
+	return decayMode;
+}
+
+void GenParticleDecayGraph::AddNode(int genParticleIndex, size_t mother)
+{
+	m_genParticleIndices.push_back(genParticleIndex);
+	m_mothers.push_back(mother);
+	if (genParticleIndex < 0)
+	{
+		m_charges.push_back(UnknownCharge);
+		m_detectable.push_back(false);
+	}
+	else
+	{
+		int pdgId = (*m_genParticles)[genParticleIndex].pdgId;
+		m_charges.push_back(GetChargeFromPdgId(pdgId));
+		m_detectable.push_back(IsDetectablePdgId(pdgId));
+	}
+}
+
+int GenParticleDecayGraph::GetIndex(KGenParticle const* genParticle) const
+{
+	if (genParticle == nullptr)
+	{
+		return -1;
+	}
+	if ((genParticle < m_genParticles->data()) || (genParticle >= (m_genParticles->data() + m_genParticles->size())))
+	{
+		LOG(FATAL) << "The particle for the decay graph is not part of the generator particle collection!";
+	}
+	return static_cast<int>(genParticle - m_genParticles->data());
+}
+
+void GenParticleDecayGraph::ExpandNodes(size_t firstNode)
+{
+	// the daughters are appended to the nodes, such that the nodes are processed in breadth-first order
+	for (size_t node = firstNode; node < GetNNodes(); ++node)
+	{
+		m_daughterOffsets.push_back(GetNNodes());
+		int genParticleIndex = m_genParticleIndices[node];
+		if (genParticleIndex >= 0)
+		{
+			std::vector<unsigned int> const& daughterIndices = (*m_genParticles)[genParticleIndex].daughterIndices;
+			for (std::vector<unsigned int>::const_iterator daughterIndex = daughterIndices.begin();
+			     daughterIndex != daughterIndices.end(); ++daughterIndex)
+			{
+				if (*daughterIndex >= m_genParticles->size())
+				{
+					LOG(FATAL) << "Daughter index " << *daughterIndex << " is out of the range of the generator particles!";
+				}
+				AddNode(static_cast<int>(*daughterIndex), node);
+			}
+		}
+	}
+	m_daughterOffsets.push_back(GetNNodes());
+}
+
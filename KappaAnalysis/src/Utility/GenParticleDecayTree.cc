@@ -53,17 +53,10 @@ void GenParticleDecayTree::CreateFinalStateProngs(GenParticleDecayTree* root)
 
 void GenParticleDecayTree::SetCharge()
 {
-	if (Utility::Contains(m_positiveChargedParticlePdgIds, m_genParticle->pdgId))
+	int charge = GenParticleDecayGraph::GetChargeFromPdgId(m_genParticle->pdgId);
+	if (charge != GenParticleDecayGraph::UnknownCharge)
 	{
-		m_charge = 1;
-	}
-	else if (Utility::Contains(m_negativeChargedParticlePdgIds, m_genParticle->pdgId))
-	{
-		m_charge = -1;
-	}
-	else if (Utility::Contains(m_neutralParticlePdgIds, m_genParticle->pdgId))
-	{
-		m_charge = 0;
+		m_charge = charge;
 	}
 }
 
@@ -74,7 +67,7 @@ int GenParticleDecayTree::GetCharge() const
 
 void GenParticleDecayTree::SetDetectable()
 {
-	m_detectable = Utility::Contains(m_detectableParticlePdgIds, m_genParticle->pdgId);
+	m_detectable = GenParticleDecayGraph::IsDetectablePdgId(m_genParticle->pdgId);
 }
 
 bool GenParticleDecayTree::IsDetectable() const
@@ -97,38 +90,9 @@ void GenParticleDecayTree::DetermineDecayMode(GenParticleDecayTree* root)
 
 void GenParticleDecayTree::SetDecayMode(GenParticleDecayTree* tauDaughter)
 {
-	int pdgId = std::abs(tauDaughter->m_genParticle->pdgId);
-	if (pdgId == DefaultValues::pdgIdTau)
-	{
-		m_decayMode = DecayMode::TAU;
-	}
-	else if (pdgId == DefaultValues::pdgIdPiPlus)
-	{
-		m_decayMode = DecayMode::PI;
-	}
-	else if (pdgId == DefaultValues::pdgIdKPlus)
-	{
-		m_decayMode = DecayMode::KPLUS;
-	}
-	else if (pdgId == DefaultValues::pdgIdKStar)
+	DecayMode decayMode = GenParticleDecayGraph::GetDecayModeFromPdgId(tauDaughter->m_genParticle->pdgId);
+	if (decayMode != DecayMode::NONE)
 	{
-		m_decayMode = DecayMode::KSTAR;
-	}
-	else if (pdgId == DefaultValues::pdgIdRhoPlus770)
-	{
-		m_decayMode = DecayMode::RHO;
-	}
-	else if (pdgId == DefaultValues::pdgIdAOnePlus1260)
-	{
-		m_decayMode = DecayMode::AONE;
-	}
-	else if (pdgId == DefaultValues::pdgIdMuon)
-	{
-		m_decayMode = DecayMode::M;
-	}
-	else if (pdgId == DefaultValues::pdgIdElectron)
-	{
-		m_decayMode = DecayMode::E;
+		m_decayMode = decayMode;
 	}
 }
-
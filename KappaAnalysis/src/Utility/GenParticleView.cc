@@ -0,0 +1,156 @@
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "Artus/KappaAnalysis/interface/Utility/GenParticleView.h"
+
+
+void GenParticleView::Build(std::vector<KGenParticle>* genParticles)
+{
+	m_genParticles = genParticles;
+	size_t nParticles = m_genParticles->size();
+
+	// status and flags
+	m_status.resize(nParticles);
+	m_flags.resize(nParticles);
+	m_sortedAbsPdgIds.clear();
+	for (size_t index = 0; index < nParticles; ++index)
+	{
+		KGenParticle const& genParticle = (*m_genParticles)[index];
+		m_status[index] = genParticle.status();
+		m_flags[index] = ((genParticle.isPrompt() ? IS_PROMPT : 0) |
+		                  (genParticle.isHardProcess() ? IS_HARD_PROCESS : 0) |
+		                  (genParticle.fromHardProcess() ? FROM_HARD_PROCESS : 0) |
+		                  (genParticle.isLastCopy() ? IS_LAST_COPY : 0) |
+		                  (genParticle.isDirectPromptTauDecayProduct() ? IS_DIRECT_PROMPT_TAU_DECAY_PRODUCT : 0));
+		m_sortedAbsPdgIds.push_back(std::make_pair(std::abs(genParticle.pdgId), static_cast<uint32_t>(index)));
+	}
+
+	// pdgId buckets
+	std::sort(m_sortedAbsPdgIds.begin(), m_sortedAbsPdgIds.end());
+	m_bucketAbsPdgIds.clear();
+	m_bucketOffsets.clear();
+	m_bucketParticles.clear();
+	for (std::vector<std::pair<int, uint32_t> >::const_iterator absPdgId = m_sortedAbsPdgIds.begin();
+	     absPdgId != m_sortedAbsPdgIds.end(); ++absPdgId)
+	{
+		if (m_bucketAbsPdgIds.empty() || (m_bucketAbsPdgIds.back() != absPdgId->first))
+		{
+			m_bucketAbsPdgIds.push_back(absPdgId->first);
+			m_bucketOffsets.push_back(static_cast<uint32_t>(m_bucketParticles.size()));
+		}
+		m_bucketParticles.push_back(absPdgId->second);
+	}
+	m_bucketOffsets.push_back(static_cast<uint32_t>(m_bucketParticles.size()));
+
+	// daughters, invalid indices are skipped
+	m_daughterOffsets.clear();
+	m_daughters.clear();
+	for (size_t index = 0; index < nParticles; ++index)
+	{
+		m_daughterOffsets.push_back(static_cast<uint32_t>(m_daughters.size()));
+		std::vector<unsigned int> const& daughterIndices = (*m_genParticles)[index].daughterIndices;
+		for (std::vector<unsigned int>::const_iterator daughterIndex = daughterIndices.begin();
+		     daughterIndex != daughterIndices.end(); ++daughterIndex)
+		{
+			if (*daughterIndex < nParticles)
+			{
+				m_daughters.push_back(*daughterIndex);
+			}
+		}
+	}
+	m_daughterOffsets.push_back(static_cast<uint32_t>(m_daughters.size()));
+
+	// mothers: count, then fill (the mothers are processed in ascending order, duplicates are consecutive)
+	m_motherOffsets.assign(nParticles + 1, 0);
+	m_lastMothers.assign(nParticles, std::numeric_limits<uint32_t>::max());
+	for (uint32_t mother = 0; mother < nParticles; ++mother)
+	{
+		for (uint32_t daughterIndex = m_daughterOffsets[mother]; daughterIndex < m_daughterOffsets[mother + 1]; ++daughterIndex)
+		{
+			uint32_t daughter = m_daughters[daughterIndex];
+			if (m_lastMothers[daughter] != mother)
+			{
+				m_lastMothers[daughter] = mother;
+				++m_motherOffsets[daughter + 1];
+			}
+		}
+	}
+	for (size_t index = 0; index < nParticles; ++index)
+	{
+		m_motherOffsets[index + 1] += m_motherOffsets[index];
+	}
+	m_mothers.resize(m_motherOffsets[nParticles]);
+	std::copy(m_motherOffsets.begin(), m_motherOffsets.end() - 1, m_lastMothers.begin()); // now used as write positions
+	for (uint32_t mother = 0; mother < nParticles; ++mother)
+	{
+		for (uint32_t daughterIndex = m_daughterOffsets[mother]; daughterIndex < m_daughterOffsets[mother + 1]; ++daughterIndex)
+		{
+			uint32_t daughter = m_daughters[daughterIndex];
+			uint32_t& position = m_lastMothers[daughter];
+			if ((position == m_motherOffsets[daughter]) || (m_mothers[position - 1] != mother))
+			{
+				m_mothers[position++] = mother;
+			}
+		}
+	}
+
+	m_isBuilt = true;
+}
+
+GenParticleView::IndexRange GenParticleView::GetParticlesWithAbsPdgId(int absPdgId) const
+{
+	std::vector<int>::const_iterator bucket = std::lower_bound(m_bucketAbsPdgIds.begin(), m_bucketAbsPdgIds.end(), absPdgId);
+	if ((bucket == m_bucketAbsPdgIds.end()) || (*bucket != absPdgId))
+	{
+		return IndexRange();
+	}
+	size_t bucketIndex = bucket - m_bucketAbsPdgIds.begin();
+	return IndexRange(m_bucketParticles.data() + m_bucketOffsets[bucketIndex],
+	                  m_bucketParticles.data() + m_bucketOffsets[bucketIndex + 1]);
+}
+
+void GenParticleView::GetParticlesWithAbsPdgIds(std::vector<int> const& absPdgIds, std::vector<uint32_t>& indices) const
+{
+	indices.clear();
+	for (std::vector<int>::const_iterator absPdgId = absPdgIds.begin(); absPdgId != absPdgIds.end(); ++absPdgId)
+	{
+		if (std::find(absPdgIds.begin(), absPdgId, *absPdgId) == absPdgId)
+		{
+			IndexRange particles = GetParticlesWithAbsPdgId(*absPdgId);
+			indices.insert(indices.end(), particles.begin(), particles.end());
+		}
+	}
+	std::sort(indices.begin(), indices.end());
+}
+
+size_t GenParticleView::FindFirst(std::vector<int> const& absPdgIds, int status, uint16_t flags, size_t startIndex) const
+{
+	size_t firstIndex = GetNParticles();
+	for (std::vector<int>::const_iterator absPdgId = absPdgIds.begin(); absPdgId != absPdgIds.end(); ++absPdgId)
+	{
+		IndexRange particles = GetParticlesWithAbsPdgId(*absPdgId);
+		for (uint32_t const* index = std::lower_bound(particles.begin(), particles.end(), startIndex);
+		     (index != particles.end()) && (*index < firstIndex); ++index)
+		{
+			if (((status == -1) || (m_status[*index] == status)) && HasFlags(*index, flags))
+			{
+				firstIndex = *index;
+				break;
+			}
+		}
+	}
+	return firstIndex;
+}
+
+GenParticleView::IndexRange GenParticleView::GetMothers(size_t index) const
+{
+	return IndexRange(m_mothers.data() + m_motherOffsets[index], m_mothers.data() + m_motherOffsets[index + 1]);
+}
+
+GenParticleView::IndexRange GenParticleView::GetDaughters(size_t index) const
+{
+	return IndexRange(m_daughters.data() + m_daughterOffsets[index], m_daughters.data() + m_daughterOffsets[index + 1]);
+}
+
@@ -51,8 +51,8 @@ RMFLV* GeneratorInfo::GetVisibleLV(KGenParticle* genParticle)
 
 KGenParticle* GeneratorInfo::GetGenMatchedParticle(
 		KLepton* lepton,
-		std::map<KLepton*, KGenParticle*> const& leptonGenParticleMap,
-		std::map<KLepton*, KGenTau*> const& leptonGenTauMap
+		FlatMap<KLepton*, KGenParticle*> const& leptonGenParticleMap,
+		FlatMap<KLepton*, KGenTau*> const& leptonGenTauMap
 )
 {
 	KGenParticle* defaultGenParticle = nullptr;
@@ -76,91 +76,120 @@ KGenParticle* GeneratorInfo::GetGenMatchedParticle(
 
 // This matching algorithm is used by the Wisconsin group and was provided by Cecile.
 KappaEnumTypes::GenMatchingCode GeneratorInfo::GetGenMatchingCodeUW(
-		KappaTypes::event_type const& event,
+		GenParticleView const& genParticleView,
+		std::vector<RMFLV> const& genTaus,
 		KLepton* lepton
 )
 {
-	if(event.m_genParticles && event.m_genParticles->size() > 0)
-	{
-		KGenParticle closest = event.m_genParticles->at(0);
-		double closestDR = 999;
-		std::vector<RMFLV> genTaus = BuildGenTausUW(event);
-		
-		//find closest lepton fulfilling the requirements
-		for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-			genParticle != event.m_genParticles->end(); ++genParticle)
+	if (genParticleView.GetNParticles() == 0)
+	{
+		return KappaEnumTypes::GenMatchingCode::NONE;
+	}
+
+	//find closest lepton fulfilling the requirements
+	size_t closestIndex = genParticleView.GetNParticles();
+	double closestDR = 999;
+	const int leptonAbsPdgIds[2] = { 11, 13 };
+	for (size_t leptonType = 0; leptonType < 2; ++leptonType)
+	{
+		for (uint32_t index : genParticleView.GetParticlesWithAbsPdgId(leptonAbsPdgIds[leptonType]))
 		{
-			int pdgId = std::abs(genParticle->pdgId);
-			if (genParticle->p4.Pt() > 8. && (pdgId == 11 || pdgId == 13) && (genParticle->isPrompt() || genParticle->isDirectPromptTauDecayProduct())){
+			KGenParticle* genParticle = genParticleView.GetParticle(index);
+			if (genParticle->p4.Pt() > 8. &&
+			    (genParticleView.HasFlags(index, GenParticleView::IS_PROMPT) ||
+			     genParticleView.HasFlags(index, GenParticleView::IS_DIRECT_PROMPT_TAU_DECAY_PRODUCT)))
+			{
 				double tmpDR = ROOT::Math::VectorUtil::DeltaR(lepton->p4, genParticle->p4);
-				if (tmpDR < closestDR)
+				// the particle with the lower index is taken in case of equal distances
+				if ((tmpDR < closestDR) || ((tmpDR == closestDR) && (index < closestIndex)))
 				{
-					closest = *genParticle;
+					closestIndex = index;
 					closestDR = tmpDR;
 				}
 			}
 		}
-		//check whether there are closer tau jets within a 0.2 cone
-		for(auto genTau : genTaus)
-		{
-			double tauDR = ROOT::Math::VectorUtil::DeltaR(lepton->p4, genTau);
-			if (genTau.Pt() > 15. && tauDR < 0.2 && tauDR < closestDR) return KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY;
-		}
-		//since there are no closer tau jets check whether dR < 0.2 is fulfilled and return lepton type
-		int pdgId = std::abs(closest.pdgId);
-		if (closestDR < 0.2){
-			if (pdgId == 11 && closest.isPrompt()) return KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT;
-			if (pdgId == 13 && closest.isPrompt()) return KappaEnumTypes::GenMatchingCode::IS_MUON_PROMPT;
-			if (pdgId == 11 && closest.isDirectPromptTauDecayProduct()) return KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU;
-			if (pdgId == 13 && closest.isDirectPromptTauDecayProduct()) return KappaEnumTypes::GenMatchingCode::IS_MUON_FROM_TAU;
-		}
-		return KappaEnumTypes::GenMatchingCode::IS_FAKE;
 	}
-	return KappaEnumTypes::GenMatchingCode::NONE;
+	//check whether there are closer tau jets within a 0.2 cone
+	for (std::vector<RMFLV>::const_iterator genTau = genTaus.begin(); genTau != genTaus.end(); ++genTau)
+	{
+		double tauDR = ROOT::Math::VectorUtil::DeltaR(lepton->p4, *genTau);
+		if (genTau->Pt() > 15. && tauDR < 0.2 && tauDR < closestDR) return KappaEnumTypes::GenMatchingCode::IS_TAU_HAD_DECAY;
+	}
+	//since there are no closer tau jets check whether dR < 0.2 is fulfilled and return lepton type
+	if (closestDR < 0.2)
+	{
+		int pdgId = std::abs(genParticleView.GetParticle(closestIndex)->pdgId);
+		bool isPrompt = genParticleView.HasFlags(closestIndex, GenParticleView::IS_PROMPT);
+		bool isFromTau = genParticleView.HasFlags(closestIndex, GenParticleView::IS_DIRECT_PROMPT_TAU_DECAY_PRODUCT);
+		if (pdgId == 11 && isPrompt) return KappaEnumTypes::GenMatchingCode::IS_ELE_PROMPT;
+		if (pdgId == 13 && isPrompt) return KappaEnumTypes::GenMatchingCode::IS_MUON_PROMPT;
+		if (pdgId == 11 && isFromTau) return KappaEnumTypes::GenMatchingCode::IS_ELE_FROM_TAU;
+		if (pdgId == 13 && isFromTau) return KappaEnumTypes::GenMatchingCode::IS_MUON_FROM_TAU;
+	}
+	return KappaEnumTypes::GenMatchingCode::IS_FAKE;
 }
 
-std::vector<RMFLV> GeneratorInfo::BuildGenTausUW(
-		KappaTypes::event_type const& event
+void GeneratorInfo::BuildGenTausUW(
+		GenParticleView const& genParticleView,
+		std::vector<RMFLV>& genTaus
 )
 {
-	std::vector<RMFLV> genTaus;
-
-	if(event.m_genParticles && event.m_genParticles->size() > 0)
+	genTaus.clear();
+	for (uint32_t index : genParticleView.GetParticlesWithAbsPdgId(15))
 	{
-		for (typename std::vector<KGenParticle>::iterator genParticle = event.m_genParticles->begin();
-			genParticle != event.m_genParticles->end(); ++genParticle)
+		GenParticleView::IndexRange daughters = genParticleView.GetDaughters(index);
+		if (genParticleView.HasFlags(index, GenParticleView::IS_PROMPT) && (! daughters.empty()))
 		{
-			if (std::abs(genParticle->pdgId) == 15)
+			bool has_tau_daughter = false;
+			bool has_lepton_daughter = false;
+			for (uint32_t daughter : daughters)
 			{
-				if (genParticle->isPrompt())
-				{
-					if (genParticle->nDaughters() > 0)
-					{
-						bool has_tau_daughter = false;
-						bool has_lepton_daughter = false;
-						for (unsigned dau = 0; dau < genParticle->nDaughters(); ++dau)
-						{
-							assert(genParticle->daughterIndex(dau) >= 0);
-							int pdgId = std::abs(event.m_genParticles->at(genParticle->daughterIndex(dau)).pdgId);
-							if (pdgId == 15) has_tau_daughter = true;
-							if (pdgId == 11 || pdgId == 13) has_lepton_daughter = true;
-						}
-						if (has_tau_daughter) continue;
-						if (has_lepton_daughter) continue;
+				int pdgId = std::abs(genParticleView.GetParticle(daughter)->pdgId);
+				if (pdgId == 15) has_tau_daughter = true;
+				if (pdgId == 11 || pdgId == 13) has_lepton_daughter = true;
+			}
+			if (has_tau_daughter) continue;
+			if (has_lepton_daughter) continue;
 
-						RMFLV genTau;
-						for (size_t dau = 0; dau < genParticle->nDaughters(); ++dau)
-						{
-							assert(genParticle->daughterIndex(dau) >= 0);
-							int pdgId = std::abs(event.m_genParticles->at(genParticle->daughterIndex(dau)).pdgId);
-							if (pdgId == 12 || pdgId == 14 || pdgId == 16) continue;
-							genTau += event.m_genParticles->at(genParticle->daughterIndex(dau)).p4;
-						}
-						genTaus.push_back(genTau);
-					}
-				}
+			RMFLV genTau;
+			for (uint32_t daughter : daughters)
+			{
+				KGenParticle* genParticle = genParticleView.GetParticle(daughter);
+				int pdgId = std::abs(genParticle->pdgId);
+				if (pdgId == 12 || pdgId == 14 || pdgId == 16) continue;
+				genTau += genParticle->p4;
 			}
+			genTaus.push_back(genTau);
 		}
 	}
+}
+
+KappaEnumTypes::GenMatchingCode GeneratorInfo::GetGenMatchingCodeUW(
+		KappaTypes::event_type const& event,
+		KLepton* lepton
+)
+{
+	if (! event.m_genParticles)
+	{
+		return KappaEnumTypes::GenMatchingCode::NONE;
+	}
+	GenParticleView genParticleView;
+	genParticleView.Build(event.m_genParticles);
+	std::vector<RMFLV> genTaus;
+	BuildGenTausUW(genParticleView, genTaus);
+	return GetGenMatchingCodeUW(genParticleView, genTaus, lepton);
+}
+
+std::vector<RMFLV> GeneratorInfo::BuildGenTausUW(
+		KappaTypes::event_type const& event
+)
+{
+	std::vector<RMFLV> genTaus;
+	if (event.m_genParticles)
+	{
+		GenParticleView genParticleView;
+		genParticleView.Build(event.m_genParticles);
+		BuildGenTausUW(genParticleView, genTaus);
+	}
 	return genTaus;
 }
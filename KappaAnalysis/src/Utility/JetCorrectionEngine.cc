@@ -0,0 +1,301 @@
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "Artus/KappaAnalysis/interface/Utility/JetCorrectionEngine.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+void JetCorrectionInputs::Clear()
+{
+	pt.clear();
+	eta.clear();
+	phi.clear();
+	energy.clear();
+	area.clear();
+}
+
+
+JetCorrectionLevelTable::Variable JetCorrectionLevelTable::ToVariable(std::string const& variableName)
+{
+	if (variableName == "JetPt") return Variable::JET_PT;
+	else if (variableName == "JetEta") return Variable::JET_ETA;
+	else if (variableName == "JetPhi") return Variable::JET_PHI;
+	else if (variableName == "JetE") return Variable::JET_E;
+	else if (variableName == "JetA") return Variable::JET_AREA;
+	else if (variableName == "Rho") return Variable::RHO;
+	else if (variableName == "NPV") return Variable::N_VERTICES;
+	else return Variable::NONE;
+}
+
+JetCorrectionLevelTable::JetCorrectionLevelTable(JetCorrectorParameters const& parameters) :
+	m_level(parameters.definitions().level())
+{
+	JetCorrectorParameters::Definitions const& definitions = parameters.definitions();
+
+	for (unsigned int binVariableIndex = 0; binVariableIndex < definitions.nBinVar(); ++binVariableIndex)
+	{
+		m_binVariables.push_back(ToVariable(definitions.binVar(binVariableIndex)));
+	}
+	for (unsigned int formulaVariableIndex = 0; formulaVariableIndex < definitions.nParVar(); ++formulaVariableIndex)
+	{
+		m_formulaVariables.push_back(ToVariable(definitions.parVar(formulaVariableIndex)));
+	}
+
+	if (definitions.isResponse() || (m_formulaVariables.size() > 4) ||
+	    (std::find(m_binVariables.begin(), m_binVariables.end(), Variable::NONE) != m_binVariables.end()) ||
+	    (std::find(m_formulaVariables.begin(), m_formulaVariables.end(), Variable::NONE) != m_formulaVariables.end()))
+	{
+		m_isSupported = false;
+		return;
+	}
+
+	m_formula.reset(new TFormula(("JetCorrectionEngine_" + m_level).c_str(), definitions.formula().c_str()));
+
+	// order of the bins: sorted by the lower edges in case of one binning variable, otherwise as in the file
+	m_nBins = parameters.size();
+	std::vector<unsigned int> recordIndices(m_nBins);
+	std::iota(recordIndices.begin(), recordIndices.end(), 0);
+	if (m_binVariables.size() == 1)
+	{
+		std::stable_sort(recordIndices.begin(), recordIndices.end(), [&parameters](unsigned int index1, unsigned int index2) -> bool
+		{
+			return parameters.record(index1).xMin(0) < parameters.record(index2).xMin(0);
+		});
+	}
+
+	// the first 2*nFormulaVariables parameters of each record are the ranges of the formula variables
+	size_t nFormulaVariables = m_formulaVariables.size();
+	m_nParameters = 0;
+	for (unsigned int recordIndex : recordIndices)
+	{
+		m_nParameters = std::max(m_nParameters, parameters.record(recordIndex).nParameters() - 2 * nFormulaVariables);
+	}
+
+	m_parameters.resize(m_nBins * m_nParameters, 0.0);
+	for (size_t bin = 0; bin < m_nBins; ++bin)
+	{
+		JetCorrectorParameters::Record const& record = parameters.record(recordIndices[bin]);
+		for (size_t binVariableIndex = 0; binVariableIndex < m_binVariables.size(); ++binVariableIndex)
+		{
+			m_binLowerEdges.push_back(record.xMin(binVariableIndex));
+			m_binUpperEdges.push_back(record.xMax(binVariableIndex));
+		}
+		std::vector<float> const& recordParameters = record.parameters();
+		for (size_t formulaVariableIndex = 0; formulaVariableIndex < nFormulaVariables; ++formulaVariableIndex)
+		{
+			m_formulaVariableMinima.push_back(recordParameters[2 * formulaVariableIndex]);
+			m_formulaVariableMaxima.push_back(recordParameters[2 * formulaVariableIndex + 1]);
+		}
+		std::copy(recordParameters.begin() + 2 * nFormulaVariables, recordParameters.end(),
+		          m_parameters.begin() + bin * m_nParameters);
+	}
+}
+
+void JetCorrectionLevelTable::Apply(JetCorrectionInputs& inputs, std::vector<double>& corrections) const
+{
+	assert(m_isSupported);
+
+	std::vector<double> const* variables[7] = { &inputs.pt, &inputs.eta, &inputs.phi, &inputs.energy, &inputs.area, nullptr, nullptr };
+	auto getVariable = [&inputs, &variables](Variable variable, size_t jetIndex) -> double
+	{
+		if (variable == Variable::RHO) return inputs.rho;
+		else if (variable == Variable::N_VERTICES) return inputs.nVertices;
+		else return (*variables[static_cast<int>(variable)])[jetIndex];
+	};
+
+	size_t nBinVariables = m_binVariables.size();
+	size_t nFormulaVariables = m_formulaVariables.size();
+	double binValues[7];
+	double formulaValues[4] = { 0.0, 0.0, 0.0, 0.0 };
+	int previousBin = 0;
+
+	for (size_t jetIndex = 0; jetIndex < inputs.size(); ++jetIndex)
+	{
+		for (size_t binVariableIndex = 0; binVariableIndex < nBinVariables; ++binVariableIndex)
+		{
+			binValues[binVariableIndex] = getVariable(m_binVariables[binVariableIndex], jetIndex);
+		}
+
+		int bin = FindBin(binValues, previousBin);
+		if (bin < 0)
+		{
+			// no correction outside of the binning (as in SimpleJetCorrector)
+			continue;
+		}
+
+		// the formula variables are clamped to the ranges given for the bin
+		for (size_t formulaVariableIndex = 0; formulaVariableIndex < nFormulaVariables; ++formulaVariableIndex)
+		{
+			size_t rangeIndex = bin * nFormulaVariables + formulaVariableIndex;
+			formulaValues[formulaVariableIndex] = std::min(std::max(getVariable(m_formulaVariables[formulaVariableIndex], jetIndex),
+			                                                        m_formulaVariableMinima[rangeIndex]),
+			                                               m_formulaVariableMaxima[rangeIndex]);
+		}
+
+		double correction = m_formula->EvalPar(formulaValues, &(m_parameters[bin * m_nParameters]));
+		corrections[jetIndex] *= correction;
+		inputs.pt[jetIndex] *= correction;
+		inputs.energy[jetIndex] *= correction;
+	}
+}
+
+int JetCorrectionLevelTable::FindBin(double const* binValues, int& previousBin) const
+{
+	size_t nBinVariables = m_binVariables.size();
+	if (m_nBins == 0)
+	{
+		return -1;
+	}
+	else if (nBinVariables == 0)
+	{
+		return 0;
+	}
+	else if (nBinVariables == 1)
+	{
+		std::vector<double>::const_iterator upperBound = std::upper_bound(m_binLowerEdges.begin(), m_binLowerEdges.end(), binValues[0]);
+		if (upperBound == m_binLowerEdges.begin())
+		{
+			return -1;
+		}
+		int bin = static_cast<int>(upperBound - m_binLowerEdges.begin()) - 1;
+		return ((binValues[0] < m_binUpperEdges[bin]) ? bin : -1);
+	}
+	else
+	{
+		for (size_t binCounter = 0; binCounter < m_nBins; ++binCounter)
+		{
+			size_t bin = (previousBin + binCounter) % m_nBins;
+			bool inBin = true;
+			for (size_t binVariableIndex = 0; inBin && (binVariableIndex < nBinVariables); ++binVariableIndex)
+			{
+				size_t edgeIndex = bin * nBinVariables + binVariableIndex;
+				inBin = ((binValues[binVariableIndex] >= m_binLowerEdges[edgeIndex]) &&
+				         (binValues[binVariableIndex] < m_binUpperEdges[edgeIndex]));
+			}
+			if (inBin)
+			{
+				previousBin = static_cast<int>(bin);
+				return previousBin;
+			}
+		}
+		return -1;
+	}
+}
+
+
+JetCorrectionEngine::JetCorrectionEngine(std::vector<JetCorrectorParameters> const& parameters)
+{
+	for (std::vector<JetCorrectorParameters>::const_iterator levelParameters = parameters.begin();
+	     levelParameters != parameters.end(); ++levelParameters)
+	{
+		m_levels.push_back(std::unique_ptr<JetCorrectionLevelTable>(new JetCorrectionLevelTable(*levelParameters)));
+		if (! m_levels.back()->IsSupported())
+		{
+			LOG(WARNING) << "The jet energy correction level " << m_levels.back()->GetLevel()
+			             << " cannot be evaluated by the JetCorrectionEngine.";
+		}
+	}
+}
+
+bool JetCorrectionEngine::IsSupported() const
+{
+	return std::all_of(m_levels.begin(), m_levels.end(), [](std::unique_ptr<JetCorrectionLevelTable> const& level) -> bool
+	{
+		return level->IsSupported();
+	});
+}
+
+void JetCorrectionEngine::GetCorrections(JetCorrectionInputs& inputs, std::vector<double>& corrections) const
+{
+	corrections.assign(inputs.size(), 1.0);
+	for (std::vector<std::unique_ptr<JetCorrectionLevelTable> >::const_iterator level = m_levels.begin();
+	     level != m_levels.end(); ++level)
+	{
+		(*level)->Apply(inputs, corrections);
+	}
+}
+
+
+JetCorrectionUncertaintyTable::JetCorrectionUncertaintyTable(JetCorrectorParameters const& parameters)
+{
+	if (parameters.definitions().nBinVar() != 1)
+	{
+		LOG(FATAL) << "Jet energy correction uncertainties are expected to be binned in one variable (JetEta).";
+	}
+
+	std::vector<unsigned int> recordIndices(parameters.size());
+	std::iota(recordIndices.begin(), recordIndices.end(), 0);
+	std::stable_sort(recordIndices.begin(), recordIndices.end(), [&parameters](unsigned int index1, unsigned int index2) -> bool
+	{
+		return parameters.record(index1).xMin(0) < parameters.record(index2).xMin(0);
+	});
+
+	m_nodeOffsets.push_back(0);
+	for (unsigned int recordIndex : recordIndices)
+	{
+		JetCorrectorParameters::Record const& record = parameters.record(recordIndex);
+		m_binLowerEdges.push_back(record.xMin(0));
+		m_binUpperEdges.push_back(record.xMax(0));
+
+		std::vector<float> const& recordParameters = record.parameters();
+		if ((recordParameters.size() % 3) != 0)
+		{
+			LOG(FATAL) << "Jet energy correction uncertainties need to be given as (pt, up, down) triplets.";
+		}
+		for (size_t node = 0; node < recordParameters.size() / 3; ++node)
+		{
+			m_nodePt.push_back(recordParameters[3 * node]);
+			m_nodeUp.push_back(recordParameters[3 * node + 1]);
+			m_nodeDown.push_back(recordParameters[3 * node + 2]);
+		}
+		m_nodeOffsets.push_back(m_nodePt.size());
+	}
+}
+
+void JetCorrectionUncertaintyTable::GetUncertainties(JetCorrectionInputs const& inputs, float* uncertaintiesUp,
+                                                     float* uncertaintiesDown, size_t stride) const
+{
+	for (size_t jetIndex = 0; jetIndex < inputs.size(); ++jetIndex)
+	{
+		float& uncertaintyUp = uncertaintiesUp[jetIndex * stride];
+		float& uncertaintyDown = uncertaintiesDown[jetIndex * stride];
+		uncertaintyUp = 0.0f;
+		uncertaintyDown = 0.0f;
+
+		std::vector<double>::const_iterator upperBound = std::upper_bound(m_binLowerEdges.begin(), m_binLowerEdges.end(), inputs.eta[jetIndex]);
+		if (upperBound == m_binLowerEdges.begin())
+		{
+			continue;
+		}
+		size_t bin = (upperBound - m_binLowerEdges.begin()) - 1;
+		if ((inputs.eta[jetIndex] >= m_binUpperEdges[bin]) || (m_nodeOffsets[bin] == m_nodeOffsets[bin + 1]))
+		{
+			continue;
+		}
+
+		// constant extrapolation outside of the nodes, linear interpolation between them
+		std::vector<float>::const_iterator firstNode = m_nodePt.begin() + m_nodeOffsets[bin];
+		std::vector<float>::const_iterator lastNode = m_nodePt.begin() + m_nodeOffsets[bin + 1] - 1;
+		float pt = inputs.pt[jetIndex];
+		if (pt <= *firstNode)
+		{
+			uncertaintyUp = m_nodeUp[firstNode - m_nodePt.begin()];
+			uncertaintyDown = m_nodeDown[firstNode - m_nodePt.begin()];
+		}
+		else if (pt >= *lastNode)
+		{
+			uncertaintyUp = m_nodeUp[lastNode - m_nodePt.begin()];
+			uncertaintyDown = m_nodeDown[lastNode - m_nodePt.begin()];
+		}
+		else
+		{
+			size_t upperNode = std::upper_bound(firstNode, lastNode + 1, pt) - m_nodePt.begin();
+			size_t lowerNode = upperNode - 1;
+			float fraction = (pt - m_nodePt[lowerNode]) / (m_nodePt[upperNode] - m_nodePt[lowerNode]);
+			uncertaintyUp = m_nodeUp[lowerNode] + fraction * (m_nodeUp[upperNode] - m_nodeUp[lowerNode]);
+			uncertaintyDown = m_nodeDown[lowerNode] + fraction * (m_nodeDown[upperNode] - m_nodeDown[lowerNode]);
+		}
+	}
+}
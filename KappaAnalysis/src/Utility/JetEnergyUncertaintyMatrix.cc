@@ -0,0 +1,55 @@
+
+#include <algorithm>
+
+#include "Artus/KappaAnalysis/interface/Utility/JetEnergyUncertaintyMatrix.h"
+
+
+const size_t JetEnergyUncertaintyMatrix::NotAvailable;
+
+void JetEnergyUncertaintyMatrix::Reset(std::vector<std::string> const* sources, size_t nJets)
+{
+	m_sources = sources;
+	m_jetRows.clear();
+	m_jetRows.reserve(nJets);
+	m_uncertaintiesUp.clear();
+	m_uncertaintiesDown.clear();
+}
+
+size_t JetEnergyUncertaintyMatrix::AddJet(KLV const* jet)
+{
+	size_t row = m_jetRows.size();
+	m_jetRows[jet] = row;
+	m_uncertaintiesUp.resize((row + 1) * GetNSources(), 0.0f);
+	m_uncertaintiesDown.resize((row + 1) * GetNSources(), 0.0f);
+	return row;
+}
+
+std::vector<std::string> const& JetEnergyUncertaintyMatrix::GetSources() const
+{
+	static const std::vector<std::string> noSources;
+	return ((m_sources == nullptr) ? noSources : *m_sources);
+}
+
+size_t JetEnergyUncertaintyMatrix::GetSourceIndex(std::string const& source) const
+{
+	std::vector<std::string> const& sources = GetSources();
+	std::vector<std::string>::const_iterator sourceIt = std::find(sources.begin(), sources.end(), source);
+	return ((sourceIt == sources.end()) ? NotAvailable : static_cast<size_t>(sourceIt - sources.begin()));
+}
+
+float JetEnergyUncertaintyMatrix::GetUncertainty(KLV const* jet, size_t sourceIndex, bool up) const
+{
+	FlatMap<KLV const*, size_t>::const_iterator jetRow = m_jetRows.find(jet);
+	if ((jetRow == m_jetRows.end()) || (sourceIndex >= GetNSources()))
+	{
+		return 0.0f;
+	}
+	size_t index = jetRow->second * GetNSources() + sourceIndex;
+	return (up ? m_uncertaintiesUp[index] : m_uncertaintiesDown[index]);
+}
+
+RMFLV JetEnergyUncertaintyMatrix::GetShiftedP4(KLV const* jet, size_t sourceIndex, float shift) const
+{
+	return (jet->p4 * (1.0 + shift * GetUncertainty(jet, sourceIndex, shift > 0.0f)));
+}
+
@@ -0,0 +1,30 @@
+
+#include <algorithm>
+
+#include "Artus/KappaAnalysis/interface/Utility/MetadataHandles.h"
+
+
+const size_t MetadataNameHandle::NotAvailable;
+
+MetadataNameHandle::MetadataNameHandle(std::string const& name) :
+	m_name(name)
+{
+}
+
+bool MetadataNameHandle::Resolve(std::vector<std::string> const& names)
+{
+	// the metadata objects are reused when new files or lumi sections are read,
+	// therefore the content is checked at the resolved index
+	if ((m_names == &names) && (m_nNames == names.size()) &&
+	    IsAvailable() && (names[m_index] == m_name))
+	{
+		return true;
+	}
+
+	m_names = &names;
+	m_nNames = names.size();
+	std::vector<std::string>::const_iterator name = std::find(names.begin(), names.end(), m_name);
+	m_index = ((name == names.end()) ? NotAvailable : static_cast<size_t>(name - names.begin()));
+	return IsAvailable();
+}
+
@@ -0,0 +1,49 @@
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Artus/KappaAnalysis/interface/Utility/PFCandidateStore.h"
+
+
+PFCandidateStore::Type PFCandidateStore::GetTypeFromPdgId(int pdgId)
+{
+	switch (std::abs(pdgId))
+	{
+		case 211: return Type::CHARGED_HADRON;
+		case 130: return Type::NEUTRAL_HADRON;
+		case 11: return Type::ELECTRON;
+		case 13: return Type::MUON;
+		case 22: return Type::PHOTON;
+		case 1: return Type::HADRONIC_HF;
+		case 2: return Type::ELECTROMAGNETIC_HF;
+		default: return Type::UNKNOWN;
+	}
+}
+
+void PFCandidateStore::Fill(std::vector<KPFCandidate> const* candidates, float gridCellSize)
+{
+	m_candidates = candidates;
+	size_t nCandidates = m_candidates->size();
+
+	m_pts.resize(nCandidates);
+	m_etas.resize(nCandidates);
+	m_phis.resize(nCandidates);
+	m_types.resize(nCandidates);
+	m_fromFirstPV.resize(nCandidates);
+	std::fill(m_nCandidatesPerType, m_nCandidatesPerType + NTypes, 0);
+
+	for (size_t index = 0; index < nCandidates; ++index)
+	{
+		KPFCandidate const& candidate = (*m_candidates)[index];
+		m_pts[index] = candidate.p4.Pt();
+		m_etas[index] = candidate.p4.Eta();
+		m_phis[index] = candidate.p4.Phi();
+		m_types[index] = GetTypeFromPdgId(candidate.pdgId);
+		m_fromFirstPV[index] = ((candidate.fromFirstPVFlag > 1) ? 1 : 0);
+		++m_nCandidatesPerType[static_cast<size_t>(m_types[index])];
+	}
+
+	m_gridCellSize = gridCellSize;
+	m_grid.Fill(m_etas, m_phis, m_gridCellSize);
+}
+
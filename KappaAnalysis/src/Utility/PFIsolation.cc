@@ -0,0 +1,106 @@
+
+#include <algorithm>
+
+#include "Artus/KappaAnalysis/interface/Utility/PFIsolation.h"
+#include "Artus/Utility/interface/DeltaRMatching.h"
+
+
+void PFIsolationSums::Reset(size_t nObjects, size_t nCones)
+{
+	m_nObjects = nObjects;
+	m_nCones = nCones;
+	m_sums.assign(m_nObjects * m_nCones * NComponents, 0.0f);
+}
+
+float PFIsolationSums::GetRelativeIsolationDeltaBeta(size_t objectIndex, size_t coneIndex, float pt, float deltaBetaFactor) const
+{
+	float neutral = GetSum(objectIndex, coneIndex, NEUTRAL) + GetSum(objectIndex, coneIndex, PHOTON) -
+	                deltaBetaFactor * GetSum(objectIndex, coneIndex, PILEUP);
+	return ((GetSum(objectIndex, coneIndex, CHARGED) + std::max(neutral, 0.0f)) / pt);
+}
+
+
+void PFIsolationEngine::Init(Config const& config)
+{
+	m_config = config;
+
+	m_maxConeSize = 0.0f;
+	m_coneSizes2.clear();
+	for (std::vector<float>::const_iterator coneSize = m_config.coneSizes.begin(); coneSize != m_config.coneSizes.end(); ++coneSize)
+	{
+		m_maxConeSize = std::max(m_maxConeSize, *coneSize);
+		m_coneSizes2.push_back(DeltaRMatcher::GetDeltaR2Cut(*coneSize));
+	}
+	for (size_t component = 0; component < PFIsolationSums::NComponents; ++component)
+	{
+		m_vetoCones2[component] = DeltaRMatcher::GetDeltaR2Cut(m_config.vetoCones[component]);
+	}
+}
+
+void PFIsolationEngine::Compute(PFCandidateStore const& pfCandidates, std::vector<float> const& etas, std::vector<float> const& phis,
+                                PFIsolationSums& sums) const
+{
+	sums.Reset(etas.size(), m_coneSizes2.size());
+	size_t nCones = m_coneSizes2.size();
+	float maxConeSize2 = m_maxConeSize * m_maxConeSize;
+
+	for (size_t objectIndex = 0; objectIndex < etas.size(); ++objectIndex)
+	{
+		float eta = etas[objectIndex];
+		float phi = phis[objectIndex];
+		pfCandidates.ForEachCandidateNear(eta, phi, m_maxConeSize, [&](size_t candidateIndex)
+		{
+			// NComponents: the candidate does not contribute to the isolation
+			size_t component = PFIsolationSums::NComponents;
+			switch (pfCandidates.GetType(candidateIndex))
+			{
+				case PFCandidateStore::Type::CHARGED_HADRON:
+					component = (pfCandidates.IsFromFirstPV(candidateIndex) ? PFIsolationSums::CHARGED : PFIsolationSums::PILEUP);
+					break;
+				case PFCandidateStore::Type::NEUTRAL_HADRON:
+					component = PFIsolationSums::NEUTRAL;
+					break;
+				case PFCandidateStore::Type::PHOTON:
+					component = PFIsolationSums::PHOTON;
+					break;
+				case PFCandidateStore::Type::ELECTRON:
+					break;
+				case PFCandidateStore::Type::MUON:
+					break;
+				case PFCandidateStore::Type::HADRONIC_HF:
+					break;
+				case PFCandidateStore::Type::ELECTROMAGNETIC_HF:
+					break;
+				case PFCandidateStore::Type::UNKNOWN:
+					break;
+				default:
+					break;
+			}
+			if (component == PFIsolationSums::NComponents)
+			{
+				return;
+			}
+
+			float pt = pfCandidates.GetPt(candidateIndex);
+			if (pt <= m_config.minPts[component])
+			{
+				return;
+			}
+
+			float deltaR2 = pfCandidates.GetDeltaR2(candidateIndex, eta, phi);
+			if ((deltaR2 >= maxConeSize2) || (deltaR2 < m_vetoCones2[component]))
+			{
+				return;
+			}
+
+			for (size_t coneIndex = 0; coneIndex < nCones; ++coneIndex)
+			{
+				if (deltaR2 < m_coneSizes2[coneIndex])
+				{
+					sums.GetSums(objectIndex, coneIndex)[component] += pt;
+				}
+			}
+		});
+	}
+}
+
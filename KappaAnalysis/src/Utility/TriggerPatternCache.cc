@@ -0,0 +1,87 @@
+
+#include "Artus/KappaAnalysis/interface/Utility/TriggerPatternCache.h"
+
+
+size_t TriggerPatternCache::AddPattern(std::string const& pattern)
+{
+	std::unordered_map<std::string, size_t>::const_iterator patternIndex = m_patternIndices.find(pattern);
+	if (patternIndex != m_patternIndices.end())
+	{
+		return patternIndex->second;
+	}
+
+	m_patterns.push_back(pattern);
+	m_regularExpressions.push_back(boost::regex(pattern, boost::regex::icase | boost::regex::extended));
+	m_matches.push_back(std::vector<char>());
+	m_patternIndices[pattern] = m_patterns.size() - 1;
+	return m_patterns.size() - 1;
+}
+
+std::vector<size_t> TriggerPatternCache::AddPatterns(std::vector<std::string> const& patterns)
+{
+	std::vector<size_t> patternIndices;
+	for (std::vector<std::string>::const_iterator pattern = patterns.begin(); pattern != patterns.end(); ++pattern)
+	{
+		patternIndices.push_back(AddPattern(*pattern));
+	}
+	return patternIndices;
+}
+
+void TriggerPatternCache::SetNames(std::vector<std::string> const& names, uint64_t run, uint64_t lumi)
+{
+	if (m_namesSet && (run == m_run) && (lumi == m_lumi))
+	{
+		return;
+	}
+	m_run = run;
+	m_lumi = lumi;
+	m_namesSet = true;
+
+	// the trigger menu usually does not change within a run
+	if (names != m_names)
+	{
+		m_names = names;
+		for (std::vector<std::vector<char> >::iterator matches = m_matches.begin(); matches != m_matches.end(); ++matches)
+		{
+			matches->clear();
+		}
+	}
+}
+
+bool TriggerPatternCache::Matches(size_t patternIndex, size_t nameIndex) const
+{
+	std::vector<char> const& matches = GetMatches(patternIndex);
+	return ((nameIndex < matches.size()) && (matches[nameIndex] != 0));
+}
+
+bool TriggerPatternCache::MatchesAny(size_t patternIndex, std::vector<int> const& nameIndices) const
+{
+	std::vector<char> const& matches = GetMatches(patternIndex);
+	for (std::vector<int>::const_iterator nameIndex = nameIndices.begin(); nameIndex != nameIndices.end(); ++nameIndex)
+	{
+		if ((*nameIndex >= 0) && (static_cast<size_t>(*nameIndex) < matches.size()) && (matches[*nameIndex] != 0))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+std::vector<std::string> const& TriggerPatternCache::GetNames() const
+{
+	return m_names;
+}
+
+std::vector<char> const& TriggerPatternCache::GetMatches(size_t patternIndex) const
+{
+	std::vector<char>& matches = m_matches.at(patternIndex);
+	if (matches.size() != m_names.size())
+	{
+		matches.resize(m_names.size());
+		for (size_t nameIndex = 0; nameIndex < m_names.size(); ++nameIndex)
+		{
+			matches[nameIndex] = (boost::regex_search(m_names[nameIndex], m_regularExpressions[patternIndex]) ? 1 : 0);
+		}
+	}
+	return matches;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+
+/**
+   \brief Counter based random number generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+
+   The random numbers are a pure function of a 128 bit counter and a 64 bit key. There is no internal state,
+   every (counter, key) combination can be evaluated in O(1) in any order.
+*/
+class Philox4x32
+{
+public:
+	typedef std::array<uint32_t, 4> Counter;
+	typedef std::array<uint32_t, 2> Key;
+
+	static Counter Generate(Counter counter, Key key);
+};
+
+
+/**
+   \brief Stream of random numbers derived from a key and a position (e.g. one object in one event).
+
+   The stream only holds its own counter, copies of a stream produce the same numbers.
+   Streams with different keys or positions are independent.
+*/
+class RandomStream
+{
+public:
+
+	RandomStream(uint64_t key, uint64_t position, uint32_t objectIndex);
+
+	/// 32 random bits
+	uint32_t UInt32();
+
+	/// uniform in (0, 1), as TRandom::Rndm
+	double Rndm();
+
+	/// uniform in (0, x1) or (x1, x2), as TRandom::Uniform
+	double Uniform(double x1=1.0);
+	double Uniform(double x1, double x2);
+
+	/// normal distribution, as TRandom::Gaus
+	double Gaus(double mean=0.0, double sigma=1.0);
+
+private:
+	Philox4x32::Counter m_counter;
+	Philox4x32::Key m_key;
+
+	Philox4x32::Counter m_block = {{ 0, 0, 0, 0 }};
+	size_t m_nUsed = 4;
+};
+
+
+/**
+   \brief Reproducible random numbers for the processors, keyed by the event identity.
+
+   The streams depend only on (run, lumi, event, processor ID, object index). The numbers for an object
+   therefore do not depend on the order of the events, the splitting of the input into jobs or on which
+   other processors or pipelines draw random numbers. There is no shared mutable state.
+*/
+class RandomNumberService
+{
+public:
+
+	static uint64_t HashName(std::string const& name);
+
+	static RandomStream GetStream(uint64_t run, uint64_t lumi, uint64_t event,
+	                              std::string const& processorId, uint32_t objectIndex=0);
+	static RandomStream GetStream(uint64_t run, uint64_t lumi, uint64_t event,
+	                              uint64_t processorIdHash, uint32_t objectIndex=0);
+};
+
@@ -15,33 +15,34 @@ public:
     
     static const float EtaBorderEB;
     
-    static const int pdgIdGluon;
-    static const int pdgIdGamma;
-    static const int pdgIdZ;
-    static const int pdgIdW;
-    static const int pdgIdH;
-    static const int pdgIdHCPOdd;
-    static const int pdgIdACPOdd;
+    // constexpr, such that they can be used in compile time tables
+    static constexpr int pdgIdGluon = 21;
+    static constexpr int pdgIdGamma = 22;
+    static constexpr int pdgIdZ = 23;
+    static constexpr int pdgIdW = 24;
+    static constexpr int pdgIdH = 25;
+    static constexpr int pdgIdHCPOdd = 35;
+    static constexpr int pdgIdACPOdd = 36;
 
-    static const int pdgIdPiZero;
-    static const int pdgIdPiPlus;
-    static const int pdgIdRhoPlus770;
-    static const int pdgIdEta;
-    static const int pdgIdProton;
+    static constexpr int pdgIdPiZero = 111;
+    static constexpr int pdgIdPiPlus = 211;
+    static constexpr int pdgIdRhoPlus770 = 213;
+    static constexpr int pdgIdEta = 221;
+    static constexpr int pdgIdProton = 2212;
 
-    static const int pdgIdKPlus;
-    static const int pdgIdKStar;
-    static const int pdgIdKLong;
-    static const int pdgIdKShort;
+    static constexpr int pdgIdKPlus = 321;
+    static constexpr int pdgIdKStar = 323;
+    static constexpr int pdgIdKLong = 130;
+    static constexpr int pdgIdKShort = 310;
 
-    static const int pdgIdElectron;
-    static const int pdgIdNuE;
-    static const int pdgIdMuon;
-    static const int pdgIdNuMu;
-    static const int pdgIdTau;
-    static const int pdgIdNuTau;
+    static constexpr int pdgIdElectron = 11;
+    static constexpr int pdgIdNuE = 12;
+    static constexpr int pdgIdMuon = 13;
+    static constexpr int pdgIdNuMu = 14;
+    static constexpr int pdgIdTau = 15;
+    static constexpr int pdgIdNuTau = 16;
 
-    static const int pdgIdAOnePlus1260;
+    static constexpr int pdgIdAOnePlus1260 = 20213;
 
     static const float ElectronMassGeV;
     static const float MuonMassGeV;
@@ -0,0 +1,147 @@
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+   \brief Coordinates of a collection of objects in the eta-phi plane, stored as separate arrays.
+
+   The arrays are filled once per collection and event and are used by DeltaRMatcher.
+   The capacities are kept when clearing the arrays.
+*/
+class EtaPhiArrays
+{
+public:
+
+	void Clear();
+	void Reserve(size_t size);
+
+	void Add(float eta, float phi);
+
+	/// add an object with a Lorentz vector member p4
+	template<class TObject>
+	void AddObject(TObject const& object)
+	{
+		Add(object.p4.Eta(), object.p4.Phi());
+	}
+
+	/// add all objects of a collection (of objects or of pointers to objects)
+	template<class TObject>
+	void AddObjects(std::vector<TObject*> const& objects)
+	{
+		Reserve(m_etas.size() + objects.size());
+		for (typename std::vector<TObject*>::const_iterator object = objects.begin(); object != objects.end(); ++object)
+		{
+			AddObject(**object);
+		}
+	}
+	template<class TObject>
+	void AddObjects(std::vector<TObject> const& objects)
+	{
+		Reserve(m_etas.size() + objects.size());
+		for (typename std::vector<TObject>::const_iterator object = objects.begin(); object != objects.end(); ++object)
+		{
+			AddObject(*object);
+		}
+	}
+
+	size_t GetSize() const { return m_etas.size(); }
+	float const* GetEtas() const { return m_etas.data(); }
+	float const* GetPhis() const { return m_phis.data(); }
+
+private:
+	std::vector<float> m_etas;
+	std::vector<float> m_phis;
+};
+
+
+/**
+   \brief Matching of two collections of objects by their distance DeltaR in the eta-phi plane.
+
+   The squared distances DeltaR^2 of all pairs are computed with SIMD vectors from EtaPhiArrays,
+   the phi differences are wrapped into [0, pi]. No square roots are taken, the DeltaR cuts are
+   compared to DeltaR^2. All cuts are exclusive, i.e. DeltaR < maxDeltaR, as in the producers
+   using ROOT::Math::VectorUtil::DeltaR before.
+
+   Matching strategies (Match):
+   - GREEDY_NEAREST: every object of the first collection is matched to the nearest object of the
+     second collection within maxDeltaR, several objects can be matched to the same object.
+     In case of equal distances, the first object of the second collection is taken.
+   - UNIQUE_ASSIGNMENT: the pairs within maxDeltaR are assigned in the order of increasing distance,
+     such that every object of both collections is used at most once.
+
+   The results refer to the indices in the EtaPhiArrays. Collections with additional requirements
+   on the objects (e.g. PDG IDs) need to keep their own mapping to the original collections.
+*/
+class DeltaRMatcher
+{
+public:
+
+	enum class Strategy : int
+	{
+		GREEDY_NEAREST = 0,
+		UNIQUE_ASSIGNMENT = 1,
+	};
+
+	/// index of the matched object for objects without match
+	static const int NoMatch = -1;
+
+	/// square of a DeltaR cut for comparisons with DeltaR^2 values; negative cuts (e.g. to disable a cut)
+	/// are mapped to -1, such that <, <=, > and >= give the same results as for the DeltaR values
+	static float GetDeltaR2Cut(float deltaRCut)
+	{
+		return ((deltaRCut < 0.0f) ? -1.0f : (deltaRCut * deltaRCut));
+	}
+
+	/// deltaR2[i] = DeltaR^2((eta, phi), objects[i]), deltaR2 needs to have space for objects.GetSize() values
+	static void ComputeDeltaR2(float eta, float phi, EtaPhiArrays const& objects, float* deltaR2);
+
+	/// true if two different objects of the collection are closer than minDeltaR
+	static bool HasPairCloserThan(EtaPhiArrays const& objects, float minDeltaR);
+
+	/// compute the matrix of DeltaR^2 values for all pairs of objects
+	void Compute(EtaPhiArrays const& objects1, EtaPhiArrays const& objects2);
+
+	size_t GetNObjects1() const { return m_nObjects1; }
+	size_t GetNObjects2() const { return m_nObjects2; }
+
+	float GetDeltaR2(size_t index1, size_t index2) const
+	{
+		return m_deltaR2[index1 * m_nObjects2 + index2];
+	}
+
+	/// DeltaR^2 of the object index1 to all objects of the second collection
+	float const* GetDeltaR2Row(size_t index1) const
+	{
+		return m_deltaR2.data() + (index1 * m_nObjects2);
+	}
+
+	/// smallest DeltaR^2 of the object index1 to the objects of the second collection (max. float if empty)
+	float GetMinDeltaR2(size_t index1) const;
+
+	/// index of the nearest object of the second collection within maxDeltaR or NoMatch
+	int GetNearest(size_t index1, float maxDeltaR) const;
+
+	/// indices of the matched objects of the second collection for all objects of the first collection
+	std::vector<int> const& Match(Strategy strategy, float maxDeltaR);
+
+private:
+
+	struct Pair
+	{
+		float deltaR2;
+		size_t index1;
+		size_t index2;
+	};
+
+	size_t m_nObjects1 = 0;
+	size_t m_nObjects2 = 0;
+	std::vector<float> m_deltaR2;
+	std::vector<int> m_matches;
+
+	// buffers for the unique assignment
+	std::vector<Pair> m_pairs;
+	std::vector<char> m_assigned2;
+};
@@ -0,0 +1,88 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+/**
+   \brief Spatial index of objects in the eta-phi plane.
+
+   The objects are bucketed into cells with a size of at least the maximum distance that is
+   searched for. All objects within this distance of a given point are therefore located in the
+   3x3 neighbouring cells, with the periodicity in phi taken into account. Objects beyond
+   the eta range of the grid are put into the outermost cells.
+
+   The cells are stored as one flat array of object indices sorted by cell (offsets per cell),
+   such that filling the grid needs no allocations once the vectors have reached their size.
+*/
+class EtaPhiGrid
+{
+public:
+
+	EtaPhiGrid();
+
+	/// fill the grid with objects at the given coordinates; the object index in the candidates
+	/// reported by ForEachCandidate is the position in these vectors
+	void Fill(std::vector<float> const& etas, std::vector<float> const& phis, float maxDistance,
+	          float maxAbsEta=5.0f);
+
+	size_t GetNObjects() const;
+
+	/// call function(objectIndex) for all objects in the cells neighbouring (eta, phi)
+	/// these objects are candidates for being closer than maxDistance to the point,
+	/// the distance itself has to be checked by the caller
+	template<class TFunction>
+	void ForEachCandidate(float eta, float phi, TFunction function) const
+	{
+		if (m_objectIndices.empty())
+		{
+			return;
+		}
+
+		size_t etaCell = GetEtaCell(eta);
+		size_t phiCell = GetPhiCell(phi);
+
+		// unsigned cell indices, the neighbours are clamped (eta) or wrapped (phi) without negative intermediate values
+		size_t firstEtaCell = ((etaCell > 0) ? etaCell - 1 : 0);
+		size_t lastEtaCell = ((etaCell + 1 < m_nEtaCells) ? etaCell + 1 : etaCell);
+		size_t neighbourPhiCells[3] = {
+			((phiCell > 0) ? phiCell - 1 : m_nPhiCells - 1),
+			phiCell,
+			((phiCell + 1 < m_nPhiCells) ? phiCell + 1 : 0)
+		};
+
+		// with less than three cells in phi, the neighbouring cells are not distinct
+		size_t firstPhiNeighbour = ((m_nPhiCells == 1) ? 1 : 0);
+		size_t lastPhiNeighbour = ((m_nPhiCells < 3) ? 1 : 2);
+
+		for (size_t neighbourEtaCell = firstEtaCell; neighbourEtaCell <= lastEtaCell; ++neighbourEtaCell)
+		{
+			for (size_t phiNeighbour = firstPhiNeighbour; phiNeighbour <= lastPhiNeighbour; ++phiNeighbour)
+			{
+				size_t cell = neighbourEtaCell * m_nPhiCells + neighbourPhiCells[phiNeighbour];
+				for (size_t entry = m_cellOffsets[cell]; entry < m_cellOffsets[cell + 1]; ++entry)
+				{
+					function(m_objectIndices[entry]);
+				}
+			}
+		}
+	}
+
+private:
+
+	float m_etaMin;
+	float m_etaCellSize;
+	float m_phiCellSize;
+	size_t m_nEtaCells;
+	size_t m_nPhiCells;
+
+	std::vector<size_t> m_cellOffsets;
+	std::vector<size_t> m_objectIndices;
+	std::vector<size_t> m_objectCells;
+	std::vector<size_t> m_cellFill;
+
+	size_t GetEtaCell(float eta) const;
+	size_t GetPhiCell(float phi) const;
+};
@@ -0,0 +1,170 @@
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+/**
+   \brief Associative container storing the (key, value) pairs in one vector sorted by key.
+
+   Intended for the small per-event associations in the products (e.g. reco object -> matched gen particle),
+   where a std::map needs one node allocation per insert. Lookups are binary searches on contiguous memory,
+   clear() keeps the capacity, such that products reused for several events do not allocate in the steady state.
+   Copies of the container (e.g. per pipeline) copy one block of memory.
+
+   The interface is the subset of std::map used for these associations (operator[], find, count, at,
+   insert, erase, iteration). The iteration order is the order of the keys, as for std::map.
+   Differences to std::map:
+   - the elements are std::pair<TKey, TValue> (the key is not const, but must not be modified via iterators)
+   - inserting and erasing elements invalidates iterators and references to other elements
+*/
+template<class TKey, class TValue>
+class FlatMap
+{
+public:
+
+	typedef TKey key_type;
+	typedef TValue mapped_type;
+	typedef std::pair<TKey, TValue> value_type;
+	typedef typename std::vector<value_type>::size_type size_type;
+	typedef typename std::vector<value_type>::iterator iterator;
+	typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+	FlatMap() = default;
+
+	template<class TInputIterator>
+	FlatMap(TInputIterator first, TInputIterator last)
+	{
+		insert(first, last);
+	}
+
+	iterator begin() { return m_elements.begin(); }
+	iterator end() { return m_elements.end(); }
+	const_iterator begin() const { return m_elements.begin(); }
+	const_iterator end() const { return m_elements.end(); }
+
+	size_type size() const { return m_elements.size(); }
+	bool empty() const { return m_elements.empty(); }
+	size_type capacity() const { return m_elements.capacity(); }
+
+	void reserve(size_type size) { m_elements.reserve(size); }
+
+	/// removes all elements and keeps the capacity
+	void clear() { m_elements.clear(); }
+
+	iterator find(TKey const& key)
+	{
+		iterator element = LowerBound(key);
+		return (((element != m_elements.end()) && (! std::less<TKey>()(key, element->first))) ? element : m_elements.end());
+	}
+
+	const_iterator find(TKey const& key) const
+	{
+		const_iterator element = LowerBound(key);
+		return (((element != m_elements.end()) && (! std::less<TKey>()(key, element->first))) ? element : m_elements.end());
+	}
+
+	size_type count(TKey const& key) const
+	{
+		return ((find(key) != end()) ? 1 : 0);
+	}
+
+	TValue& at(TKey const& key)
+	{
+		iterator element = find(key);
+		if (element == m_elements.end())
+		{
+			throw std::out_of_range("FlatMap::at");
+		}
+		return element->second;
+	}
+
+	TValue const& at(TKey const& key) const
+	{
+		const_iterator element = find(key);
+		if (element == m_elements.end())
+		{
+			throw std::out_of_range("FlatMap::at");
+		}
+		return element->second;
+	}
+
+	TValue& operator[](TKey const& key)
+	{
+		return insert(value_type(key, TValue())).first->second;
+	}
+
+	/// inserts the element if the key is not yet contained, as std::map::insert
+	std::pair<iterator, bool> insert(value_type const& value)
+	{
+		iterator element = LowerBound(value.first);
+		if ((element != m_elements.end()) && (! std::less<TKey>()(value.first, element->first)))
+		{
+			return std::make_pair(element, false);
+		}
+		return std::make_pair(m_elements.insert(element, value), true);
+	}
+
+	/// inserts elements of other associative containers with convertible keys and values
+	template<class TInputIterator>
+	void insert(TInputIterator first, TInputIterator last)
+	{
+		for (; first != last; ++first)
+		{
+			insert(value_type(first->first, first->second));
+		}
+	}
+
+	size_type erase(TKey const& key)
+	{
+		iterator element = find(key);
+		if (element == m_elements.end())
+		{
+			return 0;
+		}
+		m_elements.erase(element);
+		return 1;
+	}
+
+	iterator erase(iterator element)
+	{
+		return m_elements.erase(element);
+	}
+
+	bool operator==(FlatMap const& other) const
+	{
+		return (m_elements == other.m_elements);
+	}
+
+	bool operator!=(FlatMap const& other) const
+	{
+		return (m_elements != other.m_elements);
+	}
+
+private:
+
+	struct KeyLess
+	{
+		bool operator()(value_type const& element, TKey const& key) const
+		{
+			return std::less<TKey>()(element.first, key);
+		}
+	};
+
+	iterator LowerBound(TKey const& key)
+	{
+		return std::lower_bound(m_elements.begin(), m_elements.end(), key, KeyLess());
+	}
+
+	const_iterator LowerBound(TKey const& key) const
+	{
+		return std::lower_bound(m_elements.begin(), m_elements.end(), key, KeyLess());
+	}
+
+	std::vector<value_type> m_elements;
+};
+
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+
+/**
+   \brief Memory arena for objects that all live until the same point in time (e.g. the end of an event).
+
+   Memory is taken from large blocks by incrementing an offset. Single objects are never freed. Reset
+   destroys all objects created in the arena (in reverse order) and rewinds to the first block. The blocks
+   are kept for the next round, such that the arena itself does not allocate memory in the steady state.
+   Objects with trivial destructors are not registered for destruction, resetting the memory for them is O(1).
+
+   Pointers to objects in the arena are stable until Reset is called.
+
+   The arena counts the rounds (calls of Reset) and the rounds in which new blocks had to be allocated,
+   such that it can be checked that the memory usage reaches a steady state.
+*/
+class MonotonicArena : private boost::noncopyable
+{
+public:
+
+	explicit MonotonicArena(size_t blockSize=65536);
+	~MonotonicArena();
+
+	/// uninitialised memory with the given size and alignment
+	void* Allocate(size_t size, size_t alignment);
+
+	/// create an object in the arena, it is destroyed by Reset
+	template<class T, class... TArgs>
+	T* Create(TArgs&&... args)
+	{
+		T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+		if (! std::is_trivially_destructible<T>::value)
+		{
+			m_destructors.push_back(Destructor(object, &Destroy<T>));
+		}
+		return object;
+	}
+
+	/// destroy all objects and make the memory available again
+	void Reset();
+
+	/// number of bytes used since the last reset
+	size_t GetUsedSize() const;
+
+	/// number of bytes reserved in all blocks
+	size_t GetCapacity() const;
+
+	size_t GetNBlocks() const { return m_blocks.size(); }
+
+	/// number of calls of Reset
+	size_t GetNRounds() const { return m_nRounds; }
+
+	/// number of rounds in which blocks have been allocated and the number of the last one
+	size_t GetNGrowingRounds() const { return m_nGrowingRounds; }
+	size_t GetLastGrowingRound() const { return m_lastGrowingRound; }
+
+private:
+
+	struct Block
+	{
+		char* memory;
+		size_t size;
+	};
+
+	typedef std::pair<void*, void (*)(void*)> Destructor;
+
+	template<class T>
+	static void Destroy(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+
+	size_t m_blockSize;
+	std::vector<Block> m_blocks;
+	size_t m_currentBlock = 0;
+	size_t m_offset = 0;
+
+	std::vector<Destructor> m_destructors;
+
+	size_t m_nRounds = 0;
+	size_t m_nGrowingRounds = 0;
+	size_t m_lastGrowingRound = 0;
+};
+
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/**
+   \brief Set of (run, lumi, event) numbers with O(1) lookups, e.g. for the event lists of sync exercises or overlap removals.
+
+   The entries are stored in an open addressing hash table (linear probing) with a power of two number of slots,
+   at most 3/4 of which are used. Every slot holds 16 bytes (run and lumi with 32 bits each, event with 64 bits),
+   the table therefore needs between 21 and 43 bytes per entry. Optionally, a Bloom filter with a given number of
+   bits per entry (rounded up to a power of two in total) is checked before the table. It rejects most of the events
+   that are not contained in the index by testing a few bits of a much smaller array. GetMemorySize reports the
+   size of both arrays.
+
+   Binary list files contain the magic bytes "ARTUSRLE", the number of entries (uint64) and the entries as
+   (run uint32, lumi uint32, event uint64), all in little endian byte order. They are written by
+   KappaAnalysis/scripts/writeRunLumiEventList.py.
+*/
+class RunLumiEventIndex
+{
+public:
+
+	struct Entry
+	{
+		uint64_t run;
+		uint64_t lumi;
+		uint64_t event;
+	};
+
+	/// append the entries of a binary list file
+	static void ReadBinaryFile(std::string const& fileName, std::vector<Entry>& entries);
+
+	/// replaces the content of the index, duplicate entries are stored once
+	/// no Bloom filter is built for bloomFilterBitsPerEntry = 0
+	void Build(std::vector<Entry> const& entries, size_t bloomFilterBitsPerEntry=0);
+
+	bool Contains(uint64_t run, uint64_t lumi, uint64_t event) const;
+
+	size_t GetNEntries() const { return m_nEntries; }
+	bool IsEmpty() const { return (m_nEntries == 0); }
+
+	/// memory used by the hash table and the Bloom filter in bytes
+	size_t GetMemorySize() const;
+
+private:
+
+	struct Slot
+	{
+		uint64_t runLumi;
+		uint64_t event;
+	};
+
+	static bool PackRunLumi(uint64_t run, uint64_t lumi, uint64_t& runLumi);
+	static uint64_t Hash(uint64_t runLumi, uint64_t event);
+
+	bool IsEmptySlot(Slot const& slot) const
+	{
+		return ((slot.runLumi == EmptyRunLumi) && (slot.event == EmptyEvent));
+	}
+
+	bool BloomFilterContains(uint64_t hash) const;
+
+	static const uint64_t EmptyRunLumi = ~uint64_t(0);
+	static const uint64_t EmptyEvent = ~uint64_t(0);
+
+	size_t m_nEntries = 0;
+	std::vector<Slot> m_slots;
+	uint64_t m_slotMask = 0;
+
+	std::vector<uint64_t> m_bloomFilterWords;
+	uint64_t m_bloomFilterBitMask = 0;
+	size_t m_nBloomFilterHashes = 0;
+};
+
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree_fwd.hpp>
+
+
+/**
+   \brief Evaluation of TMVA BDT classifiers without TMVA.
+
+   The forest is read from the TMVA XML weight file and stored in flat arrays (cut variable, cut value,
+   children and leaf value per node). All trees are padded to their maximum depth: leaves point to themselves,
+   therefore the traversal is a fixed number of steps without data dependent branches.
+   The evaluation follows MethodBDT::PrivateGetMvaValue and DecisionTree::CheckEvent: cuts are compared in
+   single precision, the leaf values are combined in double precision in the order of the trees.
+
+   Supported are classification forests with the boost types AdaBoost, Bagging and Grad without input
+   variable transformations and without Fisher cuts. IsSupported returns false for other weight files,
+   in which case the TMVA::Reader has to be used.
+*/
+class TmvaBdtEvaluator
+{
+public:
+
+	explicit TmvaBdtEvaluator(std::string const& weightFile);
+
+	bool IsSupported() const { return m_isSupported; }
+	std::string const& GetReason() const { return m_reason; }
+
+	size_t GetNVariables() const { return m_nVariables; }
+	size_t GetNTrees() const { return m_treeRoots.size(); }
+
+	/// MVA output for one set of input variables (in the order of the weight file)
+	double Evaluate(float const* inputs) const;
+
+	/// MVA outputs for nRows sets of input variables, row i starts at inputs[i * rowStride]
+	void Evaluate(float const* inputs, size_t nRows, size_t rowStride, double* outputs) const;
+
+private:
+
+	enum class BoostType : int
+	{
+		ADA_BOOST = 0,
+		GRAD = 1
+	};
+
+	void SetUnsupported(std::string const& reason);
+
+	/// returns the index of the node, the children are added recursively
+	int32_t AddNode(boost::property_tree::ptree const& node, int32_t depth, int32_t& maxDepth,
+	                bool regression, bool useYesNoLeaf);
+
+	double Finalise(double sum) const;
+
+	bool m_isSupported = true;
+	std::string m_reason;
+
+	BoostType m_boostType = BoostType::ADA_BOOST;
+	size_t m_nVariables = 0;
+
+	// per tree
+	std::vector<int32_t> m_treeRoots;
+	std::vector<int32_t> m_treeDepths;
+	std::vector<double> m_treeWeights;
+	double m_sumOfTreeWeights = 0.0;
+
+	// per node, the children of node i are m_children[2*i] (cut failed) and m_children[2*i+1] (cut passed)
+	std::vector<int32_t> m_cutVariables;
+	std::vector<float> m_cutValues;
+	std::vector<int32_t> m_children;
+	std::vector<double> m_leafValues;
+};
+
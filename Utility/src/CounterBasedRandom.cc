@@ -0,0 +1,108 @@
+
+#include <cmath>
+
+#include "Artus/Utility/interface/CounterBasedRandom.h"
+
+
+namespace
+{
+	// 64 bit finaliser of SplitMix64, used to combine the parts of the key
+	uint64_t Mix(uint64_t value)
+	{
+		value += 0x9E3779B97F4A7C15ull;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+}
+
+
+Philox4x32::Counter Philox4x32::Generate(Counter counter, Key key)
+{
+	static const uint32_t multiplier0 = 0xD2511F53;
+	static const uint32_t multiplier1 = 0xCD9E8D57;
+	static const uint32_t weyl0 = 0x9E3779B9;
+	static const uint32_t weyl1 = 0xBB67AE85;
+
+	for (size_t round = 0; round < 10; ++round)
+	{
+		uint64_t product0 = static_cast<uint64_t>(multiplier0) * counter[0];
+		uint64_t product1 = static_cast<uint64_t>(multiplier1) * counter[2];
+		counter = {{ static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+		             static_cast<uint32_t>(product1),
+		             static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+		             static_cast<uint32_t>(product0) }};
+		key[0] += weyl0;
+		key[1] += weyl1;
+	}
+	return counter;
+}
+
+
+RandomStream::RandomStream(uint64_t key, uint64_t position, uint32_t objectIndex) :
+	m_counter({{ 0, objectIndex, static_cast<uint32_t>(position), static_cast<uint32_t>(position >> 32) }}),
+	m_key({{ static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32) }})
+{
+}
+
+uint32_t RandomStream::UInt32()
+{
+	if (m_nUsed == m_block.size())
+	{
+		m_block = Philox4x32::Generate(m_counter, m_key);
+		++m_counter[0];
+		m_nUsed = 0;
+	}
+	return m_block[m_nUsed++];
+}
+
+double RandomStream::Rndm()
+{
+	return (UInt32() + 0.5) * (1.0 / 4294967296.0);
+}
+
+double RandomStream::Uniform(double x1)
+{
+	return x1 * Rndm();
+}
+
+double RandomStream::Uniform(double x1, double x2)
+{
+	return x1 + (x2 - x1) * Rndm();
+}
+
+double RandomStream::Gaus(double mean, double sigma)
+{
+	// Box-Muller
+	double radius = std::sqrt(-2.0 * std::log(Rndm()));
+	double angle = 2.0 * M_PI * Rndm();
+	return mean + sigma * radius * std::cos(angle);
+}
+
+
+uint64_t RandomNumberService::HashName(std::string const& name)
+{
+	// FNV-1a
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (std::string::const_iterator character = name.begin(); character != name.end(); ++character)
+	{
+		hash ^= static_cast<unsigned char>(*character);
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
+RandomStream RandomNumberService::GetStream(uint64_t run, uint64_t lumi, uint64_t event,
+                                            std::string const& processorId, uint32_t objectIndex)
+{
+	return GetStream(run, lumi, event, HashName(processorId), objectIndex);
+}
+
+RandomStream RandomNumberService::GetStream(uint64_t run, uint64_t lumi, uint64_t event,
+                                            uint64_t processorIdHash, uint32_t objectIndex)
+{
+	// the event number goes into the counter, the other parts are combined into the key
+	uint64_t key = Mix(Mix(Mix(processorIdHash) ^ run) ^ lumi);
+	return RandomStream(key, event, objectIndex);
+}
+
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "Artus/Utility/interface/DeltaRMatching.h"
+
+
+namespace
+{
+	// four floats per SIMD vector (SSE/NEON), GCC and clang vector extensions
+	typedef float FloatVector __attribute__((vector_size(4 * sizeof(float))));
+	typedef int IntVector __attribute__((vector_size(4 * sizeof(int))));
+	const size_t VectorSize = 4;
+
+	const float Pi = static_cast<float>(M_PI);
+	const float TwoPi = static_cast<float>(2.0 * M_PI);
+
+	inline FloatVector LoadVector(float const* values)
+	{
+		FloatVector vector;
+		std::memcpy(&vector, values, sizeof(vector));
+		return vector;
+	}
+
+	inline void StoreVector(FloatVector const& vector, float* values)
+	{
+		std::memcpy(values, &vector, sizeof(vector));
+	}
+
+	inline FloatVector AbsVector(FloatVector const& vector)
+	{
+		IntVector bits;
+		std::memcpy(&bits, &vector, sizeof(bits));
+		bits &= 0x7fffffff;
+		FloatVector result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	inline FloatVector MinVector(FloatVector const& vector1, FloatVector const& vector2)
+	{
+		IntVector mask = (vector1 < vector2);
+		IntVector bits1, bits2;
+		std::memcpy(&bits1, &vector1, sizeof(bits1));
+		std::memcpy(&bits2, &vector2, sizeof(bits2));
+		IntVector bits = (bits1 & mask) | (bits2 & ~mask);
+		FloatVector result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	// the input phi values are within [-pi, pi]
+	inline float DeltaR2(float eta1, float phi1, float eta2, float phi2)
+	{
+		float deltaEta = eta1 - eta2;
+		float deltaPhi = std::abs(phi1 - phi2);
+		deltaPhi = std::min(deltaPhi, TwoPi - deltaPhi);
+		return (deltaEta * deltaEta) + (deltaPhi * deltaPhi);
+	}
+}
+
+
+void EtaPhiArrays::Clear()
+{
+	m_etas.clear();
+	m_phis.clear();
+}
+
+void EtaPhiArrays::Reserve(size_t size)
+{
+	m_etas.reserve(size);
+	m_phis.reserve(size);
+}
+
+void EtaPhiArrays::Add(float eta, float phi)
+{
+	m_etas.push_back(eta);
+	// wrap into [-pi, pi] such that the kernel only needs to handle differences up to 2 pi
+	if (std::abs(phi) > Pi)
+	{
+		phi = std::remainder(phi, TwoPi);
+	}
+	m_phis.push_back(phi);
+}
+
+
+const int DeltaRMatcher::NoMatch;
+
+void DeltaRMatcher::ComputeDeltaR2(float eta, float phi, EtaPhiArrays const& objects, float* deltaR2)
+{
+	float const* etas = objects.GetEtas();
+	float const* phis = objects.GetPhis();
+	size_t nObjects = objects.GetSize();
+
+	FloatVector etaVector = {eta, eta, eta, eta};
+	FloatVector phiVector = {phi, phi, phi, phi};
+	FloatVector twoPiVector = {TwoPi, TwoPi, TwoPi, TwoPi};
+
+	size_t index = 0;
+	for (; index + VectorSize <= nObjects; index += VectorSize)
+	{
+		FloatVector deltaEta = etaVector - LoadVector(etas + index);
+		FloatVector deltaPhi = AbsVector(phiVector - LoadVector(phis + index));
+		deltaPhi = MinVector(deltaPhi, twoPiVector - deltaPhi);
+		StoreVector((deltaEta * deltaEta) + (deltaPhi * deltaPhi), deltaR2 + index);
+	}
+	for (; index < nObjects; ++index)
+	{
+		deltaR2[index] = DeltaR2(eta, phi, etas[index], phis[index]);
+	}
+}
+
+bool DeltaRMatcher::HasPairCloserThan(EtaPhiArrays const& objects, float minDeltaR)
+{
+	float minDeltaR2 = GetDeltaR2Cut(minDeltaR);
+	float const* etas = objects.GetEtas();
+	float const* phis = objects.GetPhis();
+	for (size_t index1 = 0; index1 < objects.GetSize(); ++index1)
+	{
+		for (size_t index2 = index1 + 1; index2 < objects.GetSize(); ++index2)
+		{
+			if (DeltaR2(etas[index1], phis[index1], etas[index2], phis[index2]) < minDeltaR2)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void DeltaRMatcher::Compute(EtaPhiArrays const& objects1, EtaPhiArrays const& objects2)
+{
+	m_nObjects1 = objects1.GetSize();
+	m_nObjects2 = objects2.GetSize();
+	m_deltaR2.resize(m_nObjects1 * m_nObjects2);
+
+	for (size_t index1 = 0; index1 < m_nObjects1; ++index1)
+	{
+		ComputeDeltaR2(objects1.GetEtas()[index1], objects1.GetPhis()[index1], objects2,
+		               m_deltaR2.data() + (index1 * m_nObjects2));
+	}
+}
+
+float DeltaRMatcher::GetMinDeltaR2(size_t index1) const
+{
+	float const* row = GetDeltaR2Row(index1);
+	float minDeltaR2 = std::numeric_limits<float>::max();
+	for (size_t index2 = 0; index2 < m_nObjects2; ++index2)
+	{
+		minDeltaR2 = std::min(minDeltaR2, row[index2]);
+	}
+	return minDeltaR2;
+}
+
+int DeltaRMatcher::GetNearest(size_t index1, float maxDeltaR) const
+{
+	float const* row = GetDeltaR2Row(index1);
+	float minDeltaR2 = GetDeltaR2Cut(maxDeltaR);
+	int nearest = NoMatch;
+	for (size_t index2 = 0; index2 < m_nObjects2; ++index2)
+	{
+		if (row[index2] < minDeltaR2)
+		{
+			minDeltaR2 = row[index2];
+			nearest = static_cast<int>(index2);
+		}
+	}
+	return nearest;
+}
+
+std::vector<int> const& DeltaRMatcher::Match(Strategy strategy, float maxDeltaR)
+{
+	m_matches.assign(m_nObjects1, NoMatch);
+
+	if (strategy == Strategy::GREEDY_NEAREST)
+	{
+		for (size_t index1 = 0; index1 < m_nObjects1; ++index1)
+		{
+			m_matches[index1] = GetNearest(index1, maxDeltaR);
+		}
+	}
+	else
+	{
+		float maxDeltaR2 = GetDeltaR2Cut(maxDeltaR);
+		m_pairs.clear();
+		for (size_t index1 = 0; index1 < m_nObjects1; ++index1)
+		{
+			float const* row = GetDeltaR2Row(index1);
+			for (size_t index2 = 0; index2 < m_nObjects2; ++index2)
+			{
+				if (row[index2] < maxDeltaR2)
+				{
+					Pair pair = { row[index2], index1, index2 };
+					m_pairs.push_back(pair);
+				}
+			}
+		}
+
+		// the order of the objects decides in case of equal distances
+		std::sort(m_pairs.begin(), m_pairs.end(), [](Pair const& pair1, Pair const& pair2) -> bool
+		{
+			if (pair1.deltaR2 != pair2.deltaR2)
+			{
+				return pair1.deltaR2 < pair2.deltaR2;
+			}
+			return (pair1.index1 != pair2.index1) ? (pair1.index1 < pair2.index1) : (pair1.index2 < pair2.index2);
+		});
+
+		m_assigned2.assign(m_nObjects2, 0);
+		for (std::vector<Pair>::const_iterator pair = m_pairs.begin(); pair != m_pairs.end(); ++pair)
+		{
+			if ((m_matches[pair->index1] == NoMatch) && (! m_assigned2[pair->index2]))
+			{
+				m_matches[pair->index1] = static_cast<int>(pair->index2);
+				m_assigned2[pair->index2] = 1;
+			}
+		}
+	}
+
+	return m_matches;
+}
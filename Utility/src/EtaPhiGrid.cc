@@ -0,0 +1,91 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include "Artus/Utility/interface/EtaPhiGrid.h"
+
+
+EtaPhiGrid::EtaPhiGrid() :
+	m_etaMin(0.0f),
+	m_etaCellSize(1.0f),
+	m_phiCellSize(1.0f),
+	m_nEtaCells(1),
+	m_nPhiCells(1)
+{
+}
+
+void EtaPhiGrid::Fill(std::vector<float> const& etas, std::vector<float> const& phis, float maxDistance,
+                      float maxAbsEta)
+{
+	// cells must not be smaller than the search distance
+	if (! (maxDistance > 0.0f))
+	{
+		maxDistance = 2.0f * maxAbsEta;
+	}
+	m_nPhiCells = std::max(size_t(1), static_cast<size_t>(std::floor(2.0 * M_PI / maxDistance)));
+	m_phiCellSize = static_cast<float>(2.0 * M_PI / static_cast<double>(m_nPhiCells));
+	m_nEtaCells = std::max(size_t(1), static_cast<size_t>(std::floor(2.0f * maxAbsEta / maxDistance)));
+	m_etaCellSize = 2.0f * maxAbsEta / static_cast<float>(m_nEtaCells);
+	m_etaMin = -maxAbsEta;
+
+	// counting sort of the objects into the cells
+	size_t nCells = m_nEtaCells * m_nPhiCells;
+	m_cellOffsets.assign(nCells + 1, 0);
+	m_objectCells.resize(etas.size());
+	for (size_t objectIndex = 0; objectIndex < etas.size(); ++objectIndex)
+	{
+		m_objectCells[objectIndex] = GetEtaCell(etas[objectIndex]) * m_nPhiCells + GetPhiCell(phis[objectIndex]);
+		++m_cellOffsets[m_objectCells[objectIndex] + 1];
+	}
+	for (size_t cell = 0; cell < nCells; ++cell)
+	{
+		m_cellOffsets[cell + 1] += m_cellOffsets[cell];
+	}
+
+	// objects keep their relative order within a cell
+	m_objectIndices.resize(etas.size());
+	m_cellFill.assign(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+	for (size_t objectIndex = 0; objectIndex < etas.size(); ++objectIndex)
+	{
+		m_objectIndices[m_cellFill[m_objectCells[objectIndex]]++] = objectIndex;
+	}
+}
+
+size_t EtaPhiGrid::GetNObjects() const
+{
+	return m_objectIndices.size();
+}
+
+size_t EtaPhiGrid::GetEtaCell(float eta) const
+{
+	// clamp before the conversion, such that no negative or overflowing values are converted
+	float etaCell = std::floor((eta - m_etaMin) / m_etaCellSize);
+	if (! (etaCell > 0.0f))
+	{
+		return 0;
+	}
+	else if (etaCell >= static_cast<float>(m_nEtaCells - 1))
+	{
+		return (m_nEtaCells - 1);
+	}
+	return static_cast<size_t>(etaCell);
+}
+
+size_t EtaPhiGrid::GetPhiCell(float phi) const
+{
+	float wrappedPhi = static_cast<float>(std::fmod(phi + M_PI, 2.0 * M_PI));
+	if (wrappedPhi < 0.0f)
+	{
+		wrappedPhi += static_cast<float>(2.0 * M_PI);
+	}
+	float phiCell = std::floor(wrappedPhi / m_phiCellSize);
+	if (! (phiCell > 0.0f))
+	{
+		return 0;
+	}
+	else if (phiCell >= static_cast<float>(m_nPhiCells - 1))
+	{
+		return (m_nPhiCells - 1);
+	}
+	return static_cast<size_t>(phiCell);
+}
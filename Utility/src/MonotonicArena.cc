@@ -0,0 +1,88 @@
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Artus/Utility/interface/MonotonicArena.h"
+
+
+MonotonicArena::MonotonicArena(size_t blockSize) :
+	m_blockSize(blockSize)
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+	Reset();
+	for (std::vector<Block>::iterator block = m_blocks.begin(); block != m_blocks.end(); ++block)
+	{
+		delete[] block->memory;
+	}
+}
+
+void* MonotonicArena::Allocate(size_t size, size_t alignment)
+{
+	// continue with the current block or with the next (already reserved) blocks that are large enough
+	for (; m_currentBlock < m_blocks.size(); ++m_currentBlock, m_offset = 0)
+	{
+		Block const& block = m_blocks[m_currentBlock];
+		uintptr_t address = reinterpret_cast<uintptr_t>(block.memory) + m_offset;
+		size_t padding = (alignment - (address % alignment)) % alignment;
+		if (m_offset + padding + size <= block.size)
+		{
+			m_offset += padding + size;
+			return block.memory + (m_offset - size);
+		}
+	}
+
+	// new block, memory from new[] is aligned for all fundamental types
+	Block block;
+	block.size = std::max(m_blockSize, size + alignment);
+	block.memory = new char[block.size];
+	m_blocks.push_back(block);
+	if ((m_nGrowingRounds == 0) || (m_lastGrowingRound != m_nRounds))
+	{
+		++m_nGrowingRounds;
+		m_lastGrowingRound = m_nRounds;
+	}
+	m_currentBlock = m_blocks.size() - 1;
+
+	uintptr_t address = reinterpret_cast<uintptr_t>(block.memory);
+	size_t padding = (alignment - (address % alignment)) % alignment;
+	m_offset = padding + size;
+	return block.memory + padding;
+}
+
+void MonotonicArena::Reset()
+{
+	for (std::vector<Destructor>::reverse_iterator destructor = m_destructors.rbegin();
+	     destructor != m_destructors.rend(); ++destructor)
+	{
+		destructor->second(destructor->first);
+	}
+	m_destructors.clear();
+
+	m_currentBlock = 0;
+	m_offset = 0;
+	++m_nRounds;
+}
+
+size_t MonotonicArena::GetUsedSize() const
+{
+	size_t usedSize = m_offset;
+	for (size_t blockIndex = 0; (blockIndex < m_currentBlock) && (blockIndex < m_blocks.size()); ++blockIndex)
+	{
+		usedSize += m_blocks[blockIndex].size;
+	}
+	return usedSize;
+}
+
+size_t MonotonicArena::GetCapacity() const
+{
+	size_t capacity = 0;
+	for (std::vector<Block>::const_iterator block = m_blocks.begin(); block != m_blocks.end(); ++block)
+	{
+		capacity += block->size;
+	}
+	return capacity;
+}
+
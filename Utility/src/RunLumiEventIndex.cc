@@ -0,0 +1,227 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "Artus/Utility/interface/RunLumiEventIndex.h"
+#include "Artus/Utility/interface/ArtusLogging.h"
+
+
+namespace
+{
+	const char BinaryFileMagic[8] = { 'A', 'R', 'T', 'U', 'S', 'R', 'L', 'E' };
+
+	uint64_t Mix(uint64_t value)
+	{
+		// finaliser of splitmix64
+		value ^= (value >> 30);
+		value *= 0xbf58476d1ce4e5b9ULL;
+		value ^= (value >> 27);
+		value *= 0x94d049bb133111ebULL;
+		value ^= (value >> 31);
+		return value;
+	}
+
+	uint64_t NextPowerOfTwo(uint64_t value)
+	{
+		uint64_t result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+		return result;
+	}
+
+	template<class T>
+	bool ReadLittleEndian(std::istream& stream, T& value)
+	{
+		unsigned char bytes[sizeof(T)];
+		if (! stream.read(reinterpret_cast<char*>(bytes), sizeof(T)))
+		{
+			return false;
+		}
+		value = 0;
+		for (size_t byte = 0; byte < sizeof(T); ++byte)
+		{
+			value |= (static_cast<T>(bytes[byte]) << (8 * byte));
+		}
+		return true;
+	}
+
+}
+
+
+void RunLumiEventIndex::ReadBinaryFile(std::string const& fileName, std::vector<Entry>& entries)
+{
+	std::ifstream file(fileName.c_str(), std::ios::binary);
+	if (! file)
+	{
+		LOG(FATAL) << "Run/lumi/event list file \"" << fileName << "\" cannot be opened!";
+	}
+
+	char magic[sizeof(BinaryFileMagic)];
+	uint64_t nEntries = 0;
+	if ((! file.read(magic, sizeof(magic))) || (std::memcmp(magic, BinaryFileMagic, sizeof(magic)) != 0) ||
+	    (! ReadLittleEndian(file, nEntries)))
+	{
+		LOG(FATAL) << "File \"" << fileName << "\" is not a binary run/lumi/event list!";
+	}
+
+	// check the number of entries against the file size before reserving memory for them
+	std::streamoff headerSize = file.tellg();
+	file.seekg(0, std::ios::end);
+	std::streamoff fileSize = file.tellg();
+	file.seekg(headerSize, std::ios::beg);
+	uint64_t entrySize = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+	if ((headerSize < 0) || (fileSize < headerSize) || (! file) ||
+	    (nEntries > static_cast<uint64_t>(fileSize - headerSize) / entrySize))
+	{
+		LOG(FATAL) << "Binary run/lumi/event list \"" << fileName << "\" is too small for " << nEntries << " entries!";
+	}
+
+	entries.reserve(entries.size() + nEntries);
+	for (uint64_t index = 0; index < nEntries; ++index)
+	{
+		uint32_t run = 0;
+		uint32_t lumi = 0;
+		uint64_t event = 0;
+		if ((! ReadLittleEndian(file, run)) || (! ReadLittleEndian(file, lumi)) || (! ReadLittleEndian(file, event)))
+		{
+			LOG(FATAL) << "Binary run/lumi/event list \"" << fileName << "\" is truncated after " << index
+			           << " of " << nEntries << " entries!";
+		}
+		entries.push_back(Entry{ run, lumi, event });
+	}
+}
+
+void RunLumiEventIndex::Build(std::vector<Entry> const& entries, size_t bloomFilterBitsPerEntry)
+{
+	// hash table with a load factor of at most 3/4
+	m_nEntries = 0;
+	uint64_t nSlots = NextPowerOfTwo(std::max(entries.size() * 4 / 3 + 1, size_t(2)));
+	m_slots.assign(nSlots, Slot{ EmptyRunLumi, EmptyEvent });
+	m_slots.shrink_to_fit();
+	m_slotMask = nSlots - 1;
+
+	std::vector<uint64_t> hashes;
+	hashes.reserve(entries.size());
+	for (std::vector<Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+	{
+		uint64_t runLumi = 0;
+		if (! PackRunLumi(entry->run, entry->lumi, runLumi))
+		{
+			LOG(FATAL) << "Run " << entry->run << " or lumi " << entry->lumi << " does not fit into 32 bits!";
+		}
+		if ((runLumi == EmptyRunLumi) && (entry->event == EmptyEvent))
+		{
+			LOG(FATAL) << "Run/lumi/event " << entry->run << ":" << entry->lumi << ":" << entry->event
+			           << " cannot be stored in the index!";
+		}
+
+		uint64_t hash = Hash(runLumi, entry->event);
+		uint64_t slotIndex = hash & m_slotMask;
+		while (! IsEmptySlot(m_slots[slotIndex]))
+		{
+			if ((m_slots[slotIndex].runLumi == runLumi) && (m_slots[slotIndex].event == entry->event))
+			{
+				break;
+			}
+			slotIndex = (slotIndex + 1) & m_slotMask;
+		}
+		if (IsEmptySlot(m_slots[slotIndex]))
+		{
+			m_slots[slotIndex] = Slot{ runLumi, entry->event };
+			hashes.push_back(hash);
+			++m_nEntries;
+		}
+	}
+
+	// Bloom filter with k = ln(2) * bits per entry hash functions (double hashing)
+	m_bloomFilterWords.clear();
+	m_bloomFilterBitMask = 0;
+	m_nBloomFilterHashes = 0;
+	if ((bloomFilterBitsPerEntry > 0) && (m_nEntries > 0))
+	{
+		uint64_t nBits = NextPowerOfTwo(std::max(m_nEntries * bloomFilterBitsPerEntry, size_t(64)));
+		m_bloomFilterWords.assign(nBits / 64, 0);
+		m_bloomFilterWords.shrink_to_fit();
+		m_bloomFilterBitMask = nBits - 1;
+		m_nBloomFilterHashes = std::min(std::max(static_cast<size_t>(std::lround(std::log(2.0) * bloomFilterBitsPerEntry)),
+		                                         size_t(1)), size_t(16));
+
+		for (std::vector<uint64_t>::const_iterator hash = hashes.begin(); hash != hashes.end(); ++hash)
+		{
+			uint64_t bloomHash1 = Mix(*hash);
+			uint64_t bloomHash2 = Mix(bloomHash1) | 1;
+			for (size_t hashIndex = 0; hashIndex < m_nBloomFilterHashes; ++hashIndex)
+			{
+				uint64_t bit = (bloomHash1 + hashIndex * bloomHash2) & m_bloomFilterBitMask;
+				m_bloomFilterWords[bit >> 6] |= (uint64_t(1) << (bit & 63));
+			}
+		}
+	}
+}
+
+bool RunLumiEventIndex::Contains(uint64_t run, uint64_t lumi, uint64_t event) const
+{
+	uint64_t runLumi = 0;
+	if ((m_nEntries == 0) || (! PackRunLumi(run, lumi, runLumi)))
+	{
+		return false;
+	}
+
+	uint64_t hash = Hash(runLumi, event);
+	if ((! m_bloomFilterWords.empty()) && (! BloomFilterContains(hash)))
+	{
+		return false;
+	}
+
+	uint64_t slotIndex = hash & m_slotMask;
+	while (! IsEmptySlot(m_slots[slotIndex]))
+	{
+		if ((m_slots[slotIndex].runLumi == runLumi) && (m_slots[slotIndex].event == event))
+		{
+			return true;
+		}
+		slotIndex = (slotIndex + 1) & m_slotMask;
+	}
+	return false;
+}
+
+size_t RunLumiEventIndex::GetMemorySize() const
+{
+	return ((m_slots.size() * sizeof(Slot)) + (m_bloomFilterWords.size() * sizeof(uint64_t)));
+}
+
+bool RunLumiEventIndex::PackRunLumi(uint64_t run, uint64_t lumi, uint64_t& runLumi)
+{
+	if ((run > std::numeric_limits<uint32_t>::max()) || (lumi > std::numeric_limits<uint32_t>::max()))
+	{
+		return false;
+	}
+	runLumi = ((run << 32) | lumi);
+	return true;
+}
+
+uint64_t RunLumiEventIndex::Hash(uint64_t runLumi, uint64_t event)
+{
+	return Mix(runLumi ^ Mix(event));
+}
+
+bool RunLumiEventIndex::BloomFilterContains(uint64_t hash) const
+{
+	uint64_t bloomHash1 = Mix(hash);
+	uint64_t bloomHash2 = Mix(bloomHash1) | 1;
+	for (size_t hashIndex = 0; hashIndex < m_nBloomFilterHashes; ++hashIndex)
+	{
+		uint64_t bit = (bloomHash1 + hashIndex * bloomHash2) & m_bloomFilterBitMask;
+		if ((m_bloomFilterWords[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
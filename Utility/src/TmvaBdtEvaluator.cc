@@ -0,0 +1,276 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+#include "Artus/Utility/interface/TmvaBdtEvaluator.h"
+
+
+TmvaBdtEvaluator::TmvaBdtEvaluator(std::string const& weightFile)
+{
+	boost::property_tree::ptree weights;
+	try
+	{
+		boost::property_tree::read_xml(weightFile, weights);
+	}
+	catch (boost::property_tree::xml_parser_error const& error)
+	{
+		SetUnsupported("no TMVA XML weight file (" + std::string(error.what()) + ")");
+		return;
+	}
+
+	boost::optional<boost::property_tree::ptree&> method = weights.get_child_optional("MethodSetup");
+	if ((! method) || (method->get<std::string>("<xmlattr>.Method", "").compare(0, 5, "BDT::") != 0))
+	{
+		SetUnsupported("no BDT method");
+		return;
+	}
+
+	boost::optional<boost::property_tree::ptree&> generalInfo = method->get_child_optional("GeneralInfo");
+	if (generalInfo)
+	{
+		for (boost::property_tree::ptree::value_type const& info : *generalInfo)
+		{
+			if ((info.first == "Info") && (info.second.get<std::string>("<xmlattr>.name", "") == "AnalysisType") &&
+			    (info.second.get<std::string>("<xmlattr>.value", "") != "Classification"))
+			{
+				SetUnsupported("no classification");
+				return;
+			}
+		}
+	}
+
+	// options as written by the training, defaults of MethodBDT
+	std::string boostType = "AdaBoost";
+	bool useYesNoLeaf = true;
+	boost::optional<boost::property_tree::ptree&> options = method->get_child_optional("Options");
+	if (options)
+	{
+		for (boost::property_tree::ptree::value_type const& option : *options)
+		{
+			std::string optionName = option.second.get<std::string>("<xmlattr>.name", "");
+			std::string optionValue = option.second.get_value<std::string>();
+			if (optionName == "BoostType")
+			{
+				boostType = optionValue;
+			}
+			else if (optionName == "UseYesNoLeaf")
+			{
+				useYesNoLeaf = ((optionValue == "True") || (optionValue == "true") || (optionValue == "T") || (optionValue == "1"));
+			}
+		}
+	}
+	if ((boostType == "AdaBoost") || (boostType == "Bagging"))
+	{
+		m_boostType = BoostType::ADA_BOOST;
+	}
+	else if (boostType == "Grad")
+	{
+		m_boostType = BoostType::GRAD;
+	}
+	else
+	{
+		SetUnsupported("boost type " + boostType);
+		return;
+	}
+
+	if (method->get<int>("Transformations.<xmlattr>.NTransformations", 0) != 0)
+	{
+		SetUnsupported("input variable transformations");
+		return;
+	}
+
+	m_nVariables = method->get<size_t>("Variables.<xmlattr>.NVar", 0);
+	if (m_nVariables == 0)
+	{
+		SetUnsupported("no input variables");
+		return;
+	}
+
+	boost::optional<boost::property_tree::ptree&> forest = method->get_child_optional("Weights");
+	if (! forest)
+	{
+		SetUnsupported("no trees");
+		return;
+	}
+	// Types::EAnalysisType: 0 = classification, 1 = regression
+	int treeType = forest->get<int>("<xmlattr>.TreeType", forest->get<int>("<xmlattr>.AnalysisType", 0));
+	if ((treeType != 0) && (treeType != 1))
+	{
+		SetUnsupported("tree type " + std::to_string(treeType));
+		return;
+	}
+
+	m_treeRoots.reserve(forest->get<size_t>("<xmlattr>.NTrees", 0));
+	for (boost::property_tree::ptree::value_type const& tree : *forest)
+	{
+		if (tree.first != "BinaryTree")
+		{
+			continue;
+		}
+
+		boost::optional<boost::property_tree::ptree const&> root = tree.second.get_child_optional("Node");
+		if (! root)
+		{
+			SetUnsupported("empty tree");
+			return;
+		}
+
+		int32_t maxDepth = 0;
+		m_treeRoots.push_back(AddNode(*root, 0, maxDepth, (treeType == 1), useYesNoLeaf));
+		m_treeDepths.push_back(maxDepth);
+		m_treeWeights.push_back(tree.second.get<double>("<xmlattr>.boostWeight", 1.0));
+		if (! m_isSupported)
+		{
+			return;
+		}
+	}
+
+	// same order of the summation as in MethodBDT
+	for (std::vector<double>::const_iterator treeWeight = m_treeWeights.begin(); treeWeight != m_treeWeights.end(); ++treeWeight)
+	{
+		m_sumOfTreeWeights += *treeWeight;
+	}
+}
+
+double TmvaBdtEvaluator::Evaluate(float const* inputs) const
+{
+	double sum = 0.0;
+	for (size_t tree = 0; tree < m_treeRoots.size(); ++tree)
+	{
+		int32_t node = m_treeRoots[tree];
+		for (int32_t depth = 0; depth < m_treeDepths[tree]; ++depth)
+		{
+			node = m_children[2 * node + (inputs[m_cutVariables[node]] >= m_cutValues[node])];
+		}
+		sum += ((m_boostType == BoostType::ADA_BOOST) ? m_treeWeights[tree] * m_leafValues[node] : m_leafValues[node]);
+	}
+	return Finalise(sum);
+}
+
+void TmvaBdtEvaluator::Evaluate(float const* inputs, size_t nRows, size_t rowStride, double* outputs) const
+{
+	std::fill(outputs, outputs + nRows, 0.0);
+
+	// trees in the outer loop, such that the nodes of one tree stay in the cache
+	for (size_t tree = 0; tree < m_treeRoots.size(); ++tree)
+	{
+		double treeWeight = ((m_boostType == BoostType::ADA_BOOST) ? m_treeWeights[tree] : 1.0);
+		for (size_t row = 0; row < nRows; ++row)
+		{
+			float const* rowInputs = inputs + row * rowStride;
+			int32_t node = m_treeRoots[tree];
+			for (int32_t depth = 0; depth < m_treeDepths[tree]; ++depth)
+			{
+				node = m_children[2 * node + (rowInputs[m_cutVariables[node]] >= m_cutValues[node])];
+			}
+			outputs[row] += ((m_boostType == BoostType::ADA_BOOST) ? treeWeight * m_leafValues[node] : m_leafValues[node]);
+		}
+	}
+
+	for (size_t row = 0; row < nRows; ++row)
+	{
+		outputs[row] = Finalise(outputs[row]);
+	}
+}
+
+void TmvaBdtEvaluator::SetUnsupported(std::string const& reason)
+{
+	m_isSupported = false;
+	m_reason = reason;
+}
+
+int32_t TmvaBdtEvaluator::AddNode(boost::property_tree::ptree const& node, int32_t depth, int32_t& maxDepth,
+                                  bool regression, bool useYesNoLeaf)
+{
+	// leaves point to themselves
+	int32_t index = static_cast<int32_t>(m_cutVariables.size());
+	m_cutVariables.push_back(0);
+	m_cutValues.push_back(0.0f);
+	m_children.push_back(index);
+	m_children.push_back(index);
+	m_leafValues.push_back(0.0);
+
+	// DecisionTree::CheckEvent descends until a node with a node type different from zero is reached
+	int nodeType = node.get<int>("<xmlattr>.nType", 0);
+	if (nodeType != 0)
+	{
+		if (regression)
+		{
+			m_leafValues[index] = node.get<float>("<xmlattr>.res", 0.0f);
+		}
+		else if (useYesNoLeaf)
+		{
+			m_leafValues[index] = static_cast<double>(nodeType);
+		}
+		else
+		{
+			m_leafValues[index] = node.get<float>("<xmlattr>.purity", 0.0f);
+		}
+		maxDepth = std::max(maxDepth, depth);
+		return index;
+	}
+
+	if (node.get<int>("<xmlattr>.NCoef", 0) > 0)
+	{
+		SetUnsupported("Fisher cuts");
+		return index;
+	}
+	int cutVariable = node.get<int>("<xmlattr>.IVar", -1);
+	if ((cutVariable < 0) || (static_cast<size_t>(cutVariable) >= m_nVariables))
+	{
+		SetUnsupported("invalid cut variable");
+		return index;
+	}
+
+	boost::property_tree::ptree const* left = nullptr;
+	boost::property_tree::ptree const* right = nullptr;
+	for (boost::property_tree::ptree::value_type const& child : node)
+	{
+		if (child.first == "Node")
+		{
+			std::string position = child.second.get<std::string>("<xmlattr>.pos", "");
+			if (position == "l")
+			{
+				left = &(child.second);
+			}
+			else if (position == "r")
+			{
+				right = &(child.second);
+			}
+		}
+	}
+	if ((left == nullptr) || (right == nullptr))
+	{
+		SetUnsupported("intermediate node without children");
+		return index;
+	}
+
+	m_cutVariables[index] = cutVariable;
+	m_cutValues[index] = node.get<float>("<xmlattr>.Cut");
+
+	int32_t leftIndex = AddNode(*left, depth + 1, maxDepth, regression, useYesNoLeaf);
+	int32_t rightIndex = AddNode(*right, depth + 1, maxDepth, regression, useYesNoLeaf);
+
+	// DecisionTreeNode::GoesRight: (value >= cut) for cType = 1, inverted for cType = 0
+	bool cutType = (node.get<int>("<xmlattr>.cType", 1) != 0);
+	m_children[2 * index] = (cutType ? leftIndex : rightIndex);
+	m_children[2 * index + 1] = (cutType ? rightIndex : leftIndex);
+	return index;
+}
+
+double TmvaBdtEvaluator::Finalise(double sum) const
+{
+	if (m_boostType == BoostType::GRAD)
+	{
+		return (2.0 / (1.0 + std::exp(-2.0 * sum)) - 1.0);
+	}
+	else
+	{
+		return ((m_sumOfTreeWeights > std::numeric_limits<double>::epsilon()) ? sum / m_sumOfTreeWeights : 0.0);
+	}
+}
+